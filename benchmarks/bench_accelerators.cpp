@@ -0,0 +1,153 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Acceleration structure benchmark
+*/
+
+/**
+ * @file bench_accelerators.cpp
+ * @brief Compares the memory footprint and ray throughput of the binary and
+ * four-wide bounding volume hierarchies and of the uniform grid on a random
+ * scene
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+#include "core/Color.hpp"
+#include "core/Ray.hpp"
+#include "core/Vector3D.hpp"
+#include "scene/Scene.hpp"
+#include "scene/acceleration/Accelerator.hpp"
+#include "scene/acceleration/BVH.hpp"
+#include "scene/acceleration/BVH4.hpp"
+#include "scene/acceleration/Grid.hpp"
+#include "scene/primitives/Sphere.hpp"
+#include "scene/primitives/Triangle.hpp"
+
+using namespace RayTracer;
+
+namespace {
+
+constexpr int DEFAULT_PRIMITIVES = 100000;
+constexpr int RAY_COUNT = 500000;
+
+Scene makeScene(int count) {
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> position(-50.0, 50.0);
+  std::uniform_real_distribution<double> size(0.05, 0.6);
+
+  Scene scene;
+  for (int i = 0; i < count; ++i) {
+    Vector3D center(position(rng), position(rng), position(rng));
+    if (i % 2 == 0) {
+      scene.addPrimitive(
+          std::make_shared<Sphere>(center, size(rng), Color::RED));
+    } else {
+      scene.addPrimitive(std::make_shared<Triangle>(
+          center, center + Vector3D(size(rng), 0, 0),
+          center + Vector3D(0, size(rng), size(rng)), Color::GREEN));
+    }
+  }
+  return scene;
+}
+
+std::vector<Ray> makeRays(int count) {
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<double> target(-50.0, 50.0);
+  std::vector<Ray> rays;
+  rays.reserve(count);
+  // Primary-like rays from a common viewpoint, coherent enough to be fair
+  Vector3D origin(0, 0, -120);
+  for (int i = 0; i < count; ++i) {
+    Vector3D end(target(rng), target(rng), 50.0);
+    rays.emplace_back(origin, end - origin);
+  }
+  return rays;
+}
+
+std::size_t gridBytes(const Scene& scene) {
+  // The scene does not expose its grid, an identical one is built here
+  std::vector<AABB> bounds;
+  for (const auto& primitive : scene.getPrimitives()) {
+    bounds.push_back(primitive->worldBounds());
+  }
+  Grid grid;
+  grid.build(bounds);
+  std::size_t bytes = grid.getCells().size() * sizeof(Grid::Cell) +
+                      grid.getLevels().size() * sizeof(Grid::Level);
+  for (const auto& cell : grid.getCells()) {
+    bytes += cell.level < 0 ? cell.count * sizeof(uint32_t) : 0;
+  }
+  return bytes;
+}
+
+void run(Scene& scene, AcceleratorType type, const std::vector<Ray>& rays) {
+  scene.setAccelerator(type);
+  scene.finalize();
+  const BVH::BuildStats& stats = scene.getAccelerationStats();
+  std::size_t bytes = 0;
+  if (type == AcceleratorType::GRID) {
+    bytes = gridBytes(scene);
+  } else {
+    bytes = stats.nodeCount * (type == AcceleratorType::BVH4
+                                   ? sizeof(BVH4::Node)
+                                   : sizeof(BVH::Node));
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  std::size_t hits = 0;
+  for (const auto& ray : rays) {
+    hits += scene.traceRay(ray).has_value() ? 1 : 0;
+  }
+  double closestSeconds = std::chrono::duration<double>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+
+  start = std::chrono::steady_clock::now();
+  std::size_t occluded = 0;
+  for (const auto& ray : rays) {
+    occluded += scene.occluded(ray, 170.0) ? 1 : 0;
+  }
+  double anySeconds = std::chrono::duration<double>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+
+  std::cout << std::left << std::setw(6) << acceleratorTypeName(type)
+            << std::right << std::setw(9) << stats.nodeCount << " nodes"
+            << std::setw(10) << std::fixed << std::setprecision(1)
+            << static_cast<double>(bytes) / stats.itemCount << " B/prim"
+            << std::setw(9) << stats.buildMilliseconds << " ms build"
+            << std::setw(8) << std::setprecision(2)
+            << rays.size() / closestSeconds / 1e6 << " Mrays/s closest"
+            << std::setw(8) << rays.size() / anySeconds / 1e6
+            << " Mrays/s any (" << hits << " hits, " << occluded
+            << " occluded)" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int count = argc > 1 ? std::atoi(argv[1]) : DEFAULT_PRIMITIVES;
+  if (count <= 0) {
+    std::cerr << "USAGE: " << argv[0] << " [PRIMITIVE_COUNT]" << std::endl;
+    return 84;
+  }
+
+  Scene scene = makeScene(count);
+  std::vector<Ray> rays = makeRays(RAY_COUNT);
+  std::cout << count << " primitives, " << rays.size() << " rays, SIMD "
+            << (BVH4::usesSimd() ? "on" : "off") << std::endl;
+  run(scene, AcceleratorType::BVH, rays);
+  run(scene, AcceleratorType::BVH4, rays);
+  run(scene, AcceleratorType::GRID, rays);
+  return 0;
+}
@@ -0,0 +1,123 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Ray packet benchmark
+*/
+
+/**
+ * @file bench_packets.cpp
+ * @brief Compares the primary ray throughput of single rays and of packets
+ * of 4, 8 and 16 rays through the binary bounding volume hierarchy
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <vector>
+#include "core/Color.hpp"
+#include "core/Ray.hpp"
+#include "core/Vector3D.hpp"
+#include "scene/Camera.hpp"
+#include "scene/Scene.hpp"
+#include "scene/acceleration/Accelerator.hpp"
+#include "scene/primitives/Sphere.hpp"
+#include "scene/primitives/Triangle.hpp"
+
+using namespace RayTracer;
+
+namespace {
+
+constexpr int DEFAULT_PRIMITIVES = 20000;
+constexpr int WIDTH = 800;
+constexpr int HEIGHT = 600;
+constexpr int TILE_SIZE = 64;
+
+Scene makeScene(int count) {
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> position(-50.0, 50.0);
+  std::uniform_real_distribution<double> depth(-150.0, -50.0);
+  std::uniform_real_distribution<double> size(0.2, 2.0);
+
+  // Everything lies in front of the camera, so that most rays hit
+  Scene scene(Camera(Vector3D(0, 0, 0), WIDTH, HEIGHT, 60.0));
+  for (int i = 0; i < count; ++i) {
+    Vector3D center(position(rng), position(rng), depth(rng));
+    if (i % 2 == 0) {
+      scene.addPrimitive(
+          std::make_shared<Sphere>(center, size(rng), Color::RED));
+    } else {
+      scene.addPrimitive(std::make_shared<Triangle>(
+          center, center + Vector3D(size(rng), 0, 0),
+          center + Vector3D(0, size(rng), size(rng)), Color::GREEN));
+    }
+  }
+  scene.setAccelerator(AcceleratorType::BVH);
+  scene.finalize();
+  return scene;
+}
+
+/**
+ * @brief Trace every primary ray, tile by tile and row by row as the
+ * renderer does
+ * @return The number of rays that hit something
+ */
+std::size_t traceImage(const Scene& scene, int packetSize) {
+  const Camera& camera = scene.getCamera();
+  std::vector<Ray> rays;
+  std::vector<std::optional<Intersection>> hits;
+  std::size_t hitCount = 0;
+  for (int tileY = 0; tileY < HEIGHT; tileY += TILE_SIZE) {
+    for (int tileX = 0; tileX < WIDTH; tileX += TILE_SIZE) {
+      int endX = std::min(tileX + TILE_SIZE, WIDTH);
+      int endY = std::min(tileY + TILE_SIZE, HEIGHT);
+      for (int y = tileY; y < endY; ++y) {
+        for (int x = tileX; x < endX; x += packetSize) {
+          if (packetSize == 1) {
+            hitCount += scene.traceRay(camera.generateRay(x, y)) ? 1 : 0;
+            continue;
+          }
+          camera.generateRays(x, y, std::min(packetSize, endX - x), rays);
+          scene.traceRays(rays, hits);
+          for (const auto& hit : hits) {
+            hitCount += hit ? 1 : 0;
+          }
+        }
+      }
+    }
+  }
+  return hitCount;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int count = argc > 1 ? std::atoi(argv[1]) : DEFAULT_PRIMITIVES;
+  if (count <= 0) {
+    std::cerr << "USAGE: " << argv[0] << " [PRIMITIVE_COUNT]" << std::endl;
+    return 84;
+  }
+
+  Scene scene = makeScene(count);
+  std::cout << count << " primitives, " << WIDTH << "x" << HEIGHT
+            << " primary rays" << std::endl;
+  for (int packetSize : {1, 4, 8, 16}) {
+    auto start = std::chrono::steady_clock::now();
+    std::size_t hits = traceImage(scene, packetSize);
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+    std::cout << "packet " << std::setw(2) << packetSize << std::setw(8)
+              << std::fixed << std::setprecision(2)
+              << WIDTH * HEIGHT / seconds / 1e6 << " Mrays/s (" << hits
+              << " hits)" << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,283 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Thread pool benchmark
+*/
+
+/**
+ * @file bench_threads.cpp
+ * @brief Measures the cost of a task on the thread pool, how the primary
+ * ray throughput and the shaded render scale from one core to all of them,
+ * the render time of each tile order and packet shape, the thread
+ * utilization of fixed and adaptive tiles, and the cost of a small frame on
+ * a persistent or a fresh renderer
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <thread>
+#include <vector>
+#include "core/Color.hpp"
+#include "core/Ray.hpp"
+#include "core/ThreadPool.hpp"
+#include "core/Vector3D.hpp"
+#include "display/PPMDisplay.hpp"
+#include "display/Renderer.hpp"
+#include "scene/Camera.hpp"
+#include "scene/Scene.hpp"
+#include "scene/lights/PointLight.hpp"
+#include "scene/primitives/Sphere.hpp"
+
+using namespace RayTracer;
+
+namespace {
+
+constexpr int PRIMITIVES = 20000;
+constexpr int WIDTH = 1280;
+constexpr int HEIGHT = 960;
+constexpr int TILE_SIZE = 64;
+constexpr int PACKET_SIZE = 16;
+constexpr std::size_t TINY_TASKS = 200000;
+constexpr int SMALL_WIDTH = 160;
+constexpr int SMALL_HEIGHT = 120;
+constexpr int SMALL_FRAMES = 50;
+
+Scene makeScene() {
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> position(-50.0, 50.0);
+  std::uniform_real_distribution<double> depth(-150.0, -50.0);
+  std::uniform_real_distribution<double> size(0.2, 2.0);
+  Scene scene(Camera(Vector3D(0, 0, 0), WIDTH, HEIGHT, 60.0));
+  for (int i = 0; i < PRIMITIVES; ++i) {
+    scene.addPrimitive(std::make_shared<Sphere>(
+        Vector3D(position(rng), position(rng), depth(rng)), size(rng),
+        Color::RED));
+  }
+  scene.addLight(std::make_shared<PointLight>(Vector3D(0, 100, 0)));
+  scene.finalize();
+  return scene;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+
+/**
+ * @brief Trace the primary rays of one tile in packets
+ * @return The number of rays that hit something
+ */
+std::size_t traceTile(const Scene& scene, int tile) {
+  const Camera& camera = scene.getCamera();
+  int tilesX = (WIDTH + TILE_SIZE - 1) / TILE_SIZE;
+  int startX = tile % tilesX * TILE_SIZE;
+  int startY = tile / tilesX * TILE_SIZE;
+  int endX = std::min(startX + TILE_SIZE, WIDTH);
+  int endY = std::min(startY + TILE_SIZE, HEIGHT);
+  std::vector<Ray> rays;
+  std::vector<std::optional<Intersection>> hits;
+  std::size_t hitCount = 0;
+  for (int y = startY; y < endY; ++y) {
+    for (int x = startX; x < endX; x += PACKET_SIZE) {
+      camera.generateRays(x, y, std::min(PACKET_SIZE, endX - x), rays);
+      scene.traceRays(rays, hits);
+      for (const auto& hit : hits) {
+        hitCount += hit ? 1 : 0;
+      }
+    }
+  }
+  return hitCount;
+}
+
+/**
+ * @brief Trace the image on a number of threads, the caller being one
+ * @return The rays per second
+ */
+double traceImage(const Scene& scene, unsigned threads) {
+  int tiles = ((WIDTH + TILE_SIZE - 1) / TILE_SIZE) *
+              ((HEIGHT + TILE_SIZE - 1) / TILE_SIZE);
+  std::atomic<std::size_t> hits(0);
+  auto body = [&](std::size_t first, std::size_t last) {
+    for (std::size_t tile = first; tile < last; ++tile) {
+      hits += traceTile(scene, static_cast<int>(tile));
+    }
+  };
+  auto start = std::chrono::steady_clock::now();
+  if (threads == 1) {
+    body(0, tiles);
+  } else {
+    ThreadPool pool(threads - 1);
+    pool.parallelFor(0, tiles, 1, body);
+  }
+  return WIDTH * HEIGHT / secondsSince(start);
+}
+
+/**
+ * @brief Render and shade the image through the display
+ * @return The pixels per second
+ */
+double renderImage(const Scene& scene, unsigned threads) {
+  PPMDisplay display;
+  display.setThreadCount(static_cast<int>(threads));
+  auto start = std::chrono::steady_clock::now();
+  display.render(scene);
+  return WIDTH * HEIGHT / secondsSince(start);
+}
+
+/**
+ * @brief Render the image once with some settings
+ * @return The milliseconds of the frame
+ */
+double renderWith(const Scene& scene, unsigned threads,
+                  const RenderSettings& settings) {
+  Renderer renderer(static_cast<int>(threads));
+  auto start = std::chrono::steady_clock::now();
+  renderer.renderFrame(scene, settings);
+  return secondsSince(start) * 1e3;
+}
+
+/**
+ * @brief Render the image twice on one renderer, the second frame using
+ * what the first measured
+ * @param label Name of the settings
+ */
+void reportUtilization(const Scene& scene, unsigned threads,
+                       const char* label, const RenderSettings& settings) {
+  Renderer renderer(static_cast<int>(threads));
+  renderer.renderFrame(scene, settings);
+  renderer.renderFrame(scene, settings);
+  const FrameStats& stats = renderer.getFrameStats();
+  std::cout << "  " << label << ": " << stats.seconds * 1e3 << " ms, "
+            << stats.tiles << " tiles of " << stats.tileSize << ", "
+            << stats.splitTiles << " split, "
+            << std::setprecision(0) << stats.utilization * 100.0
+            << std::setprecision(1) << "% of " << threads << " threads busy"
+            << std::endl;
+}
+
+/**
+ * @brief Render small frames, keeping one renderer or creating one each time
+ * @return The milliseconds per frame
+ */
+double renderFrames(const Scene& scene, unsigned threads, bool persistent) {
+  std::unique_ptr<Renderer> renderer;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < SMALL_FRAMES; ++i) {
+    if (!renderer || !persistent) {
+      renderer = std::make_unique<Renderer>(static_cast<int>(threads));
+    }
+    renderer->renderFrame(scene);
+  }
+  return secondsSince(start) * 1e3 / SMALL_FRAMES;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  unsigned maxThreads =
+      argc > 1 ? static_cast<unsigned>(std::atoi(argv[1]))
+               : std::max(1u, std::thread::hardware_concurrency());
+  if (maxThreads == 0) {
+    std::cerr << "USAGE: " << argv[0] << " [MAX_THREADS]" << std::endl;
+    return 84;
+  }
+  std::cout << std::fixed << std::setprecision(1);
+
+  // Overhead of a task that does nothing, on the default pool
+  {
+    ThreadPool pool;
+    std::vector<std::future<void>> futures;
+    futures.reserve(TINY_TASKS);
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < TINY_TASKS; ++i) {
+      futures.push_back(pool.enqueue([]() {}));
+    }
+    for (auto& future : futures) {
+      future.wait();
+    }
+    double enqueueSeconds = secondsSince(start);
+
+    std::atomic<std::size_t> count(0);
+    start = std::chrono::steady_clock::now();
+    pool.parallelFor(0, TINY_TASKS, 1, [&](std::size_t first,
+                                           std::size_t last) {
+      count.fetch_add(last - first, std::memory_order_relaxed);
+    });
+    double loopSeconds = secondsSince(start);
+    std::cout << pool.size() << " workers, " << TINY_TASKS
+              << " empty tasks: enqueue " << enqueueSeconds * 1e9 / TINY_TASKS
+              << " ns/task, parallelFor " << loopSeconds * 1e9 / TINY_TASKS
+              << " ns/chunk" << std::endl;
+  }
+
+  Scene scene = makeScene();
+  std::cout << PRIMITIVES << " spheres, " << WIDTH << "x" << HEIGHT
+            << " primary rays in " << TILE_SIZE << "x" << TILE_SIZE
+            << " tiles" << std::endl;
+  double singleTrace = 0.0;
+  double singleRender = 0.0;
+  for (unsigned threads = 1; threads <= maxThreads; ++threads) {
+    double raysPerSecond = traceImage(scene, threads);
+    double pixelsPerSecond = renderImage(scene, threads);
+    if (threads == 1) {
+      singleTrace = raysPerSecond;
+      singleRender = pixelsPerSecond;
+    }
+    std::cout << std::setw(3) << threads << " threads: trace " << std::setw(6)
+              << raysPerSecond / 1e6 << " Mrays/s (x" << std::setprecision(2)
+              << raysPerSecond / singleTrace << std::setprecision(1)
+              << "), render " << std::setw(6) << pixelsPerSecond / 1e6
+              << " Mpixels/s (x" << std::setprecision(2)
+              << pixelsPerSecond / singleRender << std::setprecision(1) << ")"
+              << std::endl;
+  }
+
+  // The image does not depend on the order, only the memory traffic does
+  std::cout << "Tile orders on " << maxThreads << " threads:";
+  for (TileOrder order :
+       {TileOrder::RASTER, TileOrder::HILBERT, TileOrder::SPIRAL}) {
+    RenderSettings settings;
+    settings.tileOrder = order;
+    std::cout << " " << tileOrderName(order) << " "
+              << renderWith(scene, maxThreads, settings) << " ms";
+  }
+  std::cout << std::endl << "Packets on " << maxThreads << " threads:";
+  for (int packetSize : {1, 4, 16}) {
+    RenderSettings settings;
+    settings.packetSize = packetSize;
+    std::cout << " " << packetSize << " rays "
+              << renderWith(scene, maxThreads, settings) << " ms";
+  }
+  std::cout << std::endl;
+
+  // The end of the frame, where a few expensive tiles keep one thread busy
+  std::cout << "Tiles on " << maxThreads << " threads:" << std::endl;
+  RenderSettings fixed;
+  fixed.tileSize = RenderSettings::DEFAULT_TILE_SIZE;
+  fixed.splitTiles = false;
+  reportUtilization(scene, maxThreads, "fixed", fixed);
+  reportUtilization(scene, maxThreads, "adaptive", RenderSettings());
+
+  // Frames short enough for the thread start-up to show
+  scene.setCamera(Camera(Vector3D(0, 0, 0), SMALL_WIDTH, SMALL_HEIGHT, 60.0));
+  std::cout << SMALL_FRAMES << " frames of " << SMALL_WIDTH << "x"
+            << SMALL_HEIGHT << " on " << maxThreads << " threads: persistent "
+            << std::setprecision(2) << renderFrames(scene, maxThreads, true)
+            << " ms/frame, fresh renderer "
+            << renderFrames(scene, maxThreads, false) << " ms/frame"
+            << std::endl;
+  return 0;
+}
@@ -0,0 +1,117 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Transform benchmark
+*/
+
+/**
+ * @file bench_transforms.cpp
+ * @brief Measures the cost of building chained transforms and of loading a
+ * scene of transformed primitives
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+#include "core/Color.hpp"
+#include "core/Transform.hpp"
+#include "core/Vector3D.hpp"
+#include "scene/Scene.hpp"
+#include "scene/primitives/Sphere.hpp"
+
+using namespace RayTracer;
+
+namespace {
+
+constexpr int DEFAULT_OBJECTS = 100000;
+
+/**
+ * @brief The parameters of the five operations of one object
+ */
+struct Operations {
+  double offset[3];  ///< Translation
+  double angle[3];   ///< Rotations around X, Y and Z
+  double factor;     ///< Uniform scale
+};
+
+std::vector<Operations> makeOperations(int count) {
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> position(-100.0, 100.0);
+  std::uniform_real_distribution<double> angle(0.0, 360.0);
+  std::uniform_real_distribution<double> factor(0.5, 2.0);
+  std::vector<Operations> operations(count);
+  for (auto& operation : operations) {
+    for (int axis = 0; axis < 3; ++axis) {
+      operation.offset[axis] = position(rng);
+      operation.angle[axis] = angle(rng);
+    }
+    operation.factor = factor(rng);
+  }
+  return operations;
+}
+
+Transform makeTransform(const Operations& operation) {
+  Transform transform;
+  transform.rotateX(operation.angle[0])
+      .rotateY(operation.angle[1])
+      .rotateZ(operation.angle[2])
+      .scale(operation.factor)
+      .translate(operation.offset[0], operation.offset[1],
+                 operation.offset[2]);
+  return transform;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int count = argc > 1 ? std::atoi(argv[1]) : DEFAULT_OBJECTS;
+  if (count <= 0) {
+    std::cerr << "USAGE: " << argv[0] << " [OBJECT_COUNT]" << std::endl;
+    return 84;
+  }
+  std::vector<Operations> operations = makeOperations(count);
+  std::cout << count << " objects, five operations each" << std::endl;
+  std::cout << std::fixed << std::setprecision(1);
+
+  // Transforms alone, the checksum keeps the work from being optimized out
+  auto start = std::chrono::steady_clock::now();
+  double checksum = 0.0;
+  for (const auto& operation : operations) {
+    checksum += makeTransform(operation).getInverseMatrix().at(0, 3);
+  }
+  double seconds = secondsSince(start);
+  std::cout << "transforms " << std::setw(9) << seconds * 1e3 << " ms "
+            << std::setw(8) << seconds * 1e9 / count << " ns/object"
+            << " (checksum " << checksum << ")" << std::endl;
+
+  // Scene load: transformed spheres, then the acceleration structure
+  start = std::chrono::steady_clock::now();
+  Scene scene;
+  for (const auto& operation : operations) {
+    auto sphere = std::make_shared<Sphere>(Vector3D(0, 0, 0), 1.0, Color::RED);
+    sphere->setTransform(makeTransform(operation));
+    scene.addPrimitive(sphere);
+  }
+  double loadSeconds = secondsSince(start);
+  start = std::chrono::steady_clock::now();
+  scene.finalize();
+  double finalizeSeconds = secondsSince(start);
+  std::cout << "scene load " << std::setw(9) << loadSeconds * 1e3
+            << " ms, finalize " << finalizeSeconds * 1e3 << " ms"
+            << std::endl;
+  return 0;
+}
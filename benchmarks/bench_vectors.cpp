@@ -0,0 +1,140 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Vector math benchmark
+*/
+
+/**
+ * @file bench_vectors.cpp
+ * @brief Measures the vector math, the transforms and the primitive
+ * intersections built on it, in the precision of the build
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "core/Color.hpp"
+#include "core/Ray.hpp"
+#include "core/Transform.hpp"
+#include "core/Vector3D.hpp"
+#include "scene/primitives/Cylinder.hpp"
+#include "scene/primitives/Sphere.hpp"
+#include "scene/primitives/Triangle.hpp"
+
+using namespace RayTracer;
+
+namespace {
+
+constexpr int DEFAULT_COUNT = 1000000;
+constexpr int PASSES = 5;
+
+std::vector<Vector3D> makeVectors(unsigned seed, int count) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> component(-1.0, 1.0);
+  std::vector<Vector3D> vectors;
+  vectors.reserve(count);
+  for (int i = 0; i < count; ++i) {
+    vectors.emplace_back(component(rng), component(rng), component(rng) + 2.0);
+  }
+  return vectors;
+}
+
+/**
+ * @brief Time the best of a few passes of an operation
+ * @param name Label of the measure
+ * @param count Number of operations of one pass
+ * @param pass One pass, returning a checksum
+ */
+void measure(const std::string& name, int count,
+             const std::function<double()>& pass) {
+  double best = 0.0;
+  double checksum = 0.0;
+  for (int i = 0; i < PASSES; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    checksum = pass();
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+    if (i == 0 || seconds < best) {
+      best = seconds;
+    }
+  }
+  std::cout << std::left << std::setw(20) << name << std::right
+            << std::setw(8) << best * 1e9 / count << " ns/op"
+            << " (checksum " << checksum << ")" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int count = argc > 1 ? std::atoi(argv[1]) : DEFAULT_COUNT;
+  if (count <= 0) {
+    std::cerr << "USAGE: " << argv[0] << " [COUNT]" << std::endl;
+    return 84;
+  }
+  std::vector<Vector3D> a = makeVectors(1, count);
+  std::vector<Vector3D> b = makeVectors(2, count);
+  std::vector<Vector3D> out(count);
+  std::vector<Ray> rays;
+  rays.reserve(count);
+  for (int i = 0; i < count; ++i) {
+    rays.emplace_back(Vector3D(0, 0, -5), a[i]);
+  }
+  std::cout << count << " operations, " << sizeof(Vector3D) * 8 / 3
+            << "-bit components" << std::endl;
+  std::cout << std::fixed << std::setprecision(2);
+
+  measure("vector math", count, [&] {
+    double sum = 0.0;
+    for (int i = 0; i < count; ++i) {
+      out[i] = (a[i].cross(b[i]) + a[i] * 0.5 - b[i]).normalized();
+      sum += out[i].dot(a[i]);
+    }
+    return sum;
+  });
+
+  Transform transform;
+  transform.rotateY(30).scale(1.5).translate(1, 2, 3);
+  measure("transform points", count, [&] {
+    double sum = 0.0;
+    for (int i = 0; i < count; ++i) {
+      out[i] = transform.applyToPoint(a[i]);
+      sum += out[i].getZ();
+    }
+    return sum;
+  });
+
+  Sphere sphere(Vector3D(0, 0, 0), 1.0, Color::RED);
+  Cylinder cylinder(0.5, Color::RED);
+  cylinder.setTransform(Transform().rotateX(90));
+  Triangle triangle(Vector3D(-1, -1, 0), Vector3D(1, -1, 0), Vector3D(0, 1, 0),
+                    Color::RED);
+  const std::pair<const char*, const IPrimitive*> primitives[] = {
+      {"sphere hits", &sphere},
+      {"cylinder hits", &cylinder},
+      {"triangle hits", &triangle},
+  };
+  for (const auto& [name, primitive] : primitives) {
+    measure(name, count, [&, primitive = primitive] {
+      double sum = 0.0;
+      for (const auto& ray : rays) {
+        auto hit = primitive->intersectHit(Ray(ray));
+        if (hit) {
+          sum += hit->t;
+        }
+      }
+      return sum;
+    });
+  }
+  return 0;
+}
@@ -17,8 +17,10 @@
 #ifndef IPRIMITIVE_HPP_
 #define IPRIMITIVE_HPP_
 
+#include <cstddef>
 #include <memory>
 #include <optional>
+#include "../src/core/AABB.hpp"
 #include "../src/core/Color.hpp"
 #include "../src/core/Ray.hpp"
 #include "../src/core/Transform.hpp"
@@ -37,6 +39,22 @@ struct Intersection {
   const void* primitive;  ///< Pointer to the primitive that was intersected
 };
 
+/**
+ * @brief Cheap record of a ray hit, before any surface data is computed
+ *
+ * Produced by IPrimitive::intersectHit() for every candidate primitive; only
+ * the closest one is turned into an Intersection by computeSurface(). The
+ * local coordinates and the part are private to the primitive that wrote
+ * them, which reads them back to rebuild its surface data.
+ */
+struct HitRecord {
+  double t = 0.0;                  ///< Ray parameter of the hit
+  std::size_t primitiveIndex = 0;  ///< Index of the primitive in its owner
+  double u = 0.0;                  ///< First local coordinate of the hit
+  double v = 0.0;                  ///< Second local coordinate of the hit
+  int part = 0;                    ///< Sub-surface hit, such as a cap
+};
+
 /**
  * @brief Interface for all geometric primitives
  */
@@ -49,10 +67,86 @@ class IPrimitive {
 
   /**
    * @brief Check if a ray intersects this primitive
+   *
+   * Convenience combining intersectHit() and computeSurface(). Closest-hit
+   * searches over many primitives should call intersectHit() on every
+   * candidate and computeSurface() on the winner only.
+   *
+   * A primitive must override either this method or both intersectHit()
+   * and computeSurface(): their defaults are built on each other.
+   *
    * @param ray The ray to check
    * @return Intersection data if hit, std::nullopt otherwise
    */
-  virtual std::optional<Intersection> intersect(const Ray& ray) const = 0;
+  virtual std::optional<Intersection> intersect(const Ray& ray) const {
+    std::optional<HitRecord> hit = intersectHit(ray);
+    if (!hit) {
+      return std::nullopt;
+    }
+    return computeSurface(ray, *hit);
+  }
+
+  /**
+   * @brief Find where a ray hits this primitive, without surface data
+   *
+   * Only hits inside the [tMin, tMax] interval of the ray are reported, and
+   * the ray tMax is shrunk to the distance of a reported hit. Primitives
+   * should bail out as soon as the hit is known to be outside the interval
+   * and leave every world-space computation to computeSurface().
+   *
+   * The default implementation, for primitives that only implement
+   * intersect(), builds the full intersection and clips it to the interval.
+   *
+   * @param ray The ray to check
+   * @return The hit parameter and local coordinates, std::nullopt if missed
+   */
+  virtual std::optional<HitRecord> intersectHit(const Ray& ray) const {
+    std::optional<Intersection> intersection = intersect(ray);
+    if (!intersection || !ray.isInInterval(intersection->distance)) {
+      return std::nullopt;
+    }
+    ray.shrinkTMax(intersection->distance);
+    HitRecord hit;
+    hit.t = intersection->distance;
+    return hit;
+  }
+
+  /**
+   * @brief Build the surface data of a hit found by intersectHit()
+   *
+   * The default implementation, for primitives that only implement
+   * intersect(), runs it again.
+   *
+   * @param ray The ray that produced the hit
+   * @param hit The hit record returned by intersectHit() for this ray
+   * @return The world-space point, normal and color of the hit
+   */
+  virtual Intersection computeSurface(const Ray& ray,
+                                      const HitRecord& hit) const {
+    std::optional<Intersection> intersection = intersect(ray);
+    if (intersection) {
+      return *intersection;
+    }
+    Vector3D point = ray.pointAt(hit.t);
+    return {hit.t, point, getNormalAt(point), getColor(), this};
+  }
+
+  /**
+   * @brief Check if a ray hits this primitive closer than a given distance
+   *
+   * Any-hit query used for shadow rays: no intersection data is built.
+   * The default implementation falls back on intersectHit(); primitives
+   * override it to skip even the closest-hit bookkeeping.
+   *
+   * @param ray The ray to check, its tMin is the lower bound of the query
+   * @param tMax Hits beyond this distance are ignored
+   * @return true if the ray hits the primitive in [tMin, tMax]
+   */
+  virtual bool occluded(const Ray& ray, double tMax) const {
+    Ray query(ray);
+    query.setInterval(ray.getTMin(), tMax);
+    return intersectHit(query).has_value();
+  }
 
   /**
    * @brief Set the transformation matrix for this primitive
@@ -90,6 +184,19 @@ class IPrimitive {
    * @return A new instance of this primitive
    */
   virtual std::shared_ptr<IPrimitive> clone() const = 0;
+
+  /**
+   * @brief Get the world-space bounding box of this primitive
+   *
+   * Used to place the primitive in the scene acceleration structure.
+   * Primitives that extend to infinity keep the default and are tested
+   * separately.
+   *
+   * @return The bounding box, AABB::unbounded() if infinite
+   */
+  virtual AABB worldBounds() const {
+    return AABB::unbounded();
+  }
 };
 
 }  // namespace RayTracer
@@ -0,0 +1,161 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Axis-aligned bounding box implementation
+*/
+
+/**
+ * @file AABB.cpp
+ * @brief Implementation of the axis-aligned bounding box used by the
+ * acceleration structures
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include "AABB.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "Transform.hpp"
+
+namespace RayTracer {
+
+AABB::AABB()
+    : _min(std::numeric_limits<double>::infinity(),
+           std::numeric_limits<double>::infinity(),
+           std::numeric_limits<double>::infinity()),
+      _max(-std::numeric_limits<double>::infinity(),
+           -std::numeric_limits<double>::infinity(),
+           -std::numeric_limits<double>::infinity()) {}
+
+AABB::AABB(const Vector3D& min, const Vector3D& max)
+    : _min(std::min(min.getX(), max.getX()), std::min(min.getY(), max.getY()),
+           std::min(min.getZ(), max.getZ())),
+      _max(std::max(min.getX(), max.getX()), std::max(min.getY(), max.getY()),
+           std::max(min.getZ(), max.getZ())) {}
+
+AABB AABB::unbounded() {
+  double inf = std::numeric_limits<double>::infinity();
+  return AABB(Vector3D(-inf, -inf, -inf), Vector3D(inf, inf, inf));
+}
+
+const Vector3D& AABB::getMin() const {
+  return _min;
+}
+
+const Vector3D& AABB::getMax() const {
+  return _max;
+}
+
+AABB& AABB::expand(const Vector3D& point) {
+  _min = Vector3D(std::min(_min.getX(), point.getX()),
+                  std::min(_min.getY(), point.getY()),
+                  std::min(_min.getZ(), point.getZ()));
+  _max = Vector3D(std::max(_max.getX(), point.getX()),
+                  std::max(_max.getY(), point.getY()),
+                  std::max(_max.getZ(), point.getZ()));
+  return *this;
+}
+
+AABB& AABB::expand(const AABB& other) {
+  if (other.isEmpty()) {
+    return *this;
+  }
+  expand(other._min);
+  expand(other._max);
+  return *this;
+}
+
+bool AABB::isEmpty() const {
+  return _min.getX() > _max.getX() || _min.getY() > _max.getY() ||
+         _min.getZ() > _max.getZ();
+}
+
+bool AABB::isBounded() const {
+  return !isEmpty() && std::isfinite(_min.getX()) &&
+         std::isfinite(_min.getY()) && std::isfinite(_min.getZ()) &&
+         std::isfinite(_max.getX()) && std::isfinite(_max.getY()) &&
+         std::isfinite(_max.getZ());
+}
+
+Vector3D AABB::extent() const {
+  if (isEmpty()) {
+    return Vector3D(0, 0, 0);
+  }
+  return _max - _min;
+}
+
+Vector3D AABB::centroid() const {
+  return (_min + _max) * 0.5;
+}
+
+double AABB::surfaceArea() const {
+  Vector3D d = extent();
+  return 2.0 * (d.getX() * d.getY() + d.getY() * d.getZ() +
+                d.getZ() * d.getX());
+}
+
+int AABB::longestAxis() const {
+  Vector3D d = extent();
+  if (d.getX() >= d.getY() && d.getX() >= d.getZ()) {
+    return 0;
+  }
+  return d.getY() >= d.getZ() ? 1 : 2;
+}
+
+AABB AABB::transformed(const Transform& transform) const {
+  if (!isBounded()) {
+    return isEmpty() ? AABB() : AABB::unbounded();
+  }
+
+  AABB result;
+  for (int corner = 0; corner < 8; ++corner) {
+    Vector3D point((corner & 1) ? _max.getX() : _min.getX(),
+                   (corner & 2) ? _max.getY() : _min.getY(),
+                   (corner & 4) ? _max.getZ() : _min.getZ());
+    result.expand(transform.applyToPoint(point));
+  }
+  return result;
+}
+
+bool AABB::intersects(const Ray& ray) const {
+  return intersects(ray, ray.getTMax());
+}
+
+bool AABB::intersects(const Ray& ray, double tMax) const {
+  const Vector3D& origin = ray.getOrigin();
+  const Vector3D& invDir = ray.getInverseDirection();
+  const double o[3] = {origin.getX(), origin.getY(), origin.getZ()};
+  const double inv[3] = {invDir.getX(), invDir.getY(), invDir.getZ()};
+  const double lo[3] = {_min.getX(), _min.getY(), _min.getZ()};
+  const double hi[3] = {_max.getX(), _max.getY(), _max.getZ()};
+
+  // tMax is padded too: a hit lying on a face of the box, such as a flat
+  // triangle, can be exactly the current closest distance
+  double t0 = ray.getTMin();
+  double t1 = tMax * (1.0 + SLAB_EPSILON);
+  for (int axis = 0; axis < 3; ++axis) {
+    double tNear = (lo[axis] - o[axis]) * inv[axis];
+    double tFar = (hi[axis] - o[axis]) * inv[axis];
+    if (tNear > tFar) {
+      std::swap(tNear, tFar);
+    }
+    tFar *= 1.0 + SLAB_EPSILON;
+    // Written so that NaN (0 * inf on a slab boundary) keeps the old bound
+    t0 = tNear > t0 ? tNear : t0;
+    t1 = tFar < t1 ? tFar : t1;
+    if (t0 > t1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::ostream& operator<<(std::ostream& os, const AABB& box) {
+  os << "AABB(" << box.getMin() << ", " << box.getMax() << ")";
+  return os;
+}
+
+}  // namespace RayTracer
@@ -0,0 +1,168 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Axis-aligned bounding box header
+*/
+
+/**
+ * @file AABB.hpp
+ * @brief Definition of the AABB class used to bound primitives and to build
+ * acceleration structures
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#ifndef AABB_HPP_
+#define AABB_HPP_
+
+#include <iostream>
+#include "Ray.hpp"
+#include "Vector3D.hpp"
+
+namespace RayTracer {
+
+class Transform;
+
+/// Relative padding of slab exit distances, absorbs rounding on box faces
+constexpr double SLAB_EPSILON = 1e-9;
+
+/**
+ * @brief Axis-aligned bounding box in 3D space
+ *
+ * A default constructed box is empty (min = +inf, max = -inf) so that it can
+ * be grown with expand(). A box with infinite extents represents an unbounded
+ * primitive such as an infinite plane or cylinder.
+ */
+class AABB {
+ public:
+  /**
+   * @brief Default constructor
+   * Creates an empty box that contains nothing
+   */
+  AABB();
+
+  /**
+   * @brief Constructor from two corners
+   * @param min The minimum corner
+   * @param max The maximum corner
+   */
+  AABB(const Vector3D& min, const Vector3D& max);
+
+  /**
+   * @brief Create a box covering the whole space
+   * @return An infinite box
+   */
+  static AABB unbounded();
+
+  /**
+   * @brief Get the minimum corner
+   * @return The minimum corner
+   */
+  const Vector3D& getMin() const;
+
+  /**
+   * @brief Get the maximum corner
+   * @return The maximum corner
+   */
+  const Vector3D& getMax() const;
+
+  /**
+   * @brief Grow the box so that it contains a point
+   * @param point The point to include
+   * @return Reference to this box
+   */
+  AABB& expand(const Vector3D& point);
+
+  /**
+   * @brief Grow the box so that it contains another box
+   * @param other The box to include
+   * @return Reference to this box
+   */
+  AABB& expand(const AABB& other);
+
+  /**
+   * @brief Check if the box contains nothing
+   * @return true if min > max on any axis
+   */
+  bool isEmpty() const;
+
+  /**
+   * @brief Check if the box is finite on every axis
+   * @return true if the box is non-empty and all extents are finite
+   */
+  bool isBounded() const;
+
+  /**
+   * @brief Get the size of the box along each axis
+   * @return The extent vector (max - min)
+   */
+  Vector3D extent() const;
+
+  /**
+   * @brief Get the center of the box
+   * @return The centroid
+   */
+  Vector3D centroid() const;
+
+  /**
+   * @brief Get the surface area of the box
+   * @return The surface area, 0 for an empty box
+   */
+  double surfaceArea() const;
+
+  /**
+   * @brief Get the axis along which the box is the widest
+   * @return 0 for X, 1 for Y, 2 for Z
+   */
+  int longestAxis() const;
+
+  /**
+   * @brief Compute the world box of this box after a transformation
+   *
+   * The eight corners are transformed and re-bounded, which is conservative
+   * for any affine transformation.
+   *
+   * @param transform The transformation to apply
+   * @return The bounding box of the transformed corners
+   */
+  AABB transformed(const Transform& transform) const;
+
+  /**
+   * @brief Slab test of a ray against the box
+   *
+   * Uses the inverse direction cached in the ray, so a miss costs a few
+   * multiplications and comparisons. The exit distance is padded by a
+   * relative epsilon so that hits lying exactly on a face, such as flat
+   * triangles, are never rejected by rounding.
+   *
+   * @param ray The ray to test
+   * @return true if the ray enters the box inside its search interval
+   */
+  bool intersects(const Ray& ray) const;
+
+  /**
+   * @brief Slab test of a ray against the box with an explicit upper bound
+   * @param ray The ray to test, only its lower bound tMin is used
+   * @param tMax Upper bound of the ray parameter
+   * @return true if the ray enters the box between tMin and tMax
+   */
+  bool intersects(const Ray& ray, double tMax) const;
+
+ private:
+  Vector3D _min;  ///< Minimum corner
+  Vector3D _max;  ///< Maximum corner
+};
+
+/**
+ * @brief Output stream operator for AABB
+ * @param os The output stream
+ * @param box The box to output
+ * @return The modified output stream
+ */
+std::ostream& operator<<(std::ostream& os, const AABB& box);
+
+}  // namespace RayTracer
+
+#endif /* !AABB_HPP_ */
@@ -39,52 +39,11 @@ const Color Color::MAGENTA(static_cast<uint8_t>(255), static_cast<uint8_t>(0),
 const Color Color::GRAY(static_cast<uint8_t>(128), static_cast<uint8_t>(128),
                         static_cast<uint8_t>(128));
 
-Color::Color() : _r(0), _g(0), _b(0) {}
-
-Color::Color(uint8_t r, uint8_t g, uint8_t b) : _r(r), _g(g), _b(b) {}
-
 Color::Color(double r, double g, double b)
     : _r(floatToByte(clamp(r))),
       _g(floatToByte(clamp(g))),
       _b(floatToByte(clamp(b))) {}
 
-Color::Color(const Color& other) : _r(other._r), _g(other._g), _b(other._b) {}
-
-Color& Color::operator=(const Color& other) {
-  if (this != &other) {
-    _r = other._r;
-    _g = other._g;
-    _b = other._b;
-  }
-  return *this;
-}
-
-Color::~Color() {}
-
-uint8_t Color::getR() const {
-  return _r;
-}
-
-uint8_t Color::getG() const {
-  return _g;
-}
-
-uint8_t Color::getB() const {
-  return _b;
-}
-
-double Color::getRf() const {
-  return byteToFloat(_r);
-}
-
-double Color::getGf() const {
-  return byteToFloat(_g);
-}
-
-double Color::getBf() const {
-  return byteToFloat(_b);
-}
-
 void Color::setR(uint8_t r) {
   _r = r;
 }
@@ -218,10 +177,6 @@ uint8_t Color::floatToByte(double value) {
   return static_cast<uint8_t>(std::round(value * 255.0));
 }
 
-double Color::byteToFloat(uint8_t value) {
-  return static_cast<double>(value) / 255.0;
-}
-
 std::ostream& operator<<(std::ostream& os, const Color& color) {
   os << "Color(" << static_cast<int>(color.getR()) << ", "
      << static_cast<int>(color.getG()) << ", " << static_cast<int>(color.getB())
@@ -19,6 +19,7 @@
 
 #include <cstdint>
 #include <iostream>
+#include <type_traits>
 
 namespace RayTracer {
 
@@ -31,7 +32,7 @@ class Color {
    * @brief Default constructor
    * Creates a black color (0, 0, 0)
    */
-  Color();
+  Color() : _r(0), _g(0), _b(0) {}
 
   /**
    * @brief Constructor with RGB values (0-255)
@@ -39,7 +40,7 @@ class Color {
    * @param g Green component [0-255]
    * @param b Blue component [0-255]
    */
-  Color(uint8_t r, uint8_t g, uint8_t b);
+  Color(uint8_t r, uint8_t g, uint8_t b) : _r(r), _g(g), _b(b) {}
 
   /**
    * @brief Constructor with RGB values as floats (0.0-1.0)
@@ -49,59 +50,41 @@ class Color {
    */
   Color(double r, double g, double b);
 
-  /**
-   * @brief Copy constructor
-   * @param other The color to copy
-   */
-  Color(const Color& other);
-
-  /**
-   * @brief Assignment operator
-   * @param other The color to assign from
-   * @return Reference to this color after assignment
-   */
-  Color& operator=(const Color& other);
-
-  /**
-   * @brief Destructor
-   */
-  ~Color();
-
   /**
    * @brief Get the red component (0-255)
    * @return The red component
    */
-  uint8_t getR() const;
+  uint8_t getR() const { return _r; }
 
   /**
    * @brief Get the green component (0-255)
    * @return The green component
    */
-  uint8_t getG() const;
+  uint8_t getG() const { return _g; }
 
   /**
    * @brief Get the blue component (0-255)
    * @return The blue component
    */
-  uint8_t getB() const;
+  uint8_t getB() const { return _b; }
 
   /**
    * @brief Get the red component as a floating point (0.0-1.0)
    * @return The red component as a float
    */
-  double getRf() const;
+  double getRf() const { return byteToFloat(_r); }
 
   /**
    * @brief Get the green component as a floating point (0.0-1.0)
    * @return The green component as a float
    */
-  double getGf() const;
+  double getGf() const { return byteToFloat(_g); }
 
   /**
    * @brief Get the blue component as a floating point (0.0-1.0)
    * @return The blue component as a float
    */
-  double getBf() const;
+  double getBf() const { return byteToFloat(_b); }
 
   /**
    * @brief Set the red component (0-255)
@@ -266,7 +249,9 @@ class Color {
    * @param value The uint8_t value to convert
    * @return The converted float value
    */
-  static double byteToFloat(uint8_t value);
+  static double byteToFloat(uint8_t value) {
+    return static_cast<double>(value) / 255.0;
+  }
 };
 
 /**
@@ -277,6 +262,8 @@ class Color {
  */
 std::ostream& operator<<(std::ostream& os, const Color& color);
 
+static_assert(std::is_trivially_copyable_v<Color>);
+
 }  // namespace RayTracer
 
 #endif /* !COLOR_HPP_ */
@@ -18,6 +18,13 @@
 
 namespace RayTracer {
 
+namespace {
+
+/// Determinant below which a matrix is considered singular
+constexpr double SINGULAR_DETERMINANT = 1e-10;
+
+}  // namespace
+
 Matrix::Matrix() {
   setIdentity();
 }
@@ -52,26 +59,27 @@ const double& Matrix::at(int row, int col) const {
 Matrix& Matrix::setIdentity() {
   for (int row = 0; row < 4; ++row) {
     for (int col = 0; col < 4; ++col) {
-      at(row, col) = (row == col) ? 1.0 : 0.0;
+      _data[row * 4 + col] = (row == col) ? 1.0 : 0.0;
     }
   }
   return *this;
 }
 
 Matrix Matrix::operator*(const Matrix& other) const {
-  Matrix result;
+  // Filled directly: no identity to write first, no index checks
+  std::array<double, 16> result;
 
   for (int row = 0; row < 4; ++row) {
     for (int col = 0; col < 4; ++col) {
       double sum = 0.0;
       for (int k = 0; k < 4; ++k) {
-        sum += at(row, k) * other.at(k, col);
+        sum += _data[row * 4 + k] * other._data[k * 4 + col];
       }
-      result.at(row, col) = sum;
+      result[row * 4 + col] = sum;
     }
   }
 
-  return result;
+  return Matrix(result);
 }
 
 Matrix& Matrix::operator*=(const Matrix& other) {
@@ -128,9 +136,12 @@ double Matrix::determinant() const {
 }
 
 Matrix Matrix::inverse() const {
+  if (isAffine()) {
+    return inverseAffine();
+  }
   double det = determinant();
 
-  if (std::abs(det) < 1e-10) {
+  if (std::abs(det) < SINGULAR_DETERMINANT) {
     throw std::runtime_error(
         "Matrix is not invertible (determinant is zero or near-zero)");
   }
@@ -146,6 +157,59 @@ Matrix Matrix::inverse() const {
   return result;
 }
 
+Matrix Matrix::transposed() const {
+  std::array<double, 16> result;
+  for (int row = 0; row < 4; ++row) {
+    for (int col = 0; col < 4; ++col) {
+      result[col * 4 + row] = _data[row * 4 + col];
+    }
+  }
+  return Matrix(result);
+}
+
+bool Matrix::isAffine() const {
+  return _data[12] == 0.0 && _data[13] == 0.0 && _data[14] == 0.0 &&
+         _data[15] == 1.0;
+}
+
+Matrix Matrix::inverseAffine() const {
+  const double* m = _data.data();
+  // Cofactors of the linear part: its determinant is the one of the matrix
+  double c00 = m[5] * m[10] - m[6] * m[9];
+  double c01 = m[6] * m[8] - m[4] * m[10];
+  double c02 = m[4] * m[9] - m[5] * m[8];
+  double det = m[0] * c00 + m[1] * c01 + m[2] * c02;
+  if (std::abs(det) < SINGULAR_DETERMINANT) {
+    throw std::runtime_error(
+        "Matrix is not invertible (determinant is zero or near-zero)");
+  }
+  double c10 = m[2] * m[9] - m[1] * m[10];
+  double c11 = m[0] * m[10] - m[2] * m[8];
+  double c12 = m[1] * m[8] - m[0] * m[9];
+  double c20 = m[1] * m[6] - m[2] * m[5];
+  double c21 = m[2] * m[4] - m[0] * m[6];
+  double c22 = m[0] * m[5] - m[1] * m[4];
+
+  // The inverse of the linear part is its adjugate over the determinant,
+  // and the translation is undone after it
+  double invDet = 1.0 / det;
+  Matrix result;
+  double* r = result._data.data();
+  r[0] = c00 * invDet;
+  r[1] = c10 * invDet;
+  r[2] = c20 * invDet;
+  r[4] = c01 * invDet;
+  r[5] = c11 * invDet;
+  r[6] = c21 * invDet;
+  r[8] = c02 * invDet;
+  r[9] = c12 * invDet;
+  r[10] = c22 * invDet;
+  r[3] = -(r[0] * m[3] + r[1] * m[7] + r[2] * m[11]);
+  r[7] = -(r[4] * m[3] + r[5] * m[7] + r[6] * m[11]);
+  r[11] = -(r[8] * m[3] + r[9] * m[7] + r[10] * m[11]);
+  return result;
+}
+
 Matrix Matrix::createTranslation(double x, double y, double z) {
   Matrix result;
 
@@ -110,11 +110,28 @@ class Matrix {
 
   /**
    * @brief Calculate inverse of the matrix
+   *
+   * Affine matrices are inverted in closed form, from the adjugate of their
+   * 3x3 linear part; the others by cofactor expansion.
+   *
    * @return The inverse matrix
    * @throws std::runtime_error if matrix is not invertible
    */
   Matrix inverse() const;
 
+  /**
+   * @brief Get the transpose of the matrix
+   * @return The matrix with rows and columns swapped, the inverse of a
+   * rotation
+   */
+  Matrix transposed() const;
+
+  /**
+   * @brief Check if the last row is (0, 0, 0, 1)
+   * @return true if the matrix is an affine transformation
+   */
+  bool isAffine() const;
+
   /**
    * @brief Create a translation matrix
    * @param x Translation along x-axis
@@ -178,6 +195,13 @@ class Matrix {
    * @return The cofactor value
    */
   double cofactor(int row, int col) const;
+
+  /**
+   * @brief Closed-form inverse of an affine matrix
+   * @return The inverse matrix
+   * @throws std::runtime_error if matrix is not invertible
+   */
+  Matrix inverseAffine() const;
 };
 
 /**
@@ -0,0 +1,208 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Polynomial root finding implementation
+*/
+
+/**
+ * @file Polynomial.cpp
+ * @brief Implementation of the quadratic, cubic and quartic root finders
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include "Polynomial.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace RayTracer {
+
+namespace {
+
+/// Maximum number of refinement steps of a bracketed quartic root
+constexpr int MAX_REFINE_ITERATIONS = 64;
+
+/// Absolute tolerance on a refined quartic root
+constexpr double ROOT_TOLERANCE = 1e-12;
+
+double evaluateQuartic(const std::array<double, 5>& c, double x) {
+  return (((c[0] * x + c[1]) * x + c[2]) * x + c[3]) * x + c[4];
+}
+
+double evaluateQuarticDerivative(const std::array<double, 5>& c, double x) {
+  return ((4.0 * c[0] * x + 3.0 * c[1]) * x + 2.0 * c[2]) * x + c[3];
+}
+
+/**
+ * @brief Refine the root of a quartic bracketed by a sign change
+ * @param c Coefficients from x^4 down to the constant term
+ * @param lo End of the bracket where the quartic is negative
+ * @param hi End of the bracket where the quartic is positive
+ * @return The root, lo and hi may be in any order
+ */
+double refineBracketedRoot(const std::array<double, 5>& c, double lo,
+                           double hi) {
+  double x = 0.5 * (lo + hi);
+  double step = std::abs(hi - lo);
+  double previousStep = step;
+  double fx = evaluateQuartic(c, x);
+  double dfx = evaluateQuarticDerivative(c, x);
+
+  for (int i = 0; i < MAX_REFINE_ITERATIONS; ++i) {
+    bool newtonLeavesBracket =
+        ((x - hi) * dfx - fx) * ((x - lo) * dfx - fx) > 0.0;
+    bool newtonTooSlow = std::abs(2.0 * fx) > std::abs(previousStep * dfx);
+    previousStep = step;
+    if (newtonLeavesBracket || newtonTooSlow) {
+      step = 0.5 * (hi - lo);
+      x = lo + step;
+    } else {
+      step = fx / dfx;
+      x -= step;
+    }
+    if (std::abs(step) < ROOT_TOLERANCE) {
+      break;
+    }
+    fx = evaluateQuartic(c, x);
+    if (fx == 0.0) {
+      break;
+    }
+    dfx = evaluateQuarticDerivative(c, x);
+    if (fx < 0.0) {
+      lo = x;
+    } else {
+      hi = x;
+    }
+  }
+  return x;
+}
+
+}  // namespace
+
+int solveQuadratic(double a, double b, double c, std::array<double, 2>& roots) {
+  if (a == 0.0) {
+    if (b == 0.0) {
+      return 0;
+    }
+    roots[0] = -c / b;
+    return 1;
+  }
+
+  double discriminant = b * b - 4.0 * a * c;
+  if (discriminant < 0.0) {
+    return 0;
+  }
+  if (discriminant == 0.0) {
+    roots[0] = -0.5 * b / a;
+    return 1;
+  }
+
+  // q has the sign of b, so b + sqrt(...) never cancels
+  double q = -0.5 * (b + std::copysign(std::sqrt(discriminant), b));
+  if (q == 0.0) {
+    // b == 0 and c == 0
+    roots[0] = 0.0;
+    return 1;
+  }
+  roots[0] = q / a;
+  roots[1] = c / q;
+  if (roots[0] > roots[1]) {
+    std::swap(roots[0], roots[1]);
+  }
+  return 2;
+}
+
+int solveCubic(double a, double b, double c, double d,
+               std::array<double, 3>& roots) {
+  if (a == 0.0) {
+    std::array<double, 2> quadraticRoots{};
+    int count = solveQuadratic(b, c, d, quadraticRoots);
+    for (int i = 0; i < count; ++i) {
+      roots[i] = quadraticRoots[i];
+    }
+    return count;
+  }
+
+  // Depressed cubic x^3 + p x + q after substituting x = y - A / 3
+  double A = b / a;
+  double B = c / a;
+  double C = d / a;
+  double squaredA = A * A;
+  double p = (B - squaredA / 3.0) / 3.0;
+  double q = 0.5 * (2.0 / 27.0 * A * squaredA - A * B / 3.0 + C);
+  double cubedP = p * p * p;
+  double discriminant = q * q + cubedP;
+
+  int count = 0;
+  if (discriminant == 0.0) {
+    if (q == 0.0) {
+      roots[count++] = 0.0;
+    } else {
+      double u = std::cbrt(-q);
+      roots[count++] = 2.0 * u;
+      roots[count++] = -u;
+    }
+  } else if (discriminant < 0.0) {
+    // Three real roots
+    double cosine = std::clamp(-q / std::sqrt(-cubedP), -1.0, 1.0);
+    double phi = std::acos(cosine) / 3.0;
+    double scale = 2.0 * std::sqrt(-p);
+    roots[count++] = scale * std::cos(phi);
+    roots[count++] = -scale * std::cos(phi + M_PI / 3.0);
+    roots[count++] = -scale * std::cos(phi - M_PI / 3.0);
+  } else {
+    double sqrtDiscriminant = std::sqrt(discriminant);
+    roots[count++] =
+        std::cbrt(sqrtDiscriminant - q) - std::cbrt(sqrtDiscriminant + q);
+  }
+
+  double shift = A / 3.0;
+  for (int i = 0; i < count; ++i) {
+    roots[i] -= shift;
+  }
+  std::sort(roots.begin(), roots.begin() + count);
+  return count;
+}
+
+std::optional<double> findSmallestQuarticRoot(
+    const std::array<double, 5>& coefficients, double lo, double hi) {
+  if (!(lo <= hi)) {
+    return std::nullopt;
+  }
+
+  std::array<double, 3> criticalPoints{};
+  int criticalCount =
+      solveCubic(4.0 * coefficients[0], 3.0 * coefficients[1],
+                 2.0 * coefficients[2], coefficients[3], criticalPoints);
+
+  double start = lo;
+  double fStart = evaluateQuartic(coefficients, start);
+  if (fStart == 0.0) {
+    return start;
+  }
+  for (int i = 0; i <= criticalCount; ++i) {
+    double end = i < criticalCount ? criticalPoints[i] : hi;
+    if (end <= start) {
+      continue;
+    }
+    end = std::min(end, hi);
+    double fEnd = evaluateQuartic(coefficients, end);
+    if (fEnd == 0.0) {
+      return end;
+    }
+    if ((fStart < 0.0) != (fEnd < 0.0)) {
+      return fStart < 0.0 ? refineBracketedRoot(coefficients, start, end)
+                          : refineBracketedRoot(coefficients, end, start);
+    }
+    if (end >= hi) {
+      break;
+    }
+    start = end;
+    fStart = fEnd;
+  }
+  return std::nullopt;
+}
+
+}  // namespace RayTracer
@@ -0,0 +1,75 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Polynomial root finding header
+*/
+
+/**
+ * @file Polynomial.hpp
+ * @brief Closed-form and bracketed real root finders for the low degree
+ * polynomials met in ray-surface intersections
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#ifndef POLYNOMIAL_HPP_
+#define POLYNOMIAL_HPP_
+
+#include <array>
+#include <optional>
+
+namespace RayTracer {
+
+/**
+ * @brief Real roots of a x^2 + b x + c
+ *
+ * Uses the cancellation-free form of the quadratic formula. Degenerates to
+ * the linear equation when a is zero.
+ *
+ * @param a Coefficient of x^2
+ * @param b Coefficient of x
+ * @param c Constant term
+ * @param roots Receives the roots in increasing order
+ * @return The number of roots written (0 to 2)
+ */
+int solveQuadratic(double a, double b, double c, std::array<double, 2>& roots);
+
+/**
+ * @brief Real roots of a x^3 + b x^2 + c x + d
+ *
+ * Cardano's method, with the trigonometric form when there are three real
+ * roots. Degenerates to solveQuadratic() when a is zero.
+ *
+ * @param a Coefficient of x^3
+ * @param b Coefficient of x^2
+ * @param c Coefficient of x
+ * @param d Constant term
+ * @param roots Receives the roots in increasing order
+ * @return The number of roots written (0 to 3)
+ */
+int solveCubic(double a, double b, double c, double d,
+               std::array<double, 3>& roots);
+
+/**
+ * @brief Smallest real root of a quartic inside an interval
+ *
+ * The roots of the derivative, a cubic solved in closed form, split the
+ * interval into pieces on which the quartic is monotonic. The first piece
+ * whose ends have opposite signs brackets the wanted root, which is then
+ * refined with Newton steps that fall back on bisection whenever they
+ * would leave the bracket. No root can be skipped, unlike with a fixed
+ * step march, and the cost does not depend on the interval length.
+ *
+ * @param coefficients Coefficients from x^4 down to the constant term
+ * @param lo Lower end of the interval
+ * @param hi Upper end of the interval
+ * @return The smallest root in [lo, hi], std::nullopt if there is none
+ */
+std::optional<double> findSmallestQuarticRoot(
+    const std::array<double, 5>& coefficients, double lo, double hi);
+
+}  // namespace RayTracer
+
+#endif /* !POLYNOMIAL_HPP_ */
@@ -0,0 +1,117 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** RGB class implementation
+*/
+
+/**
+ * @file RGB.cpp
+ * @brief Implementation of the tone mapping and quantization of the linear
+ * radiance
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include "RGB.hpp"
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace RayTracer {
+
+namespace {
+
+constexpr float BYTE_SCALE = 255.0f;  ///< Byte value of a channel of 1.0
+constexpr std::size_t BLOCK = 16;     ///< Channels of one SIMD iteration
+
+/**
+ * @brief Tone map and quantize one channel
+ *
+ * The operations are those of the SIMD path, in the same order, so that
+ * both give the same byte. Adding 0.5 before truncating rounds half up,
+ * like std::round on the non-negative values left by the clamp.
+ */
+uint8_t quantizeChannel(float value, ToneMap toneMap) {
+  value = value > 0.0f ? value : 0.0f;
+  if (toneMap == ToneMap::REINHARD) {
+    value = value / (1.0f + value);
+  }
+  value = value < 1.0f ? value : 1.0f;
+  return static_cast<uint8_t>(static_cast<int>(value * BYTE_SCALE + 0.5f));
+}
+
+#if defined(__SSE2__)
+/**
+ * @brief Tone map four channels and scale them to [0, 255]
+ */
+__m128i quantizeFour(__m128 value, ToneMap toneMap) {
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.0f);
+  // The second operand is returned for NaN: NaN becomes 0, then stays 1
+  value = _mm_max_ps(value, zero);
+  if (toneMap == ToneMap::REINHARD) {
+    value = _mm_div_ps(value, _mm_add_ps(one, value));
+  }
+  value = _mm_min_ps(value, one);
+  value = _mm_add_ps(_mm_mul_ps(value, _mm_set1_ps(BYTE_SCALE)),
+                     _mm_set1_ps(0.5f));
+  return _mm_cvttps_epi32(value);
+}
+#endif
+
+}  // namespace
+
+ToneMap parseToneMap(const std::string& name) {
+  if (name == "clamp") {
+    return ToneMap::CLAMP;
+  }
+  if (name == "reinhard") {
+    return ToneMap::REINHARD;
+  }
+  throw std::invalid_argument("Unknown tone map: " + name +
+                              " (expected clamp or reinhard)");
+}
+
+std::string toneMapName(ToneMap toneMap) {
+  switch (toneMap) {
+    case ToneMap::REINHARD:
+      return "reinhard";
+    default:
+      return "clamp";
+  }
+}
+
+void quantize(const RGB* pixels, std::size_t count, ToneMap toneMap,
+              uint8_t* bytes) {
+  // The pixels are three packed floats: the buffer is one float stream
+  const float* channels = reinterpret_cast<const float*>(pixels);
+  std::size_t total = count * 3;
+  std::size_t i = 0;
+#if defined(__SSE2__)
+  for (; i + BLOCK <= total; i += BLOCK) {
+    __m128i a = quantizeFour(_mm_loadu_ps(channels + i), toneMap);
+    __m128i b = quantizeFour(_mm_loadu_ps(channels + i + 4), toneMap);
+    __m128i c = quantizeFour(_mm_loadu_ps(channels + i + 8), toneMap);
+    __m128i d = quantizeFour(_mm_loadu_ps(channels + i + 12), toneMap);
+    // Values are in [0, 255]: the saturating packs never saturate
+    __m128i packed =
+        _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(bytes + i), packed);
+  }
+#endif
+  for (; i < total; ++i) {
+    bytes[i] = quantizeChannel(channels[i], toneMap);
+  }
+}
+
+Color quantize(const RGB& pixel, ToneMap toneMap) {
+  uint8_t bytes[3];
+  quantize(&pixel, 1, toneMap, bytes);
+  return Color(bytes[0], bytes[1], bytes[2]);
+}
+
+}  // namespace RayTracer
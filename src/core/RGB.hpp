@@ -0,0 +1,228 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** RGB class header
+*/
+
+/**
+ * @file RGB.hpp
+ * @brief Definition of the RGB class, the linear floating point radiance
+ * accumulated by the shading and the framebuffer, and of the tone mapping
+ * pass that turns it into bytes
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#ifndef RGB_HPP_
+#define RGB_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include "Color.hpp"
+
+namespace RayTracer {
+
+/**
+ * @brief Linear RGB radiance in floating point
+ *
+ * Unlike Color, the channels are neither clamped nor rounded: sums and
+ * products keep their full range and precision, and any number of samples
+ * can be accumulated in a pixel. 1.0 is the brightest byte value; the
+ * conversion to bytes happens once, in quantize(), when the image is output.
+ */
+class RGB {
+ public:
+  /**
+   * @brief Default constructor
+   * Creates black (0, 0, 0)
+   */
+  constexpr RGB() : _r(0.0f), _g(0.0f), _b(0.0f) {}
+
+  /**
+   * @brief Constructor with linear channel values
+   * @param r Red channel, 1.0 for full intensity
+   * @param g Green channel, 1.0 for full intensity
+   * @param b Blue channel, 1.0 for full intensity
+   */
+  constexpr RGB(float r, float g, float b) : _r(r), _g(g), _b(b) {}
+
+  /**
+   * @brief Conversion from a byte color
+   * @param color The color, 255 maps to 1.0
+   */
+  explicit RGB(const Color& color)
+      : _r(static_cast<float>(color.getRf())),
+        _g(static_cast<float>(color.getGf())),
+        _b(static_cast<float>(color.getBf())) {}
+
+  /**
+   * @brief Get the red channel
+   * @return The linear red value
+   */
+  constexpr float getR() const { return _r; }
+
+  /**
+   * @brief Get the green channel
+   * @return The linear green value
+   */
+  constexpr float getG() const { return _g; }
+
+  /**
+   * @brief Get the blue channel
+   * @return The linear blue value
+   */
+  constexpr float getB() const { return _b; }
+
+  /**
+   * @brief Addition operator
+   * @param other The radiance to add
+   * @return The sum, not clamped
+   */
+  constexpr RGB operator+(const RGB& other) const {
+    return RGB(_r + other._r, _g + other._g, _b + other._b);
+  }
+
+  /**
+   * @brief Addition assignment operator
+   * @param other The radiance to add
+   * @return Reference to this radiance after addition
+   */
+  constexpr RGB& operator+=(const RGB& other) {
+    _r += other._r;
+    _g += other._g;
+    _b += other._b;
+    return *this;
+  }
+
+  /**
+   * @brief Multiplication by a scalar
+   * @param scalar The factor, not clamped
+   * @return The scaled radiance
+   */
+  constexpr RGB operator*(float scalar) const {
+    return RGB(_r * scalar, _g * scalar, _b * scalar);
+  }
+
+  /**
+   * @brief Multiplication assignment by a scalar
+   * @param scalar The factor, not clamped
+   * @return Reference to this radiance after multiplication
+   */
+  constexpr RGB& operator*=(float scalar) {
+    _r *= scalar;
+    _g *= scalar;
+    _b *= scalar;
+    return *this;
+  }
+
+  /**
+   * @brief Component-wise multiplication, to filter by a surface or a light
+   * @param other The radiance to multiply with
+   * @return The filtered radiance
+   */
+  constexpr RGB operator*(const RGB& other) const {
+    return RGB(_r * other._r, _g * other._g, _b * other._b);
+  }
+
+  /**
+   * @brief Component-wise multiplication assignment
+   * @param other The radiance to multiply with
+   * @return Reference to this radiance after multiplication
+   */
+  constexpr RGB& operator*=(const RGB& other) {
+    _r *= other._r;
+    _g *= other._g;
+    _b *= other._b;
+    return *this;
+  }
+
+  /**
+   * @brief Equality operator
+   * @param other The radiance to compare with
+   * @return true if the channels are identical
+   */
+  constexpr bool operator==(const RGB& other) const {
+    return _r == other._r && _g == other._g && _b == other._b;
+  }
+
+  /**
+   * @brief Clamp every channel to [0.0, 1.0]
+   * @return The clamped radiance
+   */
+  constexpr RGB clamped() const {
+    return RGB(clamp(_r), clamp(_g), clamp(_b));
+  }
+
+ private:
+  float _r;  ///< Linear red channel
+  float _g;  ///< Linear green channel
+  float _b;  ///< Linear blue channel
+
+  /**
+   * @brief Clamp a channel to [0.0, 1.0], NaN to 0.0
+   * @param value The channel
+   * @return The clamped channel
+   */
+  static constexpr float clamp(float value) {
+    value = value > 0.0f ? value : 0.0f;
+    return value < 1.0f ? value : 1.0f;
+  }
+};
+
+static_assert(std::is_trivially_copyable_v<RGB>);
+static_assert(sizeof(RGB) == 3 * sizeof(float));
+
+/**
+ * @brief Curve mapping the linear radiance to the output range
+ */
+enum class ToneMap : uint8_t {
+  CLAMP,    ///< Channels above 1.0 saturate
+  REINHARD  ///< x / (1 + x), compresses highlights instead of clipping them
+};
+
+/**
+ * @brief Parse a tone map name
+ * @param name "clamp" or "reinhard"
+ * @return The tone map
+ * @throw std::invalid_argument for any other name
+ */
+ToneMap parseToneMap(const std::string& name);
+
+/**
+ * @brief Get the name of a tone map
+ * @param toneMap The tone map
+ * @return The name accepted by parseToneMap()
+ */
+std::string toneMapName(ToneMap toneMap);
+
+/**
+ * @brief Tone map and quantize radiance to 8-bit channels
+ *
+ * Writes three bytes per pixel, in RGB order, as a PPM file stores them.
+ * Negative and NaN channels give 0. The channels are processed four at a
+ * time with SSE2 when available; the scalar path gives the same bytes.
+ *
+ * @param pixels The radiance of the pixels
+ * @param count Number of pixels
+ * @param toneMap Curve applied before quantization
+ * @param bytes Output, 3 * count bytes
+ */
+void quantize(const RGB* pixels, std::size_t count, ToneMap toneMap,
+              uint8_t* bytes);
+
+/**
+ * @brief Tone map and quantize the radiance of one pixel
+ * @param pixel The radiance
+ * @param toneMap Curve applied before quantization
+ * @return The byte color
+ * @see quantize()
+ */
+Color quantize(const RGB& pixel, ToneMap toneMap = ToneMap::CLAMP);
+
+}  // namespace RayTracer
+
+#endif /* !RGB_HPP_ */
@@ -20,18 +20,40 @@
 
 namespace RayTracer {
 
-Ray::Ray() : _origin(0, 0, 0), _direction(0, 0, 1) {}
+Ray::Ray()
+    : _origin(0, 0, 0),
+      _direction(0, 0, 1),
+      _tMin(0.0),
+      _tMax(std::numeric_limits<double>::infinity()) {
+  updateInverseDirection();
+}
 
 Ray::Ray(const Vector3D& origin, const Vector3D& direction)
-    : _origin(origin), _direction(direction.normalized()) {}
+    : _origin(origin),
+      _direction(direction.normalized()),
+      _tMin(0.0),
+      _tMax(std::numeric_limits<double>::infinity()) {
+  updateInverseDirection();
+}
 
 Ray::Ray(const Ray& other)
-    : _origin(other._origin), _direction(other._direction) {}
+    : _origin(other._origin),
+      _direction(other._direction),
+      _inverseDirection(other._inverseDirection),
+      _sign{other._sign[0], other._sign[1], other._sign[2]},
+      _tMin(other._tMin),
+      _tMax(other._tMax) {}
 
 Ray& Ray::operator=(const Ray& other) {
   if (this != &other) {
     _origin = other._origin;
     _direction = other._direction;
+    _inverseDirection = other._inverseDirection;
+    for (int axis = 0; axis < 3; ++axis) {
+      _sign[axis] = other._sign[axis];
+    }
+    _tMin = other._tMin;
+    _tMax = other._tMax;
   }
   return *this;
 }
@@ -46,12 +68,44 @@ Vector3D Ray::getDirection() const {
   return _direction;
 }
 
+const Vector3D& Ray::getInverseDirection() const {
+  return _inverseDirection;
+}
+
+int Ray::getSign(int axis) const {
+  return _sign[axis];
+}
+
+double Ray::getTMin() const {
+  return _tMin;
+}
+
+double Ray::getTMax() const {
+  return _tMax;
+}
+
+void Ray::setInterval(double tMin, double tMax) {
+  _tMin = tMin;
+  _tMax = tMax;
+}
+
+void Ray::shrinkTMax(double t) const {
+  if (t < _tMax) {
+    _tMax = t;
+  }
+}
+
+bool Ray::isInInterval(double t) const {
+  return t >= _tMin && t <= _tMax;
+}
+
 void Ray::setOrigin(const Vector3D& origin) {
   _origin = origin;
 }
 
 void Ray::setDirection(const Vector3D& direction) {
   _direction = direction.normalized();
+  updateInverseDirection();
 }
 
 Vector3D Ray::pointAt(double t) const {
@@ -59,10 +113,33 @@ Vector3D Ray::pointAt(double t) const {
 }
 
 Ray Ray::transform(const Transform& transform) const {
-  Vector3D newOrigin = transform.applyToPoint(_origin);
-  Vector3D newDirection = transform.applyToVector(_direction);
+  // Without a linear part the direction, and what derives from it, is kept
+  if (transform.getKind() == TransformKind::IDENTITY) {
+    return *this;
+  }
+  if (transform.getKind() == TransformKind::TRANSLATION) {
+    Ray result(*this);
+    result._origin = transform.applyToPoint(_origin);
+    return result;
+  }
+
+  Ray result;
+  result._origin = transform.applyToPoint(_origin);
+  // Not renormalized: t keeps designating the same point on both rays
+  result._direction = transform.applyToVector(_direction);
+  result.updateInverseDirection();
+  result._tMin = _tMin;
+  result._tMax = _tMax;
+  return result;
+}
 
-  return Ray(newOrigin, newDirection);
+void Ray::updateInverseDirection() {
+  _inverseDirection =
+      Vector3D(1.0 / _direction.getX(), 1.0 / _direction.getY(),
+               1.0 / _direction.getZ());
+  _sign[0] = _inverseDirection.getX() < 0 ? 1 : 0;
+  _sign[1] = _inverseDirection.getY() < 0 ? 1 : 0;
+  _sign[2] = _inverseDirection.getZ() < 0 ? 1 : 0;
 }
 
 }  // namespace RayTracer
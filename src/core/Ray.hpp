@@ -17,6 +17,7 @@
 #ifndef RAY_HPP_
 #define RAY_HPP_
 
+#include <limits>
 #include "Vector3D.hpp"
 
 namespace RayTracer {
@@ -25,6 +26,12 @@ class Transform;
 
 /**
  * @brief Represents a ray with an origin point and a direction vector
+ *
+ * A ray also carries the closed parametric interval [tMin, tMax] in which
+ * hits are searched. The interval is mutable so that intersection routines,
+ * which take the ray by const reference, can shrink tMax every time they find
+ * a closer hit: later primitives then reject anything farther without
+ * computing its surface data.
  */
 class Ray {
  public:
@@ -67,10 +74,70 @@ class Ray {
 
   /**
    * @brief Get the direction of the ray
-   * @return The direction vector (normalized)
+   * @return The direction vector (normalized unless the ray comes from
+   * transform())
    */
   Vector3D getDirection() const;
 
+  /**
+   * @brief Get the component-wise inverse of the direction
+   *
+   * Precomputed so that slab tests against bounding boxes only need
+   * multiplications. Components are infinite where the direction is zero.
+   *
+   * @return The vector (1/dx, 1/dy, 1/dz)
+   */
+  const Vector3D& getInverseDirection() const;
+
+  /**
+   * @brief Get the sign of a direction component
+   *
+   * Lets slab tests pick the near and far planes of a box directly.
+   *
+   * @param axis The axis index (0 = X, 1 = Y, 2 = Z)
+   * @return 1 if the direction is negative along the axis, 0 otherwise
+   */
+  int getSign(int axis) const;
+
+  /**
+   * @brief Get the lower bound of the search interval
+   * @return The minimum ray parameter of an accepted hit
+   */
+  double getTMin() const;
+
+  /**
+   * @brief Get the upper bound of the search interval
+   * @return The maximum ray parameter of an accepted hit
+   */
+  double getTMax() const;
+
+  /**
+   * @brief Set the search interval
+   * @param tMin The minimum ray parameter of an accepted hit
+   * @param tMax The maximum ray parameter of an accepted hit
+   */
+  void setInterval(double tMin, double tMax);
+
+  /**
+   * @brief Lower the upper bound of the search interval
+   *
+   * Const because the interval is mutable: intersection routines call it on
+   * the ray they were given once they have found a closer hit. A value above
+   * the current bound is ignored. The bound stays inclusive, so a hit at
+   * exactly the same distance is still reported and can be arbitrated by
+   * the caller.
+   *
+   * @param t The parameter of the new closest hit
+   */
+  void shrinkTMax(double t) const;
+
+  /**
+   * @brief Check if a parameter lies inside the search interval
+   * @param t The ray parameter to test
+   * @return true if tMin <= t <= tMax
+   */
+  bool isInInterval(double t) const;
+
   /**
    * @brief Set the origin of the ray
    * @param origin The new origin point
@@ -92,6 +159,13 @@ class Ray {
 
   /**
    * @brief Transform the ray using a transformation matrix
+   *
+   * The transformed direction is deliberately not renormalized, so a
+   * parameter t designates the same point on both rays. Primitives rely on
+   * this to compare local hit parameters with world distances, which is also
+   * why the search interval is copied unchanged: a local hit's t is a world
+   * distance, and a world tMax set on the local ray bounds local hits.
+   *
    * @param transform The transformation to apply
    * @return A new ray with the transformation applied
    */
@@ -99,7 +173,16 @@ class Ray {
 
  private:
   Vector3D _origin;     ///< The origin point of the ray
-  Vector3D _direction;  ///< The normalized direction vector of the ray
+  Vector3D _direction;  ///< The direction vector of the ray
+  Vector3D _inverseDirection;  ///< Component-wise inverse of _direction
+  int _sign[3];                ///< 1 where _direction is negative, else 0
+  double _tMin;                ///< Lower bound of the search interval
+  mutable double _tMax;        ///< Upper bound, shrunk by closer hits
+
+  /**
+   * @brief Recompute the cached inverse direction and direction signs
+   */
+  void updateInverseDirection();
 };
 
 }  // namespace RayTracer
@@ -16,9 +16,102 @@
 
 #include "RenderTile.hpp"
 #include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
 
 namespace RayTracer {
 
+namespace {
+
+/**
+ * @brief Spread the 16 low bits of a value to the even bits
+ */
+uint32_t spreadBits(uint32_t value) {
+  value &= 0x0000FFFF;
+  value = (value | (value << 8)) & 0x00FF00FF;
+  value = (value | (value << 4)) & 0x0F0F0F0F;
+  value = (value | (value << 2)) & 0x33333333;
+  value = (value | (value << 1)) & 0x55555555;
+  return value;
+}
+
+/**
+ * @brief Gather the even bits of a value into its 16 low bits
+ */
+uint32_t compactBits(uint32_t value) {
+  value &= 0x55555555;
+  value = (value | (value >> 1)) & 0x33333333;
+  value = (value | (value >> 2)) & 0x0F0F0F0F;
+  value = (value | (value >> 4)) & 0x00FF00FF;
+  value = (value | (value >> 8)) & 0x0000FFFF;
+  return value;
+}
+
+/**
+ * @brief Get the cell at a distance along the Hilbert curve of a square
+ * @param side Side of the square, a power of two
+ * @param distance Position on the curve, in [0, side * side)
+ * @param x Receives the column of the cell
+ * @param y Receives the row of the cell
+ */
+void hilbertCell(int side, int distance, int& x, int& y) {
+  x = 0;
+  y = 0;
+  for (int size = 1; size < side; size *= 2) {
+    int rx = 1 & (distance / 2);
+    int ry = 1 & (distance ^ rx);
+    // Rotate the quadrant so that the sub-curves join end to end
+    if (ry == 0) {
+      if (rx == 1) {
+        x = size - 1 - x;
+        y = size - 1 - y;
+      }
+      std::swap(x, y);
+    }
+    x += size * rx;
+    y += size * ry;
+    distance /= 4;
+  }
+}
+
+}  // namespace
+
+TileOrder parseTileOrder(const std::string& name) {
+  if (name == "raster") {
+    return TileOrder::RASTER;
+  }
+  if (name == "hilbert") {
+    return TileOrder::HILBERT;
+  }
+  if (name == "spiral") {
+    return TileOrder::SPIRAL;
+  }
+  throw std::invalid_argument("Unknown tile order: " + name +
+                              " (expected raster, hilbert or spiral)");
+}
+
+std::string tileOrderName(TileOrder order) {
+  switch (order) {
+    case TileOrder::HILBERT:
+      return "hilbert";
+    case TileOrder::SPIRAL:
+      return "spiral";
+    default:
+      return "raster";
+  }
+}
+
+uint32_t mortonEncode(uint32_t x, uint32_t y) {
+  return spreadBits(x) | (spreadBits(y) << 1);
+}
+
+void mortonDecode(uint32_t code, uint32_t& x, uint32_t& y) {
+  x = compactBits(code);
+  y = compactBits(code >> 1);
+}
+
 // RenderTile implementation
 RenderTile::RenderTile(int startX, int startY, int width, int height)
     : _startX(startX), _startY(startY), _width(width), _height(height) {}
@@ -48,19 +141,22 @@ int RenderTile::getEndY() const {
 }
 
 // TileManager implementation
-TileManager::TileManager(int imageWidth, int imageHeight, int tileSize)
+TileManager::TileManager(int imageWidth, int imageHeight, int tileSize,
+                         TileOrder order)
     : _imageWidth(imageWidth),
       _imageHeight(imageHeight),
       _tileSize(tileSize),
+      _order(order),
       _currentTileIndex(0),
       _completedTiles(0) {
   // Calculate number of tiles in each dimension
   _numTilesX = (_imageWidth + tileSize - 1) / tileSize;
   _numTilesY = (_imageHeight + tileSize - 1) / tileSize;
   _totalTiles = _numTilesX * _numTilesY;
+  generateTiles();
 }
 
-RenderTile* TileManager::getNextTile() {
+const RenderTile* TileManager::getNextTile() {
   // Get current tile index and increment atomically
   int tileIndex = _currentTileIndex.fetch_add(1);
 
@@ -69,18 +165,15 @@ RenderTile* TileManager::getNextTile() {
     return nullptr;
   }
 
-  // Calculate tile coordinates
-  int tileX = tileIndex % _numTilesX;
-  int tileY = tileIndex / _numTilesX;
+  return &_tiles[tileIndex];
+}
 
-  // Calculate tile dimensions, handling edge tiles
-  int startX = tileX * _tileSize;
-  int startY = tileY * _tileSize;
-  int width = std::min(_tileSize, _imageWidth - startX);
-  int height = std::min(_tileSize, _imageHeight - startY);
+const RenderTile& TileManager::getTile(int index) const {
+  return _tiles[index];
+}
 
-  // Create and return the tile
-  return new RenderTile(startX, startY, width, height);
+TileOrder TileManager::getOrder() const {
+  return _order;
 }
 
 int TileManager::getTotalTiles() const {
@@ -107,4 +200,60 @@ double TileManager::getProgress() const {
   return 100.0 * _completedTiles.load() / _totalTiles;
 }
 
+RenderTile TileManager::makeTile(int tileX, int tileY) const {
+  // Calculate tile dimensions, handling edge tiles
+  int startX = tileX * _tileSize;
+  int startY = tileY * _tileSize;
+  int width = std::min(_tileSize, _imageWidth - startX);
+  int height = std::min(_tileSize, _imageHeight - startY);
+
+  return RenderTile(startX, startY, width, height);
+}
+
+void TileManager::generateTiles() {
+  _tiles.reserve(_totalTiles);
+  if (_order == TileOrder::HILBERT) {
+    // Walk the curve of the smallest square covering the grid, skipping the
+    // cells out of it
+    int side = 1;
+    while (side < std::max(_numTilesX, _numTilesY)) {
+      side *= 2;
+    }
+    for (int distance = 0; distance < side * side; ++distance) {
+      int tileX = 0;
+      int tileY = 0;
+      hilbertCell(side, distance, tileX, tileY);
+      if (tileX < _numTilesX && tileY < _numTilesY) {
+        _tiles.push_back(makeTile(tileX, tileY));
+      }
+    }
+    return;
+  }
+
+  std::vector<int> order(_totalTiles);
+  std::iota(order.begin(), order.end(), 0);
+  if (_order == TileOrder::SPIRAL) {
+    // Square rings around the center of the grid, each one walked around
+    double centerX = _numTilesX / 2.0;
+    double centerY = _numTilesY / 2.0;
+    auto ring = [&](int index) {
+      double dx = std::abs(index % _numTilesX + 0.5 - centerX);
+      double dy = std::abs(index / _numTilesX + 0.5 - centerY);
+      return static_cast<int>(std::max(dx, dy));
+    };
+    auto angle = [&](int index) {
+      return std::atan2(index / _numTilesX + 0.5 - centerY,
+                        index % _numTilesX + 0.5 - centerX);
+    };
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+      int ringA = ring(a);
+      int ringB = ring(b);
+      return ringA != ringB ? ringA < ringB : angle(a) < angle(b);
+    });
+  }
+  for (int index : order) {
+    _tiles.push_back(makeTile(index % _numTilesX, index / _numTilesX));
+  }
+}
+
 }  // namespace RayTracer
@@ -18,6 +18,9 @@
 #define RENDERTILE_HPP_
 
 #include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
 
 namespace RayTracer {
 
@@ -80,8 +83,51 @@ class RenderTile {
   int _height;  ///< Height of the tile in pixels
 };
 
+/**
+ * @brief Order in which the tiles of an image are handed out
+ */
+enum class TileOrder : uint8_t {
+  RASTER,   ///< Row by row, from the top left corner
+  HILBERT,  ///< Along a Hilbert curve: consecutive tiles are neighbours
+  SPIRAL    ///< Ring by ring from the center, for previews
+};
+
+/**
+ * @brief Parse a tile order name
+ * @param name "raster", "hilbert" or "spiral"
+ * @return The tile order
+ * @throw std::invalid_argument for any other name
+ */
+TileOrder parseTileOrder(const std::string& name);
+
+/**
+ * @brief Get the name of a tile order
+ * @param order The tile order
+ * @return The name accepted by parseTileOrder()
+ */
+std::string tileOrderName(TileOrder order);
+
+/**
+ * @brief Interleave the bits of two coordinates into a Morton code
+ * @param x The column, below 2^16
+ * @param y The row, below 2^16
+ * @return The Z-order index, x in the even bits and y in the odd ones
+ */
+uint32_t mortonEncode(uint32_t x, uint32_t y);
+
+/**
+ * @brief Split a Morton code back into its coordinates
+ * @param code The Z-order index
+ * @param x Receives the column
+ * @param y Receives the row
+ */
+void mortonDecode(uint32_t code, uint32_t& x, uint32_t& y);
+
 /**
  * @brief Creates and manages rendering tiles
+ *
+ * The tiles are generated once, in the order they are handed out: neither
+ * getTile() nor getNextTile() allocates.
  */
 class TileManager {
  public:
@@ -90,14 +136,30 @@ class TileManager {
    * @param imageWidth Total image width
    * @param imageHeight Total image height
    * @param tileSize Size of each tile (both width and height)
+   * @param order Order of the tiles
    */
-  TileManager(int imageWidth, int imageHeight, int tileSize = 64);
+  TileManager(int imageWidth, int imageHeight, int tileSize = 64,
+              TileOrder order = TileOrder::RASTER);
 
   /**
    * @brief Get the next tile to render
-   * @return Next tile or nullptr if all tiles have been processed
+   * @return Next tile, owned by the manager, or nullptr if all tiles have
+   * been handed out
+   */
+  const RenderTile* getNextTile();
+
+  /**
+   * @brief Get a tile by its index in the order of the manager
+   * @param index Tile index in [0, getTotalTiles())
+   * @return The tile, clipped to the image
+   */
+  const RenderTile& getTile(int index) const;
+
+  /**
+   * @brief Get the order of the tiles
+   * @return The tile order
    */
-  RenderTile* getNextTile();
+  TileOrder getOrder() const;
 
   /**
    * @brief Get the total number of tiles
@@ -135,8 +197,24 @@ class TileManager {
   int _numTilesY;    ///< Number of tiles along Y-axis
   int _totalTiles;   ///< Total number of tiles
 
+  TileOrder _order;                ///< Order of _tiles
+  std::vector<RenderTile> _tiles;  ///< Every tile, in the order handed out
+
   std::atomic<int> _currentTileIndex;  ///< Index of the next tile to process
   std::atomic<int> _completedTiles;    ///< Number of completed tiles
+
+  /**
+   * @brief Get the tile at a position of the tile grid, clipped to the image
+   * @param tileX Column of the tile
+   * @param tileY Row of the tile
+   * @return The tile
+   */
+  RenderTile makeTile(int tileX, int tileY) const;
+
+  /**
+   * @brief Fill _tiles in the order of the manager
+   */
+  void generateTiles();
 };
 
 }  // namespace RayTracer
@@ -16,54 +16,215 @@
 
 #include "ThreadPool.hpp"
 #include <algorithm>
+#include <exception>
 #include <thread>
 
 namespace RayTracer {
 
-ThreadPool::ThreadPool(size_t numThreads) : _stop(false), _active(true) {
+namespace {
+
+/**
+ * @brief Pool of the worker running on this thread, nullptr elsewhere
+ */
+thread_local const ThreadPool* currentPool = nullptr;
+
+/**
+ * @brief Deque index of the worker running on this thread
+ */
+thread_local size_t currentQueue = 0;
+
+}  // namespace
+
+/**
+ * @brief Shared state of one parallelFor() call
+ *
+ * The chunks are split into one contiguous share per thread. Each share is
+ * claimed chunk by chunk with an atomic increment, by its owner first and
+ * by the threads that ran out of work after. The state lives until the
+ * caller and every helper task let go of it: helpers that start after the
+ * loop is over find nothing to claim and leave. The last one hands the
+ * state back to the pool, which reuses it for a later loop.
+ */
+class ThreadPool::Loop {
+ public:
+  /**
+   * @brief Constructor, with room for one share per worker and the caller
+   * @param pool The pool the state is recycled into
+   */
+  explicit Loop(ThreadPool& pool)
+      : nextFree(nullptr),
+        _pool(pool),
+        _invoke(nullptr),
+        _body(nullptr),
+        _chunkCount(0),
+        _shareCount(0),
+        _shares(new Share[pool._workers.size() + 1]),
+        _nextShare(0),
+        _finished(0),
+        _references(0),
+        _failed(false),
+        _error() {}
+
+  /**
+   * @brief Prepare the state for a new loop
+   * @param chunkCount Number of chunks
+   * @param shareCount Number of shares, at most one per worker plus one
+   * @param invoke Runs one chunk of the body
+   * @param body The type-erased body
+   */
+  void start(size_t chunkCount, size_t shareCount,
+             void (*invoke)(const void*, size_t), const void* body) {
+    _invoke = invoke;
+    _body = body;
+    _chunkCount = chunkCount;
+    _shareCount = shareCount;
+    _nextShare = 1;
+    _finished = 0;
+    _references = static_cast<int>(shareCount);
+    _failed = false;
+    _error = nullptr;
+    for (size_t i = 0; i < shareCount; ++i) {
+      _shares[i].next = chunkCount * i / shareCount;
+      _shares[i].end = chunkCount * (i + 1) / shareCount;
+    }
+  }
+
+  /**
+   * @brief Helper task: take the next free share, then steal
+   */
+  static void help(void* context) {
+    Loop* loop = static_cast<Loop*>(context);
+    loop->work(loop->_nextShare.fetch_add(1) % loop->_shareCount);
+    loop->release();
+  }
+
+  /**
+   * @brief Run the chunks of a share, then those left in the others
+   * @param share Index of the share to start with
+   */
+  void work(size_t share) {
+    for (size_t k = 0; k < _shareCount; ++k) {
+      Share& current = _shares[(share + k) % _shareCount];
+      for (size_t chunk = current.next.fetch_add(1); chunk < current.end;
+           chunk = current.next.fetch_add(1)) {
+        run(chunk);
+      }
+    }
+  }
+
+  /**
+   * @brief Check if every chunk has run
+   * @return true once the loop is over
+   */
+  bool done() const { return _finished.load() >= _chunkCount; }
+
+  /**
+   * @brief Drop a reference, the last one gives the state back to the pool
+   */
+  void release() {
+    if (_references.fetch_sub(1) == 1) {
+      _pool.recycleLoop(this);
+    }
+  }
+
+  /**
+   * @brief Get the first exception thrown by the body
+   * @return The exception, null if none was thrown
+   */
+  std::exception_ptr getError() const { return _error; }
+
+  Loop* nextFree;  ///< Next state of the pool free list
+
+ private:
+  /**
+   * @brief Chunks of one thread, alone on its cache line
+   */
+  struct alignas(64) Share {
+    std::atomic<size_t> next;  ///< Next chunk to claim
+    size_t end;                ///< One past the last chunk
+  };
+
+  ThreadPool& _pool;                     ///< Pool recycling the state
+  void (*_invoke)(const void*, size_t);  ///< Runs one chunk of the body
+  const void* _body;                     ///< The type-erased body
+  size_t _chunkCount;                    ///< Number of chunks
+  size_t _shareCount;                    ///< Number of shares
+  std::unique_ptr<Share[]> _shares;      ///< Chunks of each thread
+  std::atomic<size_t> _nextShare;        ///< Share of the next helper
+  std::atomic<size_t> _finished;         ///< Chunks done or skipped
+  std::atomic<int> _references;          ///< Caller and pending helpers
+  std::atomic<bool> _failed;             ///< Set by the first exception
+  std::exception_ptr _error;             ///< The first exception
+
+  void run(size_t chunk) {
+    if (!_failed.load(std::memory_order_relaxed)) {
+      try {
+        _invoke(_body, chunk);
+      } catch (...) {
+        if (!_failed.exchange(true)) {
+          _error = std::current_exception();
+        }
+      }
+    }
+    // Published before the count that lets the caller read it
+    if (_finished.fetch_add(1) + 1 == _chunkCount) {
+      _pool.wakeCallers();
+    }
+  }
+};
+
+void ThreadPool::Queue::pushBack(Task task) {
+  if (count == tasks.size()) {
+    // Unroll the ring into a buffer twice as large
+    std::vector<Task> grown(tasks.size() * 2);
+    for (size_t i = 0; i < count; ++i) {
+      grown[i] = tasks[(head + i) & (tasks.size() - 1)];
+    }
+    tasks.swap(grown);
+    head = 0;
+  }
+  tasks[(head + count) & (tasks.size() - 1)] = task;
+  ++count;
+}
+
+ThreadPool::Task ThreadPool::Queue::popBack() {
+  --count;
+  return tasks[(head + count) & (tasks.size() - 1)];
+}
+
+ThreadPool::Task ThreadPool::Queue::popFront() {
+  Task task = tasks[head];
+  head = (head + 1) & (tasks.size() - 1);
+  --count;
+  return task;
+}
+
+ThreadPool::ThreadPool(size_t numThreads)
+    : _freeLoops(nullptr),
+      _pending(0),
+      _sleeping(0),
+      _waitingCallers(0),
+      _nextQueue(0),
+      _stop(false),
+      _active(true) {
   // If numThreads is 0, use hardware concurrency minus 1 (leave one for OS)
   if (numThreads == 0) {
-    numThreads = std::max(1u, std::thread::hardware_concurrency() - 1);
+    unsigned cores = std::thread::hardware_concurrency();
+    numThreads = cores > 2 ? cores - 1 : 1;
   }
 
+  for (size_t i = 0; i < numThreads; ++i) {
+    _queues.push_back(std::make_unique<Queue>());
+  }
   // Create worker threads
   for (size_t i = 0; i < numThreads; ++i) {
-    _workers.emplace_back([this] {
-      while (true) {
-        std::function<void()> task;
-
-        {
-          // Wait for a task or stop signal
-          std::unique_lock<std::mutex> lock(this->_queueMutex);
-          this->_condition.wait(lock, [this] {
-            return this->_stop || (!this->_tasks.empty() && this->_active);
-          });
-
-          // Exit if stopping and no more tasks
-          if (this->_stop && this->_tasks.empty()) {
-            return;
-          }
-
-          // If not active, keep waiting
-          if (!this->_active) {
-            continue;
-          }
-
-          // Get next task
-          task = std::move(this->_tasks.front());
-          this->_tasks.pop();
-        }
-
-        // Execute the task
-        task();
-      }
-    });
+    _workers.emplace_back([this, i] { workerLoop(i); });
   }
 }
 
 ThreadPool::~ThreadPool() {
   {
-    std::lock_guard<std::mutex> lock(_queueMutex);
+    std::lock_guard<std::mutex> lock(_sleepMutex);
     _stop = true;
   }
 
@@ -76,21 +237,34 @@ ThreadPool::~ThreadPool() {
       worker.join();
     }
   }
+
+  // The helpers ran with the queued tasks: every loop state is back
+  while (_freeLoops != nullptr) {
+    Loop* loop = _freeLoops;
+    _freeLoops = loop->nextFree;
+    delete loop;
+  }
 }
 
 size_t ThreadPool::size() const {
   return _workers.size();
 }
 
+size_t ThreadPool::workerIndex() const {
+  return currentPool == this ? currentQueue : _workers.size();
+}
+
 size_t ThreadPool::queueSize() const {
-  std::lock_guard<std::mutex> lock(_queueMutex);
-  return _tasks.size();
+  std::ptrdiff_t pending = _pending.load();
+  return pending > 0 ? static_cast<size_t>(pending) : 0;
 }
 
 void ThreadPool::setActive(bool active) {
   _active = active;
   if (active) {
+    std::lock_guard<std::mutex> lock(_sleepMutex);
     _condition.notify_all();
+    _callerCondition.notify_all();
   }
 }
 
@@ -98,4 +272,136 @@ bool ThreadPool::isActive() const {
   return _active;
 }
 
+void ThreadPool::submit(Task task) {
+  size_t queue = currentPool == this
+                     ? currentQueue
+                     : _nextQueue.fetch_add(1) % _queues.size();
+  {
+    std::lock_guard<std::mutex> lock(_queues[queue]->mutex);
+    _queues[queue]->pushBack(task);
+  }
+  // The count is raised once the task can be found. A worker going to sleep
+  // either sees it or is already counted in _sleeping and gets notified
+  _pending.fetch_add(1);
+  if (_sleeping.load() > 0) {
+    std::lock_guard<std::mutex> lock(_sleepMutex);
+    _condition.notify_one();
+  }
+  wakeCallers();
+}
+
+void ThreadPool::wakeCallers() {
+  // Same handshake as _sleeping: a caller going to wait either sees the
+  // change or is already counted and gets notified
+  if (_waitingCallers.load() > 0) {
+    std::lock_guard<std::mutex> lock(_sleepMutex);
+    _callerCondition.notify_all();
+  }
+}
+
+bool ThreadPool::runOne(size_t self) {
+  Task task{nullptr, nullptr};
+  size_t count = _queues.size();
+  // The own deque from the back, the others from the front
+  if (self < count) {
+    std::lock_guard<std::mutex> lock(_queues[self]->mutex);
+    if (_queues[self]->count > 0) {
+      task = _queues[self]->popBack();
+    }
+  }
+  for (size_t k = 1; task.run == nullptr && k <= count; ++k) {
+    Queue& victim = *_queues[(self + k) % count];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (victim.count > 0) {
+      task = victim.popFront();
+    }
+  }
+  if (task.run == nullptr) {
+    return false;
+  }
+  _pending.fetch_sub(1);
+  task.run(task.context);
+  return true;
+}
+
+void ThreadPool::workerLoop(size_t index) {
+  currentPool = this;
+  currentQueue = index;
+  while (true) {
+    if ((_active || _stop) && runOne(index)) {
+      continue;
+    }
+
+    // Wait for a task or stop signal; queued tasks still run once stopping
+    std::unique_lock<std::mutex> lock(_sleepMutex);
+    _sleeping.fetch_add(1);
+    _condition.wait(lock, [this] {
+      return _stop || (_pending.load() > 0 && _active);
+    });
+    _sleeping.fetch_sub(1);
+    if (_stop && _pending.load() <= 0) {
+      return;
+    }
+  }
+}
+
+ThreadPool::Loop* ThreadPool::acquireLoop() {
+  {
+    std::lock_guard<std::mutex> lock(_loopMutex);
+    if (_freeLoops != nullptr) {
+      Loop* loop = _freeLoops;
+      _freeLoops = loop->nextFree;
+      return loop;
+    }
+  }
+  // Only while more loops than ever before run at once, nested ones included
+  return new Loop(*this);
+}
+
+void ThreadPool::recycleLoop(Loop* loop) {
+  std::lock_guard<std::mutex> lock(_loopMutex);
+  loop->nextFree = _freeLoops;
+  _freeLoops = loop;
+}
+
+void ThreadPool::runLoop(size_t chunkCount, void (*invoke)(const void*, size_t),
+                         const void* body) {
+  if (chunkCount == 1 || _workers.empty()) {
+    for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+      invoke(body, chunk);
+    }
+    return;
+  }
+
+  // One share for the caller and one per helper task
+  size_t helpers = std::min(_workers.size(), chunkCount - 1);
+  Loop* loop = acquireLoop();
+  loop->start(chunkCount, helpers + 1, invoke, body);
+  for (size_t i = 0; i < helpers; ++i) {
+    submit(Task{&Loop::help, loop});
+  }
+  loop->work(0);
+
+  // Take queued tasks until the last chunks, running elsewhere, are done:
+  // the chunks that split their work with a nested loop post it as tasks,
+  // possibly after this thread found the deques empty
+  size_t self = currentPool == this ? currentQueue : _workers.size();
+  while (!loop->done()) {
+    if (_active && runOne(self)) {
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(_sleepMutex);
+    _waitingCallers.fetch_add(1);
+    _callerCondition.wait(lock, [this, loop] {
+      return loop->done() || (_pending.load() > 0 && _active);
+    });
+    _waitingCallers.fetch_sub(1);
+  }
+  std::exception_ptr error = loop->getError();
+  loop->release();
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
 }  // namespace RayTracer
@@ -19,17 +19,31 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <cstddef>
 #include <functional>
 #include <future>
+#include <memory>
 #include <mutex>
-#include <queue>
+#include <stdexcept>
 #include <thread>
 #include <vector>
 
 namespace RayTracer {
 
 /**
- * @brief A simple thread pool for parallel task execution
+ * @brief A work-stealing thread pool for parallel task execution
+ *
+ * Every worker owns a deque of tasks. A worker runs the newest task of its
+ * own deque first and, once it is empty, steals the oldest task of another
+ * one, so that submissions and idle workers never meet on a single lock.
+ * Tasks submitted from a worker go to its own deque; tasks submitted from
+ * outside the pool are spread over the deques in turn.
+ *
+ * parallelFor() is the cheap path for loops: it posts one helper task per
+ * worker, and the calling thread works on the loop too, which also makes it
+ * safe to call from inside a task. Its state is recycled from one loop to
+ * the next and the deques are rings that only grow, so once the pool has
+ * warmed up a loop allocates nothing.
  */
 class ThreadPool {
  public:
@@ -41,26 +55,62 @@ class ThreadPool {
   explicit ThreadPool(size_t numThreads = 0);
 
   /**
-   * @brief Destructor (joins all threads)
+   * @brief Destructor (runs the queued tasks, then joins all threads)
    */
   ~ThreadPool();
 
   /**
    * @brief Add a task to the queue
+   *
+   * Allocates the task and the state of its future: loops should go through
+   * parallelFor() instead.
+   *
    * @param func Function to execute
    * @param args Arguments to pass to the function
    * @return A future for the function's result
+   * @throw std::runtime_error if the pool is being destroyed
    */
   template <class F, class... Args>
   auto enqueue(F&& func, Args&&... args)
       -> std::future<typename std::invoke_result<F, Args...>::type>;
 
+  /**
+   * @brief Run a loop over [begin, end) on the workers and the caller
+   *
+   * The range is cut into chunks of `grain` indices, and `body(chunkBegin,
+   * chunkEnd)` is called once per chunk, from any thread. Each thread starts
+   * on a contiguous share of the chunks and steals from the others when it
+   * is done. Until the last chunks, running on other threads, are done,
+   * the caller runs queued tasks, such as the helpers of a loop nested in
+   * one of them, and is woken up for the tasks queued after it ran out.
+   * Returns once every chunk has run; the first exception thrown by the
+   * body is rethrown then, and the chunks not started yet are skipped.
+   *
+   * @param begin First index
+   * @param end One past the last index
+   * @param grain Indices per chunk, 0 is read as 1
+   * @param body Callable taking (std::size_t, std::size_t)
+   */
+  template <typename Body>
+  void parallelFor(std::size_t begin, std::size_t end, std::size_t grain,
+                   const Body& body);
+
   /**
    * @brief Get the number of worker threads
    * @return Number of threads in the pool
    */
   size_t size() const;
 
+  /**
+   * @brief Get the index of the calling thread in the pool
+   *
+   * Lets a loop body pick per-thread scratch memory without locking.
+   *
+   * @return The worker index in [0, size()), size() for any thread that is
+   * not a worker of this pool
+   */
+  size_t workerIndex() const;
+
   /**
    * @brief Get the number of tasks waiting in the queue
    * @return Queue size
@@ -80,14 +130,113 @@ class ThreadPool {
   bool isActive() const;
 
  private:
-  std::vector<std::thread> _workers;         ///< Worker threads
-  std::queue<std::function<void()>> _tasks;  ///< Task queue
+  /**
+   * @brief Queued unit of work: a plain function and its argument
+   */
+  struct Task {
+    void (*run)(void* context);  ///< Function to call
+    void* context;               ///< Its argument
+  };
+
+  /**
+   * @brief Task deque of one worker, alone on its cache line
+   *
+   * A ring buffer that doubles when full and never shrinks, so that pushing
+   * and popping tasks does not allocate once it has reached its working
+   * size.
+   */
+  struct alignas(64) Queue {
+    static constexpr size_t INITIAL_CAPACITY = 256;  ///< Power of two
+
+    std::mutex mutex;         ///< Protects the tasks
+    std::vector<Task> tasks;  ///< The ring, its size a power of two
+    size_t head = 0;          ///< Position of the oldest task
+    size_t count = 0;         ///< Number of tasks
+
+    Queue() : tasks(INITIAL_CAPACITY) {}
+
+    /**
+     * @brief Add a task at the back, doubling the ring if it is full
+     * @param task The task
+     */
+    void pushBack(Task task);
+
+    /**
+     * @brief Remove the newest task
+     * @return The task, the queue must not be empty
+     */
+    Task popBack();
+
+    /**
+     * @brief Remove the oldest task
+     * @return The task, the queue must not be empty
+     */
+    Task popFront();
+  };
+
+  class Loop;
+
+  std::vector<std::unique_ptr<Queue>> _queues;  ///< One deque per worker
+  std::vector<std::thread> _workers;            ///< Worker threads
+  std::mutex _loopMutex;                        ///< Guards _freeLoops
+  Loop* _freeLoops;                             ///< Loop states to reuse
 
   // Synchronization
-  mutable std::mutex _queueMutex;      ///< Protects task queue
-  std::condition_variable _condition;  ///< For notifying worker threads
-  std::atomic<bool> _stop;             ///< Flag to stop threads
-  std::atomic<bool> _active;           ///< Flag to pause/resume processing
+  // Signed: a thief may take a task before its submitter counted it
+  std::atomic<std::ptrdiff_t> _pending;      ///< Tasks in the deques
+  std::atomic<size_t> _sleeping;             ///< Workers waiting for a task
+  std::atomic<size_t> _waitingCallers;       ///< Loop callers out of tasks
+  std::atomic<size_t> _nextQueue;            ///< Deque of the next outside task
+  std::mutex _sleepMutex;                    ///< Guards the sleeps and wake-ups
+  std::condition_variable _condition;        ///< For notifying worker threads
+  std::condition_variable _callerCondition;  ///< For notifying loop callers
+  std::atomic<bool> _stop;                   ///< Flag to stop threads
+  std::atomic<bool> _active;                 ///< Flag to pause processing
+
+  /**
+   * @brief Queue a task and wake a worker if one sleeps
+   * @param task The task
+   */
+  void submit(Task task);
+
+  /**
+   * @brief Wake the loop callers waiting for a task or for their loop
+   */
+  void wakeCallers();
+
+  /**
+   * @brief Run one task of the own deque, or stolen from another one
+   * @param self Deque of the calling worker, size() for outside threads
+   * @return true if a task ran
+   */
+  bool runOne(size_t self);
+
+  /**
+   * @brief Main loop of a worker thread
+   * @param index Index of its deque
+   */
+  void workerLoop(size_t index);
+
+  /**
+   * @brief Take a loop state from the free list, or create one
+   * @return The loop state
+   */
+  Loop* acquireLoop();
+
+  /**
+   * @brief Put back a loop state no thread refers to any more
+   * @param loop The loop state
+   */
+  void recycleLoop(Loop* loop);
+
+  /**
+   * @brief Run the chunks of a loop on the pool and the calling thread
+   * @param chunkCount Number of chunks
+   * @param invoke Runs one chunk of the body
+   * @param body The type-erased body
+   */
+  void runLoop(size_t chunkCount, void (*invoke)(const void*, size_t),
+               const void* body);
 };
 
 // Template implementation (must be in header)
@@ -95,30 +244,50 @@ template <class F, class... Args>
 auto ThreadPool::enqueue(F&& func, Args&&... args)
     -> std::future<typename std::invoke_result<F, Args...>::type> {
   using return_type = typename std::invoke_result<F, Args...>::type;
+  using packaged = std::packaged_task<return_type()>;
 
-  // Create a packaged task
-  auto task = std::make_shared<std::packaged_task<return_type()>>(
-      std::bind(std::forward<F>(func), std::forward<Args>(args)...));
+  // Don't allow enqueueing after stopping the pool
+  if (_stop) {
+    throw std::runtime_error("enqueue on stopped ThreadPool");
+  }
 
-  // Get the future to return
+  // The task owns its packaged function and frees it once it ran
+  auto* task = new packaged(
+      std::bind(std::forward<F>(func), std::forward<Args>(args)...));
   std::future<return_type> result = task->get_future();
+  submit(Task{[](void* context) {
+                auto* function = static_cast<packaged*>(context);
+                (*function)();
+                delete function;
+              },
+              task});
+  return result;
+}
 
-  // Add the task to the queue
-  {
-    std::lock_guard<std::mutex> lock(_queueMutex);
-
-    // Don't allow enqueueing after stopping the pool
-    if (_stop) {
-      throw std::runtime_error("enqueue on stopped ThreadPool");
-    }
-
-    // Wrap the packaged task into a void function
-    _tasks.emplace([task]() { (*task)(); });
+template <typename Body>
+void ThreadPool::parallelFor(std::size_t begin, std::size_t end,
+                             std::size_t grain, const Body& body) {
+  if (end <= begin) {
+    return;
   }
+  grain = grain == 0 ? 1 : grain;
 
-  // Notify a worker thread
-  _condition.notify_one();
-  return result;
+  // The chunk bounds are rebuilt from the index: nothing is allocated
+  struct Range {
+    const Body* body;
+    std::size_t begin;
+    std::size_t end;
+    std::size_t grain;
+  } range{&body, begin, end, grain};
+  auto invoke = [](const void* context, std::size_t chunk) {
+    const Range* loop = static_cast<const Range*>(context);
+    std::size_t chunkBegin = loop->begin + chunk * loop->grain;
+    std::size_t chunkEnd = loop->end - chunkBegin > loop->grain
+                               ? chunkBegin + loop->grain
+                               : loop->end;
+    (*loop->body)(chunkBegin, chunkEnd);
+  };
+  runLoop((end - begin + grain - 1) / grain, invoke, &range);
 }
 
 }  // namespace RayTracer
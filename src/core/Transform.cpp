@@ -19,18 +19,31 @@
 
 namespace RayTracer {
 
-Transform::Transform() : _matrix(), _inverseMatrix() {
+Transform::Transform()
+    : _matrix(),
+      _inverseMatrix(),
+      _affine(),
+      _normalMatrix(),
+      _kind(TransformKind::IDENTITY) {
   _matrix.setIdentity();
   _inverseMatrix.setIdentity();
+  updateCache();
 }
 
 Transform::Transform(const Transform& other)
-    : _matrix(other._matrix), _inverseMatrix(other._inverseMatrix) {}
+    : _matrix(other._matrix),
+      _inverseMatrix(other._inverseMatrix),
+      _affine(other._affine),
+      _normalMatrix(other._normalMatrix),
+      _kind(other._kind) {}
 
 Transform& Transform::operator=(const Transform& other) {
   if (this != &other) {
     _matrix = other._matrix;
     _inverseMatrix = other._inverseMatrix;
+    _affine = other._affine;
+    _normalMatrix = other._normalMatrix;
+    _kind = other._kind;
   }
   return *this;
 }
@@ -42,37 +55,36 @@ bool Transform::operator==(const Transform& other) const {
 Transform::~Transform() {}
 
 Transform& Transform::translate(double x, double y, double z) {
-  Matrix translationMatrix = Matrix::createTranslation(x, y, z);
-  _matrix = translationMatrix * _matrix;
-  updateInverseMatrix();
+  compose(Matrix::createTranslation(x, y, z),
+          Matrix::createTranslation(-x, -y, -z));
   return *this;
 }
 
 Transform& Transform::rotateX(double angleDegrees) {
-  Matrix rotationMatrix = Matrix::createRotationX(angleDegrees);
-  _matrix = rotationMatrix * _matrix;
-  updateInverseMatrix();
+  Matrix rotation = Matrix::createRotationX(angleDegrees);
+  compose(rotation, rotation.transposed());
   return *this;
 }
 
 Transform& Transform::rotateY(double angleDegrees) {
-  Matrix rotationMatrix = Matrix::createRotationY(angleDegrees);
-  _matrix = rotationMatrix * _matrix;
-  updateInverseMatrix();
+  Matrix rotation = Matrix::createRotationY(angleDegrees);
+  compose(rotation, rotation.transposed());
   return *this;
 }
 
 Transform& Transform::rotateZ(double angleDegrees) {
-  Matrix rotationMatrix = Matrix::createRotationZ(angleDegrees);
-  _matrix = rotationMatrix * _matrix;
-  updateInverseMatrix();
+  Matrix rotation = Matrix::createRotationZ(angleDegrees);
+  compose(rotation, rotation.transposed());
   return *this;
 }
 
 Transform& Transform::scale(double x, double y, double z) {
-  Matrix scaleMatrix = Matrix::createScaling(x, y, z);
-  _matrix = scaleMatrix * _matrix;
-  updateInverseMatrix();
+  if (x == 0.0 || y == 0.0 || z == 0.0) {
+    throw RaytracerException(
+        "Transform is non-invertible: scale factor of zero");
+  }
+  compose(Matrix::createScaling(x, y, z),
+          Matrix::createScaling(1.0 / x, 1.0 / y, 1.0 / z));
   return *this;
 }
 
@@ -81,8 +93,7 @@ Transform& Transform::scale(double factor) {
 }
 
 Transform& Transform::combine(const Transform& other) {
-  _matrix = other._matrix * _matrix;
-  updateInverseMatrix();
+  compose(other._matrix, other._inverseMatrix);
   return *this;
 }
 
@@ -90,6 +101,7 @@ Transform Transform::inverse() const {
   Transform result;
   result._matrix = _inverseMatrix;
   result._inverseMatrix = _matrix;
+  result.updateCache();
   return result;
 }
 
@@ -105,6 +117,23 @@ Vector3D Transform::applyToPoint(const Vector3D& point) const {
   double x = point.getX();
   double y = point.getY();
   double z = point.getZ();
+  const double* m = _affine.data();
+  // The fast paths skip the products by the zeros of the matrix
+  switch (_kind) {
+    case TransformKind::IDENTITY:
+      return point;
+    case TransformKind::TRANSLATION:
+      return Vector3D(x + m[3], y + m[7], z + m[11]);
+    case TransformKind::UNIFORM_SCALE:
+      return Vector3D(m[0] * x + m[3], m[5] * y + m[7], m[10] * z + m[11]);
+    case TransformKind::AFFINE:
+      return Vector3D(m[0] * x + m[1] * y + m[2] * z + m[3],
+                      m[4] * x + m[5] * y + m[6] * z + m[7],
+                      m[8] * x + m[9] * y + m[10] * z + m[11]);
+    default:
+      break;
+  }
+
   double w = 1.0;
 
   double newX = _matrix.at(0, 0) * x + _matrix.at(0, 1) * y +
@@ -123,30 +152,44 @@ Vector3D Transform::applyToVector(const Vector3D& vector) const {
   double x = vector.getX();
   double y = vector.getY();
   double z = vector.getZ();
-
-  double newX =
-      _matrix.at(0, 0) * x + _matrix.at(0, 1) * y + _matrix.at(0, 2) * z;
-  double newY =
-      _matrix.at(1, 0) * x + _matrix.at(1, 1) * y + _matrix.at(1, 2) * z;
-  double newZ =
-      _matrix.at(2, 0) * x + _matrix.at(2, 1) * y + _matrix.at(2, 2) * z;
-
-  return Vector3D(newX, newY, newZ);
+  const double* m = _affine.data();
+  switch (_kind) {
+    case TransformKind::IDENTITY:
+    case TransformKind::TRANSLATION:
+      return vector;
+    case TransformKind::UNIFORM_SCALE:
+      return Vector3D(m[0] * x, m[5] * y, m[10] * z);
+    default:
+      return Vector3D(m[0] * x + m[1] * y + m[2] * z,
+                      m[4] * x + m[5] * y + m[6] * z,
+                      m[8] * x + m[9] * y + m[10] * z);
+  }
 }
 
 Vector3D Transform::applyToNormal(const Vector3D& normal) const {
   double x = normal.getX();
   double y = normal.getY();
   double z = normal.getZ();
+  const double* n = _normalMatrix.data();
+  switch (_kind) {
+    case TransformKind::IDENTITY:
+    case TransformKind::TRANSLATION:
+      return normal;
+    case TransformKind::UNIFORM_SCALE:
+      return Vector3D(n[0] * x, n[4] * y, n[8] * z);
+    default:
+      return Vector3D(n[0] * x + n[1] * y + n[2] * z,
+                      n[3] * x + n[4] * y + n[5] * z,
+                      n[6] * x + n[7] * y + n[8] * z);
+  }
+}
 
-  double newX = _inverseMatrix.at(0, 0) * x + _inverseMatrix.at(1, 0) * y +
-                _inverseMatrix.at(2, 0) * z;
-  double newY = _inverseMatrix.at(0, 1) * x + _inverseMatrix.at(1, 1) * y +
-                _inverseMatrix.at(2, 1) * z;
-  double newZ = _inverseMatrix.at(0, 2) * x + _inverseMatrix.at(1, 2) * y +
-                _inverseMatrix.at(2, 2) * z;
+TransformKind Transform::getKind() const {
+  return _kind;
+}
 
-  return Vector3D(newX, newY, newZ);
+bool Transform::isAffine() const {
+  return _kind != TransformKind::PROJECTIVE;
 }
 
 Matrix Transform::getMatrix() const {
@@ -157,12 +200,41 @@ Matrix Transform::getInverseMatrix() const {
   return _inverseMatrix;
 }
 
-void Transform::updateInverseMatrix() {
-  try {
-    _inverseMatrix = _matrix.inverse();
-  } catch (const std::runtime_error& e) {
-    throw RaytracerException(std::string("Transform is non-invertible: ") +
-                             e.what());
+void Transform::compose(const Matrix& operation,
+                        const Matrix& operationInverse) {
+  // (O * M)^-1 = M^-1 * O^-1: no matrix is ever inverted
+  _matrix = operation * _matrix;
+  _inverseMatrix = _inverseMatrix * operationInverse;
+  updateCache();
+}
+
+void Transform::updateCache() {
+  for (int row = 0; row < 3; ++row) {
+    for (int col = 0; col < 4; ++col) {
+      _affine[row * 4 + col] = _matrix.at(row, col);
+    }
+    for (int col = 0; col < 3; ++col) {
+      _normalMatrix[row * 3 + col] = _inverseMatrix.at(col, row);
+    }
+  }
+
+  // Exact comparisons: a fast path must give the same result as the matrix
+  if (_matrix.at(3, 0) != 0.0 || _matrix.at(3, 1) != 0.0 ||
+      _matrix.at(3, 2) != 0.0 || _matrix.at(3, 3) != 1.0) {
+    _kind = TransformKind::PROJECTIVE;
+    return;
+  }
+  const double* m = _affine.data();
+  bool diagonal = m[1] == 0.0 && m[2] == 0.0 && m[4] == 0.0 && m[6] == 0.0 &&
+                  m[8] == 0.0 && m[9] == 0.0;
+  if (!diagonal || m[0] != m[5] || m[0] != m[10]) {
+    _kind = TransformKind::AFFINE;
+  } else if (m[0] != 1.0) {
+    _kind = TransformKind::UNIFORM_SCALE;
+  } else if (m[3] != 0.0 || m[7] != 0.0 || m[11] != 0.0) {
+    _kind = TransformKind::TRANSLATION;
+  } else {
+    _kind = TransformKind::IDENTITY;
   }
 }
 
@@ -17,13 +17,32 @@
 #ifndef TRANSFORM_HPP_
 #define TRANSFORM_HPP_
 
+#include <array>
+#include <cstdint>
 #include "Matrix.hpp"
 #include "Vector3D.hpp"
 
 namespace RayTracer {
 
+/**
+ * @brief Class of a transformation, from the cheapest to apply to the most
+ * expensive
+ */
+enum class TransformKind : uint8_t {
+  IDENTITY,       ///< Leaves every point in place
+  TRANSLATION,    ///< Translation only
+  UNIFORM_SCALE,  ///< Same scale on every axis, then a translation
+  AFFINE,         ///< Any other affine map, with rotations or shears
+  PROJECTIVE      ///< Last matrix row other than (0, 0, 0, 1)
+};
+
 /**
  * @brief Represents a 3D transformation (translation, rotation, scale)
+ *
+ * Besides the 4x4 matrices, every change precomputes their affine 3x4 rows,
+ * the normal matrix and the class of the transformation, so that applying
+ * it takes the shortest path: nothing for the identity, one addition per
+ * axis for a translation, and no homogeneous division unless projective.
  */
 class Transform {
  public:
@@ -94,6 +113,7 @@ class Transform {
    * @param y Scale factor along y-axis
    * @param z Scale factor along z-axis
    * @return Reference to this transform
+   * @throws RaytracerException if a factor is zero
    */
   Transform& scale(double x, double y, double z);
 
@@ -119,8 +139,7 @@ class Transform {
    *
    * Note that this method does not perform a mathematical inversion of the
    * matrix; it relies on the assumption that the inverse matrix is already
-   * maintained correctly during transformations via the updateInverseMatrix()
-   * method.
+   * maintained correctly during transformations via the compose() method.
    *
    * @return A new Transform representing the inverse of this transformation
    * @throws std::runtime_error if the matrix cannot be inverted
@@ -153,6 +172,18 @@ class Transform {
    */
   Vector3D applyToNormal(const Vector3D& normal) const;
 
+  /**
+   * @brief Get the class of this transformation
+   * @return The class selecting the fast path of the apply methods
+   */
+  TransformKind getKind() const;
+
+  /**
+   * @brief Check if this transformation keeps straight lines parallel
+   * @return true unless the transformation is projective
+   */
+  bool isAffine() const;
+
   /**
    * @brief Get the transformation matrix
    * @return The 4x4 transformation matrix
@@ -168,12 +199,27 @@ class Transform {
  private:
   Matrix _matrix;         ///< 4x4 transformation matrix
   Matrix _inverseMatrix;  ///< 4x4 inverse transformation matrix
+  std::array<double, 12> _affine;  ///< First three rows of _matrix
+  std::array<double, 9>
+      _normalMatrix;    ///< Transposed linear part of _inverseMatrix
+  TransformKind _kind;  ///< Class of _matrix, selects the apply path
+
+  /**
+   * @brief Apply an operation after the current transformation
+   *
+   * The inverse is composed from the inverse of the operation, known in
+   * closed form, instead of inverting the product.
+   *
+   * @param operation The matrix of the operation
+   * @param operationInverse The inverse of the operation
+   */
+  void compose(const Matrix& operation, const Matrix& operationInverse);
 
   /**
-   * @brief Update the inverse matrix
-   * Called after any operation that modifies the main matrix
+   * @brief Precompute the affine rows, normal matrix and class
+   * Called after any change of the matrices
    */
-  void updateInverseMatrix();
+  void updateCache();
 
   /**
    * @brief Performs homogeneous coordinate division if needed
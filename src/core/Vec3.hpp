@@ -0,0 +1,275 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Vec3 template header
+*/
+
+/**
+ * @file Vec3.hpp
+ * @brief Definition of the Vec3 template, the inline 3D vector math of the
+ * renderer in single or double precision
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#ifndef VEC3_HPP_
+#define VEC3_HPP_
+
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace RayTracer {
+
+/**
+ * @brief Floating point type of the scene geometry
+ *
+ * Double by default, float when the project is configured with
+ * RAYTRACER_FLOAT_PRECISION=ON.
+ */
+#if defined(RAYTRACER_FLOAT)
+using Real = float;
+#else
+using Real = double;
+#endif
+
+/**
+ * @brief 3D vector, point or normal of floating point components
+ *
+ * Every operation is defined in the header so that the compiler inlines it
+ * and keeps the components in registers. The special members are the
+ * implicit ones: the type is trivially copyable, it is passed and returned
+ * in registers and copied with plain moves. The three components are packed
+ * with no padding, so that arrays of vectors stay as compact as arrays of
+ * scalars.
+ *
+ * @tparam T float or double
+ */
+template <typename T>
+class Vec3 {
+  static_assert(std::is_floating_point_v<T>,
+                "Vec3 holds floating point components");
+
+ public:
+  using Scalar = T;  ///< Component type
+
+  /**
+   * @brief Default constructor
+   * Creates a vector at origin (0,0,0)
+   */
+  constexpr Vec3() : _x(0), _y(0), _z(0) {}
+
+  /**
+   * @brief Constructor with x, y, z coordinates
+   * @param x The x coordinate
+   * @param y The y coordinate
+   * @param z The z coordinate
+   */
+  constexpr Vec3(T x, T y, T z) : _x(x), _y(y), _z(z) {}
+
+  /**
+   * @brief Conversion from the other precision
+   * @param other The vector to convert, rounded to the nearest component
+   */
+  template <typename U>
+  constexpr explicit Vec3(const Vec3<U>& other)
+      : _x(static_cast<T>(other.getX())),
+        _y(static_cast<T>(other.getY())),
+        _z(static_cast<T>(other.getZ())) {}
+
+  /**
+   * @brief Get the X component
+   * @return The X coordinate
+   */
+  constexpr T getX() const { return _x; }
+
+  /**
+   * @brief Get the Y component
+   * @return The Y coordinate
+   */
+  constexpr T getY() const { return _y; }
+
+  /**
+   * @brief Get the Z component
+   * @return The Z coordinate
+   */
+  constexpr T getZ() const { return _z; }
+
+  /**
+   * @brief Set the X component
+   * @param x The new X coordinate
+   */
+  constexpr void setX(T x) { _x = x; }
+
+  /**
+   * @brief Set the Y component
+   * @param y The new Y coordinate
+   */
+  constexpr void setY(T y) { _y = y; }
+
+  /**
+   * @brief Set the Z component
+   * @param z The new Z coordinate
+   */
+  constexpr void setZ(T z) { _z = z; }
+
+  /**
+   * @brief Addition operator
+   * @param other The vector to add
+   * @return The sum of the two vectors
+   */
+  constexpr Vec3 operator+(const Vec3& other) const {
+    return Vec3(_x + other._x, _y + other._y, _z + other._z);
+  }
+
+  /**
+   * @brief Subtraction operator
+   * @param other The vector to subtract
+   * @return The difference of the two vectors
+   */
+  constexpr Vec3 operator-(const Vec3& other) const {
+    return Vec3(_x - other._x, _y - other._y, _z - other._z);
+  }
+
+  /**
+   * @brief Multiplication by a scalar
+   * @param scalar The scalar to multiply by
+   * @return The scaled vector
+   */
+  constexpr Vec3 operator*(T scalar) const {
+    return Vec3(_x * scalar, _y * scalar, _z * scalar);
+  }
+
+  /**
+   * @brief Division by a scalar
+   * @param scalar The scalar to divide by
+   * @return The scaled vector
+   * @throws std::runtime_error if the scalar is zero or near zero
+   */
+  constexpr Vec3 operator/(T scalar) const {
+    if (scalar < T(1e-10) && scalar > -T(1e-10)) {
+      throw std::runtime_error("Division by zero or near-zero in Vector3D");
+    }
+    return Vec3(_x / scalar, _y / scalar, _z / scalar);
+  }
+
+  /**
+   * @brief Negation operator
+   * @return The opposite vector
+   */
+  constexpr Vec3 operator-() const { return Vec3(-_x, -_y, -_z); }
+
+  /**
+   * @brief Dot product
+   * @param other The other vector
+   * @return The dot product of the two vectors
+   */
+  constexpr T dot(const Vec3& other) const {
+    return _x * other._x + _y * other._y + _z * other._z;
+  }
+
+  /**
+   * @brief Cross product
+   * @param other The other vector
+   * @return The vector perpendicular to both
+   */
+  constexpr Vec3 cross(const Vec3& other) const {
+    return Vec3(_y * other._z - _z * other._y, _z * other._x - _x * other._z,
+                _x * other._y - _y * other._x);
+  }
+
+  /**
+   * @brief Get the magnitude (length) of the vector
+   * @return The magnitude
+   */
+  T getMagnitude() const { return std::sqrt(getSquaredMagnitude()); }
+
+  /**
+   * @brief Get the squared magnitude of the vector
+   * @return The squared magnitude
+   */
+  constexpr T getSquaredMagnitude() const {
+    return _x * _x + _y * _y + _z * _z;
+  }
+
+  /**
+   * @brief Normalize the vector
+   * @return A normalized copy of this vector
+   * @throws std::runtime_error if the vector has zero magnitude
+   */
+  Vec3 normalized() const {
+    T magnitude = getMagnitude();
+
+    if (magnitude < T(1e-10)) {
+      throw std::runtime_error("Cannot normalize a vector with zero magnitude");
+    }
+    return Vec3(_x / magnitude, _y / magnitude, _z / magnitude);
+  }
+
+  /**
+   * @brief Check if two vectors are approximately equal
+   * @param other The vector to compare with
+   * @param epsilon The maximum allowed difference
+   * @return True if vectors are approximately equal
+   */
+  constexpr bool isEqual(const Vec3& other, T epsilon = T(1e-10)) const {
+    return distance(_x, other._x) < epsilon &&
+           distance(_y, other._y) < epsilon &&
+           distance(_z, other._z) < epsilon;
+  }
+
+  /**
+   * @brief Equality operator
+   * @param other The vector to compare with
+   * @return True if vectors are equal (uses default epsilon from isEqual)
+   */
+  constexpr bool operator==(const Vec3& other) const {
+    return isEqual(other);
+  }
+
+  /**
+   * @brief Inequality operator
+   * @param other The vector to compare with
+   * @return True if vectors are not equal (uses default epsilon from isEqual)
+   */
+  constexpr bool operator!=(const Vec3& other) const {
+    return !isEqual(other);
+  }
+
+ private:
+  T _x;  ///< The X coordinate
+  T _y;  ///< The Y coordinate
+  T _z;  ///< The Z coordinate
+
+  /**
+   * @brief Absolute difference of two components
+   * @param a First component
+   * @param b Second component
+   * @return |a - b|
+   */
+  static constexpr T distance(T a, T b) { return a > b ? a - b : b - a; }
+};
+
+/**
+ * @brief Output stream operator for Vec3
+ * @param os The output stream
+ * @param vector The vector to output
+ * @return The modified output stream
+ */
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const Vec3<T>& vector) {
+  os << "Vector3D(" << vector.getX() << ", " << vector.getY() << ", "
+     << vector.getZ() << ")";
+  return os;
+}
+
+static_assert(std::is_trivially_copyable_v<Vec3<float>>);
+static_assert(std::is_trivially_copyable_v<Vec3<double>>);
+static_assert(sizeof(Vec3<double>) == 3 * sizeof(double));
+
+}  // namespace RayTracer
+
+#endif /* !VEC3_HPP_ */
@@ -17,17 +17,13 @@
 #ifndef PPMDISPLAY_HPP_
 #define PPMDISPLAY_HPP_
 
-#include <atomic>
-#include <chrono>
 #include <functional>
-#include <memory>
-#include <mutex>
 #include <string>
-#include <vector>
 #include "../core/Color.hpp"
+#include "../core/RGB.hpp"
 #include "../core/RenderTile.hpp"
-#include "../core/ThreadPool.hpp"
 #include "../scene/Scene.hpp"
+#include "Renderer.hpp"
 
 namespace RayTracer {
 
@@ -36,6 +32,11 @@ namespace RayTracer {
  *
  * This class handles the conversion of a 3D scene to a 2D image
  * and saves it in the PPM (Portable Pixmap) format.
+ *
+ * Pixels are shaded and stored as linear RGB radiance by a Renderer that
+ * the display keeps: rendering again reuses its threads and buffers. They
+ * become bytes only when they are read or saved, through the tone map of
+ * the display.
  */
 class PPMDisplay {
  public:
@@ -69,6 +70,12 @@ class PPMDisplay {
 
   /**
    * @brief Render a specific tile of the image
+   *
+   * Takes no lock: tiles that do not overlap can be rendered at the same
+   * time from several threads, once the image has the resolution of the
+   * camera. A first tile, or one after a change of resolution, resizes the
+   * image; pixels out of the image are ignored.
+   *
    * @param scene The scene to render
    * @param tile The tile to render
    */
@@ -93,10 +100,18 @@ class PPMDisplay {
    * @brief Get the color at a specific pixel
    * @param x The x-coordinate of the pixel
    * @param y The y-coordinate of the pixel
-   * @return The color at that pixel
+   * @return The tone mapped color at that pixel
    */
   Color getPixel(int x, int y) const;
 
+  /**
+   * @brief Get the radiance stored at a specific pixel
+   * @param x The x-coordinate of the pixel
+   * @param y The y-coordinate of the pixel
+   * @return The linear radiance, black out of the image
+   */
+  RGB getRadiance(int x, int y) const;
+
   /**
    * @brief Set the color at a specific pixel
    * @param x The x-coordinate of the pixel
@@ -105,6 +120,14 @@ class PPMDisplay {
    */
   void setPixel(int x, int y, const Color& color);
 
+  /**
+   * @brief Set the radiance at a specific pixel
+   * @param x The x-coordinate of the pixel
+   * @param y The y-coordinate of the pixel
+   * @param radiance The linear radiance to store
+   */
+  void setPixel(int x, int y, const RGB& radiance);
+
   /**
    * @brief Get the width of the image
    * @return The width in pixels
@@ -128,36 +151,70 @@ class PPMDisplay {
    */
   void stopRendering();
 
- private:
-  std::vector<Color> _pixelBuffer;  ///< Buffer holding the pixel data
-  int _width;                       ///< Width of the image in pixels
-  int _height;                      ///< Height of the image in pixels
-  std::unique_ptr<ThreadPool>
-      _threadPool;  ///< Thread pool for parallel rendering
-  std::unique_ptr<TileManager> _tileManager;  ///< Manager for render tiles
-  std::mutex _bufferMutex;                    ///< Mutex for pixel buffer access
-  std::atomic<bool> _renderingActive;         ///< Flag to control rendering
-  std::chrono::steady_clock::time_point _startTime;  ///< Rendering start time
-
-  /**
-   * @brief Calculate the color for a pixel by tracing a ray through the scene
-   * @param scene The scene to render
-   * @param x The x-coordinate of the pixel
-   * @param y The y-coordinate of the pixel
-   * @return The calculated color
+  /**
+   * @brief Set how many primary rays of a tile row are traced together
+   * @param size 1 to trace rays one by one, or 4, 8 or 16 for packets
+   * @throw std::invalid_argument for any other size
+   * @see Scene::traceRays()
    */
-  Color calculatePixelColor(const Scene& scene, int x, int y) const;
+  void setPacketSize(int size);
 
   /**
-   * @brief Calculate lighting for an intersection point
-   * @param scene The scene containing the lights
-   * @param intersection The intersection data
-   * @return The calculated color including lighting effects
+   * @brief Get how many primary rays of a tile row are traced together
+   * @return The packet size, DEFAULT_PACKET_SIZE unless changed
    */
-  Color calculateLighting(const Scene& scene,
-                          const Intersection& intersection) const;
+  int getPacketSize() const;
 
-  Vector3D reflect(const Vector3D& incident, const Vector3D& normal) const;
+  /**
+   * @brief Set the curve mapping the radiance to the saved bytes
+   * @param toneMap The tone map
+   */
+  void setToneMap(ToneMap toneMap);
+
+  /**
+   * @brief Get the curve mapping the radiance to the saved bytes
+   * @return The tone map, ToneMap::CLAMP unless changed
+   */
+  ToneMap getToneMap() const;
+
+  /**
+   * @brief Set the order in which the tiles are rendered
+   * @param order The tile order, the image is the same for any of them
+   */
+  void setTileOrder(TileOrder order);
+
+  /**
+   * @brief Get the order in which the tiles are rendered
+   * @return The tile order, TileOrder::HILBERT unless changed
+   */
+  TileOrder getTileOrder() const;
+
+  /**
+   * @brief Set how many threads render, the calling one included
+   * @param count 1 renders on the calling thread only, 0 uses every core
+   * @throw std::invalid_argument if the count is negative
+   */
+  void setThreadCount(int count);
+
+  /**
+   * @brief Get how many threads render
+   * @return The thread count, 0 (every core) unless changed
+   */
+  int getThreadCount() const;
+
+  /**
+   * @brief Get the render engine of the display
+   * @return The renderer holding the image
+   */
+  Renderer& getRenderer();
+
+  static constexpr int DEFAULT_PACKET_SIZE =
+      RenderSettings::DEFAULT_PACKET_SIZE;  ///< Primary rays per packet
+
+ private:
+  Renderer _renderer;        ///< Threads, buffers and image of the renders
+  RenderSettings _settings;  ///< Options of the next frames
+  ToneMap _toneMap;          ///< Curve applied when the pixels become bytes
 };
 
 }  // namespace RayTracer
@@ -0,0 +1,571 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Renderer class implementation
+*/
+
+/**
+ * @file Renderer.cpp
+ * @brief Implementation of the render engine: tile scheduling on persistent
+ * threads, and the shading of the primary hits
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include "Renderer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include "../scene/lights/AmbientLight.hpp"
+
+namespace RayTracer {
+
+namespace {
+
+/**
+ * @brief Clamp a lighting factor to [0.0, 1.0]
+ *
+ * The scenes are tuned for factors that saturate at full intensity: a
+ * surface is never lit brighter than its own color by a single term.
+ */
+float saturate(double factor) {
+  return static_cast<float>(std::clamp(factor, 0.0, 1.0));
+}
+
+constexpr int MIN_TILE_SIZE = 16;             ///< Smallest tuned tile side
+constexpr int MAX_TILE_SIZE = 128;            ///< Largest tuned tile side
+constexpr int MIN_SPLIT_SIZE = 16;            ///< Sides never split
+constexpr int COST_CELL_SIZE = 16;            ///< Side of a cost map cell
+constexpr int MIN_TILES_PER_THREAD = 8;       ///< Tiles to balance with
+constexpr double SPLIT_COST_RATIO = 4.0;      ///< Cost of a hot spot tile
+constexpr double TARGET_TILE_SECONDS = 1e-3;  ///< Tuned time of a tile
+
+/**
+ * @brief Get the center of a cell of the cost map along one axis
+ * @param cell Index of the cell
+ * @param limit Size of the image along the axis, which clips the last cell
+ * @return The pixel coordinate of the center
+ */
+int cellCenter(int cell, int limit) {
+  return (cell * COST_CELL_SIZE +
+          std::min((cell + 1) * COST_CELL_SIZE, limit)) /
+         2;
+}
+
+/**
+ * @brief Get the first part of a side being split in two
+ * @return The side itself if it is too small to split, a multiple of 4 so
+ * that the packets keep their shape otherwise
+ */
+int splitSide(int side) {
+  return side > MIN_SPLIT_SIZE ? (side / 2 + 3) / 4 * 4 : side;
+}
+
+/**
+ * @brief Choose the tile side from the measured cost of a frame
+ *
+ * The smallest power of two whose tiles take TARGET_TILE_SECONDS, so that
+ * handing out a tile stays cheap, shrunk until every thread has
+ * MIN_TILES_PER_THREAD tiles to balance the load with.
+ *
+ * @param secondsPerPixel Average shading time of a pixel
+ * @param width Width of the image
+ * @param height Height of the image
+ * @param threads Number of rendering threads
+ * @return The tile side
+ */
+int tuneTileSize(double secondsPerPixel, int width, int height,
+                 int threads) {
+  auto tiles = [width, height](int size) {
+    return ((width + size - 1) / size) * ((height + size - 1) / size);
+  };
+  int size = MIN_TILE_SIZE;
+  while (size < MAX_TILE_SIZE &&
+         secondsPerPixel * size * size < TARGET_TILE_SECONDS) {
+    size *= 2;
+  }
+  while (size > MIN_TILE_SIZE && tiles(size) < MIN_TILES_PER_THREAD * threads) {
+    size /= 2;
+  }
+  return size;
+}
+
+}  // namespace
+
+void RenderSettings::validate() const {
+  if (packetSize != 1 && packetSize != 4 && packetSize != 8 &&
+      packetSize != 16) {
+    throw std::invalid_argument("Packet size must be 1, 4, 8 or 16, got " +
+                                std::to_string(packetSize));
+  }
+  if (tileSize < 0) {
+    throw std::invalid_argument(
+        "Tile size must be positive, or AUTO_TILE_SIZE, got " +
+        std::to_string(tileSize));
+  }
+}
+
+Renderer::Renderer(int threadCount)
+    : _framebuffer(),
+      _width(0),
+      _height(0),
+      _threadCount(0),
+      _threadPool(nullptr),
+      _scratch(),
+      _tileManager(nullptr),
+      _tileSize(0),
+      _renderingActive(true),
+      _reporting(false),
+      _tilesStarted(0),
+      _splitTiles(0),
+      _costMap(),
+      _costColumns(0),
+      _meanCost(0.0),
+      _tunedTileSize(RenderSettings::DEFAULT_TILE_SIZE),
+      _stats() {
+  setThreadCount(threadCount);
+}
+
+Renderer::~Renderer() {
+  stop();
+}
+
+bool Renderer::renderFrame(const Scene& scene,
+                           const RenderSettings& settings) {
+  settings.validate();
+  if (_scratch.empty()) {
+    createThreadPool();
+  }
+  const Camera& camera = scene.getCamera();
+  int tileSize = settings.tileSize == RenderSettings::AUTO_TILE_SIZE
+                     ? _tunedTileSize
+                     : settings.tileSize;
+  prepareFrame(camera.getWidth(), camera.getHeight(), tileSize,
+               settings.tileOrder);
+  for (Scratch& scratch : _scratch) {
+    scratch.timings.clear();
+    scratch.busySeconds = 0.0;
+  }
+
+  _renderingActive = true;
+  _reporting = false;
+  _tilesStarted = 0;
+  _splitTiles = 0;
+  _startTime = std::chrono::steady_clock::now();
+  _lastReport = _startTime;
+
+  // Every thread takes the next tile of the list from the shared cursor of
+  // the tile manager: the tiles start in the order of the list, and those
+  // rendered at the same time are neighbours along it
+  auto renderTiles = [this, &scene, &settings](std::size_t, std::size_t) {
+    while (_renderingActive) {
+      const RenderTile* tile = _tileManager->getNextTile();
+      if (tile == nullptr) {
+        return;
+      }
+      _tilesStarted.fetch_add(1, std::memory_order_relaxed);
+      renderAdaptive(scene, *tile, settings);
+      _tileManager->tileCompleted();
+      if (settings.progress) {
+        reportProgress(settings.progress);
+      }
+    }
+  };
+  if (!_threadPool) {
+    renderTiles(0, 1);
+  } else {
+    // One loop per thread, each one running until the list is exhausted.
+    // The pixels of every tile are visible to the caller once parallelFor()
+    // returned
+    _threadPool->parallelFor(0, _scratch.size(), 1, renderTiles);
+  }
+
+  if (!_renderingActive) {
+    return false;
+  }
+  finishFrame(std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                            _startTime)
+                  .count());
+  if (settings.progress) {
+    settings.progress(100.0, 0.0);
+  }
+  return true;
+}
+
+void Renderer::stop() {
+  _renderingActive = false;
+}
+
+void Renderer::setThreadCount(int count) {
+  if (count < 0) {
+    throw std::invalid_argument("Thread count must be positive, got " +
+                                std::to_string(count));
+  }
+  if (count != _threadCount) {
+    // The next frame starts the new workers
+    _threadCount = count;
+    _threadPool.reset();
+    _scratch.clear();
+  }
+}
+
+int Renderer::getThreadCount() const {
+  return _threadCount;
+}
+
+int Renderer::getWidth() const {
+  return _width;
+}
+
+int Renderer::getHeight() const {
+  return _height;
+}
+
+const FrameStats& Renderer::getFrameStats() const {
+  return _stats;
+}
+
+int Renderer::getTunedTileSize() const {
+  return _tunedTileSize;
+}
+
+const std::vector<RGB>& Renderer::getFramebuffer() const {
+  return _framebuffer;
+}
+
+RGB Renderer::getRadiance(int x, int y) const {
+  if (x < 0 || x >= _width || y < 0 || y >= _height) {
+    return RGB();  // Return black for out-of-bounds pixels
+  }
+  return _framebuffer[y * _width + x];
+}
+
+void Renderer::setRadiance(int x, int y, const RGB& radiance) {
+  if (x < 0 || x >= _width || y < 0 || y >= _height) {
+    return;  // Ignore out-of-bounds pixels
+  }
+  _framebuffer[y * _width + x] = radiance;
+}
+
+void Renderer::clear(const RGB& radiance) {
+  std::fill(_framebuffer.begin(), _framebuffer.end(), radiance);
+}
+
+void Renderer::renderTile(const Scene& scene, const RenderTile& tile,
+                          int packetSize) {
+  // Outside a frame the framebuffer may not have the camera's resolution
+  // yet, and the tile may reach out of the image
+  const Camera& camera = scene.getCamera();
+  resizeFramebuffer(camera.getWidth(), camera.getHeight());
+  int startX = std::max(tile.getStartX(), 0);
+  int startY = std::max(tile.getStartY(), 0);
+  int endX = std::min(tile.getEndX(), _width);
+  int endY = std::min(tile.getEndY(), _height);
+  if (startX >= endX || startY >= endY) {
+    return;
+  }
+  Scratch scratch;
+  renderTile(scene, RenderTile(startX, startY, endX - startX, endY - startY),
+             packetSize, scratch);
+}
+
+void Renderer::createThreadPool() {
+  // The rendering thread takes part in the loop: one worker less than asked
+  if (_threadCount != 1) {
+    _threadPool = std::make_unique<ThreadPool>(
+        _threadCount == 0 ? 0 : static_cast<size_t>(_threadCount - 1));
+  }
+  _scratch = std::vector<Scratch>(_threadPool ? _threadPool->size() + 1 : 1);
+}
+
+void Renderer::prepareFrame(int width, int height, int tileSize,
+                            TileOrder order) {
+  bool resized = resizeFramebuffer(width, height);
+  if (!_tileManager || resized || tileSize != _tileSize ||
+      order != _tileManager->getOrder()) {
+    _tileManager =
+        std::make_unique<TileManager>(width, height, tileSize, order);
+    _tileSize = tileSize;
+  } else {
+    _tileManager->reset();
+  }
+}
+
+bool Renderer::resizeFramebuffer(int width, int height) {
+  if (width == _width && height == _height) {
+    return false;
+  }
+  _width = width;
+  _height = height;
+  _framebuffer.resize(static_cast<std::size_t>(width) * height);
+  // The costs measured at another resolution no longer match the pixels
+  _costMap.clear();
+  return true;
+}
+
+void Renderer::renderAdaptive(const Scene& scene, const RenderTile& tile,
+                              const RenderSettings& settings) {
+  if (!shouldSplit(tile, settings)) {
+    Scratch& scratch = threadScratch();
+    auto start = std::chrono::steady_clock::now();
+    renderTile(scene, tile, settings.packetSize, scratch);
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+    scratch.timings.emplace_back(tile, seconds);
+    scratch.busySeconds += seconds;
+    return;
+  }
+
+  // Two or four parts: the nested loop posts them as tasks that idle
+  // threads take, this one working on them too
+  _splitTiles.fetch_add(1, std::memory_order_relaxed);
+  int width = splitSide(tile.getWidth());
+  int height = splitSide(tile.getHeight());
+  int columns = width < tile.getWidth() ? 2 : 1;
+  int rows = height < tile.getHeight() ? 2 : 1;
+  auto part = [&](int index) {
+    int column = index % columns;
+    int row = index / columns;
+    return RenderTile(tile.getStartX() + column * width,
+                      tile.getStartY() + row * height,
+                      column == 0 ? width : tile.getWidth() - width,
+                      row == 0 ? height : tile.getHeight() - height);
+  };
+  _threadPool->parallelFor(
+      0, static_cast<std::size_t>(columns * rows), 1,
+      [&](std::size_t first, std::size_t last) {
+        for (std::size_t index = first; index < last; ++index) {
+          renderAdaptive(scene, part(static_cast<int>(index)), settings);
+        }
+      });
+}
+
+bool Renderer::shouldSplit(const RenderTile& tile,
+                           const RenderSettings& settings) const {
+  if (!settings.splitTiles || !_threadPool ||
+      std::max(tile.getWidth(), tile.getHeight()) <= MIN_SPLIT_SIZE) {
+    return false;
+  }
+  // The last tiles of the frame: some threads would have nothing to do
+  int left = _tileManager->getTotalTiles() -
+             _tilesStarted.load(std::memory_order_relaxed);
+  if (left < static_cast<int>(_scratch.size())) {
+    return true;
+  }
+  // A hot spot of the previous frame, that would finish last
+  return costRatio(tile) > SPLIT_COST_RATIO;
+}
+
+double Renderer::costRatio(const RenderTile& tile) const {
+  if (_costMap.empty() || _meanCost <= 0.0) {
+    return 0.0;
+  }
+  double sum = 0.0;
+  int cells = 0;
+  for (int row = tile.getStartY() / COST_CELL_SIZE;
+       row <= (tile.getEndY() - 1) / COST_CELL_SIZE; ++row) {
+    for (int column = tile.getStartX() / COST_CELL_SIZE;
+         column <= (tile.getEndX() - 1) / COST_CELL_SIZE; ++column) {
+      sum += _costMap[row * _costColumns + column];
+      ++cells;
+    }
+  }
+  return sum / cells / _meanCost;
+}
+
+void Renderer::finishFrame(double seconds) {
+  // Each cell takes the cost of the tile holding its center: the tiles
+  // cover the image once, so every cell is written once
+  _costColumns = (_width + COST_CELL_SIZE - 1) / COST_CELL_SIZE;
+  int costRows = (_height + COST_CELL_SIZE - 1) / COST_CELL_SIZE;
+  _costMap.assign(static_cast<std::size_t>(_costColumns) * costRows, 0.0f);
+  double busySeconds = 0.0;
+  for (const Scratch& scratch : _scratch) {
+    busySeconds += scratch.busySeconds;
+    for (const auto& [tile, tileSeconds] : scratch.timings) {
+      float cost = static_cast<float>(
+          tileSeconds / (tile.getWidth() * tile.getHeight()));
+      for (int row = tile.getStartY() / COST_CELL_SIZE;
+           row <= (tile.getEndY() - 1) / COST_CELL_SIZE; ++row) {
+        int centerY = cellCenter(row, _height);
+        for (int column = tile.getStartX() / COST_CELL_SIZE;
+             column <= (tile.getEndX() - 1) / COST_CELL_SIZE; ++column) {
+          int centerX = cellCenter(column, _width);
+          if (centerX >= tile.getStartX() && centerX < tile.getEndX() &&
+              centerY >= tile.getStartY() && centerY < tile.getEndY()) {
+            _costMap[row * _costColumns + column] = cost;
+          }
+        }
+      }
+    }
+  }
+
+  int threads = static_cast<int>(_scratch.size());
+  double pixels = static_cast<double>(_width) * _height;
+  _meanCost = pixels > 0.0 ? busySeconds / pixels : 0.0;
+  _tunedTileSize = tuneTileSize(_meanCost, _width, _height, threads);
+
+  _stats.tileSize = _tileSize;
+  _stats.tiles = _tileManager->getTotalTiles();
+  _stats.splitTiles = _splitTiles.load();
+  _stats.seconds = seconds;
+  _stats.busySeconds = busySeconds;
+  _stats.utilization =
+      seconds > 0.0 ? busySeconds / (seconds * threads) : 0.0;
+}
+
+Renderer::Scratch& Renderer::threadScratch() {
+  // Workers get their own slot, the thread that renders the frame the last
+  return _threadPool ? _scratch[_threadPool->workerIndex()] : _scratch[0];
+}
+
+void Renderer::renderTile(const Scene& scene, const RenderTile& tile,
+                          int packetSize, Scratch& scratch) {
+  if (!_renderingActive) {
+    return;
+  }
+
+  // Trace the tile in packets of neighbouring pixels, 4x4 for 16 rays,
+  // into a buffer of the tile that no other thread touches
+  int blockWidth = 1;
+  while (blockWidth * blockWidth < packetSize) {
+    blockWidth *= 2;
+  }
+  int blockHeight = packetSize / blockWidth;
+  int width = tile.getWidth();
+  int blocksX = (width + blockWidth - 1) / blockWidth;
+  int blocksY = (tile.getHeight() + blockHeight - 1) / blockHeight;
+  uint32_t side = 1;
+  while (side < static_cast<uint32_t>(std::max(blocksX, blocksY))) {
+    side *= 2;
+  }
+
+  // Visit the blocks along a Morton curve: each one is next to the
+  // previous, and their rays meet the same nodes of the scene
+  const Camera& camera = scene.getCamera();
+  scratch.pixels.resize(static_cast<std::size_t>(width) * tile.getHeight());
+  for (uint32_t code = 0; code < side * side; ++code) {
+    uint32_t blockX = 0;
+    uint32_t blockY = 0;
+    mortonDecode(code, blockX, blockY);
+    if (blockX >= static_cast<uint32_t>(blocksX) ||
+        blockY >= static_cast<uint32_t>(blocksY)) {
+      continue;
+    }
+    if (!_renderingActive) {
+      return;
+    }
+
+    int x = tile.getStartX() + static_cast<int>(blockX) * blockWidth;
+    int y = tile.getStartY() + static_cast<int>(blockY) * blockHeight;
+    int columns = std::min(blockWidth, tile.getEndX() - x);
+    int rows = std::min(blockHeight, tile.getEndY() - y);
+    camera.generateRays(x, y, columns, rows, scratch.rays);
+    scene.traceRays(scratch.rays, scratch.hits);
+
+    RGB* block = scratch.pixels.data() + (y - tile.getStartY()) * width +
+                 (x - tile.getStartX());
+    for (int i = 0; i < columns * rows; ++i) {
+      block[i / columns * width + i % columns] =
+          scratch.hits[i] ? calculateLighting(scene, *scratch.hits[i])
+                          : RGB();
+    }
+  }
+
+  // Tiles never overlap: their rows are copied without a lock
+  for (int y = tile.getStartY(); y < tile.getEndY(); ++y) {
+    std::copy_n(scratch.pixels.data() + (y - tile.getStartY()) * width,
+                width, _framebuffer.begin() + y * _width + tile.getStartX());
+  }
+}
+
+void Renderer::reportProgress(
+    const std::function<void(double, double)>& progress) {
+  // A thread finding another one reporting skips the report, never waits
+  if (_reporting.exchange(true, std::memory_order_acquire)) {
+    return;
+  }
+  auto now = std::chrono::steady_clock::now();
+  if (now - _lastReport >= PROGRESS_INTERVAL) {
+    int totalTiles = _tileManager->getTotalTiles();
+    int completed = _tileManager->getCompletedTiles();
+    double elapsed = std::chrono::duration<double>(now - _startTime).count();
+    progress(100.0 * completed / totalTiles,
+             elapsed * (totalTiles - completed) / completed);
+    _lastReport = now;
+  }
+  _reporting.store(false, std::memory_order_release);
+}
+
+RGB Renderer::calculateLighting(const Scene& scene,
+                                const Intersection& intersection) const {
+  float ambientIntensity = saturate(scene.getAmbientLightIntensity());
+  RGB baseColor(intersection.color);
+
+  RGB ambientColor(1.0f, 1.0f, 1.0f);
+  for (const auto& light : scene.getLights()) {
+    if (auto ambient = std::dynamic_pointer_cast<AmbientLight>(light)) {
+      ambientColor = RGB(ambient->getColor());
+      break;
+    }
+  }
+
+  RGB resultColor = baseColor * ambientColor * ambientIntensity;
+
+  Vector3D viewDir =
+      (scene.getCamera().getPosition() - intersection.point).normalized();
+
+  const double specularStrength = 1.2;
+  const double shininess = 24.0;
+
+  for (const auto& light : scene.getLights()) {
+    if (scene.isInShadow(intersection.point, light)) {
+      continue;
+    }
+
+    Vector3D lightDir = light->getDirectionFrom(intersection.point);
+    double intensity = light->getIntensityAt(intersection.point);
+
+    if (std::dynamic_pointer_cast<AmbientLight>(light)) {
+      continue;
+    }
+
+    // Calculate diffuse lighting (Lambert's law)
+    double diffuseFactor =
+        std::max<double>(0.0, intersection.normal.dot(lightDir));
+    diffuseFactor *= scene.getDiffuseMultiplier() * intensity *
+                     1.5;  // Multiplied by 1.5 for stronger diffuse
+
+    // Lights are brightened by 1.2, up to full intensity
+    RGB lightColor = (RGB(light->getColor()) * 1.2f).clamped();
+
+    RGB diffuseColor = baseColor * lightColor * saturate(diffuseFactor);
+
+    // Add diffuse component to the result
+    resultColor += diffuseColor;
+
+    // Calculate specular (Phong model)
+    Vector3D reflectDir = reflect(-lightDir, intersection.normal);
+    double spec =
+        std::pow(std::max<double>(0.0, viewDir.dot(reflectDir)), shininess);
+
+    RGB specular =
+        lightColor * saturate(specularStrength * spec * intensity * 1.8);
+
+    // Add specular component to the result
+    resultColor += specular;
+  }
+
+  return resultColor;
+}
+
+Vector3D Renderer::reflect(const Vector3D& incident,
+                           const Vector3D& normal) const {
+  return incident - normal * 2.0 * incident.dot(normal);
+}
+
+}  // namespace RayTracer
@@ -0,0 +1,353 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Renderer class header
+*/
+
+/**
+ * @file Renderer.hpp
+ * @brief Defines the Renderer class, a long-lived render engine that keeps
+ * its threads, framebuffer and scratch memory from one frame to the next
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#ifndef RENDERER_HPP_
+#define RENDERER_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+#include "../core/RGB.hpp"
+#include "../core/Ray.hpp"
+#include "../core/RenderTile.hpp"
+#include "../core/ThreadPool.hpp"
+#include "../scene/Scene.hpp"
+
+namespace RayTracer {
+
+/**
+ * @brief Options of one frame
+ */
+struct RenderSettings {
+  static constexpr int DEFAULT_PACKET_SIZE = 16;  ///< Primary rays per packet
+  static constexpr int DEFAULT_TILE_SIZE = 64;    ///< Tile side in pixels
+  static constexpr int AUTO_TILE_SIZE = 0;        ///< Tuned from the timings
+
+  int packetSize = DEFAULT_PACKET_SIZE;      ///< 1, 4, 8 or 16 rays per packet
+  TileOrder tileOrder = TileOrder::HILBERT;  ///< Order the tiles start in
+
+  /**
+   * @brief Side of the square tiles
+   *
+   * AUTO_TILE_SIZE uses DEFAULT_TILE_SIZE for the first frame, then the
+   * size tuned from the cost measured on the previous frame.
+   */
+  int tileSize = AUTO_TILE_SIZE;
+
+  /**
+   * @brief Split expensive tiles into sub-tiles that idle threads steal
+   *
+   * A tile is split when fewer tiles are left than threads, or when it
+   * cost several times the average on the previous frame. The image is
+   * the same either way.
+   */
+  bool splitTiles = true;
+
+  /**
+   * @brief Called with the progress percentage and the remaining seconds
+   *
+   * Runs on a rendering thread, at most every PROGRESS_INTERVAL and never on
+   * two threads at once. Empty for no report.
+   */
+  std::function<void(double, double)> progress;
+
+  /**
+   * @brief Check the settings
+   * @throw std::invalid_argument if the packet size or tile size is invalid
+   */
+  void validate() const;
+};
+
+/**
+ * @brief Measures of the last frame
+ */
+struct FrameStats {
+  int tileSize = 0;          ///< Side of the tiles of the frame
+  int tiles = 0;             ///< Number of tiles
+  int splitTiles = 0;        ///< Tiles and sub-tiles split for idle threads
+  double seconds = 0.0;      ///< Wall time of the frame
+  double busySeconds = 0.0;  ///< Time spent shading, summed over threads
+  double utilization = 0.0;  ///< busySeconds over seconds times the threads
+};
+
+/**
+ * @brief Renders scenes into a framebuffer of linear radiance
+ *
+ * The worker threads, the tile manager, the framebuffer and the buffers
+ * each thread shades into are created by the first frame and kept for the
+ * next ones: rendering the same resolution again allocates nothing and
+ * starts no thread. Saving or displaying the image is left to the caller.
+ */
+class Renderer {
+ public:
+  /**
+   * @brief Constructor
+   * @param threadCount Threads rendering a frame, the calling one included;
+   * 0 for one per core
+   * @throw std::invalid_argument if the thread count is negative
+   */
+  explicit Renderer(int threadCount = 0);
+
+  /**
+   * @brief Destructor, stops the frame in progress and joins the workers
+   */
+  ~Renderer();
+
+  Renderer(const Renderer&) = delete;
+  Renderer& operator=(const Renderer&) = delete;
+
+  /**
+   * @brief Render a frame of a scene at the resolution of its camera
+   * @param scene The scene to render
+   * @param settings Options of the frame
+   * @return true if the frame is complete, false if stop() interrupted it
+   * @throw std::invalid_argument if the settings are invalid
+   */
+  bool renderFrame(const Scene& scene,
+                   const RenderSettings& settings = RenderSettings());
+
+  /**
+   * @brief Interrupt the frame in progress, from any thread
+   *
+   * The threads are kept for the next frame.
+   */
+  void stop();
+
+  /**
+   * @brief Set how many threads render, the calling one included
+   *
+   * The workers are replaced, by the next frame, only if the count changes.
+   *
+   * @param count 1 renders on the calling thread only, 0 uses every core
+   * @throw std::invalid_argument if the count is negative
+   */
+  void setThreadCount(int count);
+
+  /**
+   * @brief Get how many threads render
+   * @return The thread count, 0 meaning one per core
+   */
+  int getThreadCount() const;
+
+  /**
+   * @brief Get the measures of the last complete frame
+   * @return The frame statistics, zero before the first frame
+   */
+  const FrameStats& getFrameStats() const;
+
+  /**
+   * @brief Get the tile size of the next frame with AUTO_TILE_SIZE
+   * @return The tile side, tuned so that a tile takes about a millisecond
+   * while every thread gets several tiles
+   */
+  int getTunedTileSize() const;
+
+  /**
+   * @brief Get the width of the framebuffer
+   * @return The width in pixels, 0 before the first frame
+   */
+  int getWidth() const;
+
+  /**
+   * @brief Get the height of the framebuffer
+   * @return The height in pixels, 0 before the first frame
+   */
+  int getHeight() const;
+
+  /**
+   * @brief Get the radiance of every pixel, row by row
+   * @return The framebuffer
+   */
+  const std::vector<RGB>& getFramebuffer() const;
+
+  /**
+   * @brief Get the radiance of a pixel
+   * @param x The x-coordinate of the pixel
+   * @param y The y-coordinate of the pixel
+   * @return The linear radiance, black out of the image
+   */
+  RGB getRadiance(int x, int y) const;
+
+  /**
+   * @brief Set the radiance of a pixel
+   * @param x The x-coordinate of the pixel
+   * @param y The y-coordinate of the pixel
+   * @param radiance The radiance, ignored out of the image
+   */
+  void setRadiance(int x, int y, const RGB& radiance);
+
+  /**
+   * @brief Fill the framebuffer with one radiance
+   * @param radiance The radiance
+   */
+  void clear(const RGB& radiance = RGB());
+
+  /**
+   * @brief Render one tile into the framebuffer
+   *
+   * The tile is traced in blocks of one packet, as square as the packet
+   * size allows, visited along a Morton curve. Takes no lock and shades
+   * into buffers of its own: tiles that do not overlap can be rendered at
+   * the same time from several threads. The framebuffer is first resized
+   * to the camera if its resolution differs, which must not happen while
+   * other tiles render; the part of the tile out of the image is skipped.
+   *
+   * @param scene The scene to render
+   * @param tile The tile to render
+   * @param packetSize Primary rays traced together
+   */
+  void renderTile(const Scene& scene, const RenderTile& tile,
+                  int packetSize = RenderSettings::DEFAULT_PACKET_SIZE);
+
+  /**
+   * @brief Shortest delay between two progress reports
+   */
+  static constexpr std::chrono::milliseconds PROGRESS_INTERVAL{100};
+
+ private:
+  /**
+   * @brief Memory a thread reuses for every tile it shades
+   *
+   * Aligned so that two threads never write to the same cache line.
+   */
+  struct alignas(64) Scratch {
+    std::vector<RGB> pixels;                        ///< Radiance of the tile
+    std::vector<Ray> rays;                          ///< Rays of a packet
+    std::vector<std::optional<Intersection>> hits;  ///< Their closest hits
+    std::vector<std::pair<RenderTile, double>>
+        timings;               ///< Seconds of each tile shaded in the frame
+    double busySeconds = 0.0;  ///< Their sum
+  };
+
+  std::vector<RGB> _framebuffer;  ///< Linear radiance of every pixel
+  int _width;                     ///< Width of the framebuffer in pixels
+  int _height;                    ///< Height of the framebuffer in pixels
+  int _threadCount;               ///< Rendering threads, 0 for one per core
+  std::unique_ptr<ThreadPool> _threadPool;  ///< Workers, none for one thread
+  std::vector<Scratch> _scratch;  ///< One per worker, then the caller's
+  std::unique_ptr<TileManager> _tileManager;  ///< Tiles of the frame
+  int _tileSize;                              ///< Tile side of _tileManager
+  std::atomic<bool> _renderingActive;         ///< Cleared by stop()
+  std::atomic<bool> _reporting;  ///< Held by the thread reporting progress
+  std::chrono::steady_clock::time_point _startTime;   ///< Frame start
+  std::chrono::steady_clock::time_point _lastReport;  ///< Last report time
+
+  std::atomic<int> _tilesStarted;  ///< Tiles of the frame handed out
+  std::atomic<int> _splitTiles;    ///< Tiles of the frame split
+  std::vector<float> _costMap;     ///< Seconds per pixel of each cost cell
+  int _costColumns;                ///< Cost cells along X
+  double _meanCost;                ///< Seconds per pixel of the image
+  int _tunedTileSize;              ///< Tile side of the next auto frame
+  FrameStats _stats;               ///< Measures of the last frame
+
+  /**
+   * @brief Create the workers and their scratch memory for the thread count,
+   * on the first frame after a change of the count
+   */
+  void createThreadPool();
+
+  /**
+   * @brief Size the framebuffer and the tile manager for a frame
+   * @param width Width of the frame
+   * @param height Height of the frame
+   * @param tileSize Side of the tiles
+   * @param order Order of the tiles
+   */
+  void prepareFrame(int width, int height, int tileSize, TileOrder order);
+
+  /**
+   * @brief Resize the framebuffer if the resolution changes
+   * @param width Width of the image
+   * @param height Height of the image
+   * @return true if the framebuffer was resized
+   */
+  bool resizeFramebuffer(int width, int height);
+
+  /**
+   * @brief Render a tile, or split it and render its parts in parallel
+   * @param scene The scene to render
+   * @param tile The tile or sub-tile
+   * @param settings Options of the frame
+   */
+  void renderAdaptive(const Scene& scene, const RenderTile& tile,
+                      const RenderSettings& settings);
+
+  /**
+   * @brief Check if a tile is worth splitting for the idle threads
+   * @param tile The tile or sub-tile
+   * @param settings Options of the frame
+   * @return true if its parts should be rendered in parallel
+   */
+  bool shouldSplit(const RenderTile& tile,
+                   const RenderSettings& settings) const;
+
+  /**
+   * @brief Get the cost of a tile relative to the average, from the
+   * previous frame
+   * @param tile The tile
+   * @return The ratio, 0 without a previous frame at this resolution
+   */
+  double costRatio(const RenderTile& tile) const;
+
+  /**
+   * @brief Gather the tile timings of a complete frame into the cost map,
+   * the statistics and the tuned tile size
+   * @param seconds Wall time of the frame
+   */
+  void finishFrame(double seconds);
+
+  /**
+   * @brief Get the scratch memory of the calling thread
+   * @return The scratch memory, the caller's outside the workers
+   */
+  Scratch& threadScratch();
+
+  /**
+   * @brief Render one tile into the framebuffer through scratch memory
+   * @param scene The scene to render
+   * @param tile The tile to render
+   * @param packetSize Primary rays traced together
+   * @param scratch Buffers of the calling thread
+   */
+  void renderTile(const Scene& scene, const RenderTile& tile, int packetSize,
+                  Scratch& scratch);
+
+  /**
+   * @brief Report the progress, unless another thread is or did recently
+   * @param progress The progress callback
+   */
+  void reportProgress(const std::function<void(double, double)>& progress);
+
+  /**
+   * @brief Calculate lighting for an intersection point
+   * @param scene The scene containing the lights
+   * @param intersection The intersection data
+   * @return The linear radiance including lighting effects
+   */
+  RGB calculateLighting(const Scene& scene,
+                        const Intersection& intersection) const;
+
+  Vector3D reflect(const Vector3D& incident, const Vector3D& normal) const;
+};
+
+}  // namespace RayTracer
+
+#endif /* !RENDERER_HPP_ */
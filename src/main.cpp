@@ -23,6 +23,7 @@
 #include "display/SFMLDisplay.hpp"
 #include "scene/Scene.hpp"
 #include "scene/SceneBuilder.hpp"
+#include "scene/acceleration/BVHCache.hpp"
 #include "scene/lights/LightFactory.hpp"
 #include "scene/parser/SceneParser.hpp"
 #include "scene/primitives/PrimitiveFactory.hpp"
@@ -32,6 +33,22 @@ void usage() {
   std::cout << "SCENE_FILE: scene configuration" << std::endl;
   std::cout << "OPTIONS:" << std::endl;
   std::cout << "  --display, -d    Display render in SFML window" << std::endl;
+  std::cout << "  --accelerator <auto|bvh|bvh4|grid>" << std::endl;
+  std::cout << "                   Acceleration structure, overrides the "
+            << "scene file" << std::endl;
+  std::cout << "  --no-cache       Always build the acceleration structure"
+            << std::endl;
+  std::cout << "  --packet <1|4|8|16>" << std::endl;
+  std::cout << "                   Primary rays traced together, 1 traces "
+            << "them one by one;" << std::endl;
+  std::cout << "                   the grid always traces them one by one"
+            << std::endl;
+  std::cout << "  --tonemap <clamp|reinhard>" << std::endl;
+  std::cout << "                   Curve mapping the rendered light to the "
+            << "image, clamp by default" << std::endl;
+  std::cout << "  --tiles <raster|hilbert|spiral>" << std::endl;
+  std::cout << "                   Order the tiles are rendered in, hilbert "
+            << "by default" << std::endl;
 }
 
 bool hasDisplayFlag(int argc, char** argv) {
@@ -44,17 +61,41 @@ bool hasDisplayFlag(int argc, char** argv) {
   return false;
 }
 
+bool hasNoCacheFlag(int argc, char** argv) {
+  for (int i = 1; i < argc; i++) {
+    if (std::string(argv[i]) == "--no-cache") {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::string getOptionValue(int argc, char** argv, const std::string& option) {
+  for (int i = 1; i + 1 < argc; i++) {
+    if (argv[i] == option) {
+      return argv[i + 1];
+    }
+  }
+  return "";
+}
+
 std::string getSceneFilePath(int argc, char** argv) {
   for (int i = 1; i < argc; i++) {
     std::string arg = argv[i];
-    if (arg != "--display" && arg != "-d" && arg != "--help") {
+    if (arg == "--accelerator" || arg == "--packet" || arg == "--tonemap" ||
+        arg == "--tiles") {
+      i++;
+    } else if (arg != "--display" && arg != "-d" && arg != "--help" &&
+               arg != "--no-cache") {
       return arg;
     }
   }
   return "";
 }
 
-RayTracer::Scene buildSceneFromFile(const std::string& filePath) {
+RayTracer::Scene buildSceneFromFile(const std::string& filePath,
+                                    const std::string& accelerator,
+                                    bool useCache) {
   libconfig::Config cfg;
   cfg.readFile(filePath.c_str());
 
@@ -62,6 +103,28 @@ RayTracer::Scene buildSceneFromFile(const std::string& filePath) {
   RayTracer::SceneBuilder builder;
   RayTracer::SceneParser parser;
 
+  // The command line choice wins over the scene file one
+  std::string acceleratorName = accelerator;
+  if (acceleratorName.empty()) {
+    cfg.lookupValue("accelerator", acceleratorName);
+  }
+  RayTracer::AcceleratorType acceleratorType = RayTracer::AcceleratorType::AUTO;
+  if (!acceleratorName.empty()) {
+    acceleratorType = RayTracer::parseAcceleratorType(acceleratorName);
+  }
+  builder.withAccelerator(acceleratorType);
+
+  // Named after the scene contents: an edited scene never reads a stale file.
+  // AUTO only caches when it resolves to a binary BVH, the grid is rebuilt
+  if (useCache) {
+    RayTracer::AcceleratorType cachedType =
+        acceleratorType == RayTracer::AcceleratorType::AUTO
+            ? RayTracer::AcceleratorType::BVH
+            : acceleratorType;
+    builder.withAccelerationCache(RayTracer::BVHCache::pathFor(
+        RayTracer::BVHCache::hashSceneFile(filePath), cachedType));
+  }
+
   // Parse camera settings
   const libconfig::Setting& cameraSetting = cfg.lookup("camera");
   RayTracer::Camera camera = parser.parseCamera(cameraSetting);
@@ -106,15 +169,48 @@ RayTracer::Scene buildSceneFromFile(const std::string& filePath) {
   return builder.build();
 }
 
+void printAccelerationStats(const RayTracer::Scene& scene) {
+  const auto& stats = scene.getAccelerationStats();
+  if (stats.nodeCount == 0) {
+    return;
+  }
+  if (scene.getActiveAccelerator() == RayTracer::AcceleratorType::GRID) {
+    std::cout << "Grid: " << stats.itemCount << " primitives, "
+              << stats.nodeCount << " cells, " << stats.leafCount
+              << " non-empty, up to " << stats.maxLeafSize
+              << " primitives per cell"
+              << (stats.maxDepth > 0 ? ", two levels" : "") << ", built in "
+              << stats.buildMilliseconds << " ms" << std::endl;
+    return;
+  }
+  std::cout << (scene.getActiveAccelerator() ==
+                        RayTracer::AcceleratorType::BVH4
+                    ? "BVH4: "
+                    : "BVH: ")
+            << stats.itemCount << " primitives, " << stats.nodeCount
+            << " nodes, " << stats.leafCount << " leaves, depth "
+            << stats.maxDepth << ", SAH cost " << stats.sahCost
+            << (stats.fromCache ? ", loaded from cache in " : ", built in ")
+            << stats.buildMilliseconds << " ms";
+  if (stats.taskCount > 0 && !stats.fromCache) {
+    std::cout << " (" << stats.taskCount << " parallel tasks)";
+  }
+  std::cout << std::endl;
+}
+
 std::string generateOutputFilename(const std::string& inputFile) {
   return inputFile.substr(0, inputFile.find_last_of('.')) + ".ppm";
 }
 
 bool renderToPPM(const RayTracer::Scene& scene,
-                 const std::string& outputFilename) {
+                 const std::string& outputFilename, int packetSize,
+                 RayTracer::ToneMap toneMap, RayTracer::TileOrder tileOrder) {
   std::cout << "Rendering scene to " << outputFilename << "..." << std::endl;
 
   RayTracer::PPMDisplay ppmDisplay;
+  ppmDisplay.setPacketSize(packetSize);
+  ppmDisplay.setToneMap(toneMap);
+  ppmDisplay.setTileOrder(tileOrder);
   if (!ppmDisplay.renderToFile(scene, outputFilename)) {
     std::cerr << "Error: Failed to render scene" << std::endl;
     return false;
@@ -126,13 +222,18 @@ bool renderToPPM(const RayTracer::Scene& scene,
 }
 
 bool renderScene(const RayTracer::Scene& scene,
-                 const std::string& outputFilename, bool useDisplay) {
+                 const std::string& outputFilename, bool useDisplay,
+                 int packetSize, RayTracer::ToneMap toneMap,
+                 RayTracer::TileOrder tileOrder) {
 #ifdef SFML_AVAILABLE
   if (useDisplay) {
     std::cout << "Rendering scene with SFML display..." << std::endl;
 
     RayTracer::SFMLDisplay sfmlDisplay;
     RayTracer::PPMDisplay ppmDisplay;
+    ppmDisplay.setPacketSize(packetSize);
+    ppmDisplay.setToneMap(toneMap);
+    ppmDisplay.setTileOrder(tileOrder);
 
     if (!sfmlDisplay.renderWithPPM(scene, ppmDisplay, true, outputFilename)) {
       std::cerr << "Error: Failed to render scene" << std::endl;
@@ -157,7 +258,7 @@ bool renderScene(const RayTracer::Scene& scene,
   }
 #endif
 
-  return renderToPPM(scene, outputFilename);
+  return renderToPPM(scene, outputFilename, packetSize, toneMap, tileOrder);
 }
 
 int main(int argc, char** argv) {
@@ -176,6 +277,11 @@ int main(int argc, char** argv) {
   // Get scene file and check display flag
   std::string sceneFile = getSceneFilePath(argc, argv);
   bool useDisplay = hasDisplayFlag(argc, argv);
+  std::string accelerator = getOptionValue(argc, argv, "--accelerator");
+  bool useCache = !hasNoCacheFlag(argc, argv);
+  std::string packetOption = getOptionValue(argc, argv, "--packet");
+  std::string toneMapOption = getOptionValue(argc, argv, "--tonemap");
+  std::string tileOrderOption = getOptionValue(argc, argv, "--tiles");
 
   if (sceneFile.empty()) {
     std::cerr << "Error: No scene file provided" << std::endl;
@@ -195,13 +301,30 @@ int main(int argc, char** argv) {
 
   try {
     // Build scene from file
-    RayTracer::Scene scene = buildSceneFromFile(sceneFile);
+    RayTracer::Scene scene =
+        buildSceneFromFile(sceneFile, accelerator, useCache);
+    printAccelerationStats(scene);
+    int packetSize = packetOption.empty()
+                         ? RayTracer::PPMDisplay::DEFAULT_PACKET_SIZE
+                         : std::stoi(packetOption);
+    if (!packetOption.empty() && packetSize > 1 &&
+        scene.getActiveAccelerator() == RayTracer::AcceleratorType::GRID) {
+      std::cerr << "Warning: the grid traces rays one by one, the packet "
+                << "size has no effect" << std::endl;
+    }
+    RayTracer::ToneMap toneMap = toneMapOption.empty()
+                                     ? RayTracer::ToneMap::CLAMP
+                                     : RayTracer::parseToneMap(toneMapOption);
+    RayTracer::TileOrder tileOrder =
+        tileOrderOption.empty() ? RayTracer::TileOrder::HILBERT
+                                : RayTracer::parseTileOrder(tileOrderOption);
 
     // Generate output filename
     std::string outputFilename = generateOutputFilename(sceneFile);
 
     // Render the scene
-    if (!renderScene(scene, outputFilename, useDisplay)) {
+    if (!renderScene(scene, outputFilename, useDisplay, packetSize, toneMap,
+                     tileOrder)) {
       return 84;
     }
 
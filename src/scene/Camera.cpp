@@ -120,6 +120,37 @@ Ray Camera::generateRay(int x, int y) const {
   return Ray(worldOrigin, worldDirection);
 }
 
+void Camera::generateRays(int x, int y, int count,
+                          std::vector<Ray>& rays) const {
+  generateRays(x, y, count, 1, rays);
+}
+
+void Camera::generateRays(int x, int y, int width, int height,
+                          std::vector<Ray>& rays) const {
+  if (width < 0 || height < 0 || x < 0 || x + width > _width || y < 0 ||
+      y + height > _height) {
+    throw RaytracerException("Pixel coordinates out of bounds");
+  }
+
+  // Same expressions as generateRay(), so that both give identical rays
+  double aspectRatio = static_cast<double>(_width) / _height;
+  double fovRadians = (_fieldOfView * M_PI) / 180.0;
+  double tanHalfFov = tan(fovRadians / 2.0);
+
+  rays.clear();
+  rays.reserve(static_cast<std::size_t>(width) * height);
+  for (int row = y; row < y + height; ++row) {
+    double ndcY = 1.0 - (2.0 * row / (_height - 1));
+    for (int column = x; column < x + width; ++column) {
+      double ndcX = (2.0 * column / (_width - 1)) - 1.0;
+      Vector3D rayDirection(ndcX * aspectRatio * tanHalfFov,
+                            ndcY * tanHalfFov, -1.0);
+      rays.emplace_back(_position,
+                        _transform.applyToVector(rayDirection.normalized()));
+    }
+  }
+}
+
 void Camera::updateTransform() {
   _transform = Transform();
 
@@ -16,6 +16,7 @@
 #ifndef CAMERA_HPP_
 #define CAMERA_HPP_
 
+#include <vector>
 #include "../core/Ray.hpp"
 #include "../core/Transform.hpp"
 #include "../core/Vector3D.hpp"
@@ -113,6 +114,34 @@ class Camera {
    */
   Ray generateRay(int x, int y) const;
 
+  /**
+   * @brief Generate the rays of consecutive pixels of a row
+   *
+   * Same rays as generateRay() on each pixel, with the factors shared by the
+   * whole image computed once. Meant to feed Scene::traceRays().
+   *
+   * @param x The x-coordinate of the first pixel (0 is left)
+   * @param y The y-coordinate of the row (0 is top)
+   * @param count The number of pixels
+   * @param rays Receives the rays, from left to right
+   */
+  void generateRays(int x, int y, int count, std::vector<Ray>& rays) const;
+
+  /**
+   * @brief Generate the rays of a rectangular block of pixels
+   *
+   * Same rays as generateRay() on each pixel. A square block is a more
+   * coherent packet than a row of the same size.
+   *
+   * @param x The x-coordinate of the top left pixel
+   * @param y The y-coordinate of the top left pixel
+   * @param width The number of columns
+   * @param height The number of rows
+   * @param rays Receives the rays, row by row
+   */
+  void generateRays(int x, int y, int width, int height,
+                    std::vector<Ray>& rays) const;
+
  private:
   Vector3D _position;    ///< Camera position in world space
   Vector3D _rotation;    ///< Camera rotation in degrees (x, y, z)
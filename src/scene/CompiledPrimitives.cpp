@@ -0,0 +1,141 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Compiled primitive storage implementation
+*/
+
+/**
+ * @file CompiledPrimitives.cpp
+ * @brief Implementation of the CompiledPrimitives class, the render-time copy
+ * of the scene primitives stored in one contiguous array per type
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include "CompiledPrimitives.hpp"
+#include <type_traits>
+#include <typeinfo>
+
+namespace RayTracer {
+
+CompiledPrimitives::CompiledPrimitives()
+    : _handles(),
+      _sources(),
+      _spheres(),
+      _planes(),
+      _checkerboards(),
+      _cones(),
+      _limitedCones(),
+      _cylinders(),
+      _limitedCylinders(),
+      _tori(),
+      _triangles(),
+      _foreign() {}
+
+void CompiledPrimitives::compile(
+    const std::vector<std::shared_ptr<IPrimitive>>& primitives) {
+  clear();
+  _handles.reserve(primitives.size());
+  _sources.reserve(primitives.size());
+  for (const auto& primitive : primitives) {
+    _sources.push_back(primitive.get());
+    // Only exact types are copied: a derived type would be sliced
+    const std::type_info& type = typeid(*primitive);
+    if (type == typeid(Sphere)) {
+      append(_spheres, *primitive, PrimitiveKind::SPHERE);
+    } else if (type == typeid(Plane)) {
+      append(_planes, *primitive, PrimitiveKind::PLANE);
+    } else if (type == typeid(CheckerboardPlane)) {
+      append(_checkerboards, *primitive, PrimitiveKind::CHECKERBOARD_PLANE);
+    } else if (type == typeid(Cone)) {
+      append(_cones, *primitive, PrimitiveKind::CONE);
+    } else if (type == typeid(LimitedCone)) {
+      append(_limitedCones, *primitive, PrimitiveKind::LIMITED_CONE);
+    } else if (type == typeid(Cylinder)) {
+      append(_cylinders, *primitive, PrimitiveKind::CYLINDER);
+    } else if (type == typeid(LimitedCylinder)) {
+      append(_limitedCylinders, *primitive, PrimitiveKind::LIMITED_CYLINDER);
+    } else if (type == typeid(Torus)) {
+      append(_tori, *primitive, PrimitiveKind::TORUS);
+    } else if (type == typeid(Triangle)) {
+      append(_triangles, *primitive, PrimitiveKind::TRIANGLE);
+    } else {
+      _handles.push_back(
+          {PrimitiveKind::OTHER, static_cast<uint32_t>(_foreign.size())});
+      _foreign.push_back(Foreign{primitive.get()});
+    }
+  }
+}
+
+void CompiledPrimitives::clear() {
+  _handles.clear();
+  _sources.clear();
+  _spheres.clear();
+  _planes.clear();
+  _checkerboards.clear();
+  _cones.clear();
+  _limitedCones.clear();
+  _cylinders.clear();
+  _limitedCylinders.clear();
+  _tori.clear();
+  _triangles.clear();
+  _foreign.clear();
+}
+
+std::size_t CompiledPrimitives::size() const {
+  return _handles.size();
+}
+
+PrimitiveKind CompiledPrimitives::getKind(std::size_t index) const {
+  return _handles[index].kind;
+}
+
+// The qualified calls name the method of the exact type, which the compiler
+// calls directly instead of going through the virtual table
+
+std::optional<HitRecord> CompiledPrimitives::intersectHit(
+    std::size_t index, const Ray& ray) const {
+  return dispatch(index, [&](const auto& primitive) {
+    using Type = std::decay_t<decltype(primitive)>;
+    return primitive.Type::intersectHit(ray);
+  });
+}
+
+Intersection CompiledPrimitives::computeSurface(std::size_t index,
+                                                const Ray& ray,
+                                                const HitRecord& hit) const {
+  Intersection intersection =
+      dispatch(index, [&](const auto& primitive) {
+        using Type = std::decay_t<decltype(primitive)>;
+        return primitive.Type::computeSurface(ray, hit);
+      });
+  intersection.primitive = _sources[index];
+  return intersection;
+}
+
+bool CompiledPrimitives::occluded(std::size_t index, const Ray& ray,
+                                  double tMax) const {
+  return dispatch(index, [&](const auto& primitive) {
+    using Type = std::decay_t<decltype(primitive)>;
+    return primitive.Type::occluded(ray, tMax);
+  });
+}
+
+std::optional<HitRecord> CompiledPrimitives::Foreign::intersectHit(
+    const Ray& ray) const {
+  return primitive->intersectHit(ray);
+}
+
+Intersection CompiledPrimitives::Foreign::computeSurface(
+    const Ray& ray, const HitRecord& hit) const {
+  return primitive->computeSurface(ray, hit);
+}
+
+bool CompiledPrimitives::Foreign::occluded(const Ray& ray,
+                                           double tMax) const {
+  return primitive->occluded(ray, tMax);
+}
+
+}  // namespace RayTracer
@@ -0,0 +1,242 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Compiled primitive storage header
+*/
+
+/**
+ * @file CompiledPrimitives.hpp
+ * @brief Definition of the CompiledPrimitives class, the render-time copy of
+ * the scene primitives stored in one contiguous array per type
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#ifndef COMPILEDPRIMITIVES_HPP_
+#define COMPILEDPRIMITIVES_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+#include "../../include/IPrimitive.hpp"
+#include "../core/Ray.hpp"
+#include "primitives/CheckerboardPlane.hpp"
+#include "primitives/Cone.hpp"
+#include "primitives/Cylinder.hpp"
+#include "primitives/LimitedCone.hpp"
+#include "primitives/LimitedCylinder.hpp"
+#include "primitives/Plane.hpp"
+#include "primitives/Sphere.hpp"
+#include "primitives/Torus.hpp"
+#include "primitives/Triangle.hpp"
+
+namespace RayTracer {
+
+/**
+ * @brief Concrete type of a compiled primitive
+ */
+enum class PrimitiveKind : uint8_t {
+  SPHERE,              ///< Sphere
+  PLANE,               ///< Plane
+  CHECKERBOARD_PLANE,  ///< CheckerboardPlane
+  CONE,                ///< Infinite Cone
+  LIMITED_CONE,        ///< LimitedCone
+  CYLINDER,            ///< Infinite Cylinder
+  LIMITED_CYLINDER,    ///< LimitedCylinder
+  TORUS,               ///< Torus
+  TRIANGLE,            ///< Triangle
+  OTHER                ///< Any other type, called through IPrimitive
+};
+
+/**
+ * @brief Render-time storage of the scene primitives
+ *
+ * The scene authors its primitives as shared IPrimitive objects scattered on
+ * the heap. compile() copies the built-in types by value into one array per
+ * type, and every query switches on the type of the primitive to call the
+ * method of that type directly instead of through the virtual table.
+ * Meshes, instances and any type added outside the built-in ones keep their
+ * virtual calls, through a plain pointer to the authored object.
+ *
+ * Primitives are addressed by their index in the authoring list, and the
+ * intersections report the authored primitive, not its copy. The copies
+ * are taken at compile() time: the scene compiles again after a change.
+ */
+class CompiledPrimitives {
+ public:
+  /**
+   * @brief Default constructor
+   * Creates an empty storage
+   */
+  CompiledPrimitives();
+
+  /**
+   * @brief Copy the primitives into the typed arrays
+   *
+   * The authored primitives must outlive the storage, or the next
+   * compile(), when they are not of a built-in type.
+   *
+   * @param primitives The authored primitives, in scene order
+   */
+  void compile(const std::vector<std::shared_ptr<IPrimitive>>& primitives);
+
+  /**
+   * @brief Remove every primitive
+   */
+  void clear();
+
+  /**
+   * @brief Get the number of compiled primitives
+   * @return The primitive count
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Get the concrete type of a primitive
+   * @param index Index of the primitive in the authoring list
+   * @return The type its queries dispatch to
+   */
+  PrimitiveKind getKind(std::size_t index) const;
+
+  /**
+   * @brief Find where a ray hits a primitive
+   * @param index Index of the primitive in the authoring list
+   * @param ray The ray, its tMax is shrunk to a reported hit
+   * @return The hit, std::nullopt if the ray misses
+   * @see IPrimitive::intersectHit()
+   */
+  std::optional<HitRecord> intersectHit(std::size_t index,
+                                        const Ray& ray) const;
+
+  /**
+   * @brief Build the surface data of a hit on a primitive
+   * @param index Index of the primitive in the authoring list
+   * @param ray The ray that produced the hit
+   * @param hit The hit record
+   * @return The intersection, referencing the authored primitive
+   * @see IPrimitive::computeSurface()
+   */
+  Intersection computeSurface(std::size_t index, const Ray& ray,
+                              const HitRecord& hit) const;
+
+  /**
+   * @brief Check if a ray hits a primitive closer than a distance
+   * @param index Index of the primitive in the authoring list
+   * @param ray The ray to test
+   * @param tMax Hits beyond this distance are ignored
+   * @return true if the primitive is hit in [tMin, tMax]
+   * @see IPrimitive::occluded()
+   */
+  bool occluded(std::size_t index, const Ray& ray, double tMax) const;
+
+ private:
+  /**
+   * @brief Location of a primitive in the typed arrays
+   */
+  struct Handle {
+    PrimitiveKind kind;  ///< Array holding the primitive
+    uint32_t slot;       ///< Index in that array
+  };
+
+  /**
+   * @brief Primitive of a type the storage does not know
+   *
+   * Forwards to the authored object, so that it is called like the copies.
+   */
+  struct Foreign {
+    const IPrimitive* primitive;  ///< The authored primitive
+
+    /// @see IPrimitive::intersectHit()
+    std::optional<HitRecord> intersectHit(const Ray& ray) const;
+
+    /// @see IPrimitive::computeSurface()
+    Intersection computeSurface(const Ray& ray, const HitRecord& hit) const;
+
+    /// @see IPrimitive::occluded()
+    bool occluded(const Ray& ray, double tMax) const;
+  };
+
+  std::vector<Handle> _handles;  ///< Location of each authored primitive
+  std::vector<const IPrimitive*>
+      _sources;  ///< Authored primitive of each index, for intersections
+  std::vector<Sphere> _spheres;  ///< Sphere copies
+  std::vector<Plane> _planes;    ///< Plane copies
+  std::vector<CheckerboardPlane>
+      _checkerboards;                      ///< CheckerboardPlane copies
+  std::vector<Cone> _cones;                ///< Cone copies
+  std::vector<LimitedCone> _limitedCones;  ///< LimitedCone copies
+  std::vector<Cylinder> _cylinders;        ///< Cylinder copies
+  std::vector<LimitedCylinder>
+      _limitedCylinders;             ///< LimitedCylinder copies
+  std::vector<Torus> _tori;          ///< Torus copies
+  std::vector<Triangle> _triangles;  ///< Triangle copies
+  std::vector<Foreign> _foreign;     ///< Primitives of other types
+
+  /**
+   * @brief Copy a primitive at the end of its typed array
+   * @param array The array of its exact type
+   * @param primitive The authored primitive
+   * @param kind The type of the array
+   */
+  template <typename Primitive>
+  void append(std::vector<Primitive>& array, const IPrimitive& primitive,
+              PrimitiveKind kind);
+
+  /**
+   * @brief Run an operation on the typed copy of a primitive
+   *
+   * The operation is called with a reference to the exact type, so that it
+   * can name the method of that type and skip the virtual dispatch.
+   *
+   * @param index Index of the primitive in the authoring list
+   * @param operation Callable taking `const auto&`
+   * @return What the operation returns
+   */
+  template <typename Operation>
+  decltype(auto) dispatch(std::size_t index, Operation&& operation) const;
+};
+
+// Template implementation (must be in header)
+template <typename Primitive>
+void CompiledPrimitives::append(std::vector<Primitive>& array,
+                                const IPrimitive& primitive,
+                                PrimitiveKind kind) {
+  _handles.push_back({kind, static_cast<uint32_t>(array.size())});
+  array.push_back(static_cast<const Primitive&>(primitive));
+}
+
+template <typename Operation>
+decltype(auto) CompiledPrimitives::dispatch(std::size_t index,
+                                            Operation&& operation) const {
+  const Handle& handle = _handles[index];
+  switch (handle.kind) {
+    case PrimitiveKind::SPHERE:
+      return operation(_spheres[handle.slot]);
+    case PrimitiveKind::PLANE:
+      return operation(_planes[handle.slot]);
+    case PrimitiveKind::CHECKERBOARD_PLANE:
+      return operation(_checkerboards[handle.slot]);
+    case PrimitiveKind::CONE:
+      return operation(_cones[handle.slot]);
+    case PrimitiveKind::LIMITED_CONE:
+      return operation(_limitedCones[handle.slot]);
+    case PrimitiveKind::CYLINDER:
+      return operation(_cylinders[handle.slot]);
+    case PrimitiveKind::LIMITED_CYLINDER:
+      return operation(_limitedCylinders[handle.slot]);
+    case PrimitiveKind::TORUS:
+      return operation(_tori[handle.slot]);
+    case PrimitiveKind::TRIANGLE:
+      return operation(_triangles[handle.slot]);
+    default:
+      return operation(_foreign[handle.slot]);
+  }
+}
+
+}  // namespace RayTracer
+
+#endif /* !COMPILEDPRIMITIVES_HPP_ */
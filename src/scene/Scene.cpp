@@ -16,30 +16,80 @@
 
 #include "Scene.hpp"
 #include <algorithm>
-#include <limits>
+#include <array>
+#include "../core/ThreadPool.hpp"
+#include "acceleration/BVHCache.hpp"
+#include "primitives/Sphere.hpp"
+#include "primitives/Triangle.hpp"
 
 namespace RayTracer {
 
+namespace {
+
+/// Distance along shadow rays below which hits are treated as self-hits
+constexpr double SHADOW_BIAS = 0.001;
+
+}  // namespace
+
 Scene::Scene()
     : _camera(),
       _primitives(),
       _lights(),
       _ambientIntensity(0.1),
-      _diffuseMultiplier(0.9) {}
+      _diffuseMultiplier(0.9),
+      _accelerator(AcceleratorType::AUTO),
+      _activeAccelerator(AcceleratorType::BVH),
+      _bvh(),
+      _bvh4(),
+      _grid(),
+      _compiled(),
+      _spheres(),
+      _itemSpheres(),
+      _leafSpheres(),
+      _triangles(),
+      _itemTriangles(),
+      _leafTriangles(),
+      _boundedPrimitives(),
+      _unboundedPrimitives(),
+      _finalized(false),
+      _buildSahCost(0.0),
+      _cachePath() {}
 
 Scene::Scene(const Camera& camera)
     : _camera(camera),
       _primitives(),
       _lights(),
       _ambientIntensity(0.1),
-      _diffuseMultiplier(0.9) {}
+      _diffuseMultiplier(0.9),
+      _accelerator(AcceleratorType::AUTO),
+      _activeAccelerator(AcceleratorType::BVH),
+      _bvh(),
+      _bvh4(),
+      _grid(),
+      _compiled(),
+      _spheres(),
+      _itemSpheres(),
+      _leafSpheres(),
+      _triangles(),
+      _itemTriangles(),
+      _leafTriangles(),
+      _boundedPrimitives(),
+      _unboundedPrimitives(),
+      _finalized(false),
+      _buildSahCost(0.0),
+      _cachePath() {}
 
 Scene::~Scene() {}
 
 Scene::Scene(const Scene& other)
     : _camera(other._camera),
       _ambientIntensity(other._ambientIntensity),
-      _diffuseMultiplier(other._diffuseMultiplier) {
+      _diffuseMultiplier(other._diffuseMultiplier),
+      _accelerator(other._accelerator),
+      _activeAccelerator(other._activeAccelerator),
+      _finalized(false),
+      _buildSahCost(0.0),
+      _cachePath(other._cachePath) {
   // Deep copy primitives
   for (const auto& primitive : other._primitives) {
     _primitives.push_back(primitive->clone());
@@ -49,6 +99,11 @@ Scene::Scene(const Scene& other)
   for (const auto& light : other._lights) {
     _lights.push_back(light->clone());
   }
+
+  // The hierarchy references our own primitives, so it is rebuilt
+  if (other._finalized) {
+    finalize();
+  }
 }
 
 Scene& Scene::operator=(const Scene& other) {
@@ -56,6 +111,8 @@ Scene& Scene::operator=(const Scene& other) {
     _camera = other._camera;
     _ambientIntensity = other._ambientIntensity;
     _diffuseMultiplier = other._diffuseMultiplier;
+    _accelerator = other._accelerator;
+    _cachePath = other._cachePath;
 
     // Clear current primitives and lights
     _primitives.clear();
@@ -70,12 +127,18 @@ Scene& Scene::operator=(const Scene& other) {
     for (const auto& light : other._lights) {
       _lights.push_back(light->clone());
     }
+
+    invalidateAcceleration();
+    if (other._finalized) {
+      finalize();
+    }
   }
   return *this;
 }
 
 void Scene::addPrimitive(std::shared_ptr<IPrimitive> primitive) {
   _primitives.push_back(primitive);
+  invalidateAcceleration();
 }
 
 void Scene::addLight(std::shared_ptr<ILight> light) {
@@ -114,20 +177,442 @@ const std::vector<std::shared_ptr<ILight>>& Scene::getLights() const {
   return _lights;
 }
 
+void Scene::setAccelerator(AcceleratorType type) {
+  if (type != _accelerator) {
+    _accelerator = type;
+    invalidateAcceleration();
+  }
+}
+
+AcceleratorType Scene::getAccelerator() const {
+  return _accelerator;
+}
+
+AcceleratorType Scene::getActiveAccelerator() const {
+  return _activeAccelerator;
+}
+
+std::vector<AABB> Scene::classifyPrimitives(
+    std::vector<std::size_t>& bounded,
+    std::vector<std::size_t>& unbounded) const {
+  bounded.clear();
+  unbounded.clear();
+  std::vector<AABB> bounds;
+  for (std::size_t i = 0; i < _primitives.size(); ++i) {
+    AABB box = _primitives[i]->worldBounds();
+    if (box.isBounded()) {
+      bounded.push_back(i);
+      bounds.push_back(box);
+    } else if (!box.isEmpty()) {
+      unbounded.push_back(i);
+    }
+  }
+  return bounds;
+}
+
+void Scene::setAccelerationCache(const std::string& path) {
+  _cachePath = path;
+}
+
+const std::string& Scene::getAccelerationCache() const {
+  return _cachePath;
+}
+
+bool Scene::loadCachedAcceleration(const std::vector<AABB>& bounds) {
+  _bvh.clear();
+  _bvh4.clear();
+  if (_activeAccelerator == AcceleratorType::BVH4) {
+    return BVHCache::load(_cachePath, bounds, _bvh4);
+  }
+  return BVHCache::load(_cachePath, bounds, _bvh);
+}
+
+void Scene::finalize() {
+  buildAcceleration(true);
+}
+
+void Scene::buildAcceleration(bool useCacheFile) {
+  std::vector<AABB> bounds =
+      classifyPrimitives(_boundedPrimitives, _unboundedPrimitives);
+  _activeAccelerator = _accelerator == AcceleratorType::AUTO
+                           ? chooseAccelerator(bounds)
+                           : _accelerator;
+  if (_activeAccelerator == AcceleratorType::GRID) {
+    // Built in linear time, so never worth caching
+    _grid.build(bounds);
+    bakePrimitives();
+    _finalized = true;
+    _buildSahCost = 0.0;
+    return;
+  }
+
+  bool useCache = useCacheFile && !_cachePath.empty() &&
+                  bounds.size() >= BVHCache::MIN_CACHED_ITEMS;
+  if (useCache && loadCachedAcceleration(bounds)) {
+    bakePrimitives();
+    _finalized = true;
+    _buildSahCost = getAccelerationStats().sahCost;
+    return;
+  }
+
+  // Creating the workers costs less than building large scenes serially
+  std::unique_ptr<ThreadPool> pool;
+  if (bounds.size() >= BVH::PARALLEL_BUILD_THRESHOLD) {
+    pool = std::make_unique<ThreadPool>();
+  }
+  _bvh.build(bounds, pool.get());
+  if (_activeAccelerator == AcceleratorType::BVH4) {
+    // Only the collapsed hierarchy is traversed
+    _bvh4.build(_bvh);
+    _bvh.clear();
+  }
+  if (useCache) {
+    // The cache is only a shortcut: failing to write it is not an error
+    if (_activeAccelerator == AcceleratorType::BVH4) {
+      BVHCache::store(_cachePath, bounds, _bvh4);
+    } else {
+      BVHCache::store(_cachePath, bounds, _bvh);
+    }
+  }
+  bakePrimitives();
+  _finalized = true;
+  _buildSahCost = getAccelerationStats().sahCost;
+}
+
+bool Scene::refit() {
+  if (!_finalized) {
+    buildAcceleration(false);
+    return false;
+  }
+
+  std::vector<std::size_t> bounded;
+  std::vector<std::size_t> unbounded;
+  std::vector<AABB> bounds = classifyPrimitives(bounded, unbounded);
+  // The grid has no topology to keep, and rebuilding it is as cheap
+  if (bounded != _boundedPrimitives || unbounded != _unboundedPrimitives ||
+      _activeAccelerator == AcceleratorType::GRID) {
+    buildAcceleration(false);
+    return false;
+  }
+
+  if (_activeAccelerator == AcceleratorType::BVH4) {
+    _bvh4.refit(bounds);
+  } else {
+    _bvh.refit(bounds);
+  }
+  // Boxes grown by the motion overlap more and more: past some point a
+  // fresh build costs less than the slower traversal
+  if (getAccelerationStats().sahCost >
+      _buildSahCost * REFIT_REBUILD_THRESHOLD) {
+    buildAcceleration(false);
+    return false;
+  }
+  // The leaf order is kept, only the compiled and baked copies moved
+  bakePrimitives();
+  return true;
+}
+
+const BVH::BuildStats& Scene::getAccelerationStats() const {
+  if (_activeAccelerator == AcceleratorType::BVH4) {
+    return _bvh4.getBuildStats();
+  }
+  if (_activeAccelerator == AcceleratorType::GRID) {
+    return _grid.getBuildStats();
+  }
+  return _bvh.getBuildStats();
+}
+
+bool Scene::isFinalized() const {
+  return _finalized;
+}
+
+const SphereBlock& Scene::getSphereBlock() const {
+  return _spheres;
+}
+
+const TriangleBlock& Scene::getTriangleBlock() const {
+  return _triangles;
+}
+
+void Scene::bakePrimitives() {
+  _compiled.compile(_primitives);
+  _spheres.clear();
+  _itemSpheres.assign(_boundedPrimitives.size(), NOT_BAKED);
+  _leafSpheres.clear();
+  _triangles.clear();
+  _itemTriangles.assign(_boundedPrimitives.size(), NOT_BAKED);
+  _leafTriangles.clear();
+
+  // Leaf order with the binary hierarchy, item order otherwise
+  std::vector<uint32_t> order;
+  if (_activeAccelerator == AcceleratorType::BVH) {
+    order = _bvh.getItemIndices();
+  } else {
+    for (std::size_t item = 0; item < _boundedPrimitives.size(); ++item) {
+      order.push_back(static_cast<uint32_t>(item));
+    }
+  }
+
+  _leafSpheres.reserve(order.size() + 1);
+  _leafTriangles.reserve(order.size() + 1);
+  for (uint32_t item : order) {
+    _leafSpheres.push_back(static_cast<uint32_t>(_spheres.size()));
+    _leafTriangles.push_back(static_cast<uint32_t>(_triangles.size()));
+    std::size_t index = _boundedPrimitives[item];
+    const IPrimitive* primitive = _primitives[index].get();
+    Vector3D center;
+    double radius = 0.0;
+    const auto* sphere = dynamic_cast<const Sphere*>(primitive);
+    if (sphere && SphereBlock::bake(*sphere, center, radius)) {
+      _itemSpheres[item] = static_cast<uint32_t>(_spheres.size());
+      _spheres.add(center, radius, index);
+      continue;
+    }
+    Vector3D a;
+    Vector3D b;
+    Vector3D c;
+    const auto* triangle = dynamic_cast<const Triangle*>(primitive);
+    if (triangle && TriangleBlock::bake(*triangle, a, b, c)) {
+      _itemTriangles[item] = static_cast<uint32_t>(_triangles.size());
+      _triangles.add(a, b, c, index);
+    }
+  }
+  _leafSpheres.push_back(static_cast<uint32_t>(_spheres.size()));
+  _leafTriangles.push_back(static_cast<uint32_t>(_triangles.size()));
+}
+
+bool Scene::keepClosest(const std::optional<HitRecord>& hit,
+                        std::optional<HitRecord>& closest) {
+  if (!hit) {
+    return false;
+  }
+  if (closest && !(hit->t < closest->t ||
+                   (hit->t == closest->t &&
+                    hit->primitiveIndex < closest->primitiveIndex))) {
+    return false;
+  }
+  closest = hit;
+  return true;
+}
+
+Intersection Scene::computeSurface(const Ray& ray,
+                                   const HitRecord& hit) const {
+  if (!_finalized) {
+    return _primitives[hit.primitiveIndex]->computeSurface(ray, hit);
+  }
+  return _compiled.computeSurface(hit.primitiveIndex, ray, hit);
+}
+
+bool Scene::primitiveOccluded(std::size_t index, const Ray& ray,
+                              double tMax) const {
+  if (!_finalized) {
+    return _primitives[index]->occluded(ray, tMax);
+  }
+  return _compiled.occluded(index, ray, tMax);
+}
+
+bool Scene::testClosest(std::size_t index, const Ray& ray,
+                        std::optional<HitRecord>& closest) const {
+  // Before finalize(), the authored primitives are the only copy
+  std::optional<HitRecord> hit =
+      _finalized ? _compiled.intersectHit(index, ray)
+                 : _primitives[index]->intersectHit(ray);
+  if (hit) {
+    hit->primitiveIndex = index;
+  }
+  return keepClosest(hit, closest);
+}
+
+bool Scene::testItemClosest(std::size_t item, const Ray& ray,
+                            std::optional<HitRecord>& closest) const {
+  uint32_t sphere = _itemSpheres[item];
+  if (sphere != NOT_BAKED) {
+    return keepClosest(_spheres.intersect(ray, sphere, sphere + 1), closest);
+  }
+  uint32_t triangle = _itemTriangles[item];
+  if (triangle != NOT_BAKED) {
+    return keepClosest(_triangles.intersect(ray, triangle, triangle + 1),
+                       closest);
+  }
+  return testClosest(_boundedPrimitives[item], ray, closest);
+}
+
+bool Scene::testLeafClosest(std::size_t first, std::size_t count,
+                            const Ray& ray,
+                            std::optional<HitRecord>& closest) const {
+  bool replaced = false;
+  std::size_t spheresBegin = _leafSpheres[first];
+  std::size_t spheresEnd = _leafSpheres[first + count];
+  if (spheresBegin < spheresEnd &&
+      keepClosest(_spheres.intersect(ray, spheresBegin, spheresEnd),
+                  closest)) {
+    replaced = true;
+  }
+  std::size_t trianglesBegin = _leafTriangles[first];
+  std::size_t trianglesEnd = _leafTriangles[first + count];
+  if (trianglesBegin < trianglesEnd &&
+      keepClosest(_triangles.intersect(ray, trianglesBegin, trianglesEnd),
+                  closest)) {
+    replaced = true;
+  }
+  // Every other item of the leaf goes through its primitive
+  std::size_t baked =
+      (spheresEnd - spheresBegin) + (trianglesEnd - trianglesBegin);
+  if (baked < count) {
+    const std::vector<uint32_t>& items = _bvh.getItemIndices();
+    for (std::size_t i = first; i < first + count; ++i) {
+      if (_itemSpheres[items[i]] == NOT_BAKED &&
+          _itemTriangles[items[i]] == NOT_BAKED &&
+          testClosest(_boundedPrimitives[items[i]], ray, closest)) {
+        replaced = true;
+      }
+    }
+  }
+  return replaced;
+}
+
+bool Scene::itemOccluded(std::size_t item, const Ray& ray,
+                         double tMax) const {
+  uint32_t sphere = _itemSpheres[item];
+  if (sphere != NOT_BAKED) {
+    return _spheres.occluded(ray, sphere, sphere + 1, tMax);
+  }
+  uint32_t triangle = _itemTriangles[item];
+  if (triangle != NOT_BAKED) {
+    return _triangles.occluded(ray, triangle, triangle + 1, tMax);
+  }
+  return primitiveOccluded(_boundedPrimitives[item], ray, tMax);
+}
+
+bool Scene::leafOccluded(std::size_t first, std::size_t count,
+                         const Ray& ray, double tMax) const {
+  std::size_t spheresBegin = _leafSpheres[first];
+  std::size_t spheresEnd = _leafSpheres[first + count];
+  if (spheresBegin < spheresEnd &&
+      _spheres.occluded(ray, spheresBegin, spheresEnd, tMax)) {
+    return true;
+  }
+  std::size_t trianglesBegin = _leafTriangles[first];
+  std::size_t trianglesEnd = _leafTriangles[first + count];
+  if (trianglesBegin < trianglesEnd &&
+      _triangles.occluded(ray, trianglesBegin, trianglesEnd, tMax)) {
+    return true;
+  }
+  std::size_t baked =
+      (spheresEnd - spheresBegin) + (trianglesEnd - trianglesBegin);
+  if (baked < count) {
+    const std::vector<uint32_t>& items = _bvh.getItemIndices();
+    for (std::size_t i = first; i < first + count; ++i) {
+      if (_itemSpheres[items[i]] == NOT_BAKED &&
+          _itemTriangles[items[i]] == NOT_BAKED &&
+          primitiveOccluded(_boundedPrimitives[items[i]], ray, tMax)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 std::optional<Intersection> Scene::traceRay(const Ray& ray) const {
-  std::optional<Intersection> closestIntersection;
-  double closestDistance = std::numeric_limits<double>::infinity();
+  std::optional<HitRecord> closestHit;
+  // Primitives shrink the interval of this copy as closer hits are found
+  Ray query(ray);
+
+  if (!_finalized) {
+    for (std::size_t i = 0; i < _primitives.size(); ++i) {
+      testClosest(i, query, closestHit);
+    }
+  } else {
+    for (std::size_t index : _unboundedPrimitives) {
+      testClosest(index, query, closestHit);
+    }
 
-  for (const auto& primitive : _primitives) {
-    auto intersection = primitive->intersect(ray);
-    if (intersection && intersection->distance > 0 &&
-        intersection->distance < closestDistance) {
-      closestIntersection = intersection;
-      closestDistance = intersection->distance;
+    double tMax = query.getTMax();
+    if (_activeAccelerator == AcceleratorType::BVH) {
+      _bvh.traverseLeaves(
+          query, tMax,
+          [&](std::size_t first, std::size_t count, double& maxDistance) {
+            if (testLeafClosest(first, count, query, closestHit)) {
+              maxDistance = query.getTMax();
+            }
+            return false;
+          });
+    } else {
+      traverseAccelerator(
+          query, tMax, [&](std::size_t item, double& maxDistance) {
+            if (testItemClosest(item, query, closestHit)) {
+              maxDistance = query.getTMax();
+            }
+            return false;
+          });
     }
   }
 
-  return closestIntersection;
+  // Surface data is only computed for the closest hit
+  if (!closestHit) {
+    return std::nullopt;
+  }
+  return computeSurface(ray, *closestHit);
+}
+
+void Scene::traceRays(const std::vector<Ray>& rays,
+                      std::vector<std::optional<Intersection>>& hits) const {
+  hits.assign(rays.size(), std::nullopt);
+  if (!_finalized || _activeAccelerator == AcceleratorType::GRID ||
+      rays.size() < 2) {
+    for (std::size_t i = 0; i < rays.size(); ++i) {
+      hits[i] = traceRay(rays[i]);
+    }
+    return;
+  }
+
+  // Per packet and on the stack: tracing allocates nothing
+  std::array<Ray, BVH::MAX_PACKET_SIZE> queries;
+  std::array<std::optional<HitRecord>, BVH::MAX_PACKET_SIZE> closestHits;
+  std::array<double, BVH::MAX_PACKET_SIZE> tMax;
+  for (std::size_t begin = 0; begin < rays.size();
+       begin += BVH::MAX_PACKET_SIZE) {
+    std::size_t count = std::min(BVH::MAX_PACKET_SIZE, rays.size() - begin);
+    // Primitives shrink the intervals of these copies as closer hits are
+    // found
+    for (std::size_t i = 0; i < count; ++i) {
+      queries[i] = rays[begin + i];
+      closestHits[i].reset();
+      for (std::size_t index : _unboundedPrimitives) {
+        testClosest(index, queries[i], closestHits[i]);
+      }
+      tMax[i] = queries[i].getTMax();
+    }
+
+    if (_activeAccelerator == AcceleratorType::BVH4) {
+      _bvh4.traversePacket(
+          queries.data(), count, tMax.data(),
+          [&](std::size_t item, std::size_t ray, double& maxDistance) {
+            if (testItemClosest(item, queries[ray], closestHits[ray])) {
+              maxDistance = queries[ray].getTMax();
+            }
+            return false;
+          });
+    } else {
+      _bvh.traversePacketLeaves(
+          queries.data(), count, tMax.data(),
+          [&](std::size_t first, std::size_t leafCount, std::size_t ray,
+              double& maxDistance) {
+            if (testLeafClosest(first, leafCount, queries[ray],
+                                closestHits[ray])) {
+              maxDistance = queries[ray].getTMax();
+            }
+            return false;
+          });
+    }
+
+    // Surface data is only computed for the closest hit of every ray
+    for (std::size_t i = 0; i < count; ++i) {
+      if (closestHits[i]) {
+        hits[begin + i] = computeSurface(rays[begin + i], *closestHits[i]);
+      }
+    }
+  }
 }
 
 bool Scene::isInShadow(const Vector3D& point,
@@ -140,20 +625,60 @@ bool Scene::isInShadow(const Vector3D& point,
 
   double lightDistance = light->getDistanceFrom(point);
 
-  for (const auto& primitive : _primitives) {
-    auto intersection = primitive->intersect(shadowRay);
+  // Hits closer than SHADOW_BIAS to the shadow ray origin are the shaded
+  // surface itself: start the query interval past them
+  shadowRay.setInterval(SHADOW_BIAS, lightDistance);
+  return occluded(shadowRay, lightDistance);
+}
 
-    if (intersection && intersection->distance > 0.001 &&
-        intersection->distance < lightDistance) {
+bool Scene::occluded(const Ray& ray, double tMax) const {
+  if (!_finalized) {
+    for (std::size_t i = 0; i < _primitives.size(); ++i) {
+      if (primitiveOccluded(i, ray, tMax)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  for (std::size_t index : _unboundedPrimitives) {
+    if (primitiveOccluded(index, ray, tMax)) {
       return true;
     }
   }
 
-  return false;
+  double maxDistance = tMax;
+  if (_activeAccelerator == AcceleratorType::BVH) {
+    return _bvh.traverseLeaves(
+        ray, maxDistance, [&](std::size_t first, std::size_t count, double&) {
+          return leafOccluded(first, count, ray, tMax);
+        });
+  }
+  return traverseAccelerator(
+      ray, maxDistance, [&](std::size_t item, double&) {
+        return itemOccluded(item, ray, tMax);
+      });
 }
 
 void Scene::clearPrimitives() {
   _primitives.clear();
+  invalidateAcceleration();
+}
+
+void Scene::invalidateAcceleration() {
+  _bvh.clear();
+  _bvh4.clear();
+  _grid.clear();
+  _compiled.clear();
+  _spheres.clear();
+  _itemSpheres.clear();
+  _leafSpheres.clear();
+  _triangles.clear();
+  _itemTriangles.clear();
+  _leafTriangles.clear();
+  _boundedPrimitives.clear();
+  _unboundedPrimitives.clear();
+  _finalized = false;
 }
 
 void Scene::clearLights() {
@@ -17,12 +17,21 @@
 #ifndef SCENE_HPP_
 #define SCENE_HPP_
 
+#include <cstdint>
 #include <memory>
 #include <optional>
+#include <string>
 #include <vector>
 #include "../../include/ILight.hpp"
 #include "../../include/IPrimitive.hpp"
 #include "Camera.hpp"
+#include "CompiledPrimitives.hpp"
+#include "acceleration/Accelerator.hpp"
+#include "acceleration/BVH.hpp"
+#include "acceleration/BVH4.hpp"
+#include "acceleration/Grid.hpp"
+#include "acceleration/SphereBlock.hpp"
+#include "acceleration/TriangleBlock.hpp"
 
 namespace RayTracer {
 
@@ -32,6 +41,17 @@ namespace RayTracer {
  * This class manages all the elements of a scene: primitives, lights, and
  * camera. It provides functionality to trace rays through the scene and find
  * intersections.
+ *
+ * Once every primitive has been added, finalize() builds a bounding volume
+ * hierarchy over the bounded primitives. Until then, and again after the
+ * primitive list changes, ray queries fall back to testing every primitive.
+ *
+ * finalize() also compiles the primitives into CompiledPrimitives, typed
+ * arrays queried without virtual calls or shared pointers, and bakes the
+ * spheres that stay spheres in world space into a SphereBlock and the
+ * triangles into a TriangleBlock, in the leaf order of the binary
+ * hierarchy, so that a leaf tests them together with SIMD instead of one
+ * call each.
  */
 class Scene {
  public:
@@ -124,13 +144,142 @@ class Scene {
    */
   const std::vector<std::shared_ptr<ILight>>& getLights() const;
 
+  /**
+   * @brief Choose the acceleration structure built by finalize()
+   *
+   * Invalidates the current structure when the type changes.
+   *
+   * @param type The acceleration structure type
+   */
+  void setAccelerator(AcceleratorType type);
+
+  /**
+   * @brief Get the acceleration structure requested for finalize()
+   * @return The acceleration structure type, AUTO by default
+   */
+  AcceleratorType getAccelerator() const;
+
+  /**
+   * @brief Get the acceleration structure built by the last finalize()
+   *
+   * Same as getAccelerator() unless it is AUTO, which finalize() resolves
+   * with chooseAccelerator().
+   *
+   * @return The acceleration structure type, never AUTO
+   */
+  AcceleratorType getActiveAccelerator() const;
+
+  /**
+   * @brief Load and save the acceleration structure through a cache file
+   *
+   * finalize() then maps the hierarchy from the file when it was built over
+   * the same primitive boxes, and writes the file after building otherwise.
+   * Scenes with fewer than BVHCache::MIN_CACHED_ITEMS bounded primitives are
+   * always built.
+   *
+   * @param path The cache file, empty to always build
+   * @see BVHCache
+   */
+  void setAccelerationCache(const std::string& path);
+
+  /**
+   * @brief Get the acceleration structure cache file
+   * @return The cache file, empty if the cache is disabled
+   */
+  const std::string& getAccelerationCache() const;
+
+  /**
+   * @brief Build the acceleration structure over the current primitives
+   *
+   * Must be called again after primitives are added or removed, otherwise
+   * ray queries use the linear fallback. Large scenes are built in parallel
+   * on a temporary thread pool, unless the cache file already holds them.
+   */
+  void finalize();
+
+  /**
+   * @brief Update the acceleration structure after primitives moved
+   *
+   * Meant to be called every frame once transforms have changed: the
+   * hierarchy keeps its topology and only its boxes are recomputed, in time
+   * linear in the number of nodes. The scene is rebuilt from scratch
+   * instead when it was not finalized, when a primitive became bounded or
+   * unbounded, or when the SAH cost grew by more than REFIT_REBUILD_THRESHOLD
+   * since the last build. A grid is always rebuilt. These rebuilds neither
+   * read nor write the cache file, which keeps the authored scene.
+   *
+   * @return true if the hierarchy was refit, false if it was rebuilt
+   */
+  bool refit();
+
+  /**
+   * @brief Get the statistics of the last acceleration structure build
+   * @return The build statistics of the selected structure
+   */
+  const BVH::BuildStats& getAccelerationStats() const;
+
+  /**
+   * @brief Check if the acceleration structure is up to date
+   * @return true if finalize() was called since the last primitive change
+   */
+  bool isFinalized() const;
+
+  /// SAH cost growth, relative to the last build, that triggers a rebuild
+  static constexpr double REFIT_REBUILD_THRESHOLD = 1.5;
+
+  /// Block index of the items that are not baked in a block
+  static constexpr uint32_t NOT_BAKED = UINT32_MAX;
+
+  /**
+   * @brief Get the spheres baked by the last finalize()
+   * @return The sphere block, empty if the scene is not finalized
+   */
+  const SphereBlock& getSphereBlock() const;
+
+  /**
+   * @brief Get the triangles baked by the last finalize()
+   * @return The triangle block, empty if the scene is not finalized
+   */
+  const TriangleBlock& getTriangleBlock() const;
+
   /**
    * @brief Trace a ray through the scene and find the closest intersection
+   *
+   * Only hits inside the [tMin, tMax] interval of the ray are considered.
+   * The ray itself is left untouched: the search shrinks the interval of a
+   * private copy. Candidates only report their hit parameter, the surface
+   * data is computed once for the closest one.
+   *
    * @param ray The ray to trace
    * @return The closest intersection if any, std::nullopt otherwise
    */
   std::optional<Intersection> traceRay(const Ray& ray) const;
 
+  /**
+   * @brief Trace a batch of coherent rays, such as neighbouring primary rays
+   *
+   * Gives the same result as traceRay() on every ray. With either
+   * hierarchy, the rays are traced in packets of up to BVH::MAX_PACKET_SIZE
+   * that share their traversal; the grid traces them one by one.
+   *
+   * @param rays The rays to trace
+   * @param hits Receives the closest intersection of every ray, if any
+   */
+  void traceRays(const std::vector<Ray>& rays,
+                 std::vector<std::optional<Intersection>>& hits) const;
+
+  /**
+   * @brief Check if anything blocks a ray before a given distance
+   *
+   * Any-hit query: stops at the first primitive hit in [tMin, tMax] and
+   * never builds intersection data.
+   *
+   * @param ray The ray to test, its tMin is the lower bound of the query
+   * @param tMax Hits beyond this distance are ignored
+   * @return true if some primitive is hit in [tMin, tMax]
+   */
+  bool occluded(const Ray& ray, double tMax) const;
+
   /**
    * @brief Check if a point is in shadow from a specific light
    * @param point The point to check
@@ -157,8 +306,185 @@ class Scene {
   std::vector<std::shared_ptr<ILight>> _lights;  ///< All lights in the scene
   double _ambientIntensity;   ///< Ambient light intensity [0.0 - 1.0]
   double _diffuseMultiplier;  ///< Diffuse light multiplier [0.0 - 1.0]
+  AcceleratorType _accelerator;  ///< Structure requested for finalize()
+  AcceleratorType _activeAccelerator;  ///< Structure finalize() built
+  BVH _bvh;    ///< Hierarchy over the bounded primitives
+  BVH4 _bvh4;  ///< Four-wide hierarchy, replaces _bvh when selected
+  Grid _grid;  ///< Uniform grid, replaces _bvh when selected
+  CompiledPrimitives _compiled;  ///< Render-time copy of _primitives
+  SphereBlock _spheres;  ///< Baked spheres, in leaf order with the BVH
+  std::vector<uint32_t>
+      _itemSpheres;  ///< Block index of each item, NOT_BAKED if none
+  std::vector<uint32_t>
+      _leafSpheres;  ///< First block index at each BVH leaf position
+  TriangleBlock _triangles;  ///< Baked triangles, in leaf order with the BVH
+  std::vector<uint32_t>
+      _itemTriangles;  ///< Block index of each item, NOT_BAKED if none
+  std::vector<uint32_t>
+      _leafTriangles;  ///< First block index at each BVH leaf position
+  std::vector<std::size_t>
+      _boundedPrimitives;  ///< Index in _primitives of each BVH item
+  std::vector<std::size_t>
+      _unboundedPrimitives;  ///< Index in _primitives of infinite primitives
+  bool _finalized;  ///< Whether the hierarchy matches _primitives
+  double _buildSahCost;  ///< SAH cost right after the last build
+  std::string _cachePath;  ///< Acceleration cache file, empty if disabled
+
+  /**
+   * @brief Test a primitive for a hit closer than the current best
+   *
+   * Primitives only report hits inside the ray interval and shrink its tMax
+   * when they do, so a reported hit is either closer than the current best
+   * or at the same distance.
+   *
+   * @param index Index of the primitive in _primitives
+   * @param ray The ray being traced, its tMax is the closest distance so far
+   * @param closest The closest hit found so far, with its primitive index
+   * @return true if the closest hit was replaced
+   * @see keepClosest()
+   */
+  bool testClosest(std::size_t index, const Ray& ray,
+                   std::optional<HitRecord>& closest) const;
+
+  /**
+   * @brief Build the surface data of the closest hit
+   * @param ray The traced ray
+   * @param hit The closest hit, with its primitive index
+   * @return The intersection with the primitive
+   */
+  Intersection computeSurface(const Ray& ray, const HitRecord& hit) const;
+
+  /**
+   * @brief Check if a primitive blocks a ray
+   * @param index Index of the primitive in _primitives
+   * @param ray The ray to test
+   * @param tMax Hits beyond this distance are ignored
+   * @return true if the primitive is hit in [tMin, tMax]
+   */
+  bool primitiveOccluded(std::size_t index, const Ray& ray,
+                         double tMax) const;
+
+  /**
+   * @brief Keep a hit if it is closer than the current best
+   *
+   * A tie goes to the lowest primitive index, as in the primitive blocks,
+   * so that the image does not depend on the order in which primitives are
+   * visited.
+   *
+   * @param hit The hit to consider, its primitive index already set
+   * @param closest The closest hit found so far, with its primitive index
+   * @return true if the closest hit was replaced
+   */
+  static bool keepClosest(const std::optional<HitRecord>& hit,
+                          std::optional<HitRecord>& closest);
+
+  /**
+   * @brief Test an acceleration structure item for a closer hit
+   * @param item Index of the item among the bounded primitives
+   * @param ray The ray being traced, its tMax is the closest distance so far
+   * @param closest The closest hit found so far, with its primitive index
+   * @return true if the closest hit was replaced
+   */
+  bool testItemClosest(std::size_t item, const Ray& ray,
+                       std::optional<HitRecord>& closest) const;
+
+  /**
+   * @brief Test the items of a BVH leaf for a closer hit
+   *
+   * The baked spheres and triangles of the leaf are tested together by
+   * their blocks, the other items one by one.
+   *
+   * @param first First position of the leaf in the BVH item order
+   * @param count Number of items in the leaf
+   * @param ray The ray being traced, its tMax is the closest distance so far
+   * @param closest The closest hit found so far, with its primitive index
+   * @return true if the closest hit was replaced
+   */
+  bool testLeafClosest(std::size_t first, std::size_t count, const Ray& ray,
+                       std::optional<HitRecord>& closest) const;
+
+  /**
+   * @brief Check if an acceleration structure item blocks a ray
+   * @param item Index of the item among the bounded primitives
+   * @param ray The ray to test
+   * @param tMax Hits beyond this distance are ignored
+   * @return true if the item is hit in [tMin, tMax]
+   */
+  bool itemOccluded(std::size_t item, const Ray& ray, double tMax) const;
+
+  /**
+   * @brief Check if some item of a BVH leaf blocks a ray
+   * @param first First position of the leaf in the BVH item order
+   * @param count Number of items in the leaf
+   * @param ray The ray to test
+   * @param tMax Hits beyond this distance are ignored
+   * @return true if some item of the leaf is hit in [tMin, tMax]
+   */
+  bool leafOccluded(std::size_t first, std::size_t count, const Ray& ray,
+                    double tMax) const;
+
+  /**
+   * @brief Compile the primitives and bake the bounded spheres and
+   * triangles into their blocks
+   *
+   * With the binary hierarchy, they are stored in its leaf order so that
+   * the spheres and the triangles of a leaf are contiguous; otherwise in
+   * item order.
+   */
+  void bakePrimitives();
+
+  /**
+   * @brief Sort the primitives by the kind of bounds they have
+   * @param bounded Receives the index of every bounded primitive
+   * @param unbounded Receives the index of every infinite primitive
+   * @return The world bounds of every bounded primitive
+   */
+  std::vector<AABB> classifyPrimitives(
+      std::vector<std::size_t>& bounded,
+      std::vector<std::size_t>& unbounded) const;
+
+  /**
+   * @brief Load the selected hierarchy from the cache file
+   * @param bounds The boxes of the bounded primitives
+   * @return true if loaded, false if it has to be built
+   */
+  bool loadCachedAcceleration(const std::vector<AABB>& bounds);
+
+  /**
+   * @brief Build the acceleration structure over the current primitives
+   * @param useCacheFile Whether to go through the cache file, false for
+   * the rebuilds of moved primitives
+   * @see finalize()
+   */
+  void buildAcceleration(bool useCacheFile);
+
+  /**
+   * @brief Drop the acceleration structure after the primitives changed
+   */
+  void invalidateAcceleration();
+
+  /**
+   * @brief Traverse the acceleration structure built by finalize()
+   * @see BVH::traverse()
+   */
+  template <typename Visitor>
+  bool traverseAccelerator(const Ray& ray, double& tMax,
+                           Visitor&& visitor) const;
 };
 
+// Template implementation (must be in header)
+template <typename Visitor>
+bool Scene::traverseAccelerator(const Ray& ray, double& tMax,
+                                Visitor&& visitor) const {
+  if (_activeAccelerator == AcceleratorType::BVH4) {
+    return _bvh4.traverse(ray, tMax, visitor);
+  }
+  if (_activeAccelerator == AcceleratorType::GRID) {
+    return _grid.traverse(ray, tMax, visitor);
+  }
+  return _bvh.traverse(ray, tMax, visitor);
+}
+
 }  // namespace RayTracer
 
 #endif /* !SCENE_HPP_ */
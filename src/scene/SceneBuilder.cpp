@@ -23,7 +23,9 @@ SceneBuilder::SceneBuilder()
       _primitives(),
       _lights(),
       _ambientIntensity(0.1),
-      _diffuseMultiplier(0.9) {}
+      _diffuseMultiplier(0.9),
+      _accelerator(AcceleratorType::AUTO),
+      _cachePath() {}
 
 SceneBuilder::~SceneBuilder() {}
 
@@ -33,6 +35,8 @@ SceneBuilder& SceneBuilder::reset() {
   _lights.clear();
   _ambientIntensity = 0.1;
   _diffuseMultiplier = 0.9;
+  _accelerator = AcceleratorType::AUTO;
+  _cachePath.clear();
   return *this;
 }
 
@@ -82,12 +86,24 @@ SceneBuilder& SceneBuilder::withDiffuseMultiplier(double multiplier) {
   return *this;
 }
 
+SceneBuilder& SceneBuilder::withAccelerator(AcceleratorType type) {
+  _accelerator = type;
+  return *this;
+}
+
+SceneBuilder& SceneBuilder::withAccelerationCache(const std::string& path) {
+  _cachePath = path;
+  return *this;
+}
+
 Scene SceneBuilder::build() const {
   Scene scene(_camera);
 
   // Set light properties
   scene.setAmbientLightIntensity(_ambientIntensity);
   scene.setDiffuseMultiplier(_diffuseMultiplier);
+  scene.setAccelerator(_accelerator);
+  scene.setAccelerationCache(_cachePath);
 
   // Add all primitives
   for (const auto& primitive : _primitives) {
@@ -99,6 +115,9 @@ Scene SceneBuilder::build() const {
     scene.addLight(light);
   }
 
+  // Build the acceleration structure once the primitive list is final
+  scene.finalize();
+
   return scene;
 }
 
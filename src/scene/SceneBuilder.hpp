@@ -18,6 +18,7 @@
 #define SCENEBUILDER_HPP_
 
 #include <memory>
+#include <string>
 #include "../../include/ILight.hpp"
 #include "../../include/IPrimitive.hpp"
 #include "Camera.hpp"
@@ -113,8 +114,25 @@ class SceneBuilder {
    */
   SceneBuilder& withDiffuseMultiplier(double multiplier);
 
+  /**
+   * @brief Set the acceleration structure of the scene
+   * @param type The acceleration structure type
+   * @return Reference to this builder
+   */
+  SceneBuilder& withAccelerator(AcceleratorType type);
+
+  /**
+   * @brief Set the acceleration structure cache file of the scene
+   * @param path The cache file, empty to disable the cache
+   * @return Reference to this builder
+   */
+  SceneBuilder& withAccelerationCache(const std::string& path);
+
   /**
    * @brief Build and return the Scene object
+   *
+   * The returned scene is finalized, ready to be rendered.
+   *
    * @return The constructed Scene
    */
   Scene build() const;
@@ -125,6 +143,8 @@ class SceneBuilder {
   std::vector<std::shared_ptr<ILight>> _lights;          ///< Lights to add
   double _ambientIntensity;   ///< Ambient light intensity
   double _diffuseMultiplier;  ///< Diffuse light multiplier
+  AcceleratorType _accelerator;  ///< Acceleration structure type
+  std::string _cachePath;        ///< Acceleration cache file, may be empty
 };
 
 }  // namespace RayTracer
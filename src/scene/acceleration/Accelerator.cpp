@@ -0,0 +1,57 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Acceleration structure selection implementation
+*/
+
+/**
+ * @file Accelerator.cpp
+ * @brief Implementation of the conversions between acceleration structure
+ * types and their names
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include "Accelerator.hpp"
+#include <stdexcept>
+#include "Grid.hpp"
+
+namespace RayTracer {
+
+AcceleratorType parseAcceleratorType(const std::string& name) {
+  if (name == "bvh") {
+    return AcceleratorType::BVH;
+  }
+  if (name == "bvh4") {
+    return AcceleratorType::BVH4;
+  }
+  if (name == "grid") {
+    return AcceleratorType::GRID;
+  }
+  if (name == "auto") {
+    return AcceleratorType::AUTO;
+  }
+  throw std::invalid_argument("Unknown accelerator: " + name +
+                              " (expected bvh, bvh4, grid or auto)");
+}
+
+std::string acceleratorTypeName(AcceleratorType type) {
+  switch (type) {
+    case AcceleratorType::BVH4:
+      return "bvh4";
+    case AcceleratorType::GRID:
+      return "grid";
+    case AcceleratorType::AUTO:
+      return "auto";
+    default:
+      return "bvh";
+  }
+}
+
+AcceleratorType chooseAccelerator(const std::vector<AABB>& bounds) {
+  return Grid::suits(bounds) ? AcceleratorType::GRID : AcceleratorType::BVH;
+}
+
+}  // namespace RayTracer
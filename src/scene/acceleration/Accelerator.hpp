@@ -0,0 +1,64 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Acceleration structure selection header
+*/
+
+/**
+ * @file Accelerator.hpp
+ * @brief Definition of the AcceleratorType enum, the acceleration structures
+ * a scene can be built with
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#ifndef ACCELERATOR_HPP_
+#define ACCELERATOR_HPP_
+
+#include <string>
+#include <vector>
+#include "../../core/AABB.hpp"
+
+namespace RayTracer {
+
+/**
+ * @brief Acceleration structure used by a scene for its bounded primitives
+ */
+enum class AcceleratorType {
+  BVH,   ///< Binary hierarchy, double precision boxes
+  BVH4,  ///< Four-wide hierarchy, quantized boxes tested with SIMD
+  GRID,  ///< Two-level uniform grid walked with a 3D-DDA
+  AUTO,  ///< Grid or binary hierarchy, chosen from the primitive boxes
+};
+
+/**
+ * @brief Parse the name of an acceleration structure
+ * @param name "bvh", "bvh4", "grid" or "auto"
+ * @return The matching type
+ * @throw std::invalid_argument if the name is unknown
+ */
+AcceleratorType parseAcceleratorType(const std::string& name);
+
+/**
+ * @brief Get the name of an acceleration structure
+ * @param type The type
+ * @return The name accepted by parseAcceleratorType()
+ */
+std::string acceleratorTypeName(AcceleratorType type);
+
+/**
+ * @brief Resolve AcceleratorType::AUTO for a set of primitive boxes
+ *
+ * Picks the grid for dense, evenly distributed scenes of small primitives,
+ * see Grid::suits(), and the binary hierarchy otherwise.
+ *
+ * @param bounds The box of every bounded primitive
+ * @return AcceleratorType::GRID or AcceleratorType::BVH
+ */
+AcceleratorType chooseAccelerator(const std::vector<AABB>& bounds);
+
+}  // namespace RayTracer
+
+#endif /* !ACCELERATOR_HPP_ */
@@ -0,0 +1,488 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Bounding volume hierarchy implementation
+*/
+
+/**
+ * @file BVH.cpp
+ * @brief Implementation of the binned SAH construction of the bounding volume
+ * hierarchy
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include "BVH.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <stdexcept>
+#include <utility>
+#include "../../core/ThreadPool.hpp"
+
+namespace RayTracer {
+
+namespace {
+
+/**
+ * @brief Depth after which nodes are split at the median instead of with SAH
+ *
+ * Keeps the tree depth within the fixed traversal stack even for pathological
+ * item distributions.
+ */
+constexpr std::size_t MAX_SAH_DEPTH = 32;
+
+double nodeArea(const BVH::Node& node) {
+  double x = node.max[0] - node.min[0];
+  double y = node.max[1] - node.min[1];
+  double z = node.max[2] - node.min[2];
+  return 2.0 * (x * y + y * z + z * x);
+}
+
+double axisValue(const Vector3D& vector, int axis) {
+  if (axis == 0) {
+    return vector.getX();
+  }
+  return axis == 1 ? vector.getY() : vector.getZ();
+}
+
+struct Bin {
+  AABB bounds;            ///< Union of the boxes in the bin
+  std::size_t count = 0;  ///< Number of items in the bin
+};
+
+using Bins = std::array<Bin, BVH::BIN_COUNT>;
+
+struct RangeBounds {
+  AABB bounds;     ///< Union of the item boxes
+  AABB centroids;  ///< Bounds of the item centroids
+};
+
+/**
+ * @brief Reduce a range of item positions, in parallel chunks if large
+ *
+ * `accumulate(Partial&, begin, end)` folds a sub-range into a partial result
+ * and `merge(Partial&, const Partial&)` combines two of them. Both only use
+ * unions and sums, so the result does not depend on the chunking.
+ */
+template <typename Partial, typename Accumulate, typename Merge>
+Partial reduceRange(ThreadPool* pool, std::size_t begin, std::size_t end,
+                    const Accumulate& accumulate, const Merge& merge) {
+  Partial result{};
+  std::size_t itemCount = end - begin;
+  if (pool == nullptr || pool->size() < 2 ||
+      itemCount < BVH::PARALLEL_BINNING_THRESHOLD) {
+    accumulate(result, begin, end);
+    return result;
+  }
+
+  // One chunk per worker and one for the calling thread
+  std::size_t chunkCount = pool->size() + 1;
+  std::vector<Partial> partials(chunkCount);
+  pool->parallelFor(0, chunkCount, 1, [&](std::size_t first, std::size_t last) {
+    for (std::size_t chunk = first; chunk < last; ++chunk) {
+      accumulate(partials[chunk], begin + itemCount * chunk / chunkCount,
+                 begin + itemCount * (chunk + 1) / chunkCount);
+    }
+  });
+  for (const auto& partial : partials) {
+    merge(result, partial);
+  }
+  return result;
+}
+
+}  // namespace
+
+BVH::BVH() : _nodes(), _itemIndices(), _stats() {}
+
+void BVH::build(const std::vector<AABB>& bounds, ThreadPool* pool) {
+  auto start = std::chrono::steady_clock::now();
+  clear();
+  if (bounds.empty()) {
+    return;
+  }
+
+  std::vector<Vector3D> centroids;
+  centroids.reserve(bounds.size());
+  for (const auto& box : bounds) {
+    centroids.push_back(box.centroid());
+  }
+
+  _itemIndices.resize(bounds.size());
+  for (std::size_t i = 0; i < bounds.size(); ++i) {
+    _itemIndices[i] = static_cast<uint32_t>(i);
+  }
+
+  _nodes.reserve(2 * bounds.size());
+  if (pool == nullptr || pool->size() < 2 ||
+      bounds.size() < PARALLEL_BUILD_THRESHOLD) {
+    buildRecursive(bounds, centroids, _nodes, 0, bounds.size(), 0);
+  } else {
+    // Small enough subtrees become tasks, several per thread so that
+    // unbalanced splits still keep every worker busy
+    std::size_t taskSize = std::max(
+        PARALLEL_BUILD_THRESHOLD / 4,
+        bounds.size() / (pool->size() * TASKS_PER_THREAD));
+    std::vector<TopNode> top;
+    std::deque<std::vector<Node>> subtrees;
+    std::vector<std::future<void>> tasks;
+    buildTopLevel(bounds, centroids, *pool, taskSize, 0, bounds.size(), 0,
+                  top, subtrees, tasks);
+    for (auto& task : tasks) {
+      task.get();
+    }
+    flatten(top, subtrees, 0);
+    _stats.taskCount = tasks.size();
+  }
+
+  computeStats();
+  _stats.itemCount = bounds.size();
+  _stats.buildMilliseconds =
+      std::chrono::duration<double, std::milli>(
+          std::chrono::steady_clock::now() - start)
+          .count();
+}
+
+void BVH::refit(const std::vector<AABB>& bounds) {
+  auto start = std::chrono::steady_clock::now();
+  if (bounds.size() != _itemIndices.size()) {
+    throw std::invalid_argument("BVH refit: item count differs from build");
+  }
+  if (_nodes.empty()) {
+    return;
+  }
+
+  // Children are stored after their parent, so a reverse sweep sees every
+  // child before the node that encloses it
+  double cost = 0.0;
+  for (std::size_t i = _nodes.size(); i-- > 0;) {
+    Node& node = _nodes[i];
+    if (node.count > 0) {
+      AABB box;
+      for (uint32_t k = 0; k < node.count; ++k) {
+        box.expand(bounds[_itemIndices[node.offset + k]]);
+      }
+      const Vector3D& min = box.getMin();
+      const Vector3D& max = box.getMax();
+      for (int axis = 0; axis < 3; ++axis) {
+        node.min[axis] = axisValue(min, axis);
+        node.max[axis] = axisValue(max, axis);
+      }
+      cost += nodeArea(node) * node.count;
+    } else {
+      const Node& first = _nodes[i + 1];
+      const Node& second = _nodes[node.offset];
+      for (int axis = 0; axis < 3; ++axis) {
+        node.min[axis] = std::min(first.min[axis], second.min[axis]);
+        node.max[axis] = std::max(first.max[axis], second.max[axis]);
+      }
+      cost += nodeArea(node) * TRAVERSAL_COST;
+    }
+  }
+
+  double rootArea = nodeArea(_nodes[0]);
+  _stats.sahCost = rootArea > 0 ? cost / rootArea : 0.0;
+  _stats.refitCount++;
+  _stats.refitMilliseconds =
+      std::chrono::duration<double, std::milli>(
+          std::chrono::steady_clock::now() - start)
+          .count();
+}
+
+void BVH::assign(std::vector<Node> nodes, std::vector<uint32_t> itemIndices,
+                 const BuildStats& stats) {
+  _nodes = std::move(nodes);
+  _itemIndices = std::move(itemIndices);
+  _stats = stats;
+}
+
+void BVH::clear() {
+  _nodes.clear();
+  _itemIndices.clear();
+  _stats = BuildStats();
+}
+
+bool BVH::isEmpty() const {
+  return _nodes.empty();
+}
+
+std::size_t BVH::getNodeCount() const {
+  return _nodes.size();
+}
+
+const std::vector<BVH::Node>& BVH::getNodes() const {
+  return _nodes;
+}
+
+const std::vector<uint32_t>& BVH::getItemIndices() const {
+  return _itemIndices;
+}
+
+const BVH::BuildStats& BVH::getBuildStats() const {
+  return _stats;
+}
+
+AABB BVH::getBounds() const {
+  if (_nodes.empty()) {
+    return AABB();
+  }
+  const Node& root = _nodes[0];
+  return AABB(Vector3D(root.min[0], root.min[1], root.min[2]),
+              Vector3D(root.max[0], root.max[1], root.max[2]));
+}
+
+bool BVH::splitRange(const std::vector<AABB>& bounds,
+                     const std::vector<Vector3D>& centroids,
+                     std::size_t begin, std::size_t end, std::size_t depth,
+                     ThreadPool* pool, Node& node, int& axis,
+                     std::size_t& mid) {
+  RangeBounds range = reduceRange<RangeBounds>(
+      pool, begin, end,
+      [&](RangeBounds& partial, std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+          partial.bounds.expand(bounds[_itemIndices[i]]);
+          partial.centroids.expand(centroids[_itemIndices[i]]);
+        }
+      },
+      [](RangeBounds& result, const RangeBounds& partial) {
+        result.bounds.expand(partial.bounds);
+        result.centroids.expand(partial.centroids);
+      });
+  const AABB& nodeBounds = range.bounds;
+  const AABB& centroidBounds = range.centroids;
+
+  for (int i = 0; i < 3; ++i) {
+    node.min[i] = axisValue(nodeBounds.getMin(), i);
+    node.max[i] = axisValue(nodeBounds.getMax(), i);
+  }
+  node.offset = static_cast<uint32_t>(begin);
+  node.count = static_cast<uint16_t>(end - begin);
+  node.axis = 0;
+
+  std::size_t itemCount = end - begin;
+  if (itemCount <= 1) {
+    return false;
+  }
+
+  axis = centroidBounds.longestAxis();
+  double centroidMin = axisValue(centroidBounds.getMin(), axis);
+  double centroidMax = axisValue(centroidBounds.getMax(), axis);
+
+  if (centroidMax <= centroidMin) {
+    // Every centroid coincides: no split can separate the items
+    if (itemCount <= std::numeric_limits<uint16_t>::max()) {
+      return false;
+    }
+    mid = begin + itemCount / 2;
+    return true;
+  }
+
+  if (depth >= MAX_SAH_DEPTH) {
+    if (itemCount <= MAX_LEAF_SIZE) {
+      return false;
+    }
+    mid = begin + itemCount / 2;
+    std::nth_element(_itemIndices.begin() + begin, _itemIndices.begin() + mid,
+                     _itemIndices.begin() + end,
+                     [&](uint32_t a, uint32_t b) {
+                       return axisValue(centroids[a], axis) <
+                              axisValue(centroids[b], axis);
+                     });
+    return true;
+  }
+
+  double scale = BIN_COUNT / (centroidMax - centroidMin);
+  auto binOf = [&](uint32_t item) {
+    int bin = static_cast<int>(
+        (axisValue(centroids[item], axis) - centroidMin) * scale);
+    return std::clamp(bin, 0, BIN_COUNT - 1);
+  };
+  Bins bins = reduceRange<Bins>(
+      pool, begin, end,
+      [&](Bins& partial, std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+          Bin& bin = partial[binOf(_itemIndices[i])];
+          bin.bounds.expand(bounds[_itemIndices[i]]);
+          bin.count++;
+        }
+      },
+      [](Bins& result, const Bins& partial) {
+        for (int i = 0; i < BIN_COUNT; ++i) {
+          result[i].bounds.expand(partial[i].bounds);
+          result[i].count += partial[i].count;
+        }
+      });
+
+  // Sweep from the right to get the cost of every right-hand side
+  std::array<double, BIN_COUNT - 1> rightArea;
+  std::array<std::size_t, BIN_COUNT - 1> rightCount;
+  AABB rightBounds;
+  std::size_t rightItems = 0;
+  for (int i = BIN_COUNT - 1; i > 0; --i) {
+    rightBounds.expand(bins[i].bounds);
+    rightItems += bins[i].count;
+    rightArea[i - 1] = rightBounds.surfaceArea();
+    rightCount[i - 1] = rightItems;
+  }
+
+  AABB leftBounds;
+  std::size_t leftItems = 0;
+  double bestCost = std::numeric_limits<double>::infinity();
+  int bestSplit = -1;
+  for (int i = 0; i < BIN_COUNT - 1; ++i) {
+    leftBounds.expand(bins[i].bounds);
+    leftItems += bins[i].count;
+    if (leftItems == 0 || rightCount[i] == 0) {
+      continue;
+    }
+    double cost =
+        leftItems * leftBounds.surfaceArea() + rightCount[i] * rightArea[i];
+    if (cost < bestCost) {
+      bestCost = cost;
+      bestSplit = i;
+    }
+  }
+
+  double parentArea = nodeBounds.surfaceArea();
+  double leafCost = static_cast<double>(itemCount);
+  double splitCost =
+      parentArea > 0 ? TRAVERSAL_COST + bestCost / parentArea : bestCost;
+  if (itemCount <= MAX_LEAF_SIZE && (bestSplit < 0 || leafCost <= splitCost)) {
+    return false;
+  }
+
+  if (bestSplit < 0) {
+    mid = begin + itemCount / 2;
+  } else {
+    auto split = std::partition(
+        _itemIndices.begin() + begin, _itemIndices.begin() + end,
+        [&](uint32_t item) { return binOf(item) <= bestSplit; });
+    mid = static_cast<std::size_t>(split - _itemIndices.begin());
+  }
+  return true;
+}
+
+uint32_t BVH::buildRecursive(const std::vector<AABB>& bounds,
+                             const std::vector<Vector3D>& centroids,
+                             std::vector<Node>& nodes, std::size_t begin,
+                             std::size_t end, std::size_t depth) {
+  uint32_t nodeIndex = static_cast<uint32_t>(nodes.size());
+  nodes.push_back(Node());
+
+  int axis = 0;
+  std::size_t mid = begin;
+  if (!splitRange(bounds, centroids, begin, end, depth, nullptr,
+                  nodes[nodeIndex], axis, mid)) {
+    return nodeIndex;
+  }
+
+  buildRecursive(bounds, centroids, nodes, begin, mid, depth + 1);
+  uint32_t secondChild =
+      buildRecursive(bounds, centroids, nodes, mid, end, depth + 1);
+
+  Node& interior = nodes[nodeIndex];
+  interior.offset = secondChild;
+  interior.count = 0;
+  interior.axis = static_cast<uint8_t>(axis);
+  return nodeIndex;
+}
+
+uint32_t BVH::buildTopLevel(const std::vector<AABB>& bounds,
+                            const std::vector<Vector3D>& centroids,
+                            ThreadPool& pool, std::size_t taskSize,
+                            std::size_t begin, std::size_t end,
+                            std::size_t depth, std::vector<TopNode>& top,
+                            std::deque<std::vector<Node>>& subtrees,
+                            std::vector<std::future<void>>& tasks) {
+  uint32_t topIndex = static_cast<uint32_t>(top.size());
+  top.push_back(TopNode());
+
+  if (end - begin <= taskSize) {
+    // Tasks work on disjoint ranges of _itemIndices and their own node array
+    std::vector<Node>& subtree = subtrees.emplace_back();
+    top[topIndex].subtree = static_cast<int>(subtrees.size() - 1);
+    tasks.push_back(pool.enqueue(
+        [this, &bounds, &centroids, &subtree, begin, end, depth]() {
+          subtree.reserve(2 * (end - begin));
+          buildRecursive(bounds, centroids, subtree, begin, end, depth);
+        }));
+    return topIndex;
+  }
+
+  Node node;
+  int axis = 0;
+  std::size_t mid = begin;
+  if (!splitRange(bounds, centroids, begin, end, depth, &pool, node, axis,
+                  mid)) {
+    top[topIndex].node = node;
+    return topIndex;
+  }
+  node.count = 0;
+  node.axis = static_cast<uint8_t>(axis);
+  top[topIndex].node = node;
+
+  uint32_t left = buildTopLevel(bounds, centroids, pool, taskSize, begin, mid,
+                                depth + 1, top, subtrees, tasks);
+  uint32_t right = buildTopLevel(bounds, centroids, pool, taskSize, mid, end,
+                                 depth + 1, top, subtrees, tasks);
+  top[topIndex].left = left;
+  top[topIndex].right = right;
+  return topIndex;
+}
+
+uint32_t BVH::flatten(const std::vector<TopNode>& top,
+                      const std::deque<std::vector<Node>>& subtrees,
+                      uint32_t index) {
+  const TopNode& topNode = top[index];
+  uint32_t nodeIndex = static_cast<uint32_t>(_nodes.size());
+
+  if (topNode.subtree >= 0) {
+    // Child offsets of a task subtree are relative to its own array
+    for (Node node : subtrees[topNode.subtree]) {
+      if (node.count == 0) {
+        node.offset += nodeIndex;
+      }
+      _nodes.push_back(node);
+    }
+    return nodeIndex;
+  }
+
+  _nodes.push_back(topNode.node);
+  if (topNode.node.count == 0) {
+    flatten(top, subtrees, topNode.left);
+    _nodes[nodeIndex].offset = flatten(top, subtrees, topNode.right);
+  }
+  return nodeIndex;
+}
+
+void BVH::computeStats() {
+  _stats.nodeCount = _nodes.size();
+  if (_nodes.empty()) {
+    return;
+  }
+
+  double cost = 0.0;
+  std::vector<std::pair<uint32_t, std::size_t>> stack = {{0, 0}};
+  while (!stack.empty()) {
+    auto [index, depth] = stack.back();
+    stack.pop_back();
+    const Node& node = _nodes[index];
+    if (node.count > 0) {
+      _stats.leafCount++;
+      _stats.maxDepth = std::max(_stats.maxDepth, depth);
+      _stats.maxLeafSize =
+          std::max(_stats.maxLeafSize, static_cast<std::size_t>(node.count));
+      cost += nodeArea(node) * node.count;
+    } else {
+      cost += nodeArea(node) * TRAVERSAL_COST;
+      stack.push_back({index + 1, depth + 1});
+      stack.push_back({node.offset, depth + 1});
+    }
+  }
+  double rootArea = nodeArea(_nodes[0]);
+  _stats.sahCost = rootArea > 0 ? cost / rootArea : 0.0;
+}
+
+}  // namespace RayTracer
@@ -0,0 +1,688 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Bounding volume hierarchy header
+*/
+
+/**
+ * @file BVH.hpp
+ * @brief Definition of the BVH class, a bounding volume hierarchy built with
+ * the surface area heuristic to accelerate ray queries
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#ifndef BVH_HPP_
+#define BVH_HPP_
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include "../../core/AABB.hpp"
+#include "../../core/Ray.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace RayTracer {
+
+class ThreadPool;
+
+/**
+ * @brief Bounding volume hierarchy over a set of bounding boxes
+ *
+ * The hierarchy only knows about boxes: item i of the build input is reported
+ * back to the caller as index i during traversal, so the owner decides what
+ * an item is (a primitive, a triangle of a mesh, ...).
+ *
+ * Nodes are stored in a flat array in depth-first order. The first child of
+ * an interior node immediately follows it, the second child is stored at
+ * `offset`. Leaves reference `count` consecutive entries of the item index
+ * array starting at `offset`.
+ */
+class BVH {
+ public:
+  /**
+   * @brief Flattened BVH node
+   */
+  struct Node {
+    double min[3];    ///< Minimum corner of the node bounds
+    double max[3];    ///< Maximum corner of the node bounds
+    uint32_t offset;  ///< First item (leaf) or second child index (interior)
+    uint16_t count;   ///< Number of items, 0 for interior nodes
+    uint8_t axis;     ///< Split axis, used to order child traversal
+  };
+
+  /**
+   * @brief Statistics gathered by the last build
+   */
+  struct BuildStats {
+    double buildMilliseconds = 0.0;  ///< Wall-clock duration of the build
+    std::size_t itemCount = 0;       ///< Number of items in the hierarchy
+    std::size_t nodeCount = 0;       ///< Number of nodes, leaves included
+    std::size_t leafCount = 0;       ///< Number of leaves
+    std::size_t maxDepth = 0;        ///< Depth of the deepest leaf, root is 0
+    std::size_t maxLeafSize = 0;     ///< Largest number of items in a leaf
+    double sahCost = 0.0;       ///< SAH cost of the tree relative to the root
+    std::size_t taskCount = 0;  ///< Subtrees built as thread pool tasks
+    std::size_t refitCount = 0;  ///< Refits since the build
+    double refitMilliseconds = 0.0;  ///< Wall-clock duration of the last refit
+    bool fromCache = false;  ///< Loaded from a cache, the time is the load's
+  };
+
+  /**
+   * @brief Default constructor
+   * Creates an empty hierarchy
+   */
+  BVH();
+
+  /**
+   * @brief Build the hierarchy over a set of boxes
+   *
+   * Uses a binned surface area heuristic. Boxes must be bounded; unbounded
+   * items have to be handled by the caller outside of the hierarchy.
+   *
+   * With a thread pool, the top of the tree is split on the calling thread,
+   * binning large ranges in parallel chunks, and every subtree small enough
+   * is then built as its own pool task. The result is the same tree as the
+   * serial build. The pool workers must not be the caller.
+   *
+   * @param bounds The box of every item
+   * @param pool Pool running the build tasks, nullptr to build serially
+   */
+  void build(const std::vector<AABB>& bounds, ThreadPool* pool = nullptr);
+
+  /**
+   * @brief Update the node bounds after the items moved
+   *
+   * Keeps the topology of the last build and recomputes every box bottom-up
+   * in a single pass over the nodes, then updates the SAH cost so that the
+   * caller can tell when the tree degraded enough to be rebuilt.
+   *
+   * @param bounds The new box of every item, same items as the last build
+   * @throw std::invalid_argument if the item count differs from the build
+   */
+  void refit(const std::vector<AABB>& bounds);
+
+  /**
+   * @brief Replace the hierarchy with the result of an earlier build
+   *
+   * Used to restore a hierarchy saved by BVHCache. The arrays are taken as
+   * they are, they must come from getNodes() and getItemIndices().
+   *
+   * @param nodes The flattened nodes
+   * @param itemIndices The item order referenced by the leaves
+   * @param stats The statistics of the build that produced them
+   */
+  void assign(std::vector<Node> nodes, std::vector<uint32_t> itemIndices,
+              const BuildStats& stats);
+
+  /**
+   * @brief Remove every node and item
+   */
+  void clear();
+
+  /**
+   * @brief Check if the hierarchy contains no item
+   * @return true if empty, false otherwise
+   */
+  bool isEmpty() const;
+
+  /**
+   * @brief Get the number of nodes
+   * @return The node count
+   */
+  std::size_t getNodeCount() const;
+
+  /**
+   * @brief Get the flattened nodes
+   * @return The node array, root first
+   */
+  const std::vector<Node>& getNodes() const;
+
+  /**
+   * @brief Get the item order referenced by the leaves
+   * @return The item index of every leaf position
+   */
+  const std::vector<uint32_t>& getItemIndices() const;
+
+  /**
+   * @brief Get the statistics of the last build
+   * @return The build statistics, all zero if nothing was built
+   */
+  const BuildStats& getBuildStats() const;
+
+  /**
+   * @brief Get the bounds of the whole hierarchy
+   * @return The root bounds, or an empty box if the hierarchy is empty
+   */
+  AABB getBounds() const;
+
+  /**
+   * @brief Visit the items whose boxes are hit by a ray
+   *
+   * Nodes are visited front to back. The visitor is called as
+   * `bool visitor(std::size_t item, double& tMax)` and may shrink tMax to
+   * prune farther nodes; returning true stops the traversal, which is what
+   * any-hit queries need. Nodes ending before the ray tMin are skipped.
+   *
+   * @param ray The ray, its direction does not need to be normalized
+   * @param tMax Upper bound of the ray parameter, updated by the visitor
+   * @param visitor The callback run for every candidate item
+   * @return true if the visitor stopped the traversal, false otherwise
+   */
+  template <typename Visitor>
+  bool traverse(const Ray& ray, double& tMax, Visitor&& visitor) const;
+
+  /**
+   * @brief Visit the leaves whose boxes are hit by a ray
+   *
+   * Same as traverse(), but the visitor gets the items of a whole leaf at
+   * once, as a range of getItemIndices(): it is called as
+   * `bool visitor(std::size_t first, std::size_t count, double& tMax)`.
+   * Owners that store item data in leaf order read it contiguously.
+   *
+   * @param ray The ray, its direction does not need to be normalized
+   * @param tMax Upper bound of the ray parameter, updated by the visitor
+   * @param visitor The callback run for every candidate leaf
+   * @return true if the visitor stopped the traversal, false otherwise
+   */
+  template <typename LeafVisitor>
+  bool traverseLeaves(const Ray& ray, double& tMax,
+                      LeafVisitor&& visitor) const;
+
+  /**
+   * @brief Visit the items whose boxes are hit by a packet of rays
+   *
+   * The packet walks the tree as one: every node is fetched once and tested
+   * against all its rays together, two at a time with SSE2. Children are
+   * ordered with the direction of the first ray, so the packet should be
+   * coherent, like the primary rays of neighbouring pixels. The visitor is
+   * called as `bool visitor(std::size_t item, std::size_t ray, double& tMax)`
+   * for every ray of the packet reaching a leaf; returning true retires
+   * that ray. Subtrees reached by too few rays of the packet, see
+   * PACKET_SPLIT_DIVISOR, are finished ray by ray with traverse().
+   *
+   * Every ray ends up visiting the items traverse() would visit for it, so
+   * visitors whose result does not depend on the visit order get the same
+   * result either way.
+   *
+   * @param rays The rays of the packet
+   * @param count Number of rays, at most MAX_PACKET_SIZE
+   * @param tMax Upper bound of every ray parameter, updated by the visitor
+   * @param visitor The callback run for every candidate item and ray
+   * @throw std::invalid_argument if the packet is too large
+   */
+  template <typename Visitor>
+  void traversePacket(const Ray* rays, std::size_t count, double* tMax,
+                      Visitor&& visitor) const;
+
+  /**
+   * @brief Visit the leaves whose boxes are hit by a packet of rays
+   *
+   * Same as traversePacket(), with a leaf visitor called as
+   * `bool visitor(std::size_t first, std::size_t count, std::size_t ray,
+   * double& tMax)`, see traverseLeaves().
+   *
+   * @param rays The rays of the packet
+   * @param count Number of rays, at most MAX_PACKET_SIZE
+   * @param tMax Upper bound of every ray parameter, updated by the visitor
+   * @param visitor The callback run for every candidate leaf and ray
+   * @throw std::invalid_argument if the packet is too large
+   */
+  template <typename LeafVisitor>
+  void traversePacketLeaves(const Ray* rays, std::size_t count, double* tMax,
+                            LeafVisitor&& visitor) const;
+
+  static constexpr std::size_t MAX_PACKET_SIZE = 16;  ///< Rays per packet
+  static constexpr std::size_t PACKET_SPLIT_DIVISOR =
+      4;  ///< Nodes reached by at most 1/N of a packet are traced per ray
+  static constexpr std::size_t MAX_LEAF_SIZE = 4;  ///< Forced leaf threshold
+  static constexpr double TRAVERSAL_COST =
+      0.125;  ///< Cost of traversing a node relative to testing an item
+  static constexpr int BIN_COUNT = 12;  ///< Number of SAH buckets per axis
+  static constexpr std::size_t PARALLEL_BUILD_THRESHOLD =
+      4096;  ///< Items below which a parallel build is not worth it
+  static constexpr std::size_t PARALLEL_BINNING_THRESHOLD =
+      32768;  ///< Range size from which a node is binned in parallel chunks
+  static constexpr std::size_t TASKS_PER_THREAD =
+      4;  ///< Subtree tasks per pool thread, to balance uneven subtrees
+
+ private:
+  /**
+   * @brief Node of the top of the tree during a parallel build
+   */
+  struct TopNode {
+    Node node;           ///< The node, its offset is fixed up when flattened
+    uint32_t left = 0;   ///< First child in the top node array
+    uint32_t right = 0;  ///< Second child in the top node array
+    int subtree = -1;    ///< Subtree built by a task instead of this node
+  };
+
+  std::vector<Node> _nodes;            ///< Flattened nodes, root first
+  std::vector<uint32_t> _itemIndices;  ///< Item order referenced by leaves
+  BuildStats _stats;                   ///< Statistics of the last build
+
+  /**
+   * @brief Compute the bounds of a node and choose where to split it
+   * @param bounds The box of every item
+   * @param centroids The centroid of every item
+   * @param begin First position in _itemIndices
+   * @param end One past the last position in _itemIndices
+   * @param depth Depth of the node
+   * @param pool Pool to bin large ranges with, may be nullptr
+   * @param node Receives the node bounds and its leaf item range
+   * @param axis Set to the split axis when the node is split
+   * @param mid Set to the first position of the second child when split
+   * @return true if the node is split, false if it is a leaf
+   */
+  bool splitRange(const std::vector<AABB>& bounds,
+                  const std::vector<Vector3D>& centroids, std::size_t begin,
+                  std::size_t end, std::size_t depth, ThreadPool* pool,
+                  Node& node, int& axis, std::size_t& mid);
+
+  /**
+   * @brief Recursively build the subtree over a range of items
+   * @param bounds The box of every item
+   * @param centroids The centroid of every item
+   * @param nodes Array receiving the subtree, offsets are indices in it
+   * @param begin First position in _itemIndices
+   * @param end One past the last position in _itemIndices
+   * @param depth Depth of the created node
+   * @return Index of the created node in nodes
+   */
+  uint32_t buildRecursive(const std::vector<AABB>& bounds,
+                          const std::vector<Vector3D>& centroids,
+                          std::vector<Node>& nodes, std::size_t begin,
+                          std::size_t end, std::size_t depth);
+
+  /**
+   * @brief Split the top of the tree and hand the subtrees to the pool
+   * @param bounds The box of every item
+   * @param centroids The centroid of every item
+   * @param pool Pool running the subtree tasks
+   * @param taskSize Ranges up to this size become a single task
+   * @param begin First position in _itemIndices
+   * @param end One past the last position in _itemIndices
+   * @param depth Depth of the created node
+   * @param top Receives the top nodes
+   * @param subtrees Receives one node array per task
+   * @param tasks Receives the future of every task
+   * @return Index of the created node in top
+   */
+  uint32_t buildTopLevel(const std::vector<AABB>& bounds,
+                         const std::vector<Vector3D>& centroids,
+                         ThreadPool& pool, std::size_t taskSize,
+                         std::size_t begin, std::size_t end, std::size_t depth,
+                         std::vector<TopNode>& top,
+                         std::deque<std::vector<Node>>& subtrees,
+                         std::vector<std::future<void>>& tasks);
+
+  /**
+   * @brief Append the top of the tree and the task subtrees to _nodes
+   * @param top The top nodes
+   * @param subtrees The subtree built by every task
+   * @param index Index of the top node to append
+   * @return Index of the appended node in _nodes
+   */
+  uint32_t flatten(const std::vector<TopNode>& top,
+                   const std::deque<std::vector<Node>>& subtrees,
+                   uint32_t index);
+
+  /**
+   * @brief Fill the node statistics of _stats from _nodes
+   */
+  void computeStats();
+
+  /**
+   * @brief Slab test of a ray against a node
+   * @param node The node to test
+   * @param origin The ray origin
+   * @param invDir The inverse of the ray direction
+   * @param tMin Lower bound of the ray parameter
+   * @param tMax Upper bound of the ray parameter
+   * @param tNear Set to the entry parameter on hit
+   * @return true if the ray enters the node before tMax
+   */
+  static bool intersectNode(const Node& node, const double origin[3],
+                            const double invDir[3], double tMin, double tMax,
+                            double& tNear);
+
+  /**
+   * @brief Packet rays in structure of arrays layout
+   *
+   * An odd packet is padded with a copy of its first ray, so that SIMD loads
+   * of lane pairs always read initialized values.
+   */
+  struct Packet {
+    alignas(16) double origin[3][MAX_PACKET_SIZE];  ///< Ray origins
+    alignas(16) double invDir[3][MAX_PACKET_SIZE];  ///< Inverse directions
+    alignas(16) double tMin[MAX_PACKET_SIZE];       ///< Interval starts
+    alignas(16) double tMax[MAX_PACKET_SIZE];       ///< Interval ends
+    std::size_t count;                              ///< Number of rays
+  };
+
+  /**
+   * @brief Slab test of a packet against a node
+   * @param node The node to test
+   * @param packet The packet rays
+   * @param mask Rays to test, one bit per ray
+   * @return The rays of mask entering the node before their tMax
+   */
+  static uint32_t intersectNodePacket(const Node& node, const Packet& packet,
+                                      uint32_t mask);
+
+  /**
+   * @brief Visit the leaves of a subtree whose boxes are hit by a ray
+   * @param root Index of the subtree root
+   * @param ray The ray
+   * @param tMax Upper bound of the ray parameter, updated by the visitor
+   * @param visitor The callback run for every candidate leaf
+   * @return true if the visitor stopped the traversal, false otherwise
+   * @see traverseLeaves()
+   */
+  template <typename LeafVisitor>
+  bool traverseSubtree(uint32_t root, const Ray& ray, double& tMax,
+                       LeafVisitor& visitor) const;
+};
+
+// Template implementation (must be in header)
+inline bool BVH::intersectNode(const Node& node, const double origin[3],
+                               const double invDir[3], double tMin,
+                               double tMax, double& tNear) {
+  double t0 = tMin;
+  double t1 = tMax * (1.0 + SLAB_EPSILON);
+  for (int axis = 0; axis < 3; ++axis) {
+    double tA = (node.min[axis] - origin[axis]) * invDir[axis];
+    double tB = (node.max[axis] - origin[axis]) * invDir[axis];
+    if (tA > tB) {
+      double tmp = tA;
+      tA = tB;
+      tB = tmp;
+    }
+    tB *= 1.0 + SLAB_EPSILON;
+    // Written so that NaN (0 * inf on a slab boundary) keeps the old bound
+    t0 = tA > t0 ? tA : t0;
+    t1 = tB < t1 ? tB : t1;
+    if (t0 > t1) {
+      return false;
+    }
+  }
+  tNear = t0;
+  return true;
+}
+
+inline uint32_t BVH::intersectNodePacket(const Node& node,
+                                         const Packet& packet,
+                                         uint32_t mask) {
+  uint32_t hits = 0;
+#if defined(__SSE2__)
+  // Same operations as intersectNode(), so both agree on every ray
+  const __m128d widen = _mm_set1_pd(1.0 + SLAB_EPSILON);
+  for (std::size_t i = 0; i < packet.count; i += 2) {
+    if (((mask >> i) & 3u) == 0) {
+      continue;
+    }
+    __m128d t0 = _mm_load_pd(packet.tMin + i);
+    __m128d t1 = _mm_mul_pd(_mm_load_pd(packet.tMax + i), widen);
+    for (int axis = 0; axis < 3; ++axis) {
+      __m128d origin = _mm_load_pd(packet.origin[axis] + i);
+      __m128d invDir = _mm_load_pd(packet.invDir[axis] + i);
+      __m128d tA =
+          _mm_mul_pd(_mm_sub_pd(_mm_set1_pd(node.min[axis]), origin), invDir);
+      __m128d tB =
+          _mm_mul_pd(_mm_sub_pd(_mm_set1_pd(node.max[axis]), origin), invDir);
+      __m128d swap = _mm_cmpgt_pd(tA, tB);
+      __m128d near =
+          _mm_or_pd(_mm_and_pd(swap, tB), _mm_andnot_pd(swap, tA));
+      __m128d far = _mm_or_pd(_mm_and_pd(swap, tA), _mm_andnot_pd(swap, tB));
+      // max/min return their second operand on NaN: the old bound is kept
+      t0 = _mm_max_pd(near, t0);
+      t1 = _mm_min_pd(_mm_mul_pd(far, widen), t1);
+    }
+    hits |= static_cast<uint32_t>(_mm_movemask_pd(_mm_cmple_pd(t0, t1))) << i;
+  }
+#else
+  for (std::size_t i = 0; i < packet.count; ++i) {
+    if ((mask >> i) & 1u) {
+      const double origin[3] = {packet.origin[0][i], packet.origin[1][i],
+                                packet.origin[2][i]};
+      const double invDir[3] = {packet.invDir[0][i], packet.invDir[1][i],
+                                packet.invDir[2][i]};
+      double tNear = 0.0;
+      if (intersectNode(node, origin, invDir, packet.tMin[i], packet.tMax[i],
+                        tNear)) {
+        hits |= 1u << i;
+      }
+    }
+  }
+#endif
+  return hits & mask;
+}
+
+template <typename Visitor>
+bool BVH::traverse(const Ray& ray, double& tMax, Visitor&& visitor) const {
+  return traverseLeaves(
+      ray, tMax, [&](std::size_t first, std::size_t count, double& leafTMax) {
+        for (std::size_t i = first; i < first + count; ++i) {
+          if (visitor(static_cast<std::size_t>(_itemIndices[i]), leafTMax)) {
+            return true;
+          }
+        }
+        return false;
+      });
+}
+
+template <typename LeafVisitor>
+bool BVH::traverseLeaves(const Ray& ray, double& tMax,
+                         LeafVisitor&& visitor) const {
+  if (_nodes.empty()) {
+    return false;
+  }
+  return traverseSubtree(0, ray, tMax, visitor);
+}
+
+template <typename Visitor>
+void BVH::traversePacket(const Ray* rays, std::size_t count, double* tMax,
+                         Visitor&& visitor) const {
+  auto leafVisitor = [&](std::size_t first, std::size_t leafCount,
+                         std::size_t ray, double& leafTMax) {
+    for (std::size_t i = first; i < first + leafCount; ++i) {
+      if (visitor(static_cast<std::size_t>(_itemIndices[i]), ray, leafTMax)) {
+        return true;
+      }
+    }
+    return false;
+  };
+  traversePacketLeaves(rays, count, tMax, leafVisitor);
+}
+
+template <typename LeafVisitor>
+void BVH::traversePacketLeaves(const Ray* rays, std::size_t count,
+                               double* tMax, LeafVisitor&& visitor) const {
+  if (count > MAX_PACKET_SIZE) {
+    throw std::invalid_argument("BVH packet: too many rays");
+  }
+  if (_nodes.empty() || count == 0) {
+    return;
+  }
+
+  Packet packet;
+  packet.count = count;
+  // SIMD lanes go by two: an odd packet gets one padding lane
+  for (std::size_t i = 0; i < count + (count & 1); ++i) {
+    const Ray& ray = rays[i < count ? i : 0];
+    Vector3D origin = ray.getOrigin();
+    const Vector3D& invDir = ray.getInverseDirection();
+    packet.origin[0][i] = origin.getX();
+    packet.origin[1][i] = origin.getY();
+    packet.origin[2][i] = origin.getZ();
+    packet.invDir[0][i] = invDir.getX();
+    packet.invDir[1][i] = invDir.getY();
+    packet.invDir[2][i] = invDir.getZ();
+    packet.tMin[i] = ray.getTMin();
+    packet.tMax[i] = tMax[i < count ? i : 0];
+  }
+
+  struct Entry {
+    uint32_t node;  ///< Node to visit
+    uint32_t mask;  ///< Rays that entered its parent
+  };
+  Entry stack[64];
+  int stackSize = 0;
+  uint32_t active = (1u << count) - 1;
+  uint32_t current = 0;
+  uint32_t mask = intersectNodePacket(_nodes[0], packet, active);
+  std::size_t splitCount = count / PACKET_SPLIT_DIVISOR;
+
+  while (true) {
+    const Node& node = _nodes[current];
+    std::size_t rayCount = static_cast<std::size_t>(std::popcount(mask));
+    if (mask != 0 && rayCount <= splitCount) {
+      // Coherence is lost: the few remaining rays go on alone
+      for (std::size_t i = 0; i < count; ++i) {
+        if ((mask >> i) & 1u) {
+          auto single = [&](std::size_t first, std::size_t leafCount,
+                            double& rayTMax) {
+            return visitor(first, leafCount, i, rayTMax);
+          };
+          if (traverseSubtree(current, rays[i], packet.tMax[i], single)) {
+            active &= ~(1u << i);
+          }
+        }
+      }
+    } else if (mask != 0 && node.count > 0) {
+      for (std::size_t i = 0; i < count; ++i) {
+        if (((mask >> i) & 1u) &&
+            visitor(node.offset, node.count, i, packet.tMax[i])) {
+          active &= ~(1u << i);
+        }
+      }
+    } else if (mask != 0) {
+      uint32_t first = current + 1;
+      uint32_t second = node.offset;
+      std::size_t lead = static_cast<std::size_t>(std::countr_zero(mask));
+      if (rays[lead].getSign(node.axis)) {
+        uint32_t tmp = first;
+        first = second;
+        second = tmp;
+      }
+      uint32_t firstMask = intersectNodePacket(_nodes[first], packet, mask);
+      uint32_t secondMask = intersectNodePacket(_nodes[second], packet, mask);
+      if (firstMask != 0 && secondMask != 0) {
+        stack[stackSize++] = {second, secondMask};
+        current = first;
+        mask = firstMask;
+        continue;
+      }
+      if (firstMask != 0 || secondMask != 0) {
+        current = firstMask != 0 ? first : second;
+        mask = firstMask | secondMask;
+        continue;
+      }
+    }
+
+    // Pop the next node, retesting it against the shrunk intervals
+    mask = 0;
+    while (stackSize > 0 && mask == 0) {
+      Entry entry = stack[--stackSize];
+      current = entry.node;
+      mask = intersectNodePacket(_nodes[current], packet, entry.mask & active);
+    }
+    if (mask == 0) {
+      break;
+    }
+  }
+
+  for (std::size_t i = 0; i < count; ++i) {
+    tMax[i] = packet.tMax[i];
+  }
+}
+
+template <typename LeafVisitor>
+bool BVH::traverseSubtree(uint32_t root, const Ray& ray, double& tMax,
+                          LeafVisitor& visitor) const {
+  Vector3D rayOrigin = ray.getOrigin();
+  const Vector3D& rayInvDir = ray.getInverseDirection();
+  const double origin[3] = {rayOrigin.getX(), rayOrigin.getY(),
+                            rayOrigin.getZ()};
+  const double invDir[3] = {rayInvDir.getX(), rayInvDir.getY(),
+                            rayInvDir.getZ()};
+  const double tMin = ray.getTMin();
+
+  uint32_t stack[64];
+  int stackSize = 0;
+  uint32_t current = root;
+  double tNear = 0.0;
+
+  if (!intersectNode(_nodes[root], origin, invDir, tMin, tMax, tNear)) {
+    return false;
+  }
+
+  while (true) {
+    const Node& node = _nodes[current];
+    if (node.count > 0) {
+      if (visitor(static_cast<std::size_t>(node.offset),
+                  static_cast<std::size_t>(node.count), tMax)) {
+        return true;
+      }
+    } else {
+      uint32_t first = current + 1;
+      uint32_t second = node.offset;
+      if (ray.getSign(node.axis)) {
+        uint32_t tmp = first;
+        first = second;
+        second = tmp;
+      }
+      double tFirst = 0.0;
+      double tSecond = 0.0;
+      bool hitFirst =
+          intersectNode(_nodes[first], origin, invDir, tMin, tMax, tFirst);
+      bool hitSecond =
+          intersectNode(_nodes[second], origin, invDir, tMin, tMax, tSecond);
+      if (hitFirst && hitSecond) {
+        if (tSecond < tFirst) {
+          uint32_t tmp = first;
+          first = second;
+          second = tmp;
+        }
+        stack[stackSize++] = second;
+        current = first;
+        continue;
+      }
+      if (hitFirst) {
+        current = first;
+        continue;
+      }
+      if (hitSecond) {
+        current = second;
+        continue;
+      }
+    }
+
+    // Pop the next node, skipping those that tMax has since pruned
+    bool found = false;
+    while (stackSize > 0) {
+      current = stack[--stackSize];
+      if (intersectNode(_nodes[current], origin, invDir, tMin, tMax, tNear)) {
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      return false;
+    }
+  }
+}
+
+}  // namespace RayTracer
+
+#endif /* !BVH_HPP_ */
@@ -0,0 +1,333 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Four-wide quantized bounding volume hierarchy implementation
+*/
+
+/**
+ * @file BVH4.cpp
+ * @brief Implementation of the collapse of a binary bounding volume hierarchy
+ * into quantized four-wide nodes
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include "BVH4.hpp"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace RayTracer {
+
+namespace {
+
+/// Smallest and largest exponents of a normal single precision step
+constexpr int MIN_EXPONENT = -126;
+constexpr int MAX_EXPONENT = 127;
+
+/// Number of steps spanned by the 8-bit quantized planes
+constexpr double QUANTIZED_STEPS = 255.0;
+
+double nodeArea(const BVH::Node& node) {
+  double x = node.max[0] - node.min[0];
+  double y = node.max[1] - node.min[1];
+  double z = node.max[2] - node.min[2];
+  return 2.0 * (x * y + y * z + z * x);
+}
+
+/**
+ * @brief Largest float that is not above a double
+ */
+float floatBelow(double value) {
+  float rounded = static_cast<float>(value);
+  if (rounded > value) {
+    rounded =
+        std::nextafter(rounded, -std::numeric_limits<float>::infinity());
+  }
+  return rounded;
+}
+
+uint8_t quantize(double steps) {
+  return static_cast<uint8_t>(std::clamp(steps, 0.0, QUANTIZED_STEPS));
+}
+
+AABB toBox(const BVH::Node& node) {
+  return AABB(Vector3D(node.min[0], node.min[1], node.min[2]),
+              Vector3D(node.max[0], node.max[1], node.max[2]));
+}
+
+double axisValue(const Vector3D& vector, int axis) {
+  if (axis == 0) {
+    return vector.getX();
+  }
+  return axis == 1 ? vector.getY() : vector.getZ();
+}
+
+/**
+ * @brief Store the child boxes of a node relative to the node bounds
+ * @param node The node, its childCount must be set
+ * @param bounds The node bounds, enclosing every child
+ * @param children The box of every used child slot
+ */
+void quantizeChildren(BVH4::Node& node, const AABB& bounds,
+                      const AABB children[BVH4::WIDTH]) {
+  double step[3];
+  for (int axis = 0; axis < 3; ++axis) {
+    double min = axisValue(bounds.getMin(), axis);
+    node.origin[axis] = floatBelow(min);
+    double extent = axisValue(bounds.getMax(), axis) - node.origin[axis];
+    int exponent = MIN_EXPONENT;
+    if (extent > 0.0) {
+      exponent = std::ilogb(extent / QUANTIZED_STEPS);
+      while (std::ldexp(QUANTIZED_STEPS, exponent) < extent) {
+        ++exponent;
+      }
+    }
+    exponent = std::clamp(exponent, MIN_EXPONENT, MAX_EXPONENT);
+    node.exponent[axis] = static_cast<int8_t>(exponent);
+    step[axis] = std::ldexp(1.0, exponent);
+  }
+
+  // Planes are rounded outwards, plus one step against float rounding
+  for (int i = 0; i < node.childCount; ++i) {
+    for (int axis = 0; axis < 3; ++axis) {
+      double min = axisValue(children[i].getMin(), axis);
+      double max = axisValue(children[i].getMax(), axis);
+      node.qMin[axis][i] = quantize(
+          std::floor((min - node.origin[axis]) / step[axis]) - 1.0);
+      node.qMax[axis][i] = quantize(
+          std::ceil((max - node.origin[axis]) / step[axis]) + 1.0);
+    }
+  }
+}
+
+/**
+ * @brief Area of a quantized child box, as traversal sees it
+ */
+double childArea(const BVH4::Node& node, int child) {
+  double extent[3];
+  for (int axis = 0; axis < 3; ++axis) {
+    extent[axis] =
+        std::ldexp(static_cast<double>(node.qMax[axis][child]) -
+                       node.qMin[axis][child],
+                   node.exponent[axis]);
+  }
+  return 2.0 * (extent[0] * extent[1] + extent[1] * extent[2] +
+                extent[2] * extent[0]);
+}
+
+}  // namespace
+
+BVH4::BVH4() : _nodes(), _itemIndices(), _bounds(), _stats() {}
+
+void BVH4::build(const std::vector<AABB>& bounds, ThreadPool* pool) {
+  auto start = std::chrono::steady_clock::now();
+  BVH binary;
+  binary.build(bounds, pool);
+  build(binary);
+  _stats.buildMilliseconds =
+      std::chrono::duration<double, std::milli>(
+          std::chrono::steady_clock::now() - start)
+          .count();
+}
+
+void BVH4::build(const BVH& binary) {
+  auto start = std::chrono::steady_clock::now();
+  clear();
+  if (binary.isEmpty()) {
+    return;
+  }
+
+  _itemIndices = binary.getItemIndices();
+  _bounds = binary.getBounds();
+  // Every wide node removes at least one binary interior node
+  _nodes.reserve(binary.getNodeCount() / 2 + 1);
+  collapse(binary.getNodes(), 0);
+
+  computeStats();
+  const BVH::BuildStats& binaryStats = binary.getBuildStats();
+  _stats.itemCount = binaryStats.itemCount;
+  _stats.taskCount = binaryStats.taskCount;
+  _stats.buildMilliseconds =
+      binaryStats.buildMilliseconds +
+      std::chrono::duration<double, std::milli>(
+          std::chrono::steady_clock::now() - start)
+          .count();
+}
+
+void BVH4::refit(const std::vector<AABB>& bounds) {
+  auto start = std::chrono::steady_clock::now();
+  if (bounds.size() != _itemIndices.size()) {
+    throw std::invalid_argument("BVH4 refit: item count differs from build");
+  }
+  if (_nodes.empty()) {
+    return;
+  }
+
+  _bounds = refitNode(0, bounds);
+  std::size_t refitCount = _stats.refitCount;
+  computeStats();
+  _stats.refitCount = refitCount + 1;
+  _stats.refitMilliseconds =
+      std::chrono::duration<double, std::milli>(
+          std::chrono::steady_clock::now() - start)
+          .count();
+}
+
+void BVH4::assign(std::vector<Node> nodes, std::vector<uint32_t> itemIndices,
+                  const AABB& bounds, const BVH::BuildStats& stats) {
+  _nodes = std::move(nodes);
+  _itemIndices = std::move(itemIndices);
+  _bounds = bounds;
+  _stats = stats;
+}
+
+void BVH4::clear() {
+  _nodes.clear();
+  _itemIndices.clear();
+  _bounds = AABB();
+  _stats = BVH::BuildStats();
+}
+
+bool BVH4::isEmpty() const {
+  return _nodes.empty();
+}
+
+std::size_t BVH4::getNodeCount() const {
+  return _nodes.size();
+}
+
+const std::vector<BVH4::Node>& BVH4::getNodes() const {
+  return _nodes;
+}
+
+const std::vector<uint32_t>& BVH4::getItemIndices() const {
+  return _itemIndices;
+}
+
+const BVH::BuildStats& BVH4::getBuildStats() const {
+  return _stats;
+}
+
+AABB BVH4::getBounds() const {
+  return _bounds;
+}
+
+bool BVH4::usesSimd() {
+#if defined(__SSE2__)
+  return true;
+#else
+  return false;
+#endif
+}
+
+uint32_t BVH4::collapse(const std::vector<BVH::Node>& binary,
+                        uint32_t root) {
+  const BVH::Node& rootNode = binary[root];
+  uint32_t slots[WIDTH];
+  int slotCount = 0;
+  if (rootNode.count > 0) {
+    slots[slotCount++] = root;
+  } else {
+    slots[slotCount++] = root + 1;
+    slots[slotCount++] = rootNode.offset;
+  }
+
+  // Open the largest interior child until the node is full
+  while (slotCount < WIDTH) {
+    int largest = -1;
+    double largestArea = -1.0;
+    for (int i = 0; i < slotCount; ++i) {
+      const BVH::Node& candidate = binary[slots[i]];
+      if (candidate.count == 0 && nodeArea(candidate) > largestArea) {
+        largest = i;
+        largestArea = nodeArea(candidate);
+      }
+    }
+    if (largest < 0) {
+      break;
+    }
+    uint32_t opened = slots[largest];
+    slots[largest] = opened + 1;
+    slots[slotCount++] = binary[opened].offset;
+  }
+
+  Node node = {};
+  node.childCount = static_cast<uint8_t>(slotCount);
+  AABB childBounds[WIDTH];
+  for (int i = 0; i < slotCount; ++i) {
+    const BVH::Node& child = binary[slots[i]];
+    childBounds[i] = toBox(child);
+    node.child[i] = child.offset;
+    node.count[i] = child.count;
+  }
+  quantizeChildren(node, toBox(rootNode), childBounds);
+
+  uint32_t index = static_cast<uint32_t>(_nodes.size());
+  _nodes.push_back(node);
+  for (int i = 0; i < slotCount; ++i) {
+    if (binary[slots[i]].count == 0) {
+      uint32_t childIndex = collapse(binary, slots[i]);
+      _nodes[index].child[i] = childIndex;
+    }
+  }
+  return index;
+}
+
+AABB BVH4::refitNode(uint32_t index, const std::vector<AABB>& bounds) {
+  Node& node = _nodes[index];
+  AABB childBounds[WIDTH];
+  AABB nodeBounds;
+  for (int i = 0; i < node.childCount; ++i) {
+    if (node.count[i] > 0) {
+      for (uint32_t k = 0; k < node.count[i]; ++k) {
+        childBounds[i].expand(bounds[_itemIndices[node.child[i] + k]]);
+      }
+    } else {
+      childBounds[i] = refitNode(node.child[i], bounds);
+    }
+    nodeBounds.expand(childBounds[i]);
+  }
+  quantizeChildren(node, nodeBounds, childBounds);
+  return nodeBounds;
+}
+
+void BVH4::computeStats() {
+  _stats.nodeCount = _nodes.size();
+  _stats.leafCount = 0;
+  _stats.maxDepth = 0;
+  _stats.maxLeafSize = 0;
+  _stats.sahCost = 0.0;
+  if (_nodes.empty()) {
+    return;
+  }
+
+  double rootArea = _bounds.surfaceArea();
+  double cost = rootArea * BVH::TRAVERSAL_COST;
+  std::vector<std::pair<uint32_t, std::size_t>> stack = {{0, 0}};
+  while (!stack.empty()) {
+    auto [index, depth] = stack.back();
+    stack.pop_back();
+    const Node& node = _nodes[index];
+    for (int i = 0; i < node.childCount; ++i) {
+      double area = childArea(node, i);
+      if (node.count[i] > 0) {
+        cost += area * node.count[i];
+        _stats.leafCount++;
+        _stats.maxDepth = std::max(_stats.maxDepth, depth + 1);
+        _stats.maxLeafSize = std::max(
+            _stats.maxLeafSize, static_cast<std::size_t>(node.count[i]));
+      } else {
+        cost += area * BVH::TRAVERSAL_COST;
+        stack.push_back({node.child[i], depth + 1});
+      }
+    }
+  }
+  _stats.sahCost = rootArea > 0 ? cost / rootArea : 0.0;
+}
+
+}  // namespace RayTracer
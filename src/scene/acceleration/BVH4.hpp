@@ -0,0 +1,509 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Four-wide quantized bounding volume hierarchy header
+*/
+
+/**
+ * @file BVH4.hpp
+ * @brief Definition of the BVH4 class, a four-wide bounding volume hierarchy
+ * with quantized child boxes tested four at a time
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#ifndef BVH4_HPP_
+#define BVH4_HPP_
+
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include "../../core/AABB.hpp"
+#include "../../core/Ray.hpp"
+#include "BVH.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace RayTracer {
+
+class ThreadPool;
+
+/**
+ * @brief Four-wide bounding volume hierarchy with quantized child boxes
+ *
+ * Built by collapsing a binary BVH: every node keeps up to four children,
+ * found by repeatedly opening the largest interior child of a binary node.
+ * Child boxes are stored on 8 bits per plane, relative to the node bounds,
+ * as structure-of-arrays so that the four slab tests run side by side in
+ * SSE registers, with a scalar fallback on other targets. A node fits in a
+ * single 64-byte cache line, against 64 bytes per binary child.
+ *
+ * Quantized boxes are rounded outwards by one step, and the slab test is
+ * done in single precision with a relative margin, so traversal visits at
+ * least the items the binary hierarchy visits. Items are reported with the
+ * same indices as BVH::traverse().
+ */
+class BVH4 {
+ public:
+  static constexpr int WIDTH = 4;  ///< Maximum number of children per node
+
+  /**
+   * @brief Quantized four-wide node, one cache line
+   */
+  struct alignas(64) Node {
+    float origin[3];          ///< Node minimum corner, rounded down
+    int8_t exponent[3];       ///< Quantization step is 2^exponent per axis
+    uint8_t childCount;       ///< Number of used child slots
+    uint8_t qMin[3][WIDTH];   ///< Child minimum corners, in steps, per axis
+    uint8_t qMax[3][WIDTH];   ///< Child maximum corners, in steps, per axis
+    uint32_t child[WIDTH];    ///< Node index, or first leaf item position
+    uint16_t count[WIDTH];    ///< Leaf item count, 0 for interior children
+  };
+
+  /**
+   * @brief Default constructor
+   * Creates an empty hierarchy
+   */
+  BVH4();
+
+  /**
+   * @brief Build the hierarchy over a set of boxes
+   * @param bounds The box of every item
+   * @param pool Pool running the binary build, nullptr to build serially
+   * @see BVH::build()
+   */
+  void build(const std::vector<AABB>& bounds, ThreadPool* pool = nullptr);
+
+  /**
+   * @brief Build the hierarchy by collapsing an existing binary one
+   * @param binary The binary hierarchy, its item indices are kept
+   */
+  void build(const BVH& binary);
+
+  /**
+   * @brief Update the node bounds after the items moved
+   *
+   * Keeps the topology and quantizes every node again from the new boxes,
+   * bottom-up in a single pass.
+   *
+   * @param bounds The new box of every item, same items as the last build
+   * @throw std::invalid_argument if the item count differs from the build
+   * @see BVH::refit()
+   */
+  void refit(const std::vector<AABB>& bounds);
+
+  /**
+   * @brief Replace the hierarchy with the result of an earlier build
+   * @param nodes The quantized nodes, from getNodes()
+   * @param itemIndices The item order referenced by the leaves
+   * @param bounds The bounds of the whole hierarchy
+   * @param stats The statistics of the build that produced them
+   * @see BVH::assign()
+   */
+  void assign(std::vector<Node> nodes, std::vector<uint32_t> itemIndices,
+              const AABB& bounds, const BVH::BuildStats& stats);
+
+  /**
+   * @brief Get the item order referenced by the leaves
+   * @return The item index of every leaf position
+   */
+  const std::vector<uint32_t>& getItemIndices() const;
+
+  /**
+   * @brief Remove every node and item
+   */
+  void clear();
+
+  /**
+   * @brief Check if the hierarchy contains no item
+   * @return true if empty, false otherwise
+   */
+  bool isEmpty() const;
+
+  /**
+   * @brief Get the number of nodes
+   * @return The node count
+   */
+  std::size_t getNodeCount() const;
+
+  /**
+   * @brief Get the quantized nodes
+   * @return The node array, root first
+   */
+  const std::vector<Node>& getNodes() const;
+
+  /**
+   * @brief Get the statistics of the last build
+   *
+   * Every figure describes the wide tree, the SAH cost being measured on
+   * the quantized boxes; the build time includes the binary build.
+   *
+   * @return The build statistics, all zero if nothing was built
+   */
+  const BVH::BuildStats& getBuildStats() const;
+
+  /**
+   * @brief Get the bounds of the whole hierarchy
+   * @return The root bounds, or an empty box if the hierarchy is empty
+   */
+  AABB getBounds() const;
+
+  /**
+   * @brief Check if the child boxes are tested with SIMD instructions
+   * @return true when built with SSE2, false for the scalar fallback
+   */
+  static bool usesSimd();
+
+  /**
+   * @brief Visit the items whose boxes are hit by a ray
+   *
+   * Same contract as BVH::traverse(): nodes are visited front to back, the
+   * visitor is called as `bool visitor(std::size_t item, double& tMax)`,
+   * may shrink tMax, and stops the traversal by returning true.
+   *
+   * @param ray The ray, its direction does not need to be normalized
+   * @param tMax Upper bound of the ray parameter, updated by the visitor
+   * @param visitor The callback run for every candidate item
+   * @return true if the visitor stopped the traversal, false otherwise
+   */
+  template <typename Visitor>
+  bool traverse(const Ray& ray, double& tMax, Visitor&& visitor) const;
+
+  /**
+   * @brief Visit the items whose boxes are hit by a packet of rays
+   *
+   * Same contract as BVH::traversePacket(): every node is fetched once for
+   * the whole packet, and each of its rays tests the four children at once.
+   * Children are visited near to far for the first ray reaching them. The
+   * visitor is called as `bool visitor(std::size_t item, std::size_t ray,
+   * double& tMax)`; returning true retires that ray. Every ray visits at
+   * least the items traverse() would visit for it.
+   *
+   * @param rays The rays of the packet
+   * @param count Number of rays, at most BVH::MAX_PACKET_SIZE
+   * @param tMax Upper bound of every ray parameter, updated by the visitor
+   * @param visitor The callback run for every candidate item and ray
+   * @throw std::invalid_argument if the packet is too large
+   */
+  template <typename Visitor>
+  void traversePacket(const Ray* rays, std::size_t count, double* tMax,
+                      Visitor&& visitor) const;
+
+  /// Relative margin of the single precision slab test
+  static constexpr float FLOAT_SLAB_EPSILON = 1e-6f;
+
+ private:
+  /**
+   * @brief Ray data shared by every node test of a traversal
+   */
+  struct RayData {
+    double origin[3];  ///< The ray origin
+    float invDir[3];   ///< The inverse of the ray direction
+    int sign[3];       ///< 1 where the direction is negative
+    float tMin;        ///< Lower bound of the ray parameter, rounded down
+  };
+
+  /**
+   * @brief Pending child of the packet traversal stack
+   */
+  struct PacketEntry {
+    uint32_t index;  ///< Node index, or first leaf item position
+    uint32_t count;  ///< Leaf item count, 0 for nodes
+    uint32_t mask;   ///< Rays of the packet that hit the child box
+  };
+
+  /**
+   * @brief Pending child of the traversal stack
+   */
+  struct StackEntry {
+    uint32_t index;  ///< Node index, or first leaf item position
+    uint32_t count;  ///< Leaf item count, 0 for nodes
+    float tNear;     ///< Entry parameter of the child box
+  };
+
+  std::vector<Node> _nodes;            ///< Quantized nodes, root first
+  std::vector<uint32_t> _itemIndices;  ///< Item order referenced by leaves
+  AABB _bounds;                        ///< Bounds of the whole hierarchy
+  BVH::BuildStats _stats;              ///< Statistics of the last build
+
+  /**
+   * @brief Create the wide node covering a binary subtree
+   * @param binary The binary nodes
+   * @param root Index of the binary subtree root
+   * @return Index of the created node
+   */
+  uint32_t collapse(const std::vector<BVH::Node>& binary, uint32_t root);
+
+  /**
+   * @brief Recompute and quantize again the boxes of a subtree
+   * @param index Index of the subtree root
+   * @param bounds The box of every item
+   * @return The bounds of the subtree
+   */
+  AABB refitNode(uint32_t index, const std::vector<AABB>& bounds);
+
+  /**
+   * @brief Fill the node statistics of _stats from _nodes
+   */
+  void computeStats();
+
+  /**
+   * @brief Precompute the data of a ray for the node tests
+   * @param ray The ray
+   * @return The ray data
+   */
+  static RayData makeRayData(const Ray& ray);
+
+  /**
+   * @brief Slab test of a ray against the four children of a node
+   * @param node The node whose children are tested
+   * @param ray The precomputed ray data
+   * @param tMax Upper bound of the ray parameter
+   * @param tNear Receives the entry parameter of every child
+   * @return Bit i is set if child i is hit
+   */
+  static int intersectChildren(const Node& node, const RayData& ray,
+                               float tMax, float tNear[WIDTH]);
+};
+
+// Template implementation (must be in header)
+inline BVH4::RayData BVH4::makeRayData(const Ray& ray) {
+  RayData data;
+  Vector3D rayOrigin = ray.getOrigin();
+  const Vector3D& rayInvDir = ray.getInverseDirection();
+  data.origin[0] = rayOrigin.getX();
+  data.origin[1] = rayOrigin.getY();
+  data.origin[2] = rayOrigin.getZ();
+  data.invDir[0] = static_cast<float>(rayInvDir.getX());
+  data.invDir[1] = static_cast<float>(rayInvDir.getY());
+  data.invDir[2] = static_cast<float>(rayInvDir.getZ());
+  for (int axis = 0; axis < 3; ++axis) {
+    data.sign[axis] = ray.getSign(axis);
+  }
+  data.tMin = static_cast<float>(ray.getTMin());
+  if (data.tMin > ray.getTMin()) {
+    data.tMin = std::nextafter(data.tMin, -1.0f);
+  }
+  return data;
+}
+
+inline int BVH4::intersectChildren(const Node& node, const RayData& ray,
+                                   float tMax, float tNear[WIDTH]) {
+  float t1Max = tMax * (1.0f + FLOAT_SLAB_EPSILON);
+#if defined(__SSE2__)
+  const __m128i zero = _mm_setzero_si128();
+  auto decode = [&zero](const uint8_t quantized[WIDTH]) {
+    int32_t packed;
+    std::memcpy(&packed, quantized, sizeof(packed));
+    __m128i bytes = _mm_cvtsi32_si128(packed);
+    bytes = _mm_unpacklo_epi16(_mm_unpacklo_epi8(bytes, zero), zero);
+    return _mm_cvtepi32_ps(bytes);
+  };
+
+  __m128 t0 = _mm_set1_ps(ray.tMin);
+  __m128 t1 = _mm_set1_ps(t1Max);
+  for (int axis = 0; axis < 3; ++axis) {
+    // Offsets are taken from the node origin in double precision, so the
+    // single precision part only covers the extent of the node
+    float offset =
+        static_cast<float>(node.origin[axis] - ray.origin[axis]);
+    float step = std::bit_cast<float>(
+        static_cast<uint32_t>(node.exponent[axis] + 127) << 23);
+    const uint8_t* nearPlane =
+        ray.sign[axis] ? node.qMax[axis] : node.qMin[axis];
+    const uint8_t* farPlane =
+        ray.sign[axis] ? node.qMin[axis] : node.qMax[axis];
+    __m128 invDir = _mm_set1_ps(ray.invDir[axis]);
+    __m128 tA = _mm_mul_ps(
+        _mm_add_ps(_mm_set1_ps(offset),
+                   _mm_mul_ps(decode(nearPlane), _mm_set1_ps(step))),
+        invDir);
+    __m128 tB = _mm_mul_ps(
+        _mm_add_ps(_mm_set1_ps(offset),
+                   _mm_mul_ps(decode(farPlane), _mm_set1_ps(step))),
+        invDir);
+    // Operand order keeps the previous bound when the product is NaN
+    t0 = _mm_max_ps(tA, t0);
+    t1 = _mm_min_ps(_mm_mul_ps(tB, _mm_set1_ps(1.0f + FLOAT_SLAB_EPSILON)),
+                    t1);
+  }
+  _mm_storeu_ps(tNear, t0);
+  int mask = _mm_movemask_ps(_mm_cmple_ps(t0, t1));
+#else
+  int mask = 0;
+  for (int i = 0; i < WIDTH; ++i) {
+    float t0 = ray.tMin;
+    float t1 = t1Max;
+    for (int axis = 0; axis < 3; ++axis) {
+      float offset =
+          static_cast<float>(node.origin[axis] - ray.origin[axis]);
+      float step = std::bit_cast<float>(
+          static_cast<uint32_t>(node.exponent[axis] + 127) << 23);
+      float nearPlane =
+          ray.sign[axis] ? node.qMax[axis][i] : node.qMin[axis][i];
+      float farPlane =
+          ray.sign[axis] ? node.qMin[axis][i] : node.qMax[axis][i];
+      float tA = (offset + nearPlane * step) * ray.invDir[axis];
+      float tB = (offset + farPlane * step) * ray.invDir[axis] *
+                 (1.0f + FLOAT_SLAB_EPSILON);
+      t0 = tA > t0 ? tA : t0;
+      t1 = tB < t1 ? tB : t1;
+    }
+    tNear[i] = t0;
+    if (t0 <= t1) {
+      mask |= 1 << i;
+    }
+  }
+#endif
+  return mask & ((1 << node.childCount) - 1);
+}
+
+template <typename Visitor>
+bool BVH4::traverse(const Ray& ray, double& tMax, Visitor&& visitor) const {
+  if (_nodes.empty()) {
+    return false;
+  }
+
+  RayData data = makeRayData(ray);
+
+  // Three more entries per level at most, over a binary depth of 64
+  StackEntry stack[3 * 64 + WIDTH];
+  int stackSize = 0;
+  stack[stackSize++] = {0, 0, data.tMin};
+
+  while (stackSize > 0) {
+    StackEntry entry = stack[--stackSize];
+    float tLimit = static_cast<float>(tMax) * (1.0f + FLOAT_SLAB_EPSILON);
+    // Entries pushed before tMax shrank may now be out of reach
+    if (entry.tNear > tLimit) {
+      continue;
+    }
+
+    if (entry.count > 0) {
+      for (uint32_t i = 0; i < entry.count; ++i) {
+        if (visitor(
+                static_cast<std::size_t>(_itemIndices[entry.index + i]),
+                tMax)) {
+          return true;
+        }
+      }
+      continue;
+    }
+
+    const Node& node = _nodes[entry.index];
+    float tNear[WIDTH];
+    int mask = intersectChildren(node, data, static_cast<float>(tMax), tNear);
+
+    // Push the hit children far to near, so that the nearest is popped first
+    int firstPushed = stackSize;
+    for (int i = 0; i < WIDTH; ++i) {
+      if (!(mask & (1 << i))) {
+        continue;
+      }
+      StackEntry child = {node.child[i], node.count[i], tNear[i]};
+      int position = stackSize++;
+      while (position > firstPushed &&
+             stack[position - 1].tNear < child.tNear) {
+        stack[position] = stack[position - 1];
+        --position;
+      }
+      stack[position] = child;
+    }
+  }
+  return false;
+}
+
+template <typename Visitor>
+void BVH4::traversePacket(const Ray* rays, std::size_t count, double* tMax,
+                          Visitor&& visitor) const {
+  if (count > BVH::MAX_PACKET_SIZE) {
+    throw std::invalid_argument("BVH4 packet: too many rays");
+  }
+  if (_nodes.empty() || count == 0) {
+    return;
+  }
+
+  RayData data[BVH::MAX_PACKET_SIZE];
+  for (std::size_t i = 0; i < count; ++i) {
+    data[i] = makeRayData(rays[i]);
+  }
+
+  PacketEntry stack[3 * 64 + WIDTH];
+  int stackSize = 0;
+  uint32_t active = (1u << count) - 1;
+  stack[stackSize++] = {0, 0, active};
+
+  while (stackSize > 0) {
+    PacketEntry entry = stack[--stackSize];
+    // Rays retired since the entry was pushed are dropped
+    uint32_t mask = entry.mask & active;
+    if (mask == 0) {
+      continue;
+    }
+
+    if (entry.count > 0) {
+      for (; mask != 0; mask &= mask - 1) {
+        std::size_t ray = static_cast<std::size_t>(std::countr_zero(mask));
+        for (uint32_t i = 0; i < entry.count; ++i) {
+          if (visitor(
+                  static_cast<std::size_t>(_itemIndices[entry.index + i]),
+                  ray, tMax[ray])) {
+            active &= ~(1u << ray);
+            break;
+          }
+        }
+      }
+      continue;
+    }
+
+    // Each ray tests the four children against its own shrunk interval
+    const Node& node = _nodes[entry.index];
+    uint32_t childMasks[WIDTH] = {};
+    float childNear[WIDTH] = {};
+    for (; mask != 0; mask &= mask - 1) {
+      int ray = std::countr_zero(mask);
+      float tNear[WIDTH];
+      int hits = intersectChildren(node, data[ray],
+                                   static_cast<float>(tMax[ray]), tNear);
+      for (int i = 0; i < WIDTH; ++i) {
+        if (hits & (1 << i)) {
+          if (childMasks[i] == 0) {
+            childNear[i] = tNear[i];
+          }
+          childMasks[i] |= 1u << ray;
+        }
+      }
+    }
+
+    // Push the hit children far to near, so that the nearest is popped first
+    int order[WIDTH];
+    int hitCount = 0;
+    for (int i = 0; i < WIDTH; ++i) {
+      if (childMasks[i] == 0) {
+        continue;
+      }
+      int position = hitCount++;
+      while (position > 0 && childNear[order[position - 1]] < childNear[i]) {
+        order[position] = order[position - 1];
+        --position;
+      }
+      order[position] = i;
+    }
+    for (int k = 0; k < hitCount; ++k) {
+      int i = order[k];
+      stack[stackSize++] = {node.child[i], node.count[i], childMasks[i]};
+    }
+  }
+}
+
+}  // namespace RayTracer
+
+#endif /* !BVH4_HPP_ */
@@ -0,0 +1,401 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Acceleration structure disk cache implementation
+*/
+
+/**
+ * @file BVHCache.cpp
+ * @brief Implementation of the binary cache files of the acceleration
+ * structures, written and read back with streams
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include "BVHCache.hpp"
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace RayTracer {
+
+namespace {
+
+constexpr char MAGIC[8] = {'R', 'T', 'B', 'V', 'H', 'C', '\0', '\0'};
+
+/// Written as is, reads back differently on a machine of other endianness
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+/// Node arrays start on a cache line, as in memory
+constexpr std::size_t NODE_ALIGNMENT = 64;
+
+/// Nesting limit of @include directives, against include cycles
+constexpr int MAX_INCLUDE_DEPTH = 16;
+
+/// Deepest node the fixed traversal stacks of BVH and BVH4 can reach
+constexpr std::size_t MAX_TRAVERSAL_DEPTH = 64;
+
+/**
+ * @brief Header at the start of every cache file
+ */
+struct FileHeader {
+  char magic[8];            ///< MAGIC
+  uint32_t version;         ///< BVHCache::FORMAT_VERSION
+  uint32_t byteOrder;       ///< BYTE_ORDER_MARK
+  uint32_t accelerator;     ///< AcceleratorType of the stored hierarchy
+  uint32_t nodeSize;        ///< sizeof of the stored node type
+  uint32_t statsSize;       ///< sizeof(BVH::BuildStats)
+  uint32_t reserved;        ///< Zero
+  uint64_t boundsHash;      ///< BVHCache::hashBounds() of the items
+  uint64_t itemCount;       ///< Number of items and of item indices
+  uint64_t nodeCount;       ///< Number of nodes
+  double bounds[6];         ///< Minimum then maximum corner of the root
+  BVH::BuildStats stats;    ///< Statistics of the build
+};
+
+constexpr std::size_t nodesOffset() {
+  return (sizeof(FileHeader) + NODE_ALIGNMENT - 1) / NODE_ALIGNMENT *
+         NODE_ALIGNMENT;
+}
+
+/**
+ * @brief Check an item order against the items of the scene
+ * @return true if every item index appears exactly once
+ */
+bool validItems(const std::vector<uint32_t>& items, std::size_t itemCount) {
+  std::vector<bool> seen(itemCount, false);
+  for (uint32_t item : items) {
+    if (item >= itemCount || seen[item]) {
+      return false;
+    }
+    seen[item] = true;
+  }
+  return true;
+}
+
+/**
+ * @brief Check the structure of binary nodes read from a file
+ *
+ * Nodes are stored depth-first: the first child follows its parent and the
+ * second one comes after it, so every node must be reached exactly once
+ * from the root, within the depth of the traversal stack, and every leaf
+ * must cover items of the file.
+ *
+ * @return true if traversing the nodes stays within the arrays
+ */
+bool validNodes(const std::vector<BVH::Node>& nodes, std::size_t itemCount) {
+  if (nodes.empty()) {
+    return itemCount == 0;
+  }
+  std::vector<bool> reached(nodes.size(), false);
+  std::vector<std::pair<std::size_t, std::size_t>> stack = {{0, 0}};
+  std::size_t visited = 0;
+  while (!stack.empty()) {
+    auto [index, depth] = stack.back();
+    stack.pop_back();
+    const BVH::Node& node = nodes[index];
+    if (reached[index] || depth > MAX_TRAVERSAL_DEPTH || node.axis > 2) {
+      return false;
+    }
+    reached[index] = true;
+    ++visited;
+    if (node.count > 0) {
+      if (node.offset > itemCount || node.count > itemCount - node.offset) {
+        return false;
+      }
+      continue;
+    }
+    if (node.offset <= index + 1 || node.offset >= nodes.size()) {
+      return false;
+    }
+    stack.push_back({index + 1, depth + 1});
+    stack.push_back({node.offset, depth + 1});
+  }
+  return visited == nodes.size();
+}
+
+/**
+ * @brief Check the structure of four-wide nodes read from a file
+ * @see validNodes(const std::vector<BVH::Node>&, std::size_t)
+ */
+bool validNodes(const std::vector<BVH4::Node>& nodes, std::size_t itemCount) {
+  if (nodes.empty()) {
+    return itemCount == 0;
+  }
+  std::vector<bool> reached(nodes.size(), false);
+  std::vector<std::pair<std::size_t, std::size_t>> stack = {{0, 0}};
+  std::size_t visited = 0;
+  while (!stack.empty()) {
+    auto [index, depth] = stack.back();
+    stack.pop_back();
+    const BVH4::Node& node = nodes[index];
+    if (reached[index] || depth > MAX_TRAVERSAL_DEPTH ||
+        node.childCount == 0 || node.childCount > BVH4::WIDTH) {
+      return false;
+    }
+    reached[index] = true;
+    ++visited;
+    for (int i = 0; i < node.childCount; ++i) {
+      uint32_t child = node.child[i];
+      if (node.count[i] > 0) {
+        if (child > itemCount || node.count[i] > itemCount - child) {
+          return false;
+        }
+      } else if (child <= index || child >= nodes.size()) {
+        return false;
+      } else {
+        stack.push_back({child, depth + 1});
+      }
+    }
+  }
+  return visited == nodes.size();
+}
+
+/**
+ * @brief Read a cache file and keep its arrays if it matches
+ *
+ * The arrays are read straight into the vectors the hierarchy takes over,
+ * then checked so that a damaged file can never send traversal out of them.
+ *
+ * @return true if the file matches the expected hierarchy
+ */
+template <typename Node>
+bool readCacheFile(const std::string& path, const std::vector<AABB>& bounds,
+                   AcceleratorType type, std::vector<Node>& nodes,
+                   std::vector<uint32_t>& items, FileHeader& header) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) {
+    return false;
+  }
+  std::size_t size = static_cast<std::size_t>(file.tellg());
+  file.seekg(0);
+  if (size < sizeof(FileHeader) ||
+      !file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+    return false;
+  }
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      header.version != BVHCache::FORMAT_VERSION ||
+      header.byteOrder != BYTE_ORDER_MARK ||
+      header.accelerator != static_cast<uint32_t>(type) ||
+      header.nodeSize != sizeof(Node) ||
+      header.statsSize != sizeof(BVH::BuildStats) ||
+      header.itemCount != bounds.size()) {
+    return false;
+  }
+  std::size_t itemsOffset = nodesOffset() + header.nodeCount * sizeof(Node);
+  if (header.nodeCount > size / sizeof(Node) ||
+      size != itemsOffset + header.itemCount * sizeof(uint32_t)) {
+    return false;
+  }
+  // Checked before reading the payload: it is the only test that reads
+  // every box
+  if (header.boundsHash != BVHCache::hashBounds(bounds)) {
+    return false;
+  }
+
+  nodes.resize(header.nodeCount);
+  items.resize(header.itemCount);
+  file.seekg(static_cast<std::streamoff>(nodesOffset()));
+  if (!file.read(reinterpret_cast<char*>(nodes.data()),
+                 static_cast<std::streamsize>(nodes.size() * sizeof(Node))) ||
+      !file.read(reinterpret_cast<char*>(items.data()),
+                 static_cast<std::streamsize>(items.size() *
+                                              sizeof(uint32_t)))) {
+    return false;
+  }
+  return validItems(items, bounds.size()) && validNodes(nodes, items.size());
+}
+
+template <typename Node>
+bool writeCacheFile(const std::string& path, const std::vector<AABB>& bounds,
+                    AcceleratorType type, const std::vector<Node>& nodes,
+                    const std::vector<uint32_t>& items, const AABB& root,
+                    const BVH::BuildStats& stats) {
+  FileHeader header = {};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = BVHCache::FORMAT_VERSION;
+  header.byteOrder = BYTE_ORDER_MARK;
+  header.accelerator = static_cast<uint32_t>(type);
+  header.nodeSize = sizeof(Node);
+  header.statsSize = sizeof(BVH::BuildStats);
+  header.boundsHash = BVHCache::hashBounds(bounds);
+  header.itemCount = items.size();
+  header.nodeCount = nodes.size();
+  header.bounds[0] = root.getMin().getX();
+  header.bounds[1] = root.getMin().getY();
+  header.bounds[2] = root.getMin().getZ();
+  header.bounds[3] = root.getMax().getX();
+  header.bounds[4] = root.getMax().getY();
+  header.bounds[5] = root.getMax().getZ();
+  header.stats = stats;
+
+  std::error_code error;
+  std::filesystem::path target(path);
+  if (target.has_parent_path()) {
+    std::filesystem::create_directories(target.parent_path(), error);
+    if (error) {
+      return false;
+    }
+  }
+
+  std::string temporary = path + ".tmp." + std::to_string(::getpid());
+  {
+    std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      return false;
+    }
+    const char padding[NODE_ALIGNMENT] = {};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(padding, nodesOffset() - sizeof(header));
+    out.write(reinterpret_cast<const char*>(nodes.data()),
+              static_cast<std::streamsize>(nodes.size() * sizeof(Node)));
+    out.write(reinterpret_cast<const char*>(items.data()),
+              static_cast<std::streamsize>(items.size() * sizeof(uint32_t)));
+    if (!out) {
+      out.close();
+      std::remove(temporary.c_str());
+      return false;
+    }
+  }
+  std::filesystem::rename(temporary, target, error);
+  if (error) {
+    std::remove(temporary.c_str());
+    return false;
+  }
+  return true;
+}
+
+uint64_t hashFileRecursive(const std::string& path, uint64_t seed,
+                           int depth) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("Cannot read " + path);
+  }
+  std::stringstream contents;
+  contents << file.rdbuf();
+  std::string text = contents.str();
+  uint64_t result = BVHCache::hash(text.data(), text.size(), seed);
+
+  if (depth >= MAX_INCLUDE_DEPTH) {
+    return result;
+  }
+  std::istringstream lines(text);
+  std::string line;
+  while (std::getline(lines, line)) {
+    std::size_t start = line.find_first_not_of(" \t");
+    if (start == std::string::npos || line.compare(start, 8, "@include") != 0) {
+      continue;
+    }
+    std::size_t open = line.find('"', start);
+    std::size_t close =
+        open == std::string::npos ? open : line.find('"', open + 1);
+    if (close != std::string::npos) {
+      result = hashFileRecursive(line.substr(open + 1, close - open - 1),
+                                 result, depth + 1);
+    }
+  }
+  return result;
+}
+
+double elapsedMilliseconds(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+}  // namespace
+
+uint64_t BVHCache::hash(const void* data, std::size_t size, uint64_t seed) {
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  uint64_t result = seed;
+  for (std::size_t i = 0; i < size; ++i) {
+    result ^= bytes[i];
+    result *= FNV_PRIME;
+  }
+  return result;
+}
+
+uint64_t BVHCache::hashSceneFile(const std::string& path) {
+  return hashFileRecursive(path, FNV_OFFSET_BASIS, 0);
+}
+
+uint64_t BVHCache::hashBounds(const std::vector<AABB>& bounds) {
+  uint64_t result = FNV_OFFSET_BASIS;
+  for (const AABB& box : bounds) {
+    const double corners[6] = {box.getMin().getX(), box.getMin().getY(),
+                               box.getMin().getZ(), box.getMax().getX(),
+                               box.getMax().getY(), box.getMax().getZ()};
+    result = hash(corners, sizeof(corners), result);
+  }
+  return result;
+}
+
+std::string BVHCache::pathFor(uint64_t key, AcceleratorType type,
+                              const std::string& directory) {
+  char name[17];
+  std::snprintf(name, sizeof(name), "%016llx",
+                static_cast<unsigned long long>(key));
+  return (std::filesystem::path(directory) /
+          (std::string(name) + "." + acceleratorTypeName(type)))
+      .string();
+}
+
+bool BVHCache::load(const std::string& path, const std::vector<AABB>& bounds,
+                    BVH& bvh) {
+  auto start = std::chrono::steady_clock::now();
+  std::vector<BVH::Node> nodes;
+  std::vector<uint32_t> items;
+  FileHeader header;
+  if (!readCacheFile(path, bounds, AcceleratorType::BVH, nodes, items,
+                     header)) {
+    return false;
+  }
+  BVH::BuildStats stats = header.stats;
+  stats.fromCache = true;
+  stats.buildMilliseconds = elapsedMilliseconds(start);
+  bvh.assign(std::move(nodes), std::move(items), stats);
+  return true;
+}
+
+bool BVHCache::load(const std::string& path, const std::vector<AABB>& bounds,
+                    BVH4& bvh) {
+  auto start = std::chrono::steady_clock::now();
+  std::vector<BVH4::Node> nodes;
+  std::vector<uint32_t> items;
+  FileHeader header;
+  if (!readCacheFile(path, bounds, AcceleratorType::BVH4, nodes, items,
+                     header)) {
+    return false;
+  }
+  AABB root(Vector3D(header.bounds[0], header.bounds[1], header.bounds[2]),
+            Vector3D(header.bounds[3], header.bounds[4], header.bounds[5]));
+  BVH::BuildStats stats = header.stats;
+  stats.fromCache = true;
+  stats.buildMilliseconds = elapsedMilliseconds(start);
+  bvh.assign(std::move(nodes), std::move(items), root, stats);
+  return true;
+}
+
+bool BVHCache::store(const std::string& path, const std::vector<AABB>& bounds,
+                     const BVH& bvh) {
+  return writeCacheFile(path, bounds, AcceleratorType::BVH, bvh.getNodes(),
+                        bvh.getItemIndices(), bvh.getBounds(),
+                        bvh.getBuildStats());
+}
+
+bool BVHCache::store(const std::string& path, const std::vector<AABB>& bounds,
+                     const BVH4& bvh) {
+  return writeCacheFile(path, bounds, AcceleratorType::BVH4, bvh.getNodes(),
+                        bvh.getItemIndices(), bvh.getBounds(),
+                        bvh.getBuildStats());
+}
+
+}  // namespace RayTracer
@@ -0,0 +1,140 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Acceleration structure disk cache header
+*/
+
+/**
+ * @file BVHCache.hpp
+ * @brief Definition of the BVHCache class, saving built hierarchies to
+ * versioned binary files and reading them back
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#ifndef BVHCACHE_HPP_
+#define BVHCACHE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../../core/AABB.hpp"
+#include "Accelerator.hpp"
+#include "BVH.hpp"
+#include "BVH4.hpp"
+
+namespace RayTracer {
+
+/**
+ * @brief Disk cache of built acceleration structures
+ *
+ * A cache file holds the raw node and item arrays of one hierarchy behind a
+ * header recording the format version, the node layout and a hash of the
+ * item boxes it was built over. Files are named after a key, normally the
+ * hash of the scene file, so that an edited scene never finds its old file;
+ * the box hash additionally rejects a file whose primitives moved for any
+ * other reason. Files are read straight into the arrays of the hierarchy,
+ * then checked: every node must be reached once from the root, within the
+ * depth of the traversal stack, and every child and leaf range and every
+ * item index must stay within the file. Any mismatch, truncation or damage
+ * makes the load fail, in which case the caller builds the hierarchy.
+ */
+class BVHCache {
+ public:
+  static constexpr uint32_t FORMAT_VERSION = 1;  ///< Bumped on layout changes
+  static constexpr uint64_t FNV_OFFSET_BASIS =
+      0xcbf29ce484222325ULL;  ///< Initial value of the 64-bit FNV-1a hash
+  static constexpr uint64_t FNV_PRIME =
+      0x100000001b3ULL;  ///< Multiplier of the 64-bit FNV-1a hash
+
+  /// Item count below which building is faster than opening a file
+  static constexpr std::size_t MIN_CACHED_ITEMS = 4096;
+
+  /// Directory of the cache files, relative to the working directory
+  static constexpr const char* DEFAULT_DIRECTORY = ".raytracer_cache";
+
+  /**
+   * @brief Hash bytes with 64-bit FNV-1a
+   * @param data The bytes to hash
+   * @param size The number of bytes
+   * @param seed Previous hash to chain from
+   * @return The updated hash
+   */
+  static uint64_t hash(const void* data, std::size_t size,
+                       uint64_t seed = FNV_OFFSET_BASIS);
+
+  /**
+   * @brief Hash a scene file and the files it includes
+   *
+   * Files pulled in with the libconfig `@include "path"` directive are hashed
+   * after the scene itself, recursively.
+   *
+   * @param path Path of the scene file
+   * @return The hash of the contents
+   * @throw std::runtime_error if a file cannot be read
+   */
+  static uint64_t hashSceneFile(const std::string& path);
+
+  /**
+   * @brief Hash the boxes a hierarchy is built over
+   * @param bounds The box of every item
+   * @return The hash of the box coordinates
+   */
+  static uint64_t hashBounds(const std::vector<AABB>& bounds);
+
+  /**
+   * @brief Get the cache file of a key
+   * @param key The cache key, normally hashSceneFile() of the scene
+   * @param type The acceleration structure stored in the file
+   * @param directory Directory of the cache files
+   * @return The path of the cache file
+   */
+  static std::string pathFor(uint64_t key, AcceleratorType type,
+                             const std::string& directory = DEFAULT_DIRECTORY);
+
+  /**
+   * @brief Load a binary hierarchy from a cache file
+   * @param path Path of the cache file
+   * @param bounds The boxes the hierarchy must have been built over
+   * @param bvh Receives the hierarchy, untouched on failure
+   * @return true if loaded, false if the file is missing, does not match or
+   * is damaged
+   */
+  static bool load(const std::string& path, const std::vector<AABB>& bounds,
+                   BVH& bvh);
+
+  /**
+   * @brief Load a four-wide hierarchy from a cache file
+   * @see load(const std::string&, const std::vector<AABB>&, BVH&)
+   */
+  static bool load(const std::string& path, const std::vector<AABB>& bounds,
+                   BVH4& bvh);
+
+  /**
+   * @brief Save a binary hierarchy to a cache file
+   *
+   * The file is written next to its final path and renamed into place, so
+   * concurrent renders never read a partial file.
+   *
+   * @param path Path of the cache file, its directory is created if needed
+   * @param bounds The boxes the hierarchy was built over
+   * @param bvh The hierarchy to save
+   * @return true if saved, false on any I/O error
+   */
+  static bool store(const std::string& path, const std::vector<AABB>& bounds,
+                    const BVH& bvh);
+
+  /**
+   * @brief Save a four-wide hierarchy to a cache file
+   * @see store(const std::string&, const std::vector<AABB>&, const BVH&)
+   */
+  static bool store(const std::string& path, const std::vector<AABB>& bounds,
+                    const BVH4& bvh);
+};
+
+}  // namespace RayTracer
+
+#endif /* !BVHCACHE_HPP_ */
@@ -0,0 +1,276 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Uniform grid acceleration structure implementation
+*/
+
+/**
+ * @file Grid.cpp
+ * @brief Implementation of the linear time construction of the uniform grid
+ * and of the heuristic choosing it over a BVH
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include "Grid.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace RayTracer {
+
+namespace {
+
+/**
+ * @brief Fraction of a cell by which item boxes are grown when binned
+ *
+ * Keeps an item in the cell the traversal computes for a point lying on the
+ * boundary between two cells, whichever way the rounding goes.
+ */
+constexpr double CELL_PADDING = 1e-6;
+
+/// Smallest extent of an axis relative to the largest, for flat scenes
+constexpr double MIN_RELATIVE_EXTENT = 1e-3;
+
+/// Fraction of the cells an even scene is expected to fill, see suits()
+constexpr double MIN_OCCUPANCY = 0.5;
+
+/// Average cells per item above which items are too large for a grid
+constexpr double MAX_REFERENCES_PER_ITEM = 4.0;
+
+double axisValue(const Vector3D& vector, int axis) {
+  if (axis == 0) {
+    return vector.getX();
+  }
+  return axis == 1 ? vector.getY() : vector.getZ();
+}
+
+}  // namespace
+
+Grid::Grid() : _levels(), _cells(), _items(), _stats() {}
+
+void Grid::build(const std::vector<AABB>& bounds, bool twoLevel) {
+  auto start = std::chrono::steady_clock::now();
+  clear();
+  if (bounds.empty()) {
+    return;
+  }
+
+  AABB sceneBounds;
+  std::vector<uint32_t> items(bounds.size());
+  for (std::size_t i = 0; i < bounds.size(); ++i) {
+    sceneBounds.expand(bounds[i]);
+    items[i] = static_cast<uint32_t>(i);
+  }
+  _levels.push_back(makeLevel(sceneBounds, bounds.size(), MAX_RESOLUTION));
+  fillLevel(0, bounds, items, twoLevel);
+
+  computeStats();
+  _stats.itemCount = bounds.size();
+  _stats.buildMilliseconds =
+      std::chrono::duration<double, std::milli>(
+          std::chrono::steady_clock::now() - start)
+          .count();
+}
+
+void Grid::clear() {
+  _levels.clear();
+  _cells.clear();
+  _items.clear();
+  _stats = BVH::BuildStats();
+}
+
+bool Grid::isEmpty() const {
+  return _levels.empty();
+}
+
+const std::vector<Grid::Level>& Grid::getLevels() const {
+  return _levels;
+}
+
+const std::vector<Grid::Cell>& Grid::getCells() const {
+  return _cells;
+}
+
+const BVH::BuildStats& Grid::getBuildStats() const {
+  return _stats;
+}
+
+bool Grid::suits(const std::vector<AABB>& bounds) {
+  if (bounds.size() < MIN_SUITABLE_ITEMS) {
+    return false;
+  }
+
+  AABB sceneBounds;
+  for (const auto& box : bounds) {
+    sceneBounds.expand(box);
+  }
+  Level level = makeLevel(sceneBounds, bounds.size(), MAX_RESOLUTION);
+  std::size_t cellCount = static_cast<std::size_t>(level.resolution[0]) *
+                          level.resolution[1] * level.resolution[2];
+
+  // Mark the cell of every centroid and count the references a build makes
+  std::vector<bool> occupied(cellCount, false);
+  std::size_t occupiedCount = 0;
+  std::size_t references = 0;
+  for (const auto& box : bounds) {
+    int first[3];
+    int last[3];
+    cellRange(level, box, first, last);
+    references += static_cast<std::size_t>(last[0] - first[0] + 1) *
+                  (last[1] - first[1] + 1) * (last[2] - first[2] + 1);
+
+    Vector3D centroid = box.centroid();
+    std::size_t cell = 0;
+    for (int axis = 2; axis >= 0; --axis) {
+      double position = (axisValue(centroid, axis) - level.min[axis]) *
+                        level.invCellSize[axis];
+      int index = std::clamp(static_cast<int>(position), 0,
+                             level.resolution[axis] - 1);
+      cell = cell * level.resolution[axis] + index;
+    }
+    if (!occupied[cell]) {
+      occupied[cell] = true;
+      occupiedCount++;
+    }
+  }
+
+  // A uniform random field fills about 80% of min(cells, items)
+  double occupancy = static_cast<double>(occupiedCount) /
+                     static_cast<double>(std::min(cellCount, bounds.size()));
+  double referencesPerItem =
+      static_cast<double>(references) / static_cast<double>(bounds.size());
+  return occupancy >= MIN_OCCUPANCY &&
+         referencesPerItem <= MAX_REFERENCES_PER_ITEM;
+}
+
+Grid::Level Grid::makeLevel(const AABB& bounds, std::size_t itemCount,
+                            int maxResolution) {
+  Level level;
+  Vector3D extent = bounds.extent();
+  double sizes[3] = {extent.getX(), extent.getY(), extent.getZ()};
+  double largest = std::max({sizes[0], sizes[1], sizes[2]});
+
+  // Cells are as close to cubes as the bounds allow, about CELLS_PER_ITEM
+  // of them per item
+  double volume = 1.0;
+  for (double size : sizes) {
+    volume *= std::max(size, largest * MIN_RELATIVE_EXTENT);
+  }
+  double cellsPerUnit =
+      largest > 0
+          ? std::cbrt(CELLS_PER_ITEM * static_cast<double>(itemCount) / volume)
+          : 0.0;
+
+  for (int axis = 0; axis < 3; ++axis) {
+    int resolution = static_cast<int>(std::lround(sizes[axis] * cellsPerUnit));
+    level.resolution[axis] = std::clamp(resolution, 1, maxResolution);
+    level.min[axis] = axisValue(bounds.getMin(), axis);
+    level.cellSize[axis] =
+        sizes[axis] > 0 ? sizes[axis] / level.resolution[axis] : 1.0;
+    level.invCellSize[axis] = 1.0 / level.cellSize[axis];
+  }
+  level.firstCell = 0;
+  return level;
+}
+
+void Grid::cellRange(const Level& level, const AABB& box, int first[3],
+                     int last[3]) {
+  for (int axis = 0; axis < 3; ++axis) {
+    double low = (axisValue(box.getMin(), axis) - level.min[axis]) *
+                     level.invCellSize[axis] -
+                 CELL_PADDING;
+    double high = (axisValue(box.getMax(), axis) - level.min[axis]) *
+                      level.invCellSize[axis] +
+                  CELL_PADDING;
+    int maxIndex = level.resolution[axis] - 1;
+    first[axis] = low > 0 ? std::min(static_cast<int>(low), maxIndex) : 0;
+    last[axis] = high > 0 ? std::min(static_cast<int>(high), maxIndex) : 0;
+  }
+}
+
+void Grid::fillLevel(uint32_t levelIndex, const std::vector<AABB>& bounds,
+                     const std::vector<uint32_t>& items, bool twoLevel) {
+  Level level = _levels[levelIndex];
+  int resolutionX = level.resolution[0];
+  int resolutionY = level.resolution[1];
+  std::size_t cellCount =
+      static_cast<std::size_t>(resolutionX) * resolutionY * level.resolution[2];
+  level.firstCell = static_cast<uint32_t>(_cells.size());
+  _levels[levelIndex].firstCell = level.firstCell;
+  _cells.resize(_cells.size() + cellCount);
+
+  // Count the references of every cell, then place them, both in one pass
+  // over the items
+  std::vector<uint32_t> starts(cellCount + 1, 0);
+  auto forEachCell = [&](uint32_t item, auto&& action) {
+    int first[3];
+    int last[3];
+    cellRange(level, bounds[item], first, last);
+    for (int z = first[2]; z <= last[2]; ++z) {
+      for (int y = first[1]; y <= last[1]; ++y) {
+        for (int x = first[0]; x <= last[0]; ++x) {
+          action((static_cast<std::size_t>(z) * resolutionY + y) *
+                     resolutionX +
+                 x);
+        }
+      }
+    }
+  };
+  for (uint32_t item : items) {
+    forEachCell(item, [&](std::size_t cell) { starts[cell + 1]++; });
+  }
+  for (std::size_t cell = 0; cell < cellCount; ++cell) {
+    starts[cell + 1] += starts[cell];
+  }
+  std::vector<uint32_t> references(starts[cellCount]);
+  std::vector<uint32_t> cursor(starts.begin(), starts.end() - 1);
+  for (uint32_t item : items) {
+    forEachCell(item,
+                [&](std::size_t cell) { references[cursor[cell]++] = item; });
+  }
+
+  bool divide = twoLevel && levelIndex == 0;
+  for (std::size_t cell = 0; cell < cellCount; ++cell) {
+    uint32_t count = starts[cell + 1] - starts[cell];
+    std::size_t cellIndex = level.firstCell + cell;
+    if (divide && count > SUBGRID_THRESHOLD) {
+      int x = static_cast<int>(cell % resolutionX);
+      int y = static_cast<int>((cell / resolutionX) % resolutionY);
+      int z = static_cast<int>(cell / (static_cast<std::size_t>(resolutionX) *
+                                       resolutionY));
+      Vector3D min(level.min[0] + x * level.cellSize[0],
+                   level.min[1] + y * level.cellSize[1],
+                   level.min[2] + z * level.cellSize[2]);
+      Vector3D max(min.getX() + level.cellSize[0],
+                   min.getY() + level.cellSize[1],
+                   min.getZ() + level.cellSize[2]);
+      uint32_t subIndex = static_cast<uint32_t>(_levels.size());
+      _levels.push_back(
+          makeLevel(AABB(min, max), count, MAX_SUBGRID_RESOLUTION));
+      _cells[cellIndex] = {0, count, static_cast<int32_t>(subIndex)};
+      std::vector<uint32_t> cellItems(references.begin() + starts[cell],
+                                      references.begin() + starts[cell + 1]);
+      fillLevel(subIndex, bounds, cellItems, false);
+    } else {
+      _cells[cellIndex] = {static_cast<uint32_t>(_items.size()), count, -1};
+      _items.insert(_items.end(), references.begin() + starts[cell],
+                    references.begin() + starts[cell + 1]);
+    }
+  }
+}
+
+void Grid::computeStats() {
+  for (const auto& cell : _cells) {
+    if (cell.level < 0 && cell.count > 0) {
+      _stats.leafCount++;
+      _stats.maxLeafSize =
+          std::max(_stats.maxLeafSize, static_cast<std::size_t>(cell.count));
+    }
+  }
+  _stats.nodeCount = _cells.size();
+  _stats.maxDepth = _levels.size() > 1 ? 1 : 0;
+}
+
+}  // namespace RayTracer
@@ -0,0 +1,357 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Uniform grid acceleration structure header
+*/
+
+/**
+ * @file Grid.hpp
+ * @brief Definition of the Grid class, a uniform grid with optional second
+ * level cells traversed with a 3D digital differential analyzer
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#ifndef GRID_HPP_
+#define GRID_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "../../core/AABB.hpp"
+#include "../../core/Ray.hpp"
+#include "BVH.hpp"
+
+namespace RayTracer {
+
+/**
+ * @brief Uniform grid over a set of bounding boxes
+ *
+ * Every item is referenced by each cell its box overlaps, so the grid is
+ * built in time linear in the number of references, and rays walk the cells
+ * they cross in order with a 3D-DDA. This suits dense, evenly distributed
+ * scenes of small items, such as particle fields, better than a tree; on
+ * scenes mixing large and small items or with empty space a BVH wins, see
+ * suits().
+ *
+ * With two levels, top cells holding more than SUBGRID_THRESHOLD items are
+ * divided again by a grid of their own, which bounds the cost of the few
+ * crowded cells of an otherwise uniform scene.
+ *
+ * Items are reported with their index in the build input, as BVH does.
+ */
+class Grid {
+ public:
+  /**
+   * @brief One level of the grid
+   */
+  struct Level {
+    double min[3];          ///< Minimum corner of the level bounds
+    double cellSize[3];     ///< Size of a cell along every axis
+    double invCellSize[3];  ///< Inverse of the cell size
+    int resolution[3];      ///< Number of cells along every axis
+    uint32_t firstCell;     ///< Index of the first cell of the level
+  };
+
+  /**
+   * @brief Grid cell, leaf or reference to a second level grid
+   */
+  struct Cell {
+    uint32_t first;  ///< First reference in the item array
+    uint32_t count;  ///< Number of items overlapping the cell
+    int32_t level;   ///< Level dividing the cell, -1 for a leaf cell
+  };
+
+  static constexpr double CELLS_PER_ITEM = 2.0;  ///< Target cell density
+  static constexpr int MAX_RESOLUTION = 128;     ///< Top cells per axis
+  static constexpr int MAX_SUBGRID_RESOLUTION = 8;  ///< Second level cells
+  static constexpr uint32_t SUBGRID_THRESHOLD =
+      16;  ///< Items in a top cell from which it gets a second level
+  static constexpr std::size_t MIN_SUITABLE_ITEMS =
+      1024;  ///< Below this, suits() always prefers a tree
+
+  /**
+   * @brief Default constructor
+   * Creates an empty grid
+   */
+  Grid();
+
+  /**
+   * @brief Build the grid over a set of boxes
+   * @param bounds The box of every item, all bounded
+   * @param twoLevel Whether crowded cells are divided again
+   */
+  void build(const std::vector<AABB>& bounds, bool twoLevel = true);
+
+  /**
+   * @brief Remove every cell and item
+   */
+  void clear();
+
+  /**
+   * @brief Check if the grid contains no item
+   * @return true if empty, false otherwise
+   */
+  bool isEmpty() const;
+
+  /**
+   * @brief Get the levels, top level first
+   * @return The level array
+   */
+  const std::vector<Level>& getLevels() const;
+
+  /**
+   * @brief Get the cells of every level
+   * @return The cell array
+   */
+  const std::vector<Cell>& getCells() const;
+
+  /**
+   * @brief Get the statistics of the last build
+   *
+   * Shares the hierarchy statistics: nodes are cells, leaves are non-empty
+   * leaf cells, the depth is the number of levels below the top one and
+   * the leaf size is the largest number of items in a cell. There is no SAH
+   * cost.
+   *
+   * @return The build statistics, all zero if nothing was built
+   */
+  const BVH::BuildStats& getBuildStats() const;
+
+  /**
+   * @brief Check if a grid is expected to beat a BVH on a set of boxes
+   *
+   * True for large sets whose items are small compared to the cells and
+   * spread over most of them, false when items cluster in a few places or
+   * span many cells.
+   *
+   * @param bounds The box of every item
+   * @return true if a grid should be used, false for a BVH
+   */
+  static bool suits(const std::vector<AABB>& bounds);
+
+  /**
+   * @brief Visit the items whose cells are crossed by a ray
+   *
+   * Same contract as BVH::traverse(): cells are visited front to back, the
+   * visitor is called as `bool visitor(std::size_t item, double& tMax)`,
+   * may shrink tMax, and stops the traversal by returning true. An item
+   * spanning several cells may be visited more than once.
+   *
+   * @param ray The ray, its direction does not need to be normalized
+   * @param tMax Upper bound of the ray parameter, updated by the visitor
+   * @param visitor The callback run for every candidate item
+   * @return true if the visitor stopped the traversal, false otherwise
+   */
+  template <typename Visitor>
+  bool traverse(const Ray& ray, double& tMax, Visitor&& visitor) const;
+
+ private:
+  /// Recently visited items, skipped when met again in the next cells
+  static constexpr int MAILBOX_SIZE = 8;
+
+  /**
+   * @brief Ray data shared by every level of a traversal
+   */
+  struct RayData {
+    double origin[3];     ///< The ray origin
+    double direction[3];  ///< The ray direction
+    double invDir[3];     ///< The inverse of the ray direction
+    uint32_t mailbox[MAILBOX_SIZE];  ///< Last visited items
+    int mailboxNext;                 ///< Next mailbox slot to overwrite
+  };
+
+  std::vector<Level> _levels;   ///< Top level first, then the subgrids
+  std::vector<Cell> _cells;     ///< Cells of every level
+  std::vector<uint32_t> _items;  ///< Item references of the leaf cells
+  BVH::BuildStats _stats;        ///< Statistics of the last build
+
+  /**
+   * @brief Choose the resolution of a level
+   * @param bounds The level bounds
+   * @param itemCount Number of items in the level
+   * @param maxResolution Largest number of cells per axis
+   * @return The level, without cells yet
+   */
+  static Level makeLevel(const AABB& bounds, std::size_t itemCount,
+                         int maxResolution);
+
+  /**
+   * @brief Compute the range of cells overlapped by a box
+   * @param level The level
+   * @param box The box
+   * @param first Receives the first cell coordinates
+   * @param last Receives the last cell coordinates, included
+   */
+  static void cellRange(const Level& level, const AABB& box, int first[3],
+                        int last[3]);
+
+  /**
+   * @brief Create the cells of a level and distribute items into them
+   * @param levelIndex Index of the level in _levels
+   * @param bounds The box of every item
+   * @param items The items of the level
+   * @param twoLevel Whether crowded cells get a second level
+   */
+  void fillLevel(uint32_t levelIndex, const std::vector<AABB>& bounds,
+                 const std::vector<uint32_t>& items, bool twoLevel);
+
+  /**
+   * @brief Fill the statistics of _stats from the cells
+   */
+  void computeStats();
+
+  /**
+   * @brief Walk the cells of a level crossed by a ray
+   * @param levelIndex Index of the level in _levels
+   * @param ray The precomputed ray data
+   * @param tStart Lower bound of the walked interval
+   * @param tEnd Upper bound of the walked interval
+   * @param tMax Upper bound of the ray parameter, updated by the visitor
+   * @param visitor The callback run for every candidate item
+   * @return true if the visitor stopped the traversal, false otherwise
+   */
+  template <typename Visitor>
+  bool traverseLevel(uint32_t levelIndex, RayData& ray, double tStart,
+                     double tEnd, double& tMax, Visitor& visitor) const;
+};
+
+// Template implementation (must be in header)
+template <typename Visitor>
+bool Grid::traverse(const Ray& ray, double& tMax, Visitor&& visitor) const {
+  if (_levels.empty()) {
+    return false;
+  }
+
+  RayData data;
+  Vector3D origin = ray.getOrigin();
+  Vector3D direction = ray.getDirection();
+  const Vector3D& invDir = ray.getInverseDirection();
+  data.origin[0] = origin.getX();
+  data.origin[1] = origin.getY();
+  data.origin[2] = origin.getZ();
+  data.direction[0] = direction.getX();
+  data.direction[1] = direction.getY();
+  data.direction[2] = direction.getZ();
+  data.invDir[0] = invDir.getX();
+  data.invDir[1] = invDir.getY();
+  data.invDir[2] = invDir.getZ();
+  for (int i = 0; i < MAILBOX_SIZE; ++i) {
+    data.mailbox[i] = std::numeric_limits<uint32_t>::max();
+  }
+  data.mailboxNext = 0;
+  return traverseLevel(0, data, ray.getTMin(), tMax, tMax, visitor);
+}
+
+template <typename Visitor>
+bool Grid::traverseLevel(uint32_t levelIndex, RayData& ray, double tStart,
+                         double tEnd, double& tMax, Visitor& visitor) const {
+  const Level& level = _levels[levelIndex];
+
+  // Clip the walked interval to the level bounds
+  double t0 = tStart;
+  double t1 = tEnd * (1.0 + SLAB_EPSILON);
+  for (int axis = 0; axis < 3; ++axis) {
+    double max =
+        level.min[axis] + level.resolution[axis] * level.cellSize[axis];
+    double tA = (level.min[axis] - ray.origin[axis]) * ray.invDir[axis];
+    double tB = (max - ray.origin[axis]) * ray.invDir[axis];
+    if (tA > tB) {
+      double tmp = tA;
+      tA = tB;
+      tB = tmp;
+    }
+    tB *= 1.0 + SLAB_EPSILON;
+    // Written so that NaN (0 * inf on a slab boundary) keeps the old bound
+    t0 = tA > t0 ? tA : t0;
+    t1 = tB < t1 ? tB : t1;
+  }
+  if (t0 > t1) {
+    return false;
+  }
+
+  // Set up the walk from the cell containing the entry point
+  int cell[3];
+  int step[3];
+  double tNext[3];
+  double tDelta[3];
+  for (int axis = 0; axis < 3; ++axis) {
+    double entry = ray.origin[axis] + ray.direction[axis] * t0;
+    double position = (entry - level.min[axis]) * level.invCellSize[axis];
+    int index = position > 0 ? static_cast<int>(position) : 0;
+    cell[axis] = index < level.resolution[axis] ? index
+                                                : level.resolution[axis] - 1;
+    if (ray.direction[axis] > 0) {
+      step[axis] = 1;
+      tNext[axis] = (level.min[axis] + (cell[axis] + 1) * level.cellSize[axis] -
+                     ray.origin[axis]) *
+                    ray.invDir[axis];
+      tDelta[axis] = level.cellSize[axis] * ray.invDir[axis];
+    } else if (ray.direction[axis] < 0) {
+      step[axis] = -1;
+      tNext[axis] = (level.min[axis] + cell[axis] * level.cellSize[axis] -
+                     ray.origin[axis]) *
+                    ray.invDir[axis];
+      tDelta[axis] = -level.cellSize[axis] * ray.invDir[axis];
+    } else {
+      step[axis] = 0;
+      tNext[axis] = std::numeric_limits<double>::infinity();
+      tDelta[axis] = std::numeric_limits<double>::infinity();
+    }
+  }
+
+  double tCell = t0;
+  while (true) {
+    int axis = tNext[0] < tNext[1] ? 0 : 1;
+    axis = tNext[2] < tNext[axis] ? 2 : axis;
+    double tExit = tNext[axis] < t1 ? tNext[axis] : t1;
+
+    const Cell& current =
+        _cells[level.firstCell +
+               (static_cast<uint32_t>(cell[2]) * level.resolution[1] +
+                static_cast<uint32_t>(cell[1])) *
+                   level.resolution[0] +
+               static_cast<uint32_t>(cell[0])];
+    if (current.level >= 0) {
+      if (traverseLevel(static_cast<uint32_t>(current.level), ray, tCell,
+                        tExit, tMax, visitor)) {
+        return true;
+      }
+    } else {
+      for (uint32_t i = 0; i < current.count; ++i) {
+        uint32_t item = _items[current.first + i];
+        bool seen = false;
+        for (int k = 0; k < MAILBOX_SIZE; ++k) {
+          seen = seen || ray.mailbox[k] == item;
+        }
+        if (seen) {
+          continue;
+        }
+        ray.mailbox[ray.mailboxNext] = item;
+        ray.mailboxNext = (ray.mailboxNext + 1) % MAILBOX_SIZE;
+        if (visitor(static_cast<std::size_t>(item), tMax)) {
+          return true;
+        }
+      }
+    }
+
+    // Cells past the closest hit found so far cannot hold a closer one
+    if (tExit >= t1 || tExit > tMax * (1.0 + SLAB_EPSILON)) {
+      return false;
+    }
+    cell[axis] += step[axis];
+    if (cell[axis] < 0 || cell[axis] >= level.resolution[axis]) {
+      return false;
+    }
+    tCell = tNext[axis];
+    tNext[axis] += tDelta[axis];
+  }
+}
+
+}  // namespace RayTracer
+
+#endif /* !GRID_HPP_ */
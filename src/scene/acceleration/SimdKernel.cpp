@@ -0,0 +1,61 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** SIMD kernel selection implementation
+*/
+
+/**
+ * @file SimdKernel.cpp
+ * @brief Run time detection of the instruction sets of the packed primitive
+ * kernels
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include "SimdKernel.hpp"
+
+namespace RayTracer {
+
+bool supportsSimdKernel(SimdKernel kernel) {
+  switch (kernel) {
+    case SimdKernel::AVX:
+#if defined(RAYTRACER_AVX_KERNELS)
+      // Also checks that the system saves the AVX registers
+      return __builtin_cpu_supports("avx");
+#else
+      return false;
+#endif
+    case SimdKernel::SSE2:
+#if defined(__SSE2__)
+      return true;
+#else
+      return false;
+#endif
+    default:
+      return true;
+  }
+}
+
+SimdKernel bestSimdKernel() {
+  static const SimdKernel best = supportsSimdKernel(SimdKernel::AVX)
+                                     ? SimdKernel::AVX
+                                 : supportsSimdKernel(SimdKernel::SSE2)
+                                     ? SimdKernel::SSE2
+                                     : SimdKernel::SCALAR;
+  return best;
+}
+
+std::string simdKernelName(SimdKernel kernel) {
+  switch (kernel) {
+    case SimdKernel::AVX:
+      return "avx";
+    case SimdKernel::SSE2:
+      return "sse2";
+    default:
+      return "scalar";
+  }
+}
+
+}  // namespace RayTracer
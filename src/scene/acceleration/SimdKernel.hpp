@@ -0,0 +1,64 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** SIMD kernel selection header
+*/
+
+/**
+ * @file SimdKernel.hpp
+ * @brief Instruction sets of the packed primitive kernels and their run time
+ * detection
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#ifndef SIMDKERNEL_HPP_
+#define SIMDKERNEL_HPP_
+
+#include <string>
+
+// AVX kernels are compiled for their own target and only run once CPUID
+// reported AVX, the rest of the program keeps the baseline instruction set
+#if defined(__SSE2__) && defined(__GNUC__)
+#define RAYTRACER_AVX_KERNELS 1
+#define RAYTRACER_TARGET_AVX __attribute__((target("avx")))
+#else
+#define RAYTRACER_TARGET_AVX
+#endif
+
+namespace RayTracer {
+
+/**
+ * @brief Instruction set used to intersect packed primitives
+ */
+enum class SimdKernel {
+  SCALAR,  ///< One primitive at a time, works everywhere
+  SSE2,    ///< Two primitives per instruction
+  AVX,     ///< Four primitives per instruction
+};
+
+/**
+ * @brief Check if the processor runs a kernel
+ * @param kernel The kernel to check
+ * @return true if its instructions are available
+ */
+bool supportsSimdKernel(SimdKernel kernel);
+
+/**
+ * @brief Get the fastest kernel the processor runs
+ * @return AVX, SSE2 or SCALAR, detected once with CPUID
+ */
+SimdKernel bestSimdKernel();
+
+/**
+ * @brief Get the name of a kernel
+ * @param kernel The kernel
+ * @return "scalar", "sse2" or "avx"
+ */
+std::string simdKernelName(SimdKernel kernel);
+
+}  // namespace RayTracer
+
+#endif /* !SIMDKERNEL_HPP_ */
@@ -0,0 +1,347 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Packed sphere block implementation
+*/
+
+/**
+ * @file SphereBlock.cpp
+ * @brief Implementation of the packed sphere block and of its scalar, SSE2
+ * and AVX intersection kernels
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include "SphereBlock.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include "../../core/Transform.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(RAYTRACER_AVX_KERNELS)
+#include <immintrin.h>
+#endif
+
+namespace RayTracer {
+
+namespace {
+
+constexpr double INFINITE_T = std::numeric_limits<double>::infinity();
+
+/// Coordinate of the padding spheres: every comparison with it fails
+constexpr double PADDING = std::numeric_limits<double>::quiet_NaN();
+
+}  // namespace
+
+SphereBlock::SphereBlock()
+    : _centerX(),
+      _centerY(),
+      _centerZ(),
+      _radiusSquared(),
+      _tags(),
+      _count(0),
+      _kernel(bestSimdKernel()) {
+  pad();
+}
+
+bool SphereBlock::bake(const Sphere& sphere, Vector3D& center,
+                       double& radius) {
+  Transform transform = sphere.getTransform();
+  if (!transform.isAffine()) {
+    return false;
+  }
+
+  // The sphere stays a sphere when the columns of the linear part are
+  // orthogonal and of the same length, the scale factor
+  Vector3D columns[3] = {transform.applyToVector(Vector3D(1, 0, 0)),
+                         transform.applyToVector(Vector3D(0, 1, 0)),
+                         transform.applyToVector(Vector3D(0, 0, 1))};
+  double scaleSquared = columns[0].dot(columns[0]);
+  if (scaleSquared <= 0.0) {
+    return false;
+  }
+  double tolerance = BAKE_TOLERANCE * scaleSquared;
+  for (int i = 0; i < 3; ++i) {
+    for (int j = i; j < 3; ++j) {
+      double expected = i == j ? scaleSquared : 0.0;
+      if (std::abs(columns[i].dot(columns[j]) - expected) > tolerance) {
+        return false;
+      }
+    }
+  }
+
+  center = transform.applyToPoint(sphere.getCenter());
+  radius = sphere.getRadius() * std::sqrt(scaleSquared);
+  return true;
+}
+
+void SphereBlock::add(const Vector3D& center, double radius,
+                      std::size_t tag) {
+  _centerX.resize(_count);
+  _centerY.resize(_count);
+  _centerZ.resize(_count);
+  _radiusSquared.resize(_count);
+  _tags.resize(_count);
+  _centerX.push_back(center.getX());
+  _centerY.push_back(center.getY());
+  _centerZ.push_back(center.getZ());
+  _radiusSquared.push_back(radius * radius);
+  _tags.push_back(tag);
+  ++_count;
+  pad();
+}
+
+void SphereBlock::clear() {
+  _count = 0;
+  _centerX.clear();
+  _centerY.clear();
+  _centerZ.clear();
+  _radiusSquared.clear();
+  _tags.clear();
+  pad();
+}
+
+std::size_t SphereBlock::size() const {
+  return _count;
+}
+
+std::size_t SphereBlock::getTag(std::size_t index) const {
+  return _tags[index];
+}
+
+void SphereBlock::pad() {
+  _centerX.resize(_count + LANES - 1, PADDING);
+  _centerY.resize(_count + LANES - 1, PADDING);
+  _centerZ.resize(_count + LANES - 1, PADDING);
+  _radiusSquared.resize(_count + LANES - 1, PADDING);
+  _tags.resize(_count + LANES - 1, 0);
+}
+
+SphereBlock::Query SphereBlock::makeQuery(const Ray& ray, double tMax) {
+  Vector3D origin = ray.getOrigin();
+  Vector3D direction = ray.getDirection();
+  // Same expressions as Sphere, so that the results match to the bit
+  double a = direction.dot(direction);
+  Query query;
+  query.origin[0] = origin.getX();
+  query.origin[1] = origin.getY();
+  query.origin[2] = origin.getZ();
+  query.direction[0] = direction.getX();
+  query.direction[1] = direction.getY();
+  query.direction[2] = direction.getZ();
+  query.twoA = 2 * a;
+  query.fourA = 4 * a;
+  query.tMin = ray.getTMin();
+  query.tMax = tMax;
+  return query;
+}
+
+std::optional<HitRecord> SphereBlock::intersect(const Ray& ray,
+                                                std::size_t begin,
+                                                std::size_t end) const {
+  Query query = makeQuery(ray, ray.getTMax());
+  double t[LANES];
+  std::size_t best = end;
+  double bestT = INFINITE_T;
+  for (std::size_t first = begin; first < end; first += LANES) {
+    hitParameters(query, first, t);
+    std::size_t lanes = std::min(LANES, end - first);
+    for (std::size_t i = 0; i < lanes; ++i) {
+      if (t[i] < bestT || (t[i] == bestT && best != end &&
+                           _tags[first + i] < _tags[best])) {
+        best = first + i;
+        bestT = t[i];
+      }
+    }
+    // Farther spheres are culled by the kernel, equal ones still compete
+    query.tMax = std::min(query.tMax, bestT);
+  }
+  if (best == end) {
+    return std::nullopt;
+  }
+  ray.shrinkTMax(bestT);
+
+  HitRecord hit;
+  hit.t = bestT;
+  hit.primitiveIndex = _tags[best];
+  return hit;
+}
+
+bool SphereBlock::occluded(const Ray& ray, std::size_t begin,
+                           std::size_t end, double tMax) const {
+  Query query = makeQuery(ray, tMax);
+  double t[LANES];
+  for (std::size_t first = begin; first < end; first += LANES) {
+    hitParameters(query, first, t);
+    std::size_t lanes = std::min(LANES, end - first);
+    for (std::size_t i = 0; i < lanes; ++i) {
+      if (t[i] != INFINITE_T) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void SphereBlock::hitParameters(const Query& query, std::size_t first,
+                                double* t) const {
+  switch (_kernel) {
+    case SimdKernel::AVX:
+      hitParametersAvx(query, first, t);
+      break;
+    case SimdKernel::SSE2:
+      hitParametersSse2(query, first, t);
+      break;
+    default:
+      hitParametersScalar(query, first, t);
+      break;
+  }
+}
+
+void SphereBlock::hitParametersScalar(const Query& query, std::size_t first,
+                                      double* t) const {
+  for (std::size_t i = 0; i < LANES; ++i) {
+    std::size_t k = first + i;
+    double ocX = query.origin[0] - _centerX[k];
+    double ocY = query.origin[1] - _centerY[k];
+    double ocZ = query.origin[2] - _centerZ[k];
+    double b = 2.0 * (ocX * query.direction[0] + ocY * query.direction[1] +
+                      ocZ * query.direction[2]);
+    double c = ocX * ocX + ocY * ocY + ocZ * ocZ - _radiusSquared[k];
+    double discriminant = b * b - query.fourA * c;
+    t[i] = INFINITE_T;
+    if (discriminant < 0) {
+      continue;
+    }
+    // A padding sphere gives NaN, which fails every test below
+    double root = std::sqrt(discriminant);
+    double t1 = (-b - root) / query.twoA;
+    double t2 = (-b + root) / query.twoA;
+    if (t1 >= 0 && t1 >= query.tMin && t1 <= query.tMax) {
+      t[i] = t1;
+    } else if (t2 >= 0 && t2 >= query.tMin && t2 <= query.tMax) {
+      t[i] = t2;
+    }
+  }
+}
+
+void SphereBlock::hitParametersSse2(const Query& query, std::size_t first,
+                                    double* t) const {
+#if defined(__SSE2__)
+  const __m128d originX = _mm_set1_pd(query.origin[0]);
+  const __m128d originY = _mm_set1_pd(query.origin[1]);
+  const __m128d originZ = _mm_set1_pd(query.origin[2]);
+  const __m128d directionX = _mm_set1_pd(query.direction[0]);
+  const __m128d directionY = _mm_set1_pd(query.direction[1]);
+  const __m128d directionZ = _mm_set1_pd(query.direction[2]);
+  const __m128d zero = _mm_setzero_pd();
+  const __m128d signBit = _mm_set1_pd(-0.0);
+  for (std::size_t i = 0; i < LANES; i += 2) {
+    std::size_t k = first + i;
+    __m128d ocX = _mm_sub_pd(originX, _mm_loadu_pd(_centerX.data() + k));
+    __m128d ocY = _mm_sub_pd(originY, _mm_loadu_pd(_centerY.data() + k));
+    __m128d ocZ = _mm_sub_pd(originZ, _mm_loadu_pd(_centerZ.data() + k));
+    __m128d b = _mm_add_pd(_mm_add_pd(_mm_mul_pd(ocX, directionX),
+                                      _mm_mul_pd(ocY, directionY)),
+                           _mm_mul_pd(ocZ, directionZ));
+    b = _mm_mul_pd(_mm_set1_pd(2.0), b);
+    __m128d c = _mm_sub_pd(
+        _mm_add_pd(_mm_add_pd(_mm_mul_pd(ocX, ocX), _mm_mul_pd(ocY, ocY)),
+                   _mm_mul_pd(ocZ, ocZ)),
+        _mm_loadu_pd(_radiusSquared.data() + k));
+    __m128d discriminant = _mm_sub_pd(
+        _mm_mul_pd(b, b), _mm_mul_pd(_mm_set1_pd(query.fourA), c));
+    // The square root of a negative discriminant is NaN and fails below
+    __m128d root = _mm_sqrt_pd(discriminant);
+    __m128d negB = _mm_xor_pd(b, signBit);
+    __m128d twoA = _mm_set1_pd(query.twoA);
+    __m128d t1 = _mm_div_pd(_mm_sub_pd(negB, root), twoA);
+    __m128d t2 = _mm_div_pd(_mm_add_pd(negB, root), twoA);
+    __m128d tMin = _mm_set1_pd(query.tMin);
+    __m128d tMax = _mm_set1_pd(query.tMax);
+    __m128d valid1 = _mm_and_pd(
+        _mm_and_pd(_mm_cmpge_pd(t1, zero), _mm_cmpge_pd(t1, tMin)),
+        _mm_cmple_pd(t1, tMax));
+    __m128d valid2 = _mm_and_pd(
+        _mm_and_pd(_mm_cmpge_pd(t2, zero), _mm_cmpge_pd(t2, tMin)),
+        _mm_cmple_pd(t2, tMax));
+    __m128d result = _mm_or_pd(_mm_and_pd(valid2, t2),
+                               _mm_andnot_pd(valid2, _mm_set1_pd(INFINITE_T)));
+    result = _mm_or_pd(_mm_and_pd(valid1, t1), _mm_andnot_pd(valid1, result));
+    _mm_storeu_pd(t + i, result);
+  }
+#else
+  hitParametersScalar(query, first, t);
+#endif
+}
+
+RAYTRACER_TARGET_AVX
+void SphereBlock::hitParametersAvx(const Query& query, std::size_t first,
+                                   double* t) const {
+#if defined(RAYTRACER_AVX_KERNELS)
+  // Same operations as the SSE2 kernel, on four spheres at once
+  __m256d ocX = _mm256_sub_pd(_mm256_set1_pd(query.origin[0]),
+                              _mm256_loadu_pd(_centerX.data() + first));
+  __m256d ocY = _mm256_sub_pd(_mm256_set1_pd(query.origin[1]),
+                              _mm256_loadu_pd(_centerY.data() + first));
+  __m256d ocZ = _mm256_sub_pd(_mm256_set1_pd(query.origin[2]),
+                              _mm256_loadu_pd(_centerZ.data() + first));
+  __m256d b = _mm256_add_pd(
+      _mm256_add_pd(_mm256_mul_pd(ocX, _mm256_set1_pd(query.direction[0])),
+                    _mm256_mul_pd(ocY, _mm256_set1_pd(query.direction[1]))),
+      _mm256_mul_pd(ocZ, _mm256_set1_pd(query.direction[2])));
+  b = _mm256_mul_pd(_mm256_set1_pd(2.0), b);
+  __m256d c = _mm256_sub_pd(
+      _mm256_add_pd(
+          _mm256_add_pd(_mm256_mul_pd(ocX, ocX), _mm256_mul_pd(ocY, ocY)),
+          _mm256_mul_pd(ocZ, ocZ)),
+      _mm256_loadu_pd(_radiusSquared.data() + first));
+  __m256d discriminant =
+      _mm256_sub_pd(_mm256_mul_pd(b, b),
+                    _mm256_mul_pd(_mm256_set1_pd(query.fourA), c));
+  __m256d root = _mm256_sqrt_pd(discriminant);
+  __m256d negB = _mm256_xor_pd(b, _mm256_set1_pd(-0.0));
+  __m256d twoA = _mm256_set1_pd(query.twoA);
+  __m256d t1 = _mm256_div_pd(_mm256_sub_pd(negB, root), twoA);
+  __m256d t2 = _mm256_div_pd(_mm256_add_pd(negB, root), twoA);
+  __m256d zero = _mm256_setzero_pd();
+  __m256d tMin = _mm256_set1_pd(query.tMin);
+  __m256d tMax = _mm256_set1_pd(query.tMax);
+  __m256d valid1 = _mm256_and_pd(
+      _mm256_and_pd(_mm256_cmp_pd(t1, zero, _CMP_GE_OQ),
+                    _mm256_cmp_pd(t1, tMin, _CMP_GE_OQ)),
+      _mm256_cmp_pd(t1, tMax, _CMP_LE_OQ));
+  __m256d valid2 = _mm256_and_pd(
+      _mm256_and_pd(_mm256_cmp_pd(t2, zero, _CMP_GE_OQ),
+                    _mm256_cmp_pd(t2, tMin, _CMP_GE_OQ)),
+      _mm256_cmp_pd(t2, tMax, _CMP_LE_OQ));
+  __m256d result =
+      _mm256_blendv_pd(_mm256_set1_pd(INFINITE_T), t2, valid2);
+  result = _mm256_blendv_pd(result, t1, valid1);
+  _mm256_storeu_pd(t, result);
+#else
+  hitParametersSse2(query, first, t);
+#endif
+}
+
+void SphereBlock::setKernel(SimdKernel kernel) {
+  if (!supportsSimdKernel(kernel)) {
+    throw std::invalid_argument("Sphere kernel not supported: " +
+                                simdKernelName(kernel));
+  }
+  _kernel = kernel;
+}
+
+SimdKernel SphereBlock::getKernel() const {
+  return _kernel;
+}
+
+}  // namespace RayTracer
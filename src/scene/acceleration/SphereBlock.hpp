@@ -0,0 +1,201 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Packed sphere block header
+*/
+
+/**
+ * @file SphereBlock.hpp
+ * @brief Definition of the SphereBlock class, world-space spheres stored as
+ * a structure of arrays and intersected several at a time with SIMD
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#ifndef SPHEREBLOCK_HPP_
+#define SPHEREBLOCK_HPP_
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+#include "../../../include/IPrimitive.hpp"
+#include "../../core/Ray.hpp"
+#include "../primitives/Sphere.hpp"
+#include "SimdKernel.hpp"
+
+namespace RayTracer {
+
+/**
+ * @brief Spheres baked in world space, intersected four at a time
+ *
+ * A sphere whose transform only translates, rotates and scales uniformly is
+ * still a sphere in world space: its center and squared radius are stored
+ * in one array per coordinate, so that a ray is tested against several of
+ * them per instruction without a virtual call or a ray transform.
+ *
+ * The kernel is chosen at run time from what the processor supports: AVX
+ * tests four spheres per instruction, SSE2 two, and a scalar loop is used
+ * everywhere else. Every kernel runs the same operations as Sphere, so an
+ * untransformed sphere gives bit for bit the same hit parameter.
+ *
+ * Every sphere carries a tag chosen by the owner, reported back as the
+ * primitive index of its hits and used to break ties between equal hits.
+ */
+class SphereBlock {
+ public:
+  /**
+   * @brief Default constructor
+   * Creates an empty block using the best kernel of the processor
+   */
+  SphereBlock();
+
+  /**
+   * @brief Get the world-space center and radius of a sphere
+   * @param sphere The sphere to bake
+   * @param center Receives the world-space center
+   * @param radius Receives the world-space radius
+   * @return false if the transform turns the sphere into an ellipsoid
+   */
+  static bool bake(const Sphere& sphere, Vector3D& center, double& radius);
+
+  /**
+   * @brief Append a world-space sphere
+   * @param center The center of the sphere
+   * @param radius The radius of the sphere
+   * @param tag Reported as the primitive index of the sphere hits
+   */
+  void add(const Vector3D& center, double radius, std::size_t tag);
+
+  /**
+   * @brief Remove every sphere
+   */
+  void clear();
+
+  /**
+   * @brief Get the number of spheres
+   * @return The sphere count
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Get the tag of a sphere
+   * @param index Position of the sphere in the block
+   * @return The tag given to add()
+   */
+  std::size_t getTag(std::size_t index) const;
+
+  /**
+   * @brief Find the closest hit of a ray among a range of spheres
+   *
+   * Same contract as IPrimitive::intersectHit(): only hits inside the ray
+   * interval are reported, and the ray tMax is shrunk to the hit. Among
+   * hits at the same distance, the one with the lowest tag wins.
+   *
+   * @param ray The ray to test
+   * @param begin First sphere of the range
+   * @param end One past the last sphere of the range
+   * @return The closest hit with the tag as primitive index, if any
+   */
+  std::optional<HitRecord> intersect(const Ray& ray, std::size_t begin,
+                                     std::size_t end) const;
+
+  /**
+   * @brief Check if a ray hits a range of spheres closer than a distance
+   * @param ray The ray to test, its tMin is the lower bound of the query
+   * @param begin First sphere of the range
+   * @param end One past the last sphere of the range
+   * @param tMax Hits beyond this distance are ignored
+   * @return true if some sphere of the range is hit in [tMin, tMax]
+   */
+  bool occluded(const Ray& ray, std::size_t begin, std::size_t end,
+                double tMax) const;
+
+  /**
+   * @brief Choose the kernel used by this block
+   * @param kernel The kernel, must be supported by the processor
+   * @throw std::invalid_argument if the processor lacks the instructions
+   */
+  void setKernel(SimdKernel kernel);
+
+  /**
+   * @brief Get the kernel used by this block
+   * @return The kernel, bestSimdKernel() unless set otherwise
+   */
+  SimdKernel getKernel() const;
+
+  static constexpr std::size_t LANES = 4;  ///< Spheres per kernel step
+  static constexpr double BAKE_TOLERANCE =
+      1e-12;  ///< Relative error accepted on a uniform scale
+
+ private:
+  /**
+   * @brief Ray data shared by every lane of a kernel step
+   */
+  struct Query {
+    double origin[3];     ///< Ray origin
+    double direction[3];  ///< Ray direction
+    double twoA;          ///< Twice the squared direction length
+    double fourA;         ///< Four times the squared direction length
+    double tMin;          ///< Lower bound of the ray parameter
+    double tMax;          ///< Upper bound of the ray parameter
+  };
+
+  // Padded with LANES - 1 spheres that are never hit, so that a kernel step
+  // starting at the last sphere only reads initialized values
+  std::vector<double> _centerX;        ///< Center x coordinates
+  std::vector<double> _centerY;        ///< Center y coordinates
+  std::vector<double> _centerZ;        ///< Center z coordinates
+  std::vector<double> _radiusSquared;  ///< Squared radii
+  std::vector<std::size_t> _tags;      ///< Tag of every sphere
+  std::size_t _count;                  ///< Number of spheres, padding aside
+  SimdKernel _kernel;                  ///< Kernel used by the queries
+
+  /**
+   * @brief Build the kernel query of a ray
+   * @param ray The ray
+   * @param tMax Upper bound of the ray parameter
+   * @return The shared ray data
+   */
+  static Query makeQuery(const Ray& ray, double tMax);
+
+  /**
+   * @brief Compute the hit parameter of LANES consecutive spheres
+   * @param query The ray data
+   * @param first First sphere of the step
+   * @param t Receives the hit of sphere first + i at index i, infinity when
+   * the ray misses it
+   */
+  void hitParameters(const Query& query, std::size_t first, double* t) const;
+
+  /**
+   * @brief Scalar kernel of hitParameters()
+   * @see hitParameters()
+   */
+  void hitParametersScalar(const Query& query, std::size_t first,
+                           double* t) const;
+
+  /**
+   * @brief SSE2 kernel of hitParameters()
+   * @see hitParameters()
+   */
+  void hitParametersSse2(const Query& query, std::size_t first,
+                         double* t) const;
+
+  /**
+   * @brief AVX kernel of hitParameters()
+   * @see hitParameters()
+   */
+  void hitParametersAvx(const Query& query, std::size_t first,
+                        double* t) const;
+
+  /**
+   * @brief Grow the padding back after the spheres changed
+   */
+  void pad();
+};
+
+}  // namespace RayTracer
+
+#endif /* !SPHEREBLOCK_HPP_ */
@@ -0,0 +1,383 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Packed triangle block implementation
+*/
+
+/**
+ * @file TriangleBlock.cpp
+ * @brief Implementation of the packed triangle block and of its scalar, SSE2
+ * and AVX Möller-Trumbore kernels
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include "TriangleBlock.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include "../../core/Transform.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(RAYTRACER_AVX_KERNELS)
+#include <immintrin.h>
+#endif
+
+namespace RayTracer {
+
+namespace {
+
+constexpr double INFINITE_T = std::numeric_limits<double>::infinity();
+
+/// Coordinate of the padding triangles: every comparison with it fails
+constexpr double PADDING = std::numeric_limits<double>::quiet_NaN();
+
+}  // namespace
+
+TriangleBlock::TriangleBlock() : _tags(), _count(0), _kernel(bestSimdKernel()) {
+  pad();
+}
+
+bool TriangleBlock::bake(const Triangle& triangle, Vector3D& a, Vector3D& b,
+                         Vector3D& c) {
+  Transform transform = triangle.getTransform();
+  if (!transform.isAffine()) {
+    return false;
+  }
+  // An affine map keeps the barycentric coordinates of every point
+  a = transform.applyToPoint(triangle.getA());
+  b = transform.applyToPoint(triangle.getB());
+  c = transform.applyToPoint(triangle.getC());
+  return true;
+}
+
+void TriangleBlock::add(const Vector3D& a, const Vector3D& b,
+                        const Vector3D& c, std::size_t tag) {
+  // Same expressions as Triangle, so that the results match to the bit
+  Vector3D edge1 = b - a;
+  Vector3D edge2 = c - a;
+  const double vertex[3] = {a.getX(), a.getY(), a.getZ()};
+  const double first[3] = {edge1.getX(), edge1.getY(), edge1.getZ()};
+  const double second[3] = {edge2.getX(), edge2.getY(), edge2.getZ()};
+  for (int axis = 0; axis < 3; ++axis) {
+    _vertex[axis].resize(_count);
+    _edge1[axis].resize(_count);
+    _edge2[axis].resize(_count);
+    _vertex[axis].push_back(vertex[axis]);
+    _edge1[axis].push_back(first[axis]);
+    _edge2[axis].push_back(second[axis]);
+  }
+  _tags.resize(_count);
+  _tags.push_back(tag);
+  ++_count;
+  pad();
+}
+
+void TriangleBlock::clear() {
+  _count = 0;
+  for (int axis = 0; axis < 3; ++axis) {
+    _vertex[axis].clear();
+    _edge1[axis].clear();
+    _edge2[axis].clear();
+  }
+  _tags.clear();
+  pad();
+}
+
+std::size_t TriangleBlock::size() const {
+  return _count;
+}
+
+std::size_t TriangleBlock::getTag(std::size_t index) const {
+  return _tags[index];
+}
+
+void TriangleBlock::pad() {
+  for (int axis = 0; axis < 3; ++axis) {
+    _vertex[axis].resize(_count + LANES - 1, PADDING);
+    _edge1[axis].resize(_count + LANES - 1, PADDING);
+    _edge2[axis].resize(_count + LANES - 1, PADDING);
+  }
+  _tags.resize(_count + LANES - 1, 0);
+}
+
+TriangleBlock::Query TriangleBlock::makeQuery(const Ray& ray, double tMax) {
+  Vector3D origin = ray.getOrigin();
+  Vector3D direction = ray.getDirection();
+  Query query;
+  query.origin[0] = origin.getX();
+  query.origin[1] = origin.getY();
+  query.origin[2] = origin.getZ();
+  query.direction[0] = direction.getX();
+  query.direction[1] = direction.getY();
+  query.direction[2] = direction.getZ();
+  query.tMin = ray.getTMin();
+  query.tMax = tMax;
+  return query;
+}
+
+std::optional<HitRecord> TriangleBlock::intersect(const Ray& ray,
+                                                  std::size_t begin,
+                                                  std::size_t end) const {
+  Query query = makeQuery(ray, ray.getTMax());
+  Lanes hits;
+  std::size_t best = end;
+  double bestT = INFINITE_T;
+  double bestU = 0.0;
+  double bestV = 0.0;
+  for (std::size_t first = begin; first < end; first += LANES) {
+    hitParameters(query, first, hits);
+    std::size_t lanes = std::min(LANES, end - first);
+    for (std::size_t i = 0; i < lanes; ++i) {
+      if (hits.t[i] < bestT || (hits.t[i] == bestT && best != end &&
+                                _tags[first + i] < _tags[best])) {
+        best = first + i;
+        bestT = hits.t[i];
+        bestU = hits.u[i];
+        bestV = hits.v[i];
+      }
+    }
+    // Farther triangles are culled by the kernel, equal ones still compete
+    query.tMax = std::min(query.tMax, bestT);
+  }
+  if (best == end) {
+    return std::nullopt;
+  }
+  ray.shrinkTMax(bestT);
+
+  HitRecord hit;
+  hit.t = bestT;
+  hit.primitiveIndex = _tags[best];
+  hit.u = bestU;
+  hit.v = bestV;
+  return hit;
+}
+
+bool TriangleBlock::occluded(const Ray& ray, std::size_t begin,
+                             std::size_t end, double tMax) const {
+  Query query = makeQuery(ray, tMax);
+  Lanes hits;
+  for (std::size_t first = begin; first < end; first += LANES) {
+    hitParameters(query, first, hits);
+    std::size_t lanes = std::min(LANES, end - first);
+    for (std::size_t i = 0; i < lanes; ++i) {
+      if (hits.t[i] != INFINITE_T) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void TriangleBlock::hitParameters(const Query& query, std::size_t first,
+                                  Lanes& hits) const {
+  switch (_kernel) {
+    case SimdKernel::AVX:
+      hitParametersAvx(query, first, hits);
+      break;
+    case SimdKernel::SSE2:
+      hitParametersSse2(query, first, hits);
+      break;
+    default:
+      hitParametersScalar(query, first, hits);
+      break;
+  }
+}
+
+void TriangleBlock::hitParametersScalar(const Query& query, std::size_t first,
+                                        Lanes& hits) const {
+  const double* dir = query.direction;
+  for (std::size_t i = 0; i < LANES; ++i) {
+    std::size_t k = first + i;
+    hits.t[i] = INFINITE_T;
+    double e1[3] = {_edge1[0][k], _edge1[1][k], _edge1[2][k]};
+    double e2[3] = {_edge2[0][k], _edge2[1][k], _edge2[2][k]};
+    double h[3] = {dir[1] * e2[2] - dir[2] * e2[1],
+                   dir[2] * e2[0] - dir[0] * e2[2],
+                   dir[0] * e2[1] - dir[1] * e2[0]};
+    double det = e1[0] * h[0] + e1[1] * h[1] + e1[2] * h[2];
+    // Written as in Triangle: NaN from a padding triangle fails at t
+    if (std::abs(det) < PARALLEL_EPSILON) {
+      continue;
+    }
+    double f = 1.0 / det;
+    double s[3] = {query.origin[0] - _vertex[0][k],
+                   query.origin[1] - _vertex[1][k],
+                   query.origin[2] - _vertex[2][k]};
+    double u = f * (s[0] * h[0] + s[1] * h[1] + s[2] * h[2]);
+    if (u < 0.0 || u > 1.0) {
+      continue;
+    }
+    double q[3] = {s[1] * e1[2] - s[2] * e1[1], s[2] * e1[0] - s[0] * e1[2],
+                   s[0] * e1[1] - s[1] * e1[0]};
+    double v = f * (dir[0] * q[0] + dir[1] * q[1] + dir[2] * q[2]);
+    if (v < 0.0 || u + v > 1.0) {
+      continue;
+    }
+    double t = f * (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]);
+    if (t >= MIN_HIT_DISTANCE && t >= query.tMin && t <= query.tMax) {
+      hits.t[i] = t;
+      hits.u[i] = u;
+      hits.v[i] = v;
+    }
+  }
+}
+
+void TriangleBlock::hitParametersSse2(const Query& query, std::size_t first,
+                                      Lanes& hits) const {
+#if defined(__SSE2__)
+  const __m128d dirX = _mm_set1_pd(query.direction[0]);
+  const __m128d dirY = _mm_set1_pd(query.direction[1]);
+  const __m128d dirZ = _mm_set1_pd(query.direction[2]);
+  const __m128d signBit = _mm_set1_pd(-0.0);
+  const __m128d zero = _mm_setzero_pd();
+  const __m128d one = _mm_set1_pd(1.0);
+  for (std::size_t i = 0; i < LANES; i += 2) {
+    std::size_t k = first + i;
+    __m128d e1X = _mm_loadu_pd(_edge1[0].data() + k);
+    __m128d e1Y = _mm_loadu_pd(_edge1[1].data() + k);
+    __m128d e1Z = _mm_loadu_pd(_edge1[2].data() + k);
+    __m128d e2X = _mm_loadu_pd(_edge2[0].data() + k);
+    __m128d e2Y = _mm_loadu_pd(_edge2[1].data() + k);
+    __m128d e2Z = _mm_loadu_pd(_edge2[2].data() + k);
+    __m128d hX = _mm_sub_pd(_mm_mul_pd(dirY, e2Z), _mm_mul_pd(dirZ, e2Y));
+    __m128d hY = _mm_sub_pd(_mm_mul_pd(dirZ, e2X), _mm_mul_pd(dirX, e2Z));
+    __m128d hZ = _mm_sub_pd(_mm_mul_pd(dirX, e2Y), _mm_mul_pd(dirY, e2X));
+    __m128d det = _mm_add_pd(
+        _mm_add_pd(_mm_mul_pd(e1X, hX), _mm_mul_pd(e1Y, hY)),
+        _mm_mul_pd(e1Z, hZ));
+    __m128d f = _mm_div_pd(one, det);
+    __m128d sX = _mm_sub_pd(_mm_set1_pd(query.origin[0]),
+                            _mm_loadu_pd(_vertex[0].data() + k));
+    __m128d sY = _mm_sub_pd(_mm_set1_pd(query.origin[1]),
+                            _mm_loadu_pd(_vertex[1].data() + k));
+    __m128d sZ = _mm_sub_pd(_mm_set1_pd(query.origin[2]),
+                            _mm_loadu_pd(_vertex[2].data() + k));
+    __m128d u = _mm_mul_pd(
+        f, _mm_add_pd(_mm_add_pd(_mm_mul_pd(sX, hX), _mm_mul_pd(sY, hY)),
+                      _mm_mul_pd(sZ, hZ)));
+    __m128d qX = _mm_sub_pd(_mm_mul_pd(sY, e1Z), _mm_mul_pd(sZ, e1Y));
+    __m128d qY = _mm_sub_pd(_mm_mul_pd(sZ, e1X), _mm_mul_pd(sX, e1Z));
+    __m128d qZ = _mm_sub_pd(_mm_mul_pd(sX, e1Y), _mm_mul_pd(sY, e1X));
+    __m128d v = _mm_mul_pd(
+        f, _mm_add_pd(_mm_add_pd(_mm_mul_pd(dirX, qX), _mm_mul_pd(dirY, qY)),
+                      _mm_mul_pd(dirZ, qZ)));
+    __m128d t = _mm_mul_pd(
+        f, _mm_add_pd(_mm_add_pd(_mm_mul_pd(e2X, qX), _mm_mul_pd(e2Y, qY)),
+                      _mm_mul_pd(e2Z, qZ)));
+    // Every test passes on the hits only, NaN lanes included
+    __m128d valid = _mm_cmpge_pd(_mm_andnot_pd(signBit, det),
+                                 _mm_set1_pd(PARALLEL_EPSILON));
+    valid = _mm_and_pd(valid, _mm_cmpge_pd(u, zero));
+    valid = _mm_and_pd(valid, _mm_cmple_pd(u, one));
+    valid = _mm_and_pd(valid, _mm_cmpge_pd(v, zero));
+    valid = _mm_and_pd(valid, _mm_cmple_pd(_mm_add_pd(u, v), one));
+    valid = _mm_and_pd(valid,
+                       _mm_cmpge_pd(t, _mm_set1_pd(MIN_HIT_DISTANCE)));
+    valid = _mm_and_pd(valid, _mm_cmpge_pd(t, _mm_set1_pd(query.tMin)));
+    valid = _mm_and_pd(valid, _mm_cmple_pd(t, _mm_set1_pd(query.tMax)));
+    _mm_storeu_pd(hits.t + i,
+                  _mm_or_pd(_mm_and_pd(valid, t),
+                            _mm_andnot_pd(valid, _mm_set1_pd(INFINITE_T))));
+    _mm_storeu_pd(hits.u + i, u);
+    _mm_storeu_pd(hits.v + i, v);
+  }
+#else
+  hitParametersScalar(query, first, hits);
+#endif
+}
+
+RAYTRACER_TARGET_AVX
+void TriangleBlock::hitParametersAvx(const Query& query, std::size_t first,
+                                     Lanes& hits) const {
+#if defined(RAYTRACER_AVX_KERNELS)
+  // Same operations as the SSE2 kernel, on four triangles at once
+  const __m256d dirX = _mm256_set1_pd(query.direction[0]);
+  const __m256d dirY = _mm256_set1_pd(query.direction[1]);
+  const __m256d dirZ = _mm256_set1_pd(query.direction[2]);
+  const __m256d one = _mm256_set1_pd(1.0);
+  __m256d e1X = _mm256_loadu_pd(_edge1[0].data() + first);
+  __m256d e1Y = _mm256_loadu_pd(_edge1[1].data() + first);
+  __m256d e1Z = _mm256_loadu_pd(_edge1[2].data() + first);
+  __m256d e2X = _mm256_loadu_pd(_edge2[0].data() + first);
+  __m256d e2Y = _mm256_loadu_pd(_edge2[1].data() + first);
+  __m256d e2Z = _mm256_loadu_pd(_edge2[2].data() + first);
+  __m256d hX =
+      _mm256_sub_pd(_mm256_mul_pd(dirY, e2Z), _mm256_mul_pd(dirZ, e2Y));
+  __m256d hY =
+      _mm256_sub_pd(_mm256_mul_pd(dirZ, e2X), _mm256_mul_pd(dirX, e2Z));
+  __m256d hZ =
+      _mm256_sub_pd(_mm256_mul_pd(dirX, e2Y), _mm256_mul_pd(dirY, e2X));
+  __m256d det = _mm256_add_pd(
+      _mm256_add_pd(_mm256_mul_pd(e1X, hX), _mm256_mul_pd(e1Y, hY)),
+      _mm256_mul_pd(e1Z, hZ));
+  __m256d f = _mm256_div_pd(one, det);
+  __m256d sX = _mm256_sub_pd(_mm256_set1_pd(query.origin[0]),
+                             _mm256_loadu_pd(_vertex[0].data() + first));
+  __m256d sY = _mm256_sub_pd(_mm256_set1_pd(query.origin[1]),
+                             _mm256_loadu_pd(_vertex[1].data() + first));
+  __m256d sZ = _mm256_sub_pd(_mm256_set1_pd(query.origin[2]),
+                             _mm256_loadu_pd(_vertex[2].data() + first));
+  __m256d u = _mm256_mul_pd(
+      f, _mm256_add_pd(
+             _mm256_add_pd(_mm256_mul_pd(sX, hX), _mm256_mul_pd(sY, hY)),
+             _mm256_mul_pd(sZ, hZ)));
+  __m256d qX =
+      _mm256_sub_pd(_mm256_mul_pd(sY, e1Z), _mm256_mul_pd(sZ, e1Y));
+  __m256d qY =
+      _mm256_sub_pd(_mm256_mul_pd(sZ, e1X), _mm256_mul_pd(sX, e1Z));
+  __m256d qZ =
+      _mm256_sub_pd(_mm256_mul_pd(sX, e1Y), _mm256_mul_pd(sY, e1X));
+  __m256d v = _mm256_mul_pd(
+      f, _mm256_add_pd(
+             _mm256_add_pd(_mm256_mul_pd(dirX, qX), _mm256_mul_pd(dirY, qY)),
+             _mm256_mul_pd(dirZ, qZ)));
+  __m256d t = _mm256_mul_pd(
+      f, _mm256_add_pd(
+             _mm256_add_pd(_mm256_mul_pd(e2X, qX), _mm256_mul_pd(e2Y, qY)),
+             _mm256_mul_pd(e2Z, qZ)));
+  __m256d valid =
+      _mm256_cmp_pd(_mm256_andnot_pd(_mm256_set1_pd(-0.0), det),
+                    _mm256_set1_pd(PARALLEL_EPSILON), _CMP_GE_OQ);
+  valid = _mm256_and_pd(
+      valid, _mm256_cmp_pd(u, _mm256_setzero_pd(), _CMP_GE_OQ));
+  valid = _mm256_and_pd(valid, _mm256_cmp_pd(u, one, _CMP_LE_OQ));
+  valid = _mm256_and_pd(
+      valid, _mm256_cmp_pd(v, _mm256_setzero_pd(), _CMP_GE_OQ));
+  valid = _mm256_and_pd(
+      valid, _mm256_cmp_pd(_mm256_add_pd(u, v), one, _CMP_LE_OQ));
+  valid = _mm256_and_pd(
+      valid,
+      _mm256_cmp_pd(t, _mm256_set1_pd(MIN_HIT_DISTANCE), _CMP_GE_OQ));
+  valid = _mm256_and_pd(
+      valid, _mm256_cmp_pd(t, _mm256_set1_pd(query.tMin), _CMP_GE_OQ));
+  valid = _mm256_and_pd(
+      valid, _mm256_cmp_pd(t, _mm256_set1_pd(query.tMax), _CMP_LE_OQ));
+  _mm256_storeu_pd(hits.t,
+                   _mm256_blendv_pd(_mm256_set1_pd(INFINITE_T), t, valid));
+  _mm256_storeu_pd(hits.u, u);
+  _mm256_storeu_pd(hits.v, v);
+#else
+  hitParametersSse2(query, first, hits);
+#endif
+}
+
+void TriangleBlock::setKernel(SimdKernel kernel) {
+  if (!supportsSimdKernel(kernel)) {
+    throw std::invalid_argument("Triangle kernel not supported: " +
+                                simdKernelName(kernel));
+  }
+  _kernel = kernel;
+}
+
+SimdKernel TriangleBlock::getKernel() const {
+  return _kernel;
+}
+
+}  // namespace RayTracer
@@ -0,0 +1,213 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Packed triangle block header
+*/
+
+/**
+ * @file TriangleBlock.hpp
+ * @brief Definition of the TriangleBlock class, triangles with precomputed
+ * edges stored as a structure of arrays and intersected several at a time
+ * with SIMD
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#ifndef TRIANGLEBLOCK_HPP_
+#define TRIANGLEBLOCK_HPP_
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+#include "../../../include/IPrimitive.hpp"
+#include "../../core/Ray.hpp"
+#include "../../core/Vector3D.hpp"
+#include "../primitives/Triangle.hpp"
+#include "SimdKernel.hpp"
+
+namespace RayTracer {
+
+/**
+ * @brief Triangles with precomputed edges, intersected four at a time
+ *
+ * Every triangle is stored as its first vertex and its two edges, one array
+ * per coordinate, so that the Möller-Trumbore test of a ray against several
+ * triangles runs in the same instructions without recomputing the edges.
+ * The kernel is chosen at run time like SphereBlock's, and every kernel runs
+ * the same operations as Triangle and Mesh: triangles stored in the space
+ * the ray is given in report bit for bit the same hit.
+ *
+ * Every triangle carries a tag chosen by the owner, reported back as the
+ * primitive index of its hits and used to break ties between equal hits.
+ */
+class TriangleBlock {
+ public:
+  /**
+   * @brief Default constructor
+   * Creates an empty block using the best kernel of the processor
+   */
+  TriangleBlock();
+
+  /**
+   * @brief Get the world-space vertices of a triangle
+   * @param triangle The triangle to bake
+   * @param a Receives the first world-space vertex
+   * @param b Receives the second world-space vertex
+   * @param c Receives the third world-space vertex
+   * @return false if the transform is projective and bends the triangle
+   */
+  static bool bake(const Triangle& triangle, Vector3D& a, Vector3D& b,
+                   Vector3D& c);
+
+  /**
+   * @brief Append a triangle
+   * @param a The first vertex
+   * @param b The second vertex
+   * @param c The third vertex
+   * @param tag Reported as the primitive index of the triangle hits
+   */
+  void add(const Vector3D& a, const Vector3D& b, const Vector3D& c,
+           std::size_t tag);
+
+  /**
+   * @brief Remove every triangle
+   */
+  void clear();
+
+  /**
+   * @brief Get the number of triangles
+   * @return The triangle count
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Get the tag of a triangle
+   * @param index Position of the triangle in the block
+   * @return The tag given to add()
+   */
+  std::size_t getTag(std::size_t index) const;
+
+  /**
+   * @brief Find the closest hit of a ray among a range of triangles
+   *
+   * Same contract as IPrimitive::intersectHit(): only hits inside the ray
+   * interval are reported, and the ray tMax is shrunk to the hit. The hit
+   * holds the barycentric coordinates along the two edges in u and v.
+   * Among hits at the same distance, the one with the lowest tag wins.
+   *
+   * @param ray The ray to test
+   * @param begin First triangle of the range
+   * @param end One past the last triangle of the range
+   * @return The closest hit with the tag as primitive index, if any
+   */
+  std::optional<HitRecord> intersect(const Ray& ray, std::size_t begin,
+                                     std::size_t end) const;
+
+  /**
+   * @brief Check if a ray hits a range of triangles closer than a distance
+   * @param ray The ray to test, its tMin is the lower bound of the query
+   * @param begin First triangle of the range
+   * @param end One past the last triangle of the range
+   * @param tMax Hits beyond this distance are ignored
+   * @return true if some triangle of the range is hit in [tMin, tMax]
+   */
+  bool occluded(const Ray& ray, std::size_t begin, std::size_t end,
+                double tMax) const;
+
+  /**
+   * @brief Choose the kernel used by this block
+   * @param kernel The kernel, must be supported by the processor
+   * @throw std::invalid_argument if the processor lacks the instructions
+   */
+  void setKernel(SimdKernel kernel);
+
+  /**
+   * @brief Get the kernel used by this block
+   * @return The kernel, bestSimdKernel() unless set otherwise
+   */
+  SimdKernel getKernel() const;
+
+  static constexpr std::size_t LANES = 4;  ///< Triangles per kernel step
+  static constexpr double PARALLEL_EPSILON =
+      1e-8;  ///< Determinant below which a ray is parallel to a triangle
+  static constexpr double MIN_HIT_DISTANCE =
+      1e-4;  ///< Hits closer than this to the ray origin are ignored
+
+ private:
+  /**
+   * @brief Ray data shared by every lane of a kernel step
+   */
+  struct Query {
+    double origin[3];     ///< Ray origin
+    double direction[3];  ///< Ray direction
+    double tMin;          ///< Lower bound of the ray parameter
+    double tMax;          ///< Upper bound of the ray parameter
+  };
+
+  /**
+   * @brief Hits of a kernel step
+   */
+  struct Lanes {
+    double t[LANES];  ///< Hit parameter, infinity when missed
+    double u[LANES];  ///< Barycentric coordinate along the first edge
+    double v[LANES];  ///< Barycentric coordinate along the second edge
+  };
+
+  // Padded with LANES - 1 triangles that are never hit, so that a kernel
+  // step starting at the last triangle only reads initialized values
+  std::vector<double> _vertex[3];  ///< First vertex, one array per axis
+  std::vector<double> _edge1[3];   ///< Second minus first vertex
+  std::vector<double> _edge2[3];   ///< Third minus first vertex
+  std::vector<std::size_t> _tags;  ///< Tag of every triangle
+  std::size_t _count;              ///< Number of triangles, padding aside
+  SimdKernel _kernel;              ///< Kernel used by the queries
+
+  /**
+   * @brief Build the kernel query of a ray
+   * @param ray The ray
+   * @param tMax Upper bound of the ray parameter
+   * @return The shared ray data
+   */
+  static Query makeQuery(const Ray& ray, double tMax);
+
+  /**
+   * @brief Intersect LANES consecutive triangles
+   * @param query The ray data
+   * @param first First triangle of the step
+   * @param hits Receives the hit of triangle first + i in lane i
+   */
+  void hitParameters(const Query& query, std::size_t first,
+                     Lanes& hits) const;
+
+  /**
+   * @brief Scalar kernel of hitParameters()
+   * @see hitParameters()
+   */
+  void hitParametersScalar(const Query& query, std::size_t first,
+                           Lanes& hits) const;
+
+  /**
+   * @brief SSE2 kernel of hitParameters()
+   * @see hitParameters()
+   */
+  void hitParametersSse2(const Query& query, std::size_t first,
+                         Lanes& hits) const;
+
+  /**
+   * @brief AVX kernel of hitParameters()
+   * @see hitParameters()
+   */
+  void hitParametersAvx(const Query& query, std::size_t first,
+                        Lanes& hits) const;
+
+  /**
+   * @brief Grow the padding back after the triangles changed
+   */
+  void pad();
+};
+
+}  // namespace RayTracer
+
+#endif /* !TRIANGLEBLOCK_HPP_ */
@@ -28,38 +28,14 @@ CheckerboardPlane::CheckerboardPlane(char axis, double position,
       _alternateColor(alternateColor),
       _squareSize(squareSize) {}
 
-std::optional<Intersection> CheckerboardPlane::intersect(const Ray& ray) const {
-  auto intersection = Plane::intersect(ray);
-
-  if (!intersection) {
-    return std::nullopt;
-  }
-
-  Ray localRay = ray.transform(getTransform().inverse());
-  Vector3D localIntersectionPoint =
-      localRay.pointAt((intersection->point - ray.getOrigin()).getMagnitude() /
-                       ray.getDirection().getMagnitude());
-
-  intersection->color = getColorAtPoint(localIntersectionPoint);
-
+Intersection CheckerboardPlane::computeSurface(const Ray& ray,
+                                               const HitRecord& hit) const {
+  Intersection intersection = Plane::computeSurface(ray, hit);
+  intersection.color = getColorAt(hit.u, hit.v);
   return intersection;
 }
 
-Color CheckerboardPlane::getColorAtPoint(const Vector3D& point) const {
-  double u, v;
-  Axis axis = getAxis();
-
-  if (axis == Axis::X) {
-    u = point.getY();
-    v = point.getZ();
-  } else if (axis == Axis::Y) {
-    u = point.getX();
-    v = point.getZ();
-  } else {
-    u = point.getX();
-    v = point.getY();
-  }
-
+Color CheckerboardPlane::getColorAt(double u, double v) const {
   int uCheckIndex = static_cast<int>(std::floor(u / _squareSize));
   int vCheckIndex = static_cast<int>(std::floor(v / _squareSize));
   if ((uCheckIndex + vCheckIndex) % 2 == 0) {
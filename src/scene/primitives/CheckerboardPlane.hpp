@@ -49,11 +49,13 @@ class CheckerboardPlane : public Plane {
   ~CheckerboardPlane() override = default;
 
   /**
-   * @brief Check if a ray intersects this plane
-   * @param ray The ray to check
-   * @return Intersection data if hit, std::nullopt otherwise
+   * @brief Build the surface data of a hit, colored by the checker pattern
+   * @param ray The ray that produced the hit
+   * @param hit The hit record returned by intersectHit()
+   * @return The world-space point, normal and checker color of the hit
    */
-  std::optional<Intersection> intersect(const Ray& ray) const override;
+  Intersection computeSurface(const Ray& ray,
+                              const HitRecord& hit) const override;
 
   /**
    * @brief Clone this plane
@@ -88,10 +90,11 @@ class CheckerboardPlane : public Plane {
  private:
   /**
    * @brief Determine the color at a point on the checkerboard
-   * @param point The point in local space
+   * @param u First local in-plane coordinate, as stored in a HitRecord
+   * @param v Second local in-plane coordinate, as stored in a HitRecord
    * @return The color at the point
    */
-  Color getColorAtPoint(const Vector3D& point) const;
+  Color getColorAt(double u, double v) const;
 
   Color _alternateColor;  ///< The alternate color of the checkerboard
   double _squareSize;     ///< The size of each square in the checkerboard
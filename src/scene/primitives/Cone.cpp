@@ -87,7 +87,7 @@ std::optional<double> Cone::findClosestValidIntersectionT(
   double valid_t_values[2];
   int num_valid_t = 0;
 
-  if (t0 > CONE_EPSILON) {
+  if (t0 > CONE_EPSILON && localRay.isInInterval(t0)) {
     Vector3D p0 = localRay.pointAt(t0);
     double nappe_check_val_0 = (p0 - _apex).dot(_axis);
     if (nappe_check_val_0 >= -CONE_EPSILON) {
@@ -95,7 +95,7 @@ std::optional<double> Cone::findClosestValidIntersectionT(
     }
   }
 
-  if (t1 > CONE_EPSILON) {
+  if (t1 > CONE_EPSILON && localRay.isInInterval(t1)) {
     Vector3D p1 = localRay.pointAt(t1);
     double nappe_check_val_1 = (p1 - _apex).dot(_axis);
     if (nappe_check_val_1 >= -CONE_EPSILON) {
@@ -113,17 +113,23 @@ std::optional<double> Cone::findClosestValidIntersectionT(
   }
 }
 
-std::optional<Intersection> Cone::intersect(const Ray& ray) const {
-  Ray localRay = ray.transform(_inverseTransform);
-
-  std::optional<double> t_opt = findClosestValidIntersectionT(localRay);
+std::optional<HitRecord> Cone::intersectHit(const Ray& ray) const {
+  std::optional<double> t_opt =
+      findClosestValidIntersectionT(ray.transform(_inverseTransform));
 
   if (!t_opt) {
     return std::nullopt;
   }
 
-  double t_hit = *t_opt;
-  Vector3D localIntersectionPoint = localRay.pointAt(t_hit);
+  ray.shrinkTMax(*t_opt);
+  HitRecord hit;
+  hit.t = *t_opt;
+  return hit;
+}
+
+Intersection Cone::computeSurface(const Ray& ray, const HitRecord& hit) const {
+  Ray localRay = ray.transform(_inverseTransform);
+  Vector3D localIntersectionPoint = localRay.pointAt(hit.t);
 
   Vector3D worldIntersectionPoint =
       _transform.applyToPoint(localIntersectionPoint);
@@ -133,14 +139,19 @@ std::optional<Intersection> Cone::intersect(const Ray& ray) const {
   Intersection intersection_data;
   intersection_data.point = worldIntersectionPoint;
   intersection_data.normal = worldNormal;
-  intersection_data.distance =
-      (worldIntersectionPoint - ray.getOrigin()).getMagnitude();
+  intersection_data.distance = hit.t;
   intersection_data.color = _color;
   intersection_data.primitive = this;
 
   return intersection_data;
 }
 
+bool Cone::occluded(const Ray& ray, double tMax) const {
+  Ray localRay = ray.transform(_inverseTransform);
+  localRay.setInterval(ray.getTMin(), tMax);
+  return findClosestValidIntersectionT(localRay).has_value();
+}
+
 void Cone::setTransform(const Transform& transform) {
   _transform = transform;
   updateInverseTransform();
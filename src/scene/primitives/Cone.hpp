@@ -49,11 +49,28 @@ class Cone : public ICone {
   ~Cone() override = default;
 
   /**
-   * @brief Check if a ray intersects this cone.
+   * @brief Find where a ray hits this cone, without surface data.
    * @param ray The ray to check.
-   * @return Intersection data if hit, std::nullopt otherwise.
+   * @return The hit parameter, std::nullopt if the ray misses.
    */
-  std::optional<Intersection> intersect(const Ray& ray) const override;
+  std::optional<HitRecord> intersectHit(const Ray& ray) const override;
+
+  /**
+   * @brief Build the surface data of a hit found by intersectHit().
+   * @param ray The ray that produced the hit.
+   * @param hit The hit record.
+   * @return The world-space point, normal and color of the hit.
+   */
+  Intersection computeSurface(const Ray& ray,
+                              const HitRecord& hit) const override;
+
+  /**
+   * @brief Check if a ray hits this cone closer than a given distance.
+   * @param ray The ray to check.
+   * @param tMax Hits beyond this distance are ignored.
+   * @return true if the ray hits the cone in [tMin, tMax].
+   */
+  bool occluded(const Ray& ray, double tMax) const override;
 
   /**
    * @brief Set the transformation matrix for this cone.
@@ -79,8 +79,50 @@ double Cylinder::getHeight() const {
   return std::numeric_limits<double>::infinity();
 }
 
-std::optional<Intersection> Cylinder::intersect(const Ray& ray) const {
+std::optional<HitRecord> Cylinder::intersectHit(const Ray& ray) const {
+  std::optional<double> t =
+      findClosestValidIntersectionT(ray.transform(_inverseTransform));
+  if (!t) {
+    return std::nullopt;
+  }
+  ray.shrinkTMax(*t);
+
+  HitRecord hit;
+  hit.t = *t;
+  return hit;
+}
+
+Intersection Cylinder::computeSurface(const Ray& ray,
+                                      const HitRecord& hit) const {
   Ray localRay = ray.transform(_inverseTransform);
+  Vector3D localIntersectionPoint = localRay.pointAt(hit.t);
+  Vector3D localNormal(localIntersectionPoint.getX(), 0,
+                       localIntersectionPoint.getZ());
+  Vector3D worldIntersectionPoint =
+      _transform.applyToPoint(localIntersectionPoint);
+  Vector3D worldNormal = _transform.applyToNormal(localNormal).normalized();
+
+  if (worldNormal.dot(ray.getDirection()) > 0) {
+    worldNormal = -worldNormal;
+  }
+
+  Intersection intersection;
+  intersection.distance = hit.t;
+  intersection.point = worldIntersectionPoint;
+  intersection.normal = worldNormal;
+  intersection.color = _color;
+  intersection.primitive = this;
+  return intersection;
+}
+
+bool Cylinder::occluded(const Ray& ray, double tMax) const {
+  Ray localRay = ray.transform(_inverseTransform);
+  localRay.setInterval(ray.getTMin(), tMax);
+  return findClosestValidIntersectionT(localRay).has_value();
+}
+
+std::optional<double> Cylinder::findClosestValidIntersectionT(
+    const Ray& localRay) const {
   Vector3D O = localRay.getOrigin();
   Vector3D D = localRay.getDirection();
 
@@ -101,36 +143,14 @@ std::optional<Intersection> Cylinder::intersect(const Ray& ray) const {
   double t0 = (-b - sqrt_discriminant) / (2 * a);
   double t1 = (-b + sqrt_discriminant) / (2 * a);
 
-  double t = std::numeric_limits<double>::infinity();
-  if (t0 > CYLINDER_EPSILON && t1 > CYLINDER_EPSILON) {
-    t = std::min(t0, t1);
-  } else if (t0 > CYLINDER_EPSILON) {
-    t = t0;
-  } else if (t1 > CYLINDER_EPSILON) {
-    t = t1;
-  } else {
-    return std::nullopt;
+  // a is positive, so t0 <= t1
+  if (t0 > CYLINDER_EPSILON && localRay.isInInterval(t0)) {
+    return t0;
   }
-
-  Vector3D localIntersectionPoint = localRay.pointAt(t);
-  Vector3D localNormal(localIntersectionPoint.getX(), 0,
-                       localIntersectionPoint.getZ());
-  Vector3D worldIntersectionPoint =
-      _transform.applyToPoint(localIntersectionPoint);
-  Vector3D worldNormal = _transform.applyToNormal(localNormal).normalized();
-
-  if (worldNormal.dot(ray.getDirection()) > 0) {
-    worldNormal = -worldNormal;
+  if (t1 > CYLINDER_EPSILON && localRay.isInInterval(t1)) {
+    return t1;
   }
-
-  Intersection intersection;
-  intersection.distance =
-      (worldIntersectionPoint - ray.getOrigin()).getMagnitude();
-  intersection.point = worldIntersectionPoint;
-  intersection.normal = worldNormal;
-  intersection.color = _color;
-  intersection.primitive = this;
-  return intersection;
+  return std::nullopt;
 }
 
 }  // namespace RayTracer
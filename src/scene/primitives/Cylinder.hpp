@@ -38,7 +38,10 @@ class Cylinder : public ICylinder {
   Cylinder(double radius, const Color& color);
   ~Cylinder() override = default;
 
-  std::optional<Intersection> intersect(const Ray& ray) const override;
+  std::optional<HitRecord> intersectHit(const Ray& ray) const override;
+  Intersection computeSurface(const Ray& ray,
+                              const HitRecord& hit) const override;
+  bool occluded(const Ray& ray, double tMax) const override;
   void setTransform(const Transform& transform) override;
   Transform getTransform() const override;
   void setColor(const Color& color) override;
@@ -57,6 +60,9 @@ class Cylinder : public ICylinder {
   Color _color;
   Transform _transform;
   Transform _inverseTransform;
+
+  std::optional<double> findClosestValidIntersectionT(
+      const Ray& localRay) const;
 };
 
 }  // namespace RayTracer
@@ -40,7 +40,9 @@ class ICone : public IPrimitive {
 
   // Methods inherited from IPrimitive that must be implemented by concrete
   // cones
-  std::optional<Intersection> intersect(const Ray& ray) const override = 0;
+  std::optional<HitRecord> intersectHit(const Ray& ray) const override = 0;
+  Intersection computeSurface(const Ray& ray,
+                              const HitRecord& hit) const override = 0;
   void setTransform(const Transform& transform) override = 0;
   Transform getTransform() const override = 0;
   void setColor(const Color& color) override = 0;
@@ -0,0 +1,114 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Instance primitive class implementation
+*/
+
+/**
+ * @file Instance.cpp
+ * @brief Implementation of the Instance class, forwarding rays to a shared
+ * primitive through a per-instance transform
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include "Instance.hpp"
+#include <stdexcept>
+
+namespace RayTracer {
+
+Instance::Instance(std::shared_ptr<const IPrimitive> geometry,
+                   const Transform& transform)
+    : _geometry(std::move(geometry)),
+      _transform(),
+      _inverseTransform(),
+      _color(),
+      _worldBounds() {
+  if (!_geometry) {
+    throw std::invalid_argument("Instance geometry cannot be null");
+  }
+  setTransform(transform);
+}
+
+void Instance::setTransform(const Transform& transform) {
+  _transform = transform;
+  try {
+    _inverseTransform = _transform.inverse();
+  } catch (const std::runtime_error&) {
+    _inverseTransform = Transform();
+  }
+  updateWorldBounds();
+}
+
+Transform Instance::getTransform() const {
+  return _transform;
+}
+
+void Instance::setColor(const Color& color) {
+  _color = color;
+}
+
+Color Instance::getColor() const {
+  return _color ? *_color : _geometry->getColor();
+}
+
+std::shared_ptr<IPrimitive> Instance::clone() const {
+  return std::make_shared<Instance>(*this);
+}
+
+AABB Instance::worldBounds() const {
+  return _worldBounds;
+}
+
+std::shared_ptr<const IPrimitive> Instance::getGeometry() const {
+  return _geometry;
+}
+
+void Instance::updateWorldBounds() {
+  _worldBounds = _geometry->worldBounds().transformed(_transform);
+}
+
+std::optional<HitRecord> Instance::intersectHit(const Ray& ray) const {
+  if (_worldBounds.isBounded() && !_worldBounds.intersects(ray)) {
+    return std::nullopt;
+  }
+  // The geometry sees the same t as the world ray, only tMax needs copying
+  std::optional<HitRecord> hit =
+      _geometry->intersectHit(ray.transform(_inverseTransform));
+  if (hit) {
+    ray.shrinkTMax(hit->t);
+  }
+  return hit;
+}
+
+Intersection Instance::computeSurface(const Ray& ray,
+                                      const HitRecord& hit) const {
+  Intersection intersection =
+      _geometry->computeSurface(ray.transform(_inverseTransform), hit);
+  intersection.point = _transform.applyToPoint(intersection.point);
+  // The inverse transpose keeps the normal facing against the ray
+  intersection.normal =
+      _transform.applyToNormal(intersection.normal).normalized();
+  if (_color) {
+    intersection.color = *_color;
+  }
+  intersection.primitive = this;
+  return intersection;
+}
+
+bool Instance::occluded(const Ray& ray, double tMax) const {
+  if (_worldBounds.isBounded() && !_worldBounds.intersects(ray, tMax)) {
+    return false;
+  }
+  return _geometry->occluded(ray.transform(_inverseTransform), tMax);
+}
+
+Vector3D Instance::getNormalAt(const Vector3D& point) const {
+  Vector3D localNormal =
+      _geometry->getNormalAt(_inverseTransform.applyToPoint(point));
+  return _transform.applyToNormal(localNormal).normalized();
+}
+
+}  // namespace RayTracer
@@ -0,0 +1,144 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Instance primitive class header
+*/
+
+/**
+ * @file Instance.hpp
+ * @brief Definition of the Instance class, a transformed reference to a
+ * shared primitive
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#ifndef INSTANCE_HPP_
+#define INSTANCE_HPP_
+
+#include <memory>
+#include <optional>
+#include "../../../include/IPrimitive.hpp"
+#include "../../core/AABB.hpp"
+#include "../../core/Color.hpp"
+#include "../../core/Ray.hpp"
+#include "../../core/Transform.hpp"
+#include "../../core/Vector3D.hpp"
+
+namespace RayTracer {
+
+/**
+ * @brief Places a shared primitive in the scene with its own transform
+ *
+ * Instances are the top level of the acceleration structure: the scene BVH
+ * is built over their world bounds, while the geometry they reference, most
+ * often a Mesh with its own hierarchy, is stored once however many instances
+ * use it. Rays are moved into the space of the geometry and handed to it
+ * unchanged otherwise, so the geometry hit records are passed through as is.
+ */
+class Instance : public IPrimitive {
+ public:
+  /**
+   * @brief Constructor
+   * @param geometry The shared primitive to place
+   * @param transform The transformation from geometry space to world space
+   * @throw std::invalid_argument if geometry is null
+   */
+  explicit Instance(std::shared_ptr<const IPrimitive> geometry,
+                    const Transform& transform = Transform());
+
+  /**
+   * @brief Destructor
+   */
+  ~Instance() override = default;
+
+  /**
+   * @brief Find where a ray hits the instanced geometry
+   * @param ray The ray to check
+   * @return The hit record of the geometry, std::nullopt if the ray misses
+   */
+  std::optional<HitRecord> intersectHit(const Ray& ray) const override;
+
+  /**
+   * @brief Build the world-space surface data of a hit
+   * @param ray The ray that produced the hit
+   * @param hit The hit record
+   * @return The geometry surface data moved to world space
+   */
+  Intersection computeSurface(const Ray& ray,
+                              const HitRecord& hit) const override;
+
+  /**
+   * @brief Check if a ray hits the instanced geometry before a distance
+   * @param ray The ray to check
+   * @param tMax Hits beyond this distance are ignored
+   * @return true if the ray hits the geometry in [tMin, tMax]
+   */
+  bool occluded(const Ray& ray, double tMax) const override;
+
+  /**
+   * @brief Set the transformation of this instance
+   * @param transform The transformation from geometry space to world space
+   */
+  void setTransform(const Transform& transform) override;
+
+  /**
+   * @brief Get the transformation of this instance
+   * @return The current transformation
+   */
+  Transform getTransform() const override;
+
+  /**
+   * @brief Override the color of the geometry for this instance only
+   * @param color The color to set
+   */
+  void setColor(const Color& color) override;
+
+  /**
+   * @brief Get the color of this instance
+   * @return The override color if set, the geometry color otherwise
+   */
+  Color getColor() const override;
+
+  /**
+   * @brief Get the normal at a specific point on the instance
+   * @param point The point in world space
+   * @return The normal vector at that point
+   */
+  Vector3D getNormalAt(const Vector3D& point) const override;
+
+  /**
+   * @brief Clone this instance
+   * @return A new instance sharing the same geometry
+   */
+  std::shared_ptr<IPrimitive> clone() const override;
+
+  /**
+   * @brief Get the world-space bounding box of this instance
+   * @return The geometry bounds moved by the instance transform
+   */
+  AABB worldBounds() const override;
+
+  /**
+   * @brief Get the instanced geometry
+   * @return The shared primitive
+   */
+  std::shared_ptr<const IPrimitive> getGeometry() const;
+
+ private:
+  std::shared_ptr<const IPrimitive> _geometry;  ///< The shared primitive
+  Transform _transform;  ///< Geometry space to world space
+  Transform _inverseTransform;  ///< Cached inverse of the transformation
+  std::optional<Color> _color;  ///< Color override, geometry color if unset
+  AABB _worldBounds;            ///< Cached world-space bounding box
+
+  /**
+   * @brief Recompute the cached world bounds after a transform change
+   */
+  void updateWorldBounds();
+};
+
+}  // namespace RayTracer
+
+#endif /* !INSTANCE_HPP_ */
@@ -23,6 +23,10 @@ namespace RayTracer {
 
 constexpr double LIMITED_CONE_EPSILON = 1e-6;
 
+/// HitRecord::part values of a limited cone
+constexpr int PART_SURFACE = 0;
+constexpr int PART_CAP = 1;
+
 LimitedCone::LimitedCone(const Vector3D& apex, const Vector3D& axis,
                          double angleDegrees, const Color& color, double height,
                          bool hasCaps)
@@ -43,6 +47,7 @@ LimitedCone::LimitedCone(const Vector3D& apex, const Vector3D& axis,
   double cos_angle = std::cos(_angle_rad);
   _cos_angle_sq = cos_angle * cos_angle;
   updateInverseTransform();
+  updateWorldBounds();
 }
 
 void LimitedCone::updateInverseTransform() {
@@ -61,10 +66,12 @@ std::optional<double> LimitedCone::intersectBaseCap(const Ray& localRay) const {
     return std::nullopt;
 
   Vector3D baseCenter = _apex + _axis * _height;
-  double t = (baseCenter - localRay.getOrigin()).dot(_axis) /
-             localRay.getDirection().dot(_axis);
+  double denominator = localRay.getDirection().dot(_axis);
+  if (std::abs(denominator) < LIMITED_CONE_EPSILON)
+    return std::nullopt;
+  double t = (baseCenter - localRay.getOrigin()).dot(_axis) / denominator;
 
-  if (t < LIMITED_CONE_EPSILON)
+  if (t < LIMITED_CONE_EPSILON || !localRay.isInInterval(t))
     return std::nullopt;
 
   Vector3D intersectionPoint = localRay.pointAt(t);
@@ -104,7 +111,7 @@ std::optional<double> LimitedCone::findClosestValidIntersectionT(
     double valid_ts[2];
     int count = 0;
 
-    if (t0 > LIMITED_CONE_EPSILON) {
+    if (t0 > LIMITED_CONE_EPSILON && localRay.isInInterval(t0)) {
       Vector3D p0 = localRay.pointAt(t0);
       double height_check_0 = (p0 - _apex).dot(_axis);
       if (height_check_0 >= -LIMITED_CONE_EPSILON &&
@@ -114,7 +121,7 @@ std::optional<double> LimitedCone::findClosestValidIntersectionT(
         }
       }
     }
-    if (t1 > LIMITED_CONE_EPSILON) {
+    if (t1 > LIMITED_CONE_EPSILON && localRay.isInInterval(t1)) {
       Vector3D p1 = localRay.pointAt(t1);
       double height_check_1 = (p1 - _apex).dot(_axis);
       if (height_check_1 >= -LIMITED_CONE_EPSILON &&
@@ -153,25 +160,35 @@ std::optional<double> LimitedCone::findClosestValidIntersectionT(
   return std::nullopt;
 }
 
-std::optional<Intersection> LimitedCone::intersect(const Ray& ray) const {
-  Ray localRay = ray.transform(_inverseTransform);
-  Vector3D normal_at_intersection_local_dummy;
-  bool cap_intersection = false;
+std::optional<HitRecord> LimitedCone::intersectHit(const Ray& ray) const {
+  if (!_worldBounds.intersects(ray)) {
+    return std::nullopt;
+  }
 
-  std::optional<double> t_opt =
-      findClosestValidIntersectionT(localRay, cap_intersection);
+  bool cap_intersection = false;
+  std::optional<double> t_opt = findClosestValidIntersectionT(
+      ray.transform(_inverseTransform), cap_intersection);
 
   if (!t_opt) {
     return std::nullopt;
   }
 
-  double t_hit = *t_opt;
-  Vector3D localIntersectionPoint = localRay.pointAt(t_hit);
+  ray.shrinkTMax(*t_opt);
+  HitRecord hit;
+  hit.t = *t_opt;
+  hit.part = cap_intersection ? PART_CAP : PART_SURFACE;
+  return hit;
+}
+
+Intersection LimitedCone::computeSurface(const Ray& ray,
+                                         const HitRecord& hit) const {
+  Ray localRay = ray.transform(_inverseTransform);
+  Vector3D localIntersectionPoint = localRay.pointAt(hit.t);
   Vector3D worldIntersectionPoint =
       _transform.applyToPoint(localIntersectionPoint);
 
   Vector3D localNormal;
-  if (cap_intersection) {
+  if (hit.part == PART_CAP) {
     localNormal = _axis;
   } else {
     Vector3D PA = localIntersectionPoint - _apex;
@@ -187,17 +204,28 @@ std::optional<Intersection> LimitedCone::intersect(const Ray& ray) const {
   Intersection intersection_data;
   intersection_data.point = worldIntersectionPoint;
   intersection_data.normal = worldNormal;
-  intersection_data.distance =
-      (worldIntersectionPoint - ray.getOrigin()).getMagnitude();
+  intersection_data.distance = hit.t;
   intersection_data.color = _color;
   intersection_data.primitive = this;
 
   return intersection_data;
 }
 
+bool LimitedCone::occluded(const Ray& ray, double tMax) const {
+  if (!_worldBounds.intersects(ray, tMax)) {
+    return false;
+  }
+
+  Ray localRay = ray.transform(_inverseTransform);
+  localRay.setInterval(ray.getTMin(), tMax);
+  bool cap_intersection = false;
+  return findClosestValidIntersectionT(localRay, cap_intersection).has_value();
+}
+
 void LimitedCone::setTransform(const Transform& transform) {
   _transform = transform;
   updateInverseTransform();
+  updateWorldBounds();
 }
 
 Transform LimitedCone::getTransform() const {
@@ -253,6 +281,31 @@ std::shared_ptr<IPrimitive> LimitedCone::clone() const {
   return clonedCone;
 }
 
+AABB LimitedCone::worldBounds() const {
+  return _worldBounds;
+}
+
+void LimitedCone::updateWorldBounds() {
+  // The cone lies between the apex and its base disk, whose extent along each
+  // axis is radius * sqrt(1 - axis_i^2)
+  Vector3D baseCenter = _apex + _axis * _height;
+  double baseRadius = _height * std::tan(_angle_rad);
+  Vector3D diskExtent(
+      baseRadius * std::sqrt(std::max(0.0, 1.0 - _axis.getX() * _axis.getX())),
+      baseRadius * std::sqrt(std::max(0.0, 1.0 - _axis.getY() * _axis.getY())),
+      baseRadius * std::sqrt(std::max(0.0, 1.0 - _axis.getZ() * _axis.getZ())));
+
+  AABB localBounds(baseCenter - diskExtent, baseCenter + diskExtent);
+  localBounds.expand(_apex);
+  // Padded by the tolerance of the height checks, which accept hits just
+  // outside the apex and base planes
+  Vector3D padding(LIMITED_CONE_EPSILON, LIMITED_CONE_EPSILON,
+                   LIMITED_CONE_EPSILON);
+  localBounds.expand(localBounds.getMin() - padding);
+  localBounds.expand(localBounds.getMax() + padding);
+  _worldBounds = localBounds.transformed(_transform);
+}
+
 Vector3D LimitedCone::getApex() const {
   return _transform.applyToPoint(_apex);
 }
@@ -277,6 +330,7 @@ void LimitedCone::setHeight(double height) {
     throw std::invalid_argument("Cone height must be positive.");
   }
   _height = height;
+  updateWorldBounds();
 }
 
 void LimitedCone::setHasCaps(bool hasCaps) {
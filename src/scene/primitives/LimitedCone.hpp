@@ -47,13 +47,17 @@ class LimitedCone : public ICone {
    */
   ~LimitedCone() override = default;
 
-  std::optional<Intersection> intersect(const Ray& ray) const override;
+  std::optional<HitRecord> intersectHit(const Ray& ray) const override;
+  Intersection computeSurface(const Ray& ray,
+                              const HitRecord& hit) const override;
+  bool occluded(const Ray& ray, double tMax) const override;
   void setTransform(const Transform& transform) override;
   Transform getTransform() const override;
   void setColor(const Color& color) override;
   Color getColor() const override;
   Vector3D getNormalAt(const Vector3D& point) const override;
   std::shared_ptr<IPrimitive> clone() const override;
+  AABB worldBounds() const override;
 
   void setHeight(double height);
   void setHasCaps(bool hasCaps);
@@ -77,6 +81,7 @@ class LimitedCone : public ICone {
   Transform _inverseTransform;  ///< Inverse of the transformation.
   double _height;               ///< Maximum height of the cone.
   bool _has_caps;               ///< Whether the cone has end caps.
+  AABB _worldBounds;            ///< Cached world-space bounding box.
 
   /**
    * @brief Updates the inverse transform matrix whenever the main transform
@@ -84,6 +89,12 @@ class LimitedCone : public ICone {
    */
   void updateInverseTransform();
 
+  /**
+   * @brief Recomputes the cached world bounds whenever the geometry or the
+   * transform changes.
+   */
+  void updateWorldBounds();
+
   /**
    * @brief Finds the smallest valid intersection distance 't' for a ray in
    * local space, considering height limits and caps.
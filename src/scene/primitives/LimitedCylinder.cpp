@@ -24,6 +24,15 @@
 
 namespace RayTracer {
 
+namespace {
+
+/// HitRecord::part values of a limited cylinder
+constexpr int PART_BODY = 0;
+constexpr int PART_TOP_CAP = 1;
+constexpr int PART_BOTTOM_CAP = 2;
+
+}  // namespace
+
 LimitedCylinder::LimitedCylinder(double radius, double height,
                                  const Color& color)
     : _radius(radius), _height(height), _color(color), _transform() {
@@ -38,6 +47,7 @@ LimitedCylinder::LimitedCylinder(double radius, double height,
   } catch (const std::runtime_error& /*e*/) {
     _inverseTransform = Transform();
   }
+  updateWorldBounds();
 }
 
 void LimitedCylinder::setTransform(const Transform& transform) {
@@ -47,6 +57,7 @@ void LimitedCylinder::setTransform(const Transform& transform) {
   } catch (const std::runtime_error& /*e*/) {
     _inverseTransform = Transform();
   }
+  updateWorldBounds();
 }
 
 Transform LimitedCylinder::getTransform() const {
@@ -80,6 +91,19 @@ std::shared_ptr<IPrimitive> LimitedCylinder::clone() const {
   return std::make_shared<LimitedCylinder>(*this);
 }
 
+AABB LimitedCylinder::worldBounds() const {
+  return _worldBounds;
+}
+
+void LimitedCylinder::updateWorldBounds() {
+  // Padded by the tolerance of the height check, which accepts body hits
+  // just outside the caps
+  double halfHeight = _height / 2.0 + CYLINDER_EPSILON;
+  _worldBounds = AABB(Vector3D(-_radius, -halfHeight, -_radius),
+                      Vector3D(_radius, halfHeight, _radius))
+                     .transformed(_transform);
+}
+
 double LimitedCylinder::getRadius() const {
   return _radius;
 }
@@ -98,95 +122,116 @@ Vector3D LimitedCylinder::getAxis() const {
   return _transform.applyToNormal(Vector3D(0, 1, 0)).normalized();
 }
 
-std::optional<Intersection> LimitedCylinder::intersect(const Ray& ray) const {
-  Ray localRay = ray.transform(_inverseTransform);
-  double t_min_overall = std::numeric_limits<double>::infinity();
-  std::optional<Intersection> closest_intersection = std::nullopt;
+std::optional<HitRecord> LimitedCylinder::intersectHit(const Ray& ray) const {
+  if (!_worldBounds.intersects(ray)) {
+    return std::nullopt;
+  }
 
-  auto body_intersect_result = intersectBody(localRay, t_min_overall);
-  if (body_intersect_result) {
-    closest_intersection = body_intersect_result;
+  Ray localRay = ray.transform(_inverseTransform);
+  // Candidates must be strictly below t_min_overall, tMax itself is allowed
+  double t_min_overall = std::nextafter(
+      localRay.getTMax(), std::numeric_limits<double>::infinity());
+  int part = PART_BODY;
+
+  bool hit_body = intersectBody(localRay, t_min_overall);
+  bool hit_cap = intersectCaps(localRay, t_min_overall, part);
+  if (!hit_body && !hit_cap) {
+    return std::nullopt;
   }
 
-  auto cap_intersect_result = intersectCaps(localRay, t_min_overall);
-  if (cap_intersect_result) {
-    closest_intersection = cap_intersect_result;
+  ray.shrinkTMax(t_min_overall);
+  HitRecord hit;
+  hit.t = t_min_overall;
+  hit.part = part;
+  return hit;
+}
+
+Intersection LimitedCylinder::computeSurface(const Ray& ray,
+                                             const HitRecord& hit) const {
+  Ray localRay = ray.transform(_inverseTransform);
+  Vector3D localIntersectionPoint = localRay.pointAt(hit.t);
+
+  Vector3D localNormal;
+  if (hit.part == PART_TOP_CAP) {
+    localNormal = Vector3D(0, 1, 0);
+  } else if (hit.part == PART_BOTTOM_CAP) {
+    localNormal = Vector3D(0, -1, 0);
+  } else {
+    localNormal = Vector3D(localIntersectionPoint.getX(), 0,
+                           localIntersectionPoint.getZ());
   }
 
-  if (closest_intersection) {
-    Vector3D worldIntersectionPoint =
-        _transform.applyToPoint(closest_intersection->point);
-    Vector3D worldNormal =
-        _transform.applyToNormal(closest_intersection->normal).normalized();
+  Vector3D worldNormal = _transform.applyToNormal(localNormal).normalized();
+  if (worldNormal.dot(ray.getDirection()) > 0) {
+    worldNormal = -worldNormal;
+  }
 
-    if (worldNormal.dot(ray.getDirection()) > 0) {
-      worldNormal = -worldNormal;
-    }
+  Intersection intersection;
+  intersection.distance = hit.t;
+  intersection.point = _transform.applyToPoint(localIntersectionPoint);
+  intersection.normal = worldNormal;
+  intersection.color = _color;
+  intersection.primitive = this;
+  return intersection;
+}
 
-    closest_intersection->point = worldIntersectionPoint;
-    closest_intersection->normal = worldNormal;
-    closest_intersection->distance =
-        (worldIntersectionPoint - ray.getOrigin()).getMagnitude();
-    closest_intersection->color = _color;
-    closest_intersection->primitive = this;
-    return closest_intersection;
+bool LimitedCylinder::occluded(const Ray& ray, double tMax) const {
+  if (!_worldBounds.intersects(ray, tMax)) {
+    return false;
   }
 
-  return std::nullopt;
+  Ray localRay = ray.transform(_inverseTransform);
+  localRay.setInterval(ray.getTMin(), tMax);
+  double t_min_overall =
+      std::nextafter(tMax, std::numeric_limits<double>::infinity());
+  int part = PART_BODY;
+  return intersectBody(localRay, t_min_overall) ||
+         intersectCaps(localRay, t_min_overall, part);
 }
 
-std::optional<Intersection> LimitedCylinder::intersectCaps(
-    const Ray& localRay, double& t_min_overall) const {
-  std::optional<Intersection> closest_cap_intersection = std::nullopt;
+bool LimitedCylinder::intersectCaps(const Ray& localRay, double& t_min_overall,
+                                    int& part) const {
   double halfHeight = _height / 2.0;
+  bool hit = false;
 
-  auto top_cap_hit =
-      checkCap(localRay, t_min_overall, halfHeight, Vector3D(0, 1, 0));
-  if (top_cap_hit) {
-    closest_cap_intersection = top_cap_hit;
+  if (checkCap(localRay, t_min_overall, halfHeight)) {
+    part = PART_TOP_CAP;
+    hit = true;
   }
-
-  auto bottom_cap_hit =
-      checkCap(localRay, t_min_overall, -halfHeight, Vector3D(0, -1, 0));
-  if (bottom_cap_hit) {
-    closest_cap_intersection = bottom_cap_hit;
+  if (checkCap(localRay, t_min_overall, -halfHeight)) {
+    part = PART_BOTTOM_CAP;
+    hit = true;
   }
-
-  return closest_cap_intersection;
+  return hit;
 }
 
-std::optional<Intersection> LimitedCylinder::checkCap(
-    const Ray& localRay, double& t_min_overall, double cap_y_position,
-    const Vector3D& cap_normal_param) const {
+bool LimitedCylinder::checkCap(const Ray& localRay, double& t_min_overall,
+                               double cap_y_position) const {
   double directionY = localRay.getDirection().getY();
 
   if (std::abs(directionY) < CYLINDER_EPSILON) {
-    return std::nullopt;
+    return false;
   }
 
   double t = (cap_y_position - localRay.getOrigin().getY()) / directionY;
 
-  if (t <= CYLINDER_EPSILON || t >= t_min_overall) {
-    return std::nullopt;
+  if (t <= CYLINDER_EPSILON || t < localRay.getTMin() || t >= t_min_overall) {
+    return false;
   }
 
   Vector3D p = localRay.pointAt(t);
 
   if (p.getX() * p.getX() + p.getZ() * p.getZ() >
       _radius * _radius + CYLINDER_EPSILON) {
-    return std::nullopt;
+    return false;
   }
 
   t_min_overall = t;
-  Intersection intersection_data;
-  intersection_data.distance = t;
-  intersection_data.point = p;
-  intersection_data.normal = cap_normal_param;
-  return intersection_data;
+  return true;
 }
 
-std::optional<Intersection> LimitedCylinder::intersectBody(
-    const Ray& localRay, double& t_min_overall) const {
+bool LimitedCylinder::intersectBody(const Ray& localRay,
+                                    double& t_min_overall) const {
   Vector3D O = localRay.getOrigin();
   Vector3D D = localRay.getDirection();
 
@@ -195,49 +240,43 @@ std::optional<Intersection> LimitedCylinder::intersectBody(
   double c_quad = O.getX() * O.getX() + O.getZ() * O.getZ() - _radius * _radius;
 
   if (std::abs(a) < CYLINDER_EPSILON) {
-    return std::nullopt;
+    return false;
   }
 
   double discriminant = b * b - 4 * a * c_quad;
 
   if (discriminant < 0) {
-    return std::nullopt;
+    return false;
   }
 
   double sqrt_discriminant = std::sqrt(discriminant);
   double t0 = (-b - sqrt_discriminant) / (2 * a);
   double t1 = (-b + sqrt_discriminant) / (2 * a);
 
-  std::optional<Intersection> body_intersection = std::nullopt;
+  bool hit = false;
   double halfHeight = _height / 2.0;
 
-  if (t0 > CYLINDER_EPSILON && t0 < t_min_overall) {
-    Vector3D p0 = localRay.pointAt(t0);
-    if (p0.getY() >= -halfHeight - CYLINDER_EPSILON &&
-        p0.getY() <= halfHeight + CYLINDER_EPSILON) {
+  if (t0 > CYLINDER_EPSILON && t0 >= localRay.getTMin() &&
+      t0 < t_min_overall) {
+    double y0 = localRay.getOrigin().getY() + t0 * D.getY();
+    if (y0 >= -halfHeight - CYLINDER_EPSILON &&
+        y0 <= halfHeight + CYLINDER_EPSILON) {
       t_min_overall = t0;
-      Intersection intersection_data;
-      intersection_data.distance = t0;
-      intersection_data.point = p0;
-      intersection_data.normal = Vector3D(p0.getX(), 0, p0.getZ()).normalized();
-      body_intersection = intersection_data;
+      hit = true;
     }
   }
 
-  if (t1 > CYLINDER_EPSILON && t1 < t_min_overall) {
-    Vector3D p1 = localRay.pointAt(t1);
-    if (p1.getY() >= -halfHeight - CYLINDER_EPSILON &&
-        p1.getY() <= halfHeight + CYLINDER_EPSILON) {
+  if (t1 > CYLINDER_EPSILON && t1 >= localRay.getTMin() &&
+      t1 < t_min_overall) {
+    double y1 = localRay.getOrigin().getY() + t1 * D.getY();
+    if (y1 >= -halfHeight - CYLINDER_EPSILON &&
+        y1 <= halfHeight + CYLINDER_EPSILON) {
       t_min_overall = t1;
-      Intersection intersection_data;
-      intersection_data.distance = t1;
-      intersection_data.point = p1;
-      intersection_data.normal = Vector3D(p1.getX(), 0, p1.getZ()).normalized();
-      body_intersection = intersection_data;
+      hit = true;
     }
   }
 
-  return body_intersection;
+  return hit;
 }
 
 }  // namespace RayTracer
@@ -20,6 +20,7 @@
 #include <memory>
 #include <optional>
 #include "../../../include/IPrimitive.hpp"
+#include "../../core/AABB.hpp"
 #include "../../core/Color.hpp"
 #include "../../core/Ray.hpp"
 #include "../../core/Transform.hpp"
@@ -52,13 +53,30 @@ class LimitedCylinder : public ICylinder {
   // --- IPrimitive Interface Implementation ---
 
   /**
-   * @brief Check if a ray intersects this cylinder.
+   * @brief Find where a ray hits this cylinder, without surface data.
    * Considers intersections with the body and the end caps.
    * @param ray The ray to check for intersection.
-   * @return An std::optional<Intersection> containing intersection data if a
-   * hit occurs within the cylinder's bounds, std::nullopt otherwise.
+   * @return The hit parameter, with the part set to the body or a cap, or
+   * std::nullopt if the ray misses.
    */
-  std::optional<Intersection> intersect(const Ray& ray) const override;
+  std::optional<HitRecord> intersectHit(const Ray& ray) const override;
+
+  /**
+   * @brief Build the surface data of a hit found by intersectHit().
+   * @param ray The ray that produced the hit.
+   * @param hit The hit record.
+   * @return The world-space point, normal and color of the hit.
+   */
+  Intersection computeSurface(const Ray& ray,
+                              const HitRecord& hit) const override;
+
+  /**
+   * @brief Check if a ray hits this cylinder closer than a given distance.
+   * @param ray The ray to check.
+   * @param tMax Hits beyond this distance are ignored.
+   * @return true if the ray hits the cylinder, body or caps, in [tMin, tMax].
+   */
+  bool occluded(const Ray& ray, double tMax) const override;
 
   /**
    * @brief Set the transformation matrix for this cylinder.
@@ -99,6 +117,12 @@ class LimitedCylinder : public ICylinder {
    */
   std::shared_ptr<IPrimitive> clone() const override;
 
+  /**
+   * @brief Get the world-space bounding box of this cylinder.
+   * @return The box of the transformed cylinder, caps included.
+   */
+  AABB worldBounds() const override;
+
   // ICylinder interface
   /**
    * @brief Get the base center of the cylinder.
@@ -131,6 +155,12 @@ class LimitedCylinder : public ICylinder {
   Transform _transform;         ///< Transformation applied to the cylinder.
   Transform _inverseTransform;  ///< Cached inverse of _transform for
                                 ///< intersection calculations.
+  AABB _worldBounds;            ///< Cached world-space bounding box.
+
+  /**
+   * @brief Recompute the cached world bounds after a transform change.
+   */
+  void updateWorldBounds();
 
   /**
    * @brief Helper function to check intersection with a single cylinder cap.
@@ -138,39 +168,33 @@ class LimitedCylinder : public ICylinder {
    * @param t_min_overall Reference to the closest intersection distance found
    * so far. Updated if a closer hit is found.
    * @param cap_y_position The Y coordinate of the cap plane.
-   * @param cap_normal The normal vector of the cap plane (in local space).
-   * @return An optional Intersection data if a valid cap intersection is found
-   * closer than t_min_overall, otherwise std::nullopt. Intersection data is in
-   * local space.
+   * @return true if a valid cap intersection is found closer than
+   * t_min_overall.
    */
-  std::optional<Intersection> checkCap(const Ray& localRay,
-                                       double& t_min_overall,
-                                       double cap_y_position,
-                                       const Vector3D& cap_normal) const;
+  bool checkCap(const Ray& localRay, double& t_min_overall,
+                double cap_y_position) const;
 
   /**
    * @brief Calculates intersection with the cylinder's circular end caps.
    * @param localRay Ray in the cylinder's local coordinate system.
    * @param t_min_overall Reference to the closest intersection distance found
    * so far. This method will update it if a closer cap intersection is found.
-   * @return An optional Intersection data if a valid cap intersection is found
-   * closer than t_min_overall, otherwise std::nullopt. Intersection data is in
-   * local space.
+   * @param part Set to the cap that was hit, if any.
+   * @return true if a valid cap intersection is found closer than
+   * t_min_overall.
    */
-  std::optional<Intersection> intersectCaps(const Ray& localRay,
-                                            double& t_min_overall) const;
+  bool intersectCaps(const Ray& localRay, double& t_min_overall,
+                     int& part) const;
 
   /**
    * @brief Calculates intersection with the cylinder's curved body.
    * @param localRay Ray in the cylinder's local coordinate system.
    * @param t_min_overall Reference to the closest intersection distance found
    * so far. This method will update it if a closer body intersection is found.
-   * @return An optional Intersection data if a valid body intersection is found
-   * closer than t_min_overall, otherwise std::nullopt. Intersection data is in
-   * local space.
+   * @return true if a valid body intersection is found closer than
+   * t_min_overall.
    */
-  std::optional<Intersection> intersectBody(const Ray& localRay,
-                                            double& t_min_overall) const;
+  bool intersectBody(const Ray& localRay, double& t_min_overall) const;
 };
 
 }  // namespace RayTracer
@@ -0,0 +1,197 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Mesh primitive class implementation
+*/
+
+/**
+ * @file Mesh.cpp
+ * @brief Implementation of the Mesh class, an indexed triangle mesh traversed
+ * through its own bounding volume hierarchy
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include "Mesh.hpp"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace RayTracer {
+
+Mesh::Mesh(std::vector<Vector3D> vertices, std::vector<Face> faces,
+           const Color& color)
+    : _vertices(std::move(vertices)),
+      _faces(std::move(faces)),
+      _normals(),
+      _color(color),
+      _transform(),
+      _inverseTransform(),
+      _bvh(),
+      _triangles(),
+      _worldBounds() {
+  if (_faces.empty()) {
+    throw std::invalid_argument("Mesh must have at least one triangle");
+  }
+
+  std::vector<AABB> bounds;
+  bounds.reserve(_faces.size());
+  _normals.reserve(_faces.size());
+  for (const Face& face : _faces) {
+    for (uint32_t index : face) {
+      if (index >= _vertices.size()) {
+        throw std::invalid_argument("Mesh face references a missing vertex");
+      }
+    }
+    const Vector3D& a = _vertices[face[0]];
+    const Vector3D& b = _vertices[face[1]];
+    const Vector3D& c = _vertices[face[2]];
+    _normals.push_back((b - a).cross(c - a).normalized());
+
+    AABB box;
+    box.expand(a);
+    box.expand(b);
+    box.expand(c);
+    bounds.push_back(box);
+  }
+
+  _bvh.build(bounds);
+  for (uint32_t face : _bvh.getItemIndices()) {
+    _triangles.add(_vertices[_faces[face][0]], _vertices[_faces[face][1]],
+                   _vertices[_faces[face][2]], face);
+  }
+  updateWorldBounds();
+}
+
+void Mesh::setTransform(const Transform& transform) {
+  _transform = transform;
+  try {
+    _inverseTransform = _transform.inverse();
+  } catch (const std::runtime_error&) {
+    _inverseTransform = Transform();
+  }
+  updateWorldBounds();
+}
+
+Transform Mesh::getTransform() const {
+  return _transform;
+}
+
+void Mesh::setColor(const Color& color) {
+  _color = color;
+}
+
+Color Mesh::getColor() const {
+  return _color;
+}
+
+std::shared_ptr<IPrimitive> Mesh::clone() const {
+  return std::make_shared<Mesh>(*this);
+}
+
+AABB Mesh::worldBounds() const {
+  return _worldBounds;
+}
+
+std::size_t Mesh::getVertexCount() const {
+  return _vertices.size();
+}
+
+std::size_t Mesh::getTriangleCount() const {
+  return _faces.size();
+}
+
+const BVH& Mesh::getBVH() const {
+  return _bvh;
+}
+
+void Mesh::updateWorldBounds() {
+  _worldBounds = _bvh.getBounds().transformed(_transform);
+}
+
+std::optional<HitRecord> Mesh::intersectHit(const Ray& ray) const {
+  if (!_worldBounds.intersects(ray)) {
+    return std::nullopt;
+  }
+
+  Ray localRay = ray.transform(_inverseTransform);
+  std::optional<HitRecord> closest;
+  double tMax = localRay.getTMax();
+  _bvh.traverseLeaves(
+      localRay, tMax,
+      [&](std::size_t first, std::size_t count, double& maxDistance) {
+        auto hit = _triangles.intersect(localRay, first, first + count);
+        if (!hit) {
+          return false;
+        }
+        int face = static_cast<int>(hit->primitiveIndex);
+        // Equal hits of several leaves go to the lowest face
+        if (!closest || hit->t < closest->t ||
+            (hit->t == closest->t && face < closest->part)) {
+          maxDistance = hit->t;
+          closest = HitRecord{hit->t, 0, hit->u, hit->v, face};
+        }
+        return false;
+      });
+
+  if (!closest) {
+    return std::nullopt;
+  }
+  ray.shrinkTMax(closest->t);
+  return closest;
+}
+
+Intersection Mesh::computeSurface(const Ray& ray, const HitRecord& hit) const {
+  // Rebuilt from the barycentric coordinates, without transforming the ray
+  const Face& face = _faces[hit.part];
+  const Vector3D& a = _vertices[face[0]];
+  Vector3D localPoint = a + (_vertices[face[1]] - a) * hit.u +
+                        (_vertices[face[2]] - a) * hit.v;
+  Vector3D worldNormal =
+      _transform.applyToNormal(_normals[hit.part]).normalized();
+  if (worldNormal.dot(ray.getDirection()) > 0) {
+    worldNormal = -worldNormal;
+  }
+
+  Intersection intersection;
+  intersection.distance = hit.t;
+  intersection.point = _transform.applyToPoint(localPoint);
+  intersection.normal = worldNormal;
+  intersection.color = _color;
+  intersection.primitive = this;
+  return intersection;
+}
+
+bool Mesh::occluded(const Ray& ray, double tMax) const {
+  if (!_worldBounds.intersects(ray, tMax)) {
+    return false;
+  }
+
+  Ray localRay = ray.transform(_inverseTransform);
+  localRay.setInterval(ray.getTMin(), tMax);
+  double maxDistance = tMax;
+  return _bvh.traverseLeaves(
+      localRay, maxDistance,
+      [&](std::size_t first, std::size_t count, double&) {
+        return _triangles.occluded(localRay, first, first + count, tMax);
+      });
+}
+
+Vector3D Mesh::getNormalAt(const Vector3D& point) const {
+  Vector3D localPoint = _inverseTransform.applyToPoint(point);
+  std::size_t closestFace = 0;
+  double closestDistance = std::numeric_limits<double>::infinity();
+  for (std::size_t i = 0; i < _faces.size(); ++i) {
+    double distance =
+        std::abs(_normals[i].dot(localPoint - _vertices[_faces[i][0]]));
+    if (distance < closestDistance) {
+      closestDistance = distance;
+      closestFace = i;
+    }
+  }
+  return _transform.applyToNormal(_normals[closestFace]).normalized();
+}
+
+}  // namespace RayTracer
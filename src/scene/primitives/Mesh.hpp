@@ -0,0 +1,175 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Mesh primitive class header
+*/
+
+/**
+ * @file Mesh.hpp
+ * @brief Definition of the Mesh class, an indexed triangle mesh with its own
+ * bounding volume hierarchy, meant to be shared by many instances
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#ifndef MESH_HPP_
+#define MESH_HPP_
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+#include "../../../include/IPrimitive.hpp"
+#include "../../core/AABB.hpp"
+#include "../../core/Color.hpp"
+#include "../../core/Ray.hpp"
+#include "../../core/Transform.hpp"
+#include "../../core/Vector3D.hpp"
+#include "../acceleration/BVH.hpp"
+#include "../acceleration/TriangleBlock.hpp"
+
+namespace RayTracer {
+
+/**
+ * @brief Indexed triangle mesh, the bottom level of the acceleration structure
+ *
+ * The triangles are stored once, in the mesh local space, under a BVH built
+ * at construction, and packed in the leaf order of the hierarchy so that a
+ * leaf is intersected with SIMD in one TriangleBlock query. The mesh is a
+ * primitive on its own but is usually placed in the scene through Instance
+ * objects sharing it, so that every copy only costs a transform instead of
+ * its triangles and their hierarchy.
+ *
+ * Hits report the barycentric coordinates of the hit in u and v and the hit
+ * triangle in part.
+ */
+class Mesh : public IPrimitive {
+ public:
+  using Face = std::array<uint32_t, 3>;  ///< Vertex indices of a triangle
+
+  /**
+   * @brief Constructor
+   * @param vertices The vertex positions in local space
+   * @param faces The triangles, as indices in vertices
+   * @param color The color of the mesh
+   * @throw std::invalid_argument if the mesh has no triangle or a face
+   * references a missing vertex
+   */
+  Mesh(std::vector<Vector3D> vertices, std::vector<Face> faces,
+       const Color& color);
+
+  /**
+   * @brief Destructor
+   */
+  ~Mesh() override = default;
+
+  /**
+   * @brief Find the closest triangle hit by a ray, without surface data
+   * @param ray The ray to check
+   * @return The hit parameter, barycentrics and triangle, std::nullopt if
+   * the ray misses
+   */
+  std::optional<HitRecord> intersectHit(const Ray& ray) const override;
+
+  /**
+   * @brief Build the surface data of a hit found by intersectHit()
+   * @param ray The ray that produced the hit
+   * @param hit The hit record
+   * @return The world-space point, normal and color of the hit
+   */
+  Intersection computeSurface(const Ray& ray,
+                              const HitRecord& hit) const override;
+
+  /**
+   * @brief Check if a ray hits any triangle closer than a given distance
+   * @param ray The ray to check
+   * @param tMax Hits beyond this distance are ignored
+   * @return true if the ray hits the mesh in [tMin, tMax]
+   */
+  bool occluded(const Ray& ray, double tMax) const override;
+
+  /**
+   * @brief Set the transformation matrix for this mesh
+   * @param transform The transformation to apply
+   */
+  void setTransform(const Transform& transform) override;
+
+  /**
+   * @brief Get the transformation of this mesh
+   * @return The current transformation
+   */
+  Transform getTransform() const override;
+
+  /**
+   * @brief Set the color of this mesh
+   * @param color The color to set
+   */
+  void setColor(const Color& color) override;
+
+  /**
+   * @brief Get the color of this mesh
+   * @return The current color
+   */
+  Color getColor() const override;
+
+  /**
+   * @brief Get the normal of the triangle whose plane is closest to a point
+   * @param point The point in world space
+   * @return The normal vector at that point
+   */
+  Vector3D getNormalAt(const Vector3D& point) const override;
+
+  /**
+   * @brief Clone this mesh
+   * @return A new mesh with its own copy of the triangles
+   */
+  std::shared_ptr<IPrimitive> clone() const override;
+
+  /**
+   * @brief Get the world-space bounding box of this mesh
+   * @return The box of the transformed hierarchy bounds
+   */
+  AABB worldBounds() const override;
+
+  /**
+   * @brief Get the number of vertices
+   * @return The vertex count
+   */
+  std::size_t getVertexCount() const;
+
+  /**
+   * @brief Get the number of triangles
+   * @return The triangle count
+   */
+  std::size_t getTriangleCount() const;
+
+  /**
+   * @brief Get the hierarchy over the triangles
+   * @return The bottom level BVH, in local space
+   */
+  const BVH& getBVH() const;
+
+ private:
+  std::vector<Vector3D> _vertices;  ///< Vertex positions in local space
+  std::vector<Face> _faces;         ///< Vertex indices of every triangle
+  std::vector<Vector3D> _normals;   ///< Unit geometric normal per triangle
+  Color _color;                     ///< The color of the mesh
+  Transform _transform;             ///< The transformation of the mesh
+  Transform _inverseTransform;      ///< Cached inverse of the transformation
+  BVH _bvh;                         ///< Hierarchy over the triangles
+  TriangleBlock _triangles;         ///< Triangles in leaf order, tagged
+                                    ///< with their face index
+  AABB _worldBounds;                ///< Cached world-space bounding box
+
+  /**
+   * @brief Recompute the cached world bounds after a transform change
+   */
+  void updateWorldBounds();
+};
+
+}  // namespace RayTracer
+
+#endif /* !MESH_HPP_ */
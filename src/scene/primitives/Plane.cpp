@@ -40,32 +40,41 @@ Plane::Plane(char axis, double position, const Color& color)
   }
 }
 
-std::optional<Intersection> Plane::intersect(const Ray& ray) const {
+std::optional<HitRecord> Plane::intersectHit(const Ray& ray) const {
   Ray localRay = ray.transform(_inverseTransform);
 
-  double denominator = localRay.getDirection().dot(_normal);
-
-  if (std::abs(denominator) < EPSILON) {
+  std::optional<double> t = findClosestValidIntersectionT(localRay);
+  if (!t) {
     return std::nullopt;
   }
+  ray.shrinkTMax(*t);
 
-  Vector3D planePointOnAxis;
+  // The in-plane coordinates are enough to rebuild the local hit point
+  Vector3D localIntersectionPoint = localRay.pointAt(*t);
+  HitRecord hit;
+  hit.t = *t;
   if (_axis == Axis::X) {
-    planePointOnAxis = Vector3D(_position, 0, 0);
+    hit.u = localIntersectionPoint.getY();
+    hit.v = localIntersectionPoint.getZ();
   } else if (_axis == Axis::Y) {
-    planePointOnAxis = Vector3D(0, _position, 0);
+    hit.u = localIntersectionPoint.getX();
+    hit.v = localIntersectionPoint.getZ();
   } else {
-    planePointOnAxis = Vector3D(0, 0, _position);
+    hit.u = localIntersectionPoint.getX();
+    hit.v = localIntersectionPoint.getY();
   }
+  return hit;
+}
 
-  Vector3D originToPoint = planePointOnAxis - localRay.getOrigin();
-  double t = originToPoint.dot(_normal) / denominator;
-
-  if (t < EPSILON) {
-    return std::nullopt;
+Intersection Plane::computeSurface(const Ray& ray, const HitRecord& hit) const {
+  Vector3D localIntersectionPoint;
+  if (_axis == Axis::X) {
+    localIntersectionPoint = Vector3D(_position, hit.u, hit.v);
+  } else if (_axis == Axis::Y) {
+    localIntersectionPoint = Vector3D(hit.u, _position, hit.v);
+  } else {
+    localIntersectionPoint = Vector3D(hit.u, hit.v, _position);
   }
-
-  Vector3D localIntersectionPoint = localRay.pointAt(t);
   Vector3D worldIntersectionPoint =
       _transform.applyToPoint(localIntersectionPoint);
   Vector3D worldNormal = _transform.applyToNormal(_normal).normalized();
@@ -75,8 +84,7 @@ std::optional<Intersection> Plane::intersect(const Ray& ray) const {
   }
 
   Intersection intersection;
-  intersection.distance =
-      (worldIntersectionPoint - ray.getOrigin()).getMagnitude();
+  intersection.distance = hit.t;
   intersection.point = worldIntersectionPoint;
   intersection.normal = worldNormal;
   intersection.color = _color;
@@ -85,6 +93,38 @@ std::optional<Intersection> Plane::intersect(const Ray& ray) const {
   return intersection;
 }
 
+bool Plane::occluded(const Ray& ray, double tMax) const {
+  Ray localRay = ray.transform(_inverseTransform);
+  localRay.setInterval(ray.getTMin(), tMax);
+  return findClosestValidIntersectionT(localRay).has_value();
+}
+
+std::optional<double> Plane::findClosestValidIntersectionT(
+    const Ray& localRay) const {
+  double denominator = localRay.getDirection().dot(_normal);
+
+  if (std::abs(denominator) < EPSILON) {
+    return std::nullopt;
+  }
+
+  Vector3D planePointOnAxis;
+  if (_axis == Axis::X) {
+    planePointOnAxis = Vector3D(_position, 0, 0);
+  } else if (_axis == Axis::Y) {
+    planePointOnAxis = Vector3D(0, _position, 0);
+  } else {
+    planePointOnAxis = Vector3D(0, 0, _position);
+  }
+
+  Vector3D originToPoint = planePointOnAxis - localRay.getOrigin();
+  double t = originToPoint.dot(_normal) / denominator;
+
+  if (t < EPSILON || !localRay.isInInterval(t)) {
+    return std::nullopt;
+  }
+  return t;
+}
+
 void Plane::setTransform(const Transform& transform) {
   _transform = transform;
   try {
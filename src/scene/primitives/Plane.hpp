@@ -55,11 +55,30 @@ class Plane : public IPrimitive {
   ~Plane() override = default;
 
   /**
-   * @brief Check if a ray intersects this plane
+   * @brief Find where a ray hits this plane, without surface data
    * @param ray The ray to check
-   * @return Intersection data if hit, std::nullopt otherwise
+   * @return The hit parameter and the local in-plane coordinates of the hit
+   * (Y and Z for an X plane, X and Z for a Y plane, X and Y for a Z plane),
+   * std::nullopt if the ray misses
    */
-  std::optional<Intersection> intersect(const Ray& ray) const override;
+  std::optional<HitRecord> intersectHit(const Ray& ray) const override;
+
+  /**
+   * @brief Build the surface data of a hit found by intersectHit()
+   * @param ray The ray that produced the hit
+   * @param hit The hit record
+   * @return The world-space point, normal and color of the hit
+   */
+  Intersection computeSurface(const Ray& ray,
+                              const HitRecord& hit) const override;
+
+  /**
+   * @brief Check if a ray hits this plane closer than a given distance
+   * @param ray The ray to check
+   * @param tMax Hits beyond this distance are ignored
+   * @return true if the ray crosses the plane in [tMin, tMax]
+   */
+  bool occluded(const Ray& ray, double tMax) const override;
 
   /**
    * @brief Set the transformation matrix for this plane
@@ -124,6 +143,15 @@ class Plane : public IPrimitive {
   Transform _transform;  ///< Transformation applied to the plane
   Transform _inverseTransform;  ///< Inverse transformation
 
+  /**
+   * @brief Find the hit parameter along a local-space ray
+   * @param localRay The ray in the plane's local coordinate system
+   * @return t if the ray crosses the plane in front of its origin,
+   * std::nullopt otherwise
+   */
+  std::optional<double> findClosestValidIntersectionT(
+      const Ray& localRay) const;
+
  protected:
   Axis getAxisFromChar(char axis) const;
   char getCharFromAxis(Axis axis) const;
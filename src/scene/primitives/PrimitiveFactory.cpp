@@ -89,12 +89,29 @@ PrimitiveFactory::Result PrimitiveFactory::createPrimitives(
     const Setting& setting) {
   Result result;
 
+  // Meshes are declared before any instance can reference them
+  for (int i = 0; i < setting.getLength(); ++i) {
+    if (normalizeTypeName(setting[i].getName()) == "meshes") {
+      createMeshes(setting[i], result.meshes);
+    }
+  }
+
   // Iterate through all groups in the primitives section
   for (int i = 0; i < setting.getLength(); ++i) {
     const Setting& primitiveGroup = setting[i];
     std::string typeName = primitiveGroup.getName();
     std::string normalizedTypeName = normalizeTypeName(typeName);
 
+    if (normalizedTypeName == "meshes") {
+      continue;
+    }
+    if (normalizedTypeName == "instances") {
+      auto instances = createInstances(primitiveGroup, result.meshes);
+      result.primitives.insert(result.primitives.end(), instances.begin(),
+                               instances.end());
+      continue;
+    }
+
     // Check if this primitive type is supported (with case insensitivity)
     auto it = primitiveCreators.find(normalizedTypeName);
 
@@ -145,6 +162,148 @@ PrimitiveFactory::createPrimitivesOfType(const Setting& setting,
   return primitives;
 }
 
+void PrimitiveFactory::createMeshes(const Setting& setting,
+                                    MeshLibrary& meshes) {
+  if (!setting.isList() && !setting.isGroup()) {
+    throw ParserException("Meshes setting must be a list or group");
+  }
+
+  for (int i = 0; i < setting.getLength(); ++i) {
+    try {
+      std::string name;
+      if (!setting[i].lookupValue("name", name) || name.empty()) {
+        throw ParserException("Mesh: missing 'name'");
+      }
+      if (meshes.count(name) > 0) {
+        throw ParserException("Mesh: duplicate name '" + name + "'");
+      }
+      meshes[name] = createMesh(setting[i]);
+    } catch (const std::exception& e) {
+      std::cerr << "Failed to create mesh at index " << i << ": " << e.what()
+                << std::endl;
+    }
+  }
+}
+
+std::vector<std::shared_ptr<IPrimitive>> PrimitiveFactory::createInstances(
+    const Setting& setting, const MeshLibrary& meshes) {
+  std::vector<std::shared_ptr<IPrimitive>> instances;
+
+  if (!setting.isList() && !setting.isGroup()) {
+    throw ParserException("Instances setting must be a list or group");
+  }
+
+  for (int i = 0; i < setting.getLength(); ++i) {
+    try {
+      instances.push_back(createInstance(setting[i], meshes));
+    } catch (const std::exception& e) {
+      std::cerr << "Failed to create instance at index " << i << ": "
+                << e.what() << std::endl;
+    }
+  }
+
+  return instances;
+}
+
+std::shared_ptr<Mesh> PrimitiveFactory::createMesh(const Setting& setting) {
+  try {
+    if (!setting.exists("vertices")) {
+      throw ParserException("Mesh: missing 'vertices'");
+    }
+    if (!setting.exists("triangles")) {
+      throw ParserException("Mesh: missing 'triangles'");
+    }
+
+    // Vertices are groups like the triangle corners: { x = 0; y = 0; z = 0; }
+    const Setting& verticesSetting = setting["vertices"];
+    std::vector<Vector3D> vertices;
+    vertices.reserve(verticesSetting.getLength());
+    for (int i = 0; i < verticesSetting.getLength(); ++i) {
+      const Setting& vertex = verticesSetting[i];
+      if (!vertex.exists("x") || !vertex.exists("y") || !vertex.exists("z")) {
+        throw ParserException("Mesh: missing or invalid vertex coordinates");
+      }
+      vertices.emplace_back(getFlexibleFloat(vertex["x"]),
+                            getFlexibleFloat(vertex["y"]),
+                            getFlexibleFloat(vertex["z"]));
+    }
+
+    // Triangles are arrays of three vertex indices: [0, 1, 2]
+    const Setting& trianglesSetting = setting["triangles"];
+    std::vector<Mesh::Face> faces;
+    faces.reserve(trianglesSetting.getLength());
+    for (int i = 0; i < trianglesSetting.getLength(); ++i) {
+      const Setting& triangle = trianglesSetting[i];
+      if (triangle.getLength() != 3) {
+        throw ParserException("Mesh: a triangle needs exactly 3 indices");
+      }
+      Mesh::Face face;
+      for (int corner = 0; corner < 3; ++corner) {
+        int index = triangle[corner];
+        if (index < 0) {
+          throw ParserException("Mesh: negative vertex index");
+        }
+        face[corner] = static_cast<uint32_t>(index);
+      }
+      faces.push_back(face);
+    }
+
+    Color color = Color::WHITE;  // Default color
+    if (setting.exists("color")) {
+      color = parseColor(setting["color"]);
+    }
+
+    auto mesh =
+        std::make_shared<Mesh>(std::move(vertices), std::move(faces), color);
+
+    // Apply any transformation, shared by every instance of the mesh
+    applyTransformIfExists(setting, mesh);
+
+    return mesh;
+  } catch (const SettingNotFoundException& e) {
+    throw ParserException(std::string("Setting not found in mesh: ") +
+                          e.what());
+  } catch (const SettingTypeException& e) {
+    throw ParserException(std::string("Setting type error in mesh: ") +
+                          e.what());
+  } catch (const std::exception& e) {
+    throw ParserException(std::string("Error creating mesh: ") + e.what());
+  }
+}
+
+std::shared_ptr<Instance> PrimitiveFactory::createInstance(
+    const Setting& setting, const MeshLibrary& meshes) {
+  try {
+    std::string meshName;
+    if (!setting.lookupValue("mesh", meshName)) {
+      throw ParserException("Instance: missing 'mesh'");
+    }
+    auto mesh = meshes.find(meshName);
+    if (mesh == meshes.end()) {
+      throw ParserException("Instance: unknown mesh '" + meshName + "'");
+    }
+
+    auto instance = std::make_shared<Instance>(mesh->second);
+
+    if (setting.exists("color")) {
+      instance->setColor(parseColor(setting["color"]));
+    }
+
+    // Apply the placement of this copy
+    applyTransformIfExists(setting, instance);
+
+    return instance;
+  } catch (const SettingNotFoundException& e) {
+    throw ParserException(std::string("Setting not found in instance: ") +
+                          e.what());
+  } catch (const SettingTypeException& e) {
+    throw ParserException(std::string("Setting type error in instance: ") +
+                          e.what());
+  } catch (const std::exception& e) {
+    throw ParserException(std::string("Error creating instance: ") + e.what());
+  }
+}
+
 std::shared_ptr<Sphere> PrimitiveFactory::createSphere(const Setting& setting) {
   try {
     double x = 0.0, y = 0.0, z = 0.0, r = 1.0;
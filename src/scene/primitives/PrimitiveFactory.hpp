@@ -27,8 +27,10 @@
 #include "CheckerboardPlane.hpp"
 #include "Cone.hpp"
 #include "Cylinder.hpp"
+#include "Instance.hpp"
 #include "LimitedCone.hpp"
 #include "LimitedCylinder.hpp"
+#include "Mesh.hpp"
 #include "Plane.hpp"
 #include "Sphere.hpp"
 #include "Torus.hpp"
@@ -45,15 +47,24 @@ namespace RayTracer {
  */
 class PrimitiveFactory {
  public:
+  /// Shared meshes by name, referenced by the instances of a config
+  using MeshLibrary = std::unordered_map<std::string, std::shared_ptr<Mesh>>;
+
   /**
    * @brief Result struct containing all primitives created from a config
    */
   struct Result {
     std::vector<std::shared_ptr<IPrimitive>> primitives;
+    MeshLibrary meshes;  ///< Meshes declared for instancing, not rendered
   };
 
   /**
    * @brief Create all primitives from a configuration section
+   *
+   * The "meshes" group only declares named meshes; they are placed in the
+   * scene by the entries of the "instances" group, which all share the
+   * triangles and hierarchy of the mesh they reference.
+   *
    * @param setting libconfig setting containing all primitive definitions
    * @return A Result structure containing all created primitives
    */
@@ -120,6 +131,22 @@ class PrimitiveFactory {
   static std::shared_ptr<Triangle> createTriangle(
       const libconfig::Setting& setting);
 
+  /**
+   * @brief Create a mesh from configuration
+   * @param setting libconfig setting containing the vertices and triangles
+   * @return A shared pointer to the created mesh
+   */
+  static std::shared_ptr<Mesh> createMesh(const libconfig::Setting& setting);
+
+  /**
+   * @brief Create an instance of a declared mesh from configuration
+   * @param setting libconfig setting containing the mesh name and transform
+   * @param meshes The meshes declared so far
+   * @return A shared pointer to the created instance
+   */
+  static std::shared_ptr<Instance> createInstance(
+      const libconfig::Setting& setting, const MeshLibrary& meshes);
+
   /**
    * @brief Create all primitives of a specific type from configuration
    * @param setting libconfig setting containing primitive list
@@ -160,6 +187,23 @@ class PrimitiveFactory {
    */
   static std::string normalizeTypeName(const std::string& typeName);
 
+  /**
+   * @brief Parse the named meshes of a "meshes" group
+   * @param setting libconfig setting containing the mesh list
+   * @param meshes Receives every mesh that could be created
+   */
+  static void createMeshes(const libconfig::Setting& setting,
+                           MeshLibrary& meshes);
+
+  /**
+   * @brief Create every instance of an "instances" group
+   * @param setting libconfig setting containing the instance list
+   * @param meshes The declared meshes
+   * @return Vector of shared pointers to the created instances
+   */
+  static std::vector<std::shared_ptr<IPrimitive>> createInstances(
+      const libconfig::Setting& setting, const MeshLibrary& meshes);
+
   // Type to factory method mapping for primitive creation
   using PrimitiveCreator =
       std::function<std::shared_ptr<IPrimitive>(const libconfig::Setting&)>;
@@ -21,20 +21,25 @@
 namespace RayTracer {
 
 Sphere::Sphere()
-    : _center(0, 0, 0), _radius(1.0), _color(Color::RED), _transform() {}
+    : _center(0, 0, 0), _radius(1.0), _color(Color::RED), _transform() {
+  updateWorldBounds();
+}
 
 Sphere::Sphere(const Vector3D& center, double radius, const Color& color)
     : _center(center), _radius(radius), _color(color), _transform() {
   if (radius <= 0) {
     throw InvalidTypeException("Sphere radius must be positive");
   }
+  updateWorldBounds();
 }
 
 Sphere::Sphere(const Sphere& other)
     : _center(other._center),
       _radius(other._radius),
       _color(other._color),
-      _transform(other._transform) {}
+      _transform(other._transform),
+      _inverseTransform(other._inverseTransform),
+      _worldBounds(other._worldBounds) {}
 
 Sphere& Sphere::operator=(const Sphere& other) {
   if (this != &other) {
@@ -42,49 +47,41 @@ Sphere& Sphere::operator=(const Sphere& other) {
     _radius = other._radius;
     _color = other._color;
     _transform = other._transform;
+    _inverseTransform = other._inverseTransform;
+    _worldBounds = other._worldBounds;
   }
   return *this;
 }
 
 Sphere::~Sphere() {}
 
-std::optional<Intersection> Sphere::intersect(const Ray& ray) const {
-  Ray localRay = ray.transform(_transform.inverse());
-
-  Vector3D oc = localRay.getOrigin() - _center;
-
-  double a = localRay.getDirection().dot(localRay.getDirection());
-  double b = 2.0 * oc.dot(localRay.getDirection());
-  double c = oc.dot(oc) - _radius * _radius;
-
-  double discriminant = b * b - 4 * a * c;
-
-  if (discriminant < 0) {
+std::optional<HitRecord> Sphere::intersectHit(const Ray& ray) const {
+  if (!_worldBounds.intersects(ray)) {
     return std::nullopt;
   }
 
-  double sqrtDiscriminant = std::sqrt(discriminant);
-  double t1 = (-b - sqrtDiscriminant) / (2 * a);
-  double t2 = (-b + sqrtDiscriminant) / (2 * a);
-
-  double t = t1;
-  if (t < 0) {
-    t = t2;
-    if (t < 0) {
-      return std::nullopt;
-    }
+  std::optional<double> t =
+      findClosestValidIntersectionT(ray.transform(_inverseTransform));
+  if (!t) {
+    return std::nullopt;
   }
+  ray.shrinkTMax(*t);
+
+  HitRecord hit;
+  hit.t = *t;
+  return hit;
+}
 
-  Vector3D localIntersectionPoint = localRay.pointAt(t);
+Intersection Sphere::computeSurface(const Ray& ray,
+                                    const HitRecord& hit) const {
+  Ray localRay = ray.transform(_inverseTransform);
+  Vector3D localIntersectionPoint = localRay.pointAt(hit.t);
 
   Vector3D localNormal = (localIntersectionPoint - _center).normalized();
 
   Vector3D worldIntersectionPoint =
       _transform.applyToPoint(localIntersectionPoint);
 
-  double worldDistance =
-      (worldIntersectionPoint - ray.getOrigin()).getMagnitude();
-
   Vector3D worldNormal = _transform.applyToNormal(localNormal).normalized();
 
   if (worldNormal.dot(ray.getDirection()) > 0) {
@@ -92,7 +89,7 @@ std::optional<Intersection> Sphere::intersect(const Ray& ray) const {
   }
 
   Intersection intersection;
-  intersection.distance = worldDistance;
+  intersection.distance = hit.t;
   intersection.point = worldIntersectionPoint;
   intersection.normal = worldNormal;
   intersection.color = _color;
@@ -101,8 +98,47 @@ std::optional<Intersection> Sphere::intersect(const Ray& ray) const {
   return intersection;
 }
 
+bool Sphere::occluded(const Ray& ray, double tMax) const {
+  if (!_worldBounds.intersects(ray, tMax)) {
+    return false;
+  }
+
+  Ray localRay = ray.transform(_inverseTransform);
+  localRay.setInterval(ray.getTMin(), tMax);
+  return findClosestValidIntersectionT(localRay).has_value();
+}
+
+std::optional<double> Sphere::findClosestValidIntersectionT(
+    const Ray& localRay) const {
+  Vector3D oc = localRay.getOrigin() - _center;
+
+  double a = localRay.getDirection().dot(localRay.getDirection());
+  double b = 2.0 * oc.dot(localRay.getDirection());
+  double c = oc.dot(oc) - _radius * _radius;
+
+  double discriminant = b * b - 4 * a * c;
+
+  if (discriminant < 0) {
+    return std::nullopt;
+  }
+
+  double sqrtDiscriminant = std::sqrt(discriminant);
+  double t1 = (-b - sqrtDiscriminant) / (2 * a);
+  double t2 = (-b + sqrtDiscriminant) / (2 * a);
+
+  if (t1 >= 0 && localRay.isInInterval(t1)) {
+    return t1;
+  }
+  if (t2 >= 0 && localRay.isInInterval(t2)) {
+    return t2;
+  }
+  return std::nullopt;
+}
+
 void Sphere::setTransform(const Transform& transform) {
   _transform = transform;
+  _inverseTransform = _transform.inverse();
+  updateWorldBounds();
 }
 
 Transform Sphere::getTransform() const {
@@ -118,7 +154,7 @@ Color Sphere::getColor() const {
 }
 
 Vector3D Sphere::getNormalAt(const Vector3D& point) const {
-  Vector3D localPoint = _transform.inverse().applyToPoint(point);
+  Vector3D localPoint = _inverseTransform.applyToPoint(point);
 
   Vector3D localNormal = (localPoint - _center).normalized();
 
@@ -132,8 +168,33 @@ std::shared_ptr<IPrimitive> Sphere::clone() const {
   return std::make_shared<Sphere>(*this);
 }
 
+AABB Sphere::worldBounds() const {
+  return _worldBounds;
+}
+
+void Sphere::updateWorldBounds() {
+  // The sphere becomes an ellipsoid whose half extent along world axis i is
+  // the radius times the norm of row i of the linear part of the transform
+  Vector3D columnX = _transform.applyToVector(Vector3D(1, 0, 0));
+  Vector3D columnY = _transform.applyToVector(Vector3D(0, 1, 0));
+  Vector3D columnZ = _transform.applyToVector(Vector3D(0, 0, 1));
+  Vector3D extent(
+      _radius * std::sqrt(columnX.getX() * columnX.getX() +
+                          columnY.getX() * columnY.getX() +
+                          columnZ.getX() * columnZ.getX()),
+      _radius * std::sqrt(columnX.getY() * columnX.getY() +
+                          columnY.getY() * columnY.getY() +
+                          columnZ.getY() * columnZ.getY()),
+      _radius * std::sqrt(columnX.getZ() * columnX.getZ() +
+                          columnY.getZ() * columnY.getZ() +
+                          columnZ.getZ() * columnZ.getZ()));
+  Vector3D worldCenter = _transform.applyToPoint(_center);
+  _worldBounds = AABB(worldCenter - extent, worldCenter + extent);
+}
+
 void Sphere::setCenter(const Vector3D& center) {
   _center = center;
+  updateWorldBounds();
 }
 
 Vector3D Sphere::getCenter() const {
@@ -145,6 +206,7 @@ void Sphere::setRadius(double radius) {
     throw InvalidTypeException("Sphere radius must be positive");
   }
   _radius = radius;
+  updateWorldBounds();
 }
 
 double Sphere::getRadius() const {
@@ -20,6 +20,7 @@
 #include <memory>
 #include <optional>
 #include "../../../include/IPrimitive.hpp"
+#include "../../core/AABB.hpp"
 #include "../../core/Color.hpp"
 #include "../../core/Ray.hpp"
 #include "../../core/Transform.hpp"
@@ -65,11 +66,28 @@ class Sphere : public IPrimitive {
   ~Sphere() override;
 
   /**
-   * @brief Check if a ray intersects this sphere
+   * @brief Find where a ray hits this sphere, without surface data
    * @param ray The ray to check
-   * @return Intersection data if hit, std::nullopt otherwise
+   * @return The hit parameter, std::nullopt if the ray misses
    */
-  std::optional<Intersection> intersect(const Ray& ray) const override;
+  std::optional<HitRecord> intersectHit(const Ray& ray) const override;
+
+  /**
+   * @brief Build the surface data of a hit found by intersectHit()
+   * @param ray The ray that produced the hit
+   * @param hit The hit record
+   * @return The world-space point, normal and color of the hit
+   */
+  Intersection computeSurface(const Ray& ray,
+                              const HitRecord& hit) const override;
+
+  /**
+   * @brief Check if a ray hits this sphere closer than a given distance
+   * @param ray The ray to check
+   * @param tMax Hits beyond this distance are ignored
+   * @return true if the ray hits the sphere in [tMin, tMax]
+   */
+  bool occluded(const Ray& ray, double tMax) const override;
 
   /**
    * @brief Set the transformation matrix for this sphere
@@ -108,6 +126,12 @@ class Sphere : public IPrimitive {
    */
   std::shared_ptr<IPrimitive> clone() const override;
 
+  /**
+   * @brief Get the world-space bounding box of this sphere
+   * @return The tight box of the transformed sphere (an ellipsoid)
+   */
+  AABB worldBounds() const override;
+
   /**
    * @brief Set the center of the sphere
    * @param center The new center position
@@ -137,6 +161,21 @@ class Sphere : public IPrimitive {
   double _radius;        ///< The radius of the sphere
   Color _color;          ///< The color of the sphere
   Transform _transform;  ///< The transformation applied to the sphere
+  Transform _inverseTransform;  ///< Cached inverse of the transformation
+  AABB _worldBounds;            ///< Cached world-space bounding box
+
+  /**
+   * @brief Find the closest hit parameter along a local-space ray
+   * @param localRay The ray in the sphere's local coordinate system
+   * @return The smallest non-negative t, std::nullopt if the ray misses
+   */
+  std::optional<double> findClosestValidIntersectionT(
+      const Ray& localRay) const;
+
+  /**
+   * @brief Recompute the cached world bounds after a geometry change
+   */
+  void updateWorldBounds();
 };
 
 }  // namespace RayTracer
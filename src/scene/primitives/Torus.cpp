@@ -15,12 +15,21 @@
  */
 
 #include "Torus.hpp"
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <stdexcept>
-#include <vector>
+#include "../../core/Polynomial.hpp"
 
 namespace RayTracer {
 
+namespace {
+
+/// Relative widening of the root search past the end of the ray interval
+constexpr double TORUS_SOLVER_SLACK = 1e-9;
+
+}  // namespace
+
 Torus::Torus(double majorRadius, double tubeRadius, const Color& color)
     : _majorRadius(majorRadius),
       _tubeRadius(tubeRadius),
@@ -34,6 +43,7 @@ Torus::Torus(double majorRadius, double tubeRadius, const Color& color)
   } catch (const std::runtime_error&) {
     _inverseTransform = Transform();
   }
+  updateWorldBounds();
 }
 
 void Torus::setTransform(const Transform& transform) {
@@ -43,6 +53,7 @@ void Torus::setTransform(const Transform& transform) {
   } catch (const std::runtime_error&) {
     _inverseTransform = Transform();
   }
+  updateWorldBounds();
 }
 
 Transform Torus::getTransform() const {
@@ -61,6 +72,17 @@ std::shared_ptr<IPrimitive> Torus::clone() const {
   return std::make_shared<Torus>(*this);
 }
 
+AABB Torus::worldBounds() const {
+  return _worldBounds;
+}
+
+void Torus::updateWorldBounds() {
+  double outer = _majorRadius + _tubeRadius;
+  _worldBounds = AABB(Vector3D(-outer, -_tubeRadius, -outer),
+                      Vector3D(outer, _tubeRadius, outer))
+                     .transformed(_transform);
+}
+
 double Torus::getMajorRadius() const {
   return _majorRadius;
 }
@@ -69,72 +91,25 @@ double Torus::getTubeRadius() const {
   return _tubeRadius;
 }
 
-std::optional<Intersection> Torus::intersect(const Ray& ray) const {
-  Ray localRay = ray.transform(_inverseTransform);
-  Vector3D O = localRay.getOrigin();
-  Vector3D D = localRay.getDirection();
-  double R = _majorRadius;
-  double r = _tubeRadius;
-
-  double ox = O.getX(), oy = O.getY(), oz = O.getZ();
-  double dx = D.getX(), dy = D.getY(), dz = D.getZ();
-
-  double sum_d_sq = dx * dx + dy * dy + dz * dz;
-  double sum_o_sq = ox * ox + oy * oy + oz * oz;
-  double k = sum_o_sq + R * R - r * r;
-
-  double a4 = sum_d_sq * sum_d_sq;
-  double a3 = 4.0 * sum_d_sq * (ox * dx + oy * dy + oz * dz);
-  double a2 =
-      2.0 * sum_d_sq * k +
-      4.0 * (ox * dx + oy * dy + oz * dz) * (ox * dx + oy * dy + oz * dz) -
-      4.0 * R * R * (dx * dx + dz * dz);
-  double a1 = 4.0 * k * (ox * dx + oy * dy + oz * dz) -
-              8.0 * R * R * (ox * dx + oz * dz);
-  double a0 = k * k - 4.0 * R * R * (ox * ox + oz * oz);
-
-  // optimisation to find roots
-  std::vector<std::pair<double, double>> intervals;
-  double t_prev = ROOT_FINDING_THRESHOLD;
-  double val_prev = a4 * t_prev * t_prev * t_prev * t_prev +
-                    a3 * t_prev * t_prev * t_prev + a2 * t_prev * t_prev +
-                    a1 * t_prev + a0;
-  for (double t = 1e-2; t < 100.0; t += 1e-2) {
-    double val = a4 * t * t * t * t + a3 * t * t * t + a2 * t * t + a1 * t + a0;
-    if (val_prev * val < 0) {
-      intervals.emplace_back(t_prev, t);
-    }
-    t_prev = t;
-    val_prev = val;
+std::optional<HitRecord> Torus::intersectHit(const Ray& ray) const {
+  if (!_worldBounds.intersects(ray)) {
+    return std::nullopt;
   }
 
-  auto quartic = [&](double t) {
-    return a4 * t * t * t * t + a3 * t * t * t + a2 * t * t + a1 * t + a0;
-  };
-  auto quartic_deriv = [&](double t) {
-    return 4 * a4 * t * t * t + 3 * a3 * t * t + 2 * a2 * t + a1;
-  };
-
-  double t_min = std::numeric_limits<double>::infinity();
-  for (const auto& interval : intervals) {
-    double t = (interval.first + interval.second) / 2.0;
-    for (int i = 0; i < 10; ++i) {
-      double f = quartic(t);
-      double df = quartic_deriv(t);
-      if (std::abs(df) < 1e-8)
-        break;
-      t = t - f / df;
-      if (t < 0)
-        break;
-    }
-    if (t > 1e-4 && t < t_min && std::abs(quartic(t)) < 1e-3) {
-      t_min = t;
-    }
-  }
-  if (t_min == std::numeric_limits<double>::infinity())
+  std::optional<double> t_hit =
+      findClosestValidIntersectionT(ray.transform(_inverseTransform));
+  if (!t_hit)
     return std::nullopt;
+  ray.shrinkTMax(*t_hit);
+
+  HitRecord hit;
+  hit.t = *t_hit;
+  return hit;
+}
 
-  Vector3D localIntersectionPoint = localRay.pointAt(t_min);
+Intersection Torus::computeSurface(const Ray& ray, const HitRecord& hit) const {
+  Ray localRay = ray.transform(_inverseTransform);
+  Vector3D localIntersectionPoint = localRay.pointAt(hit.t);
   double sumSquared =
       localIntersectionPoint.getX() * localIntersectionPoint.getX() +
       localIntersectionPoint.getZ() * localIntersectionPoint.getZ();
@@ -152,8 +127,7 @@ std::optional<Intersection> Torus::intersect(const Ray& ray) const {
   }
 
   Intersection intersection;
-  intersection.distance =
-      (worldIntersectionPoint - ray.getOrigin()).getMagnitude();
+  intersection.distance = hit.t;
   intersection.point = worldIntersectionPoint;
   intersection.normal = worldNormal;
   intersection.color = _color;
@@ -161,6 +135,80 @@ std::optional<Intersection> Torus::intersect(const Ray& ray) const {
   return intersection;
 }
 
+bool Torus::occluded(const Ray& ray, double tMax) const {
+  if (!_worldBounds.intersects(ray, tMax)) {
+    return false;
+  }
+  Ray localRay = ray.transform(_inverseTransform);
+  localRay.setInterval(ray.getTMin(), tMax);
+  return findClosestValidIntersectionT(localRay).has_value();
+}
+
+std::optional<double> Torus::findClosestValidIntersectionT(
+    const Ray& localRay) const {
+  Vector3D O = localRay.getOrigin();
+  Vector3D D = localRay.getDirection();
+  double R = _majorRadius;
+  double r = _tubeRadius;
+
+  double ox = O.getX(), oy = O.getY(), oz = O.getZ();
+  double dx = D.getX(), dy = D.getY(), dz = D.getZ();
+
+  // Clip the search to the bounding sphere, which rejects most misses with
+  // a single quadratic
+  double sum_d_sq = dx * dx + dy * dy + dz * dz;
+  double o_dot_d = ox * dx + oy * dy + oz * dz;
+  double outer = R + r;
+  std::array<double, 2> sphereHits{};
+  if (solveQuadratic(sum_d_sq, 2.0 * o_dot_d,
+                     ox * ox + oy * oy + oz * oz - outer * outer,
+                     sphereHits) < 2) {
+    return std::nullopt;
+  }
+  double t_lo = std::max(sphereHits[0], localRay.getTMin());
+  t_lo = std::max(t_lo, ROOT_FINDING_THRESHOLD);
+  double t_hi = std::min(sphereHits[1], localRay.getTMax());
+
+  // Then to the slab |y| <= r holding the tube
+  if (std::abs(dy) > 0.0) {
+    double t_a = (-r - oy) / dy;
+    double t_b = (r - oy) / dy;
+    t_lo = std::max(t_lo, std::min(t_a, t_b));
+    t_hi = std::min(t_hi, std::max(t_a, t_b));
+  } else if (std::abs(oy) > r) {
+    return std::nullopt;
+  }
+  if (t_lo > t_hi) {
+    return std::nullopt;
+  }
+
+  // Restart the ray at the entry point: the quartic coefficients then stay
+  // small, which keeps far away tori accurate
+  ox += t_lo * dx;
+  oy += t_lo * dy;
+  oz += t_lo * dz;
+  o_dot_d = ox * dx + oy * dy + oz * dz;
+  double k = ox * ox + oy * oy + oz * oz + R * R - r * r;
+
+  std::array<double, 5> coefficients = {
+      sum_d_sq * sum_d_sq,
+      4.0 * sum_d_sq * o_dot_d,
+      2.0 * sum_d_sq * k + 4.0 * o_dot_d * o_dot_d -
+          4.0 * R * R * (dx * dx + dz * dz),
+      4.0 * k * o_dot_d - 8.0 * R * R * (ox * dx + oz * dz),
+      k * k - 4.0 * R * R * (ox * ox + oz * oz)};
+
+  // The search is widened by the solver tolerance so that a root sitting
+  // exactly on tMax, such as the current closest hit, is still bracketed
+  double span = t_hi - t_lo;
+  std::optional<double> s = findSmallestQuarticRoot(
+      coefficients, 0.0, span + TORUS_SOLVER_SLACK * (1.0 + t_hi));
+  if (!s) {
+    return std::nullopt;
+  }
+  return t_lo + std::min(*s, span);
+}
+
 Vector3D Torus::getNormalAt(const Vector3D& point) const {
   Vector3D localPoint = _inverseTransform.applyToPoint(point);
   double sumSquared = localPoint.getX() * localPoint.getX() +
@@ -20,6 +20,7 @@
 #include <memory>
 #include <optional>
 #include "../../../include/IPrimitive.hpp"
+#include "../../core/AABB.hpp"
 #include "../../core/Color.hpp"
 #include "../../core/Ray.hpp"
 #include "../../core/Transform.hpp"
@@ -34,13 +35,17 @@ class Torus : public IPrimitive {
   Torus(double majorRadius, double tubeRadius, const Color& color);
   ~Torus() override = default;
 
-  std::optional<Intersection> intersect(const Ray& ray) const override;
+  std::optional<HitRecord> intersectHit(const Ray& ray) const override;
+  Intersection computeSurface(const Ray& ray,
+                              const HitRecord& hit) const override;
+  bool occluded(const Ray& ray, double tMax) const override;
   void setTransform(const Transform& transform) override;
   Transform getTransform() const override;
   void setColor(const Color& color) override;
   Color getColor() const override;
   Vector3D getNormalAt(const Vector3D& point) const override;
   std::shared_ptr<IPrimitive> clone() const override;
+  AABB worldBounds() const override;
 
   double getMajorRadius() const;
   double getTubeRadius() const;
@@ -51,6 +56,11 @@ class Torus : public IPrimitive {
   Color _color;
   Transform _transform;
   Transform _inverseTransform;
+  AABB _worldBounds;
+
+  void updateWorldBounds();
+  std::optional<double> findClosestValidIntersectionT(
+      const Ray& localRay) const;
 };
 
 }  // namespace RayTracer
@@ -29,6 +29,7 @@ Triangle::Triangle(const Vector3D& a, const Vector3D& b, const Vector3D& c,
   } catch (const std::runtime_error&) {
     _inverseTransform = Transform();
   }
+  updateWorldBounds();
 }
 
 void Triangle::setTransform(const Transform& transform) {
@@ -38,6 +39,7 @@ void Triangle::setTransform(const Transform& transform) {
   } catch (const std::runtime_error&) {
     _inverseTransform = Transform();
   }
+  updateWorldBounds();
 }
 
 Transform Triangle::getTransform() const {
@@ -56,6 +58,17 @@ std::shared_ptr<IPrimitive> Triangle::clone() const {
   return std::make_shared<Triangle>(*this);
 }
 
+AABB Triangle::worldBounds() const {
+  return _worldBounds;
+}
+
+void Triangle::updateWorldBounds() {
+  _worldBounds = AABB();
+  _worldBounds.expand(_transform.applyToPoint(_a));
+  _worldBounds.expand(_transform.applyToPoint(_b));
+  _worldBounds.expand(_transform.applyToPoint(_c));
+}
+
 Vector3D Triangle::getA() const {
   return _a;
 }
@@ -66,9 +79,48 @@ Vector3D Triangle::getC() const {
   return _c;
 }
 
-std::optional<Intersection> Triangle::intersect(const Ray& ray) const {
-  // Möller–Trumbore intersection algorithm
+std::optional<HitRecord> Triangle::intersectHit(const Ray& ray) const {
+  if (!_worldBounds.intersects(ray))
+    return std::nullopt;
+  HitRecord hit;
+  std::optional<double> t = findClosestValidIntersectionT(
+      ray.transform(_inverseTransform), hit.u, hit.v);
+  if (!t)
+    return std::nullopt;
+  ray.shrinkTMax(*t);
+  hit.t = *t;
+  return hit;
+}
+Intersection Triangle::computeSurface(const Ray& ray,
+                                      const HitRecord& hit) const {
+  // Rebuilt from the barycentric coordinates, without transforming the ray
+  Vector3D localIntersection = _a + (_b - _a) * hit.u + (_c - _a) * hit.v;
+  Vector3D worldIntersection = _transform.applyToPoint(localIntersection);
+  Vector3D worldNormal = _transform.applyToNormal(_normal).normalized();
+  if (worldNormal.dot(ray.getDirection()) > 0)
+    worldNormal = -worldNormal;
+  Intersection intersection;
+  intersection.distance = hit.t;
+  intersection.point = worldIntersection;
+  intersection.normal = worldNormal;
+  intersection.color = _color;
+  intersection.primitive = this;
+  return intersection;
+}
+
+bool Triangle::occluded(const Ray& ray, double tMax) const {
+  if (!_worldBounds.intersects(ray, tMax))
+    return false;
   Ray localRay = ray.transform(_inverseTransform);
+  localRay.setInterval(ray.getTMin(), tMax);
+  double u = 0.0;
+  double v = 0.0;
+  return findClosestValidIntersectionT(localRay, u, v).has_value();
+}
+
+std::optional<double> Triangle::findClosestValidIntersectionT(
+    const Ray& localRay, double& u, double& v) const {
+  // Möller–Trumbore intersection algorithm
   const Vector3D& orig = localRay.getOrigin();
   const Vector3D& dir = localRay.getDirection();
   Vector3D edge1 = _b - _a;
@@ -79,28 +131,17 @@ std::optional<Intersection> Triangle::intersect(const Ray& ray) const {
     return std::nullopt;
   double f = 1.0 / a;
   Vector3D s = orig - _a;
-  double u = f * s.dot(h);
+  u = f * s.dot(h);
   if (u < 0.0 || u > 1.0)
     return std::nullopt;
   Vector3D q = s.cross(edge1);
-  double v = f * dir.dot(q);
+  v = f * dir.dot(q);
   if (v < 0.0 || u + v > 1.0)
     return std::nullopt;
   double t = f * edge2.dot(q);
-  if (t < 1e-4)
+  if (t < 1e-4 || !localRay.isInInterval(t))
     return std::nullopt;
-  Vector3D localIntersection = orig + dir * t;
-  Vector3D worldIntersection = _transform.applyToPoint(localIntersection);
-  Vector3D worldNormal = _transform.applyToNormal(_normal).normalized();
-  if (worldNormal.dot(ray.getDirection()) > 0)
-    worldNormal = -worldNormal;
-  Intersection intersection;
-  intersection.distance = (worldIntersection - ray.getOrigin()).getMagnitude();
-  intersection.point = worldIntersection;
-  intersection.normal = worldNormal;
-  intersection.color = _color;
-  intersection.primitive = this;
-  return intersection;
+  return t;
 }
 
 Vector3D Triangle::getNormalAt(const Vector3D&) const {
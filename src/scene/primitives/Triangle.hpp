@@ -19,6 +19,7 @@
 #include <memory>
 #include <optional>
 #include "../../../include/IPrimitive.hpp"
+#include "../../core/AABB.hpp"
 #include "../../core/Color.hpp"
 #include "../../core/Ray.hpp"
 #include "../../core/Transform.hpp"
@@ -32,13 +33,17 @@ class Triangle : public IPrimitive {
            const Color& color);
   ~Triangle() override = default;
 
-  std::optional<Intersection> intersect(const Ray& ray) const override;
+  std::optional<HitRecord> intersectHit(const Ray& ray) const override;
+  Intersection computeSurface(const Ray& ray,
+                              const HitRecord& hit) const override;
+  bool occluded(const Ray& ray, double tMax) const override;
   void setTransform(const Transform& transform) override;
   Transform getTransform() const override;
   void setColor(const Color& color) override;
   Color getColor() const override;
   Vector3D getNormalAt(const Vector3D& point) const override;
   std::shared_ptr<IPrimitive> clone() const override;
+  AABB worldBounds() const override;
 
   Vector3D getA() const;
   Vector3D getB() const;
@@ -49,7 +54,15 @@ class Triangle : public IPrimitive {
   Color _color;
   Transform _transform;
   Transform _inverseTransform;
-  Vector3D _normal;  // cached normal
+  Vector3D _normal;    // cached normal
+  AABB _worldBounds;  // cached world-space bounds
+
+  void updateWorldBounds();
+  // u and v receive the barycentric coordinates of the hit along (b - a)
+  // and (c - a)
+  std::optional<double> findClosestValidIntersectionT(const Ray& localRay,
+                                                      double& u,
+                                                      double& v) const;
 };
 
 }  // namespace RayTracer
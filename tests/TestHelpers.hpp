@@ -0,0 +1,135 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Helpers shared by the unit tests
+*/
+
+/**
+ * @file TestHelpers.hpp
+ * @brief Random rays, random boxes, a small scene and SIMD kernel lists
+ * shared by the acceleration, primitive and rendering unit tests
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#ifndef TEST_HELPERS_HPP_
+#define TEST_HELPERS_HPP_
+
+#include <memory>
+#include <random>
+#include <vector>
+#include "../src/core/AABB.hpp"
+#include "../src/core/Ray.hpp"
+#include "../src/core/Vector3D.hpp"
+#include "../src/scene/Camera.hpp"
+#include "../src/scene/Scene.hpp"
+#include "../src/scene/acceleration/SimdKernel.hpp"
+#include "../src/scene/lights/PointLight.hpp"
+#include "../src/scene/primitives/Sphere.hpp"
+
+namespace RayTracer {
+
+/**
+ * @brief Get the kernels the processor runs, the scalar one first
+ * @return Every kernel to check against the primitives
+ */
+inline std::vector<SimdKernel> supportedKernels() {
+  std::vector<SimdKernel> kernels;
+  for (auto kernel : {SimdKernel::SCALAR, SimdKernel::SSE2, SimdKernel::AVX}) {
+    if (supportsSimdKernel(kernel)) {
+      kernels.push_back(kernel);
+    }
+  }
+  return kernels;
+}
+
+/**
+ * @brief Make rays with random origins and directions
+ * @param seed Seed of the generator, the same seed gives the same rays
+ * @param count Number of rays
+ * @param extent Origins are drawn in [-extent, extent] on every axis
+ * @return The rays
+ */
+inline std::vector<Ray> makeRandomRays(unsigned seed, int count,
+                                       double extent = 15.0) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> position(-extent, extent);
+  std::uniform_real_distribution<double> direction(-1.0, 1.0);
+  std::vector<Ray> rays;
+  for (int i = 0; i < count; ++i) {
+    Vector3D dir(direction(rng), direction(rng), direction(rng));
+    if (dir.getMagnitude() < 1e-3) {
+      dir = Vector3D(0, 0, 1);
+    }
+    rays.emplace_back(Vector3D(position(rng), position(rng), position(rng)),
+                      dir);
+  }
+  return rays;
+}
+
+/**
+ * @brief Make random rays followed by one ray along each axis
+ * @param seed Seed of the generator, the same seed gives the same rays
+ * @param count Number of random rays
+ * @param extent Origins of the random rays are drawn in [-extent, extent],
+ * the axis-aligned rays start outside that cube
+ * @return The rays
+ */
+inline std::vector<Ray> makeTraversalRays(unsigned seed, int count,
+                                          double extent = 15.0) {
+  std::vector<Ray> rays = makeRandomRays(seed, count, extent);
+  // Axis-aligned directions exercise the infinite inverse direction path
+  double outside = extent + 5.0;
+  rays.emplace_back(Vector3D(0, 0, -outside), Vector3D(0, 0, 1));
+  rays.emplace_back(Vector3D(0.5, outside, 0.5), Vector3D(0, -1, 0));
+  rays.emplace_back(Vector3D(-outside, 1, 1), Vector3D(1, 0, 0));
+  return rays;
+}
+
+/**
+ * @brief Make axis-aligned boxes with random corners and sizes
+ * @param seed Seed of the generator, the same seed gives the same boxes
+ * @param count Number of boxes
+ * @param extent Lower corners are drawn in [-extent, extent] on every axis
+ * @param maxSize Edges are drawn in [0.01, maxSize]
+ * @return The boxes
+ */
+inline std::vector<AABB> makeRandomBoxes(unsigned seed, int count,
+                                         double extent = 100.0,
+                                         double maxSize = 2.0) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> position(-extent, extent);
+  std::uniform_real_distribution<double> size(0.01, maxSize);
+  std::vector<AABB> boxes;
+  boxes.reserve(count);
+  for (int i = 0; i < count; ++i) {
+    Vector3D corner(position(rng), position(rng), position(rng));
+    boxes.emplace_back(corner,
+                       corner + Vector3D(size(rng), size(rng), size(rng)));
+  }
+  return boxes;
+}
+
+/**
+ * @brief Make a finalized scene of five red spheres in a row, receding from
+ * the camera, lit from above
+ * @param width Width of the image in pixels
+ * @param height Height of the image in pixels
+ * @return The scene
+ */
+inline Scene makeSphereRowScene(int width, int height) {
+  Scene scene(Camera(Vector3D(0, 0, 0), width, height, 60.0));
+  for (int i = 0; i < 5; ++i) {
+    scene.addPrimitive(std::make_shared<Sphere>(
+        Vector3D(i * 1.5 - 3.0, 0, -8.0 - i), 1.0, Color::RED));
+  }
+  scene.addLight(std::make_shared<PointLight>(Vector3D(0, 10, 0)));
+  scene.finalize();
+  return scene;
+}
+
+}  // namespace RayTracer
+
+#endif /* !TEST_HELPERS_HPP_ */
@@ -0,0 +1,185 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Unit tests for AABB
+*/
+
+/**
+ * @file test_AABB.cpp
+ * @brief Unit tests for the AABB class and the primitive bounding boxes
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include "../src/core/AABB.hpp"
+#include "../src/core/Color.hpp"
+#include "../src/core/Ray.hpp"
+#include "../src/core/Transform.hpp"
+#include "../src/core/Vector3D.hpp"
+#include "../src/scene/primitives/Cylinder.hpp"
+#include "../src/scene/primitives/LimitedCone.hpp"
+#include "../src/scene/primitives/LimitedCylinder.hpp"
+#include "../src/scene/primitives/Plane.hpp"
+#include "../src/scene/primitives/Sphere.hpp"
+#include "../src/scene/primitives/Torus.hpp"
+#include "../src/scene/primitives/Triangle.hpp"
+
+using namespace RayTracer;
+
+// Helper function to compare Vector3D with tolerance
+static void expectVectorNear(const Vector3D& actual, const Vector3D& expected,
+                             double epsilon = 1e-9) {
+  EXPECT_NEAR(actual.getX(), expected.getX(), epsilon);
+  EXPECT_NEAR(actual.getY(), expected.getY(), epsilon);
+  EXPECT_NEAR(actual.getZ(), expected.getZ(), epsilon);
+}
+
+TEST(AABBTest, DefaultIsEmpty) {
+  AABB box;
+  EXPECT_TRUE(box.isEmpty());
+  EXPECT_FALSE(box.isBounded());
+  EXPECT_DOUBLE_EQ(box.surfaceArea(), 0.0);
+}
+
+TEST(AABBTest, ConstructorOrdersCorners) {
+  AABB box(Vector3D(1, -2, 3), Vector3D(-1, 2, -3));
+  expectVectorNear(box.getMin(), Vector3D(-1, -2, -3));
+  expectVectorNear(box.getMax(), Vector3D(1, 2, 3));
+}
+
+TEST(AABBTest, ExpandWithPointsAndBoxes) {
+  AABB box;
+  box.expand(Vector3D(1, 2, 3));
+  EXPECT_FALSE(box.isEmpty());
+  EXPECT_TRUE(box.isBounded());
+  expectVectorNear(box.getMin(), Vector3D(1, 2, 3));
+  expectVectorNear(box.getMax(), Vector3D(1, 2, 3));
+
+  box.expand(AABB(Vector3D(-1, 0, 0), Vector3D(0, 5, 1)));
+  expectVectorNear(box.getMin(), Vector3D(-1, 0, 0));
+  expectVectorNear(box.getMax(), Vector3D(1, 5, 3));
+
+  box.expand(AABB());
+  expectVectorNear(box.getMin(), Vector3D(-1, 0, 0));
+  expectVectorNear(box.getMax(), Vector3D(1, 5, 3));
+}
+
+TEST(AABBTest, MeasuresAndAxis) {
+  AABB box(Vector3D(0, 0, 0), Vector3D(1, 2, 3));
+  expectVectorNear(box.extent(), Vector3D(1, 2, 3));
+  expectVectorNear(box.centroid(), Vector3D(0.5, 1, 1.5));
+  EXPECT_DOUBLE_EQ(box.surfaceArea(), 2.0 * (2 + 6 + 3));
+  EXPECT_EQ(box.longestAxis(), 2);
+  EXPECT_EQ(AABB(Vector3D(0, 0, 0), Vector3D(4, 2, 3)).longestAxis(), 0);
+  EXPECT_EQ(AABB(Vector3D(0, 0, 0), Vector3D(1, 5, 3)).longestAxis(), 1);
+}
+
+TEST(AABBTest, UnboundedIsNotBounded) {
+  AABB box = AABB::unbounded();
+  EXPECT_FALSE(box.isEmpty());
+  EXPECT_FALSE(box.isBounded());
+  EXPECT_FALSE(box.transformed(Transform().translate(1, 2, 3)).isBounded());
+}
+
+TEST(AABBTest, TransformedRotatedBox) {
+  AABB box(Vector3D(-1, -1, -1), Vector3D(1, 1, 1));
+  Transform transform;
+  transform.rotateZ(45);
+  AABB result = box.transformed(transform);
+  double half = std::sqrt(2.0);
+  expectVectorNear(result.getMin(), Vector3D(-half, -half, -1), 1e-6);
+  expectVectorNear(result.getMax(), Vector3D(half, half, 1), 1e-6);
+}
+
+TEST(AABBTest, SlabTestHitsAndMisses) {
+  AABB box(Vector3D(-1, -1, -1), Vector3D(1, 1, 1));
+  EXPECT_TRUE(box.intersects(Ray(Vector3D(0, 0, -5), Vector3D(0, 0, 1))));
+  EXPECT_TRUE(box.intersects(Ray(Vector3D(-5, -5, -5), Vector3D(1, 1, 1))));
+  EXPECT_FALSE(box.intersects(Ray(Vector3D(0, 2, -5), Vector3D(0, 0, 1))));
+  EXPECT_FALSE(box.intersects(Ray(Vector3D(0, 0, -5), Vector3D(0, 0, -1))));
+  // Starting inside the box always hits
+  EXPECT_TRUE(box.intersects(Ray(Vector3D(0, 0, 0), Vector3D(1, 0, 0))));
+  // The box is farther than tMax
+  EXPECT_FALSE(box.intersects(Ray(Vector3D(0, 0, -5), Vector3D(0, 0, 1)), 3.0));
+  EXPECT_TRUE(box.intersects(Ray(Vector3D(0, 0, -5), Vector3D(0, 0, 1)), 4.5));
+}
+
+TEST(AABBTest, SlabTestOnFlatBox) {
+  // Zero thickness along Y, like an axis-aligned triangle
+  AABB box(Vector3D(-1, 0, -1), Vector3D(1, 0, 1));
+  EXPECT_TRUE(box.intersects(Ray(Vector3D(0.5, 3, 0.5), Vector3D(0, -1, 0))));
+  EXPECT_TRUE(box.intersects(Ray(Vector3D(1, 3, 1), Vector3D(0, -1, 0))));
+  EXPECT_FALSE(box.intersects(Ray(Vector3D(0, 3, 0), Vector3D(1, 0, 0))));
+}
+
+TEST(AABBTest, SphereBoundsFollowTransform) {
+  Sphere sphere(Vector3D(1, 0, 0), 2.0, Color::RED);
+  Transform transform;
+  transform.translate(0, 3, 0);
+  sphere.setTransform(transform);
+  AABB box = sphere.worldBounds();
+  expectVectorNear(box.getMin(), Vector3D(-1, 1, -2), 1e-6);
+  expectVectorNear(box.getMax(), Vector3D(3, 5, 2), 1e-6);
+}
+
+TEST(AABBTest, SphereBoundsAreTightUnderScaleAndRotation) {
+  Sphere sphere(Vector3D(0, 0, 0), 1.0, Color::RED);
+  Transform transform;
+  transform.scale(3, 1, 1).rotateZ(45);
+  sphere.setTransform(transform);
+  AABB box = sphere.worldBounds();
+  // Exact ellipsoid extent, smaller than the box of the rotated local cube
+  double half = std::sqrt(5.0);
+  expectVectorNear(box.getMin(), Vector3D(-half, -half, -1), 1e-6);
+  expectVectorNear(box.getMax(), Vector3D(half, half, 1), 1e-6);
+}
+
+TEST(AABBTest, SphereBoundsFollowGeometryChanges) {
+  Sphere sphere(Vector3D(0, 0, 0), 1.0, Color::RED);
+  sphere.setCenter(Vector3D(10, 0, 0));
+  sphere.setRadius(2.0);
+  AABB box = sphere.worldBounds();
+  expectVectorNear(box.getMin(), Vector3D(8, -2, -2), 1e-6);
+  expectVectorNear(box.getMax(), Vector3D(12, 2, 2), 1e-6);
+  Ray hitting(Vector3D(10, 0, -10), Vector3D(0, 0, 1));
+  Ray missing(Vector3D(0, 0, -10), Vector3D(0, 0, 1));
+  EXPECT_TRUE(sphere.intersect(hitting).has_value());
+  EXPECT_FALSE(sphere.intersect(missing).has_value());
+}
+
+TEST(AABBTest, BoundedPrimitivesReportTightBounds) {
+  Torus torus(2.0, 0.5, Color::RED);
+  AABB torusBox = torus.worldBounds();
+  expectVectorNear(torusBox.getMin(), Vector3D(-2.5, -0.5, -2.5), 1e-6);
+  expectVectorNear(torusBox.getMax(), Vector3D(2.5, 0.5, 2.5), 1e-6);
+
+  LimitedCylinder cylinder(1.0, 4.0, Color::RED);
+  AABB cylinderBox = cylinder.worldBounds();
+  expectVectorNear(cylinderBox.getMin(), Vector3D(-1, -2, -1), 1e-5);
+  expectVectorNear(cylinderBox.getMax(), Vector3D(1, 2, 1), 1e-5);
+
+  LimitedCone cone(Vector3D(0, 0, 0), Vector3D(0, 1, 0), 45.0, Color::RED,
+                   2.0);
+  AABB coneBox = cone.worldBounds();
+  expectVectorNear(coneBox.getMin(), Vector3D(-2, 0, -2), 1e-5);
+  expectVectorNear(coneBox.getMax(), Vector3D(2, 2, 2), 1e-5);
+
+  Triangle triangle(Vector3D(0, 0, 0), Vector3D(1, 0, 0), Vector3D(0, 2, 1),
+                    Color::RED);
+  AABB triangleBox = triangle.worldBounds();
+  expectVectorNear(triangleBox.getMin(), Vector3D(0, 0, 0), 1e-6);
+  expectVectorNear(triangleBox.getMax(), Vector3D(1, 2, 1), 1e-6);
+}
+
+TEST(AABBTest, InfinitePrimitivesAreUnbounded) {
+  Plane plane('Y', 0.0, Color::RED);
+  EXPECT_FALSE(plane.worldBounds().isBounded());
+  EXPECT_FALSE(plane.worldBounds().isEmpty());
+
+  Cylinder cylinder(1.0, Color::RED);
+  EXPECT_FALSE(cylinder.worldBounds().isBounded());
+}
@@ -0,0 +1,898 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Unit tests for BVH
+*/
+
+/**
+ * @file test_BVH.cpp
+ * @brief Unit tests for the bounding volume hierarchy and the accelerated
+ * scene queries
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <vector>
+#include "../src/core/AABB.hpp"
+#include "../src/core/Color.hpp"
+#include "../src/core/Ray.hpp"
+#include "../src/core/ThreadPool.hpp"
+#include "../src/core/Vector3D.hpp"
+#include "../src/scene/Scene.hpp"
+#include "../src/scene/acceleration/Accelerator.hpp"
+#include "../src/scene/acceleration/BVH.hpp"
+#include "../src/scene/acceleration/BVH4.hpp"
+#include "../src/scene/lights/PointLight.hpp"
+#include "../src/scene/primitives/CheckerboardPlane.hpp"
+#include "../src/scene/primitives/Cone.hpp"
+#include "../src/scene/primitives/Cylinder.hpp"
+#include "../src/scene/primitives/LimitedCone.hpp"
+#include "../src/scene/primitives/LimitedCylinder.hpp"
+#include "../src/scene/primitives/Plane.hpp"
+#include "../src/scene/primitives/Sphere.hpp"
+#include "../src/scene/primitives/Torus.hpp"
+#include "../src/scene/primitives/Triangle.hpp"
+#include "TestHelpers.hpp"
+
+using namespace RayTracer;
+
+namespace {
+
+/**
+ * @brief Build a scene mixing many bounded primitives and a ground plane
+ */
+Scene makeRandomScene(unsigned seed, int count) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> position(-10.0, 10.0);
+  std::uniform_real_distribution<double> size(0.2, 1.5);
+
+  Scene scene;
+  scene.addPrimitive(std::make_shared<Plane>('Y', -12.0, Color::GRAY));
+  for (int i = 0; i < count; ++i) {
+    Vector3D center(position(rng), position(rng), position(rng));
+    if (i % 3 == 0) {
+      scene.addPrimitive(
+          std::make_shared<Sphere>(center, size(rng), Color::RED));
+    } else if (i % 3 == 1) {
+      scene.addPrimitive(std::make_shared<Triangle>(
+          center, center + Vector3D(size(rng), 0, 0),
+          center + Vector3D(0, size(rng), size(rng)), Color::GREEN));
+    } else {
+      auto cylinder =
+          std::make_shared<LimitedCylinder>(size(rng), size(rng), Color::BLUE);
+      Transform transform;
+      transform.translate(center.getX(), center.getY(), center.getZ());
+      transform.rotateX(position(rng) * 9.0);
+      cylinder->setTransform(transform);
+      scene.addPrimitive(cylinder);
+    }
+  }
+  return scene;
+}
+
+/**
+ * @brief Sphere counting how many hits get their surface data computed
+ */
+class CountingSphere : public Sphere {
+ public:
+  CountingSphere(const Vector3D& center, double radius, int& counter)
+      : Sphere(center, radius, Color::RED), _counter(counter) {}
+
+  Intersection computeSurface(const Ray& ray,
+                              const HitRecord& hit) const override {
+    ++_counter;
+    return Sphere::computeSurface(ray, hit);
+  }
+
+ private:
+  int& _counter;
+};
+
+}  // namespace
+
+TEST(BVHTest, EmptyBuild) {
+  BVH bvh;
+  bvh.build({});
+  EXPECT_TRUE(bvh.isEmpty());
+  double tMax = 100.0;
+  bool visited = false;
+  EXPECT_FALSE(bvh.traverse(Ray(Vector3D(0, 0, 0), Vector3D(0, 0, 1)), tMax,
+                            [&](std::size_t, double&) {
+                              visited = true;
+                              return false;
+                            }));
+  EXPECT_FALSE(visited);
+}
+
+TEST(BVHTest, RootBoundsCoverItems) {
+  std::vector<AABB> boxes = {
+      AABB(Vector3D(0, 0, 0), Vector3D(1, 1, 1)),
+      AABB(Vector3D(5, -2, 0), Vector3D(6, -1, 3)),
+      AABB(Vector3D(-4, 0, 2), Vector3D(-3, 8, 4)),
+  };
+  BVH bvh;
+  bvh.build(boxes);
+  AABB root = bvh.getBounds();
+  EXPECT_DOUBLE_EQ(root.getMin().getX(), -4);
+  EXPECT_DOUBLE_EQ(root.getMin().getY(), -2);
+  EXPECT_DOUBLE_EQ(root.getMin().getZ(), 0);
+  EXPECT_DOUBLE_EQ(root.getMax().getX(), 6);
+  EXPECT_DOUBLE_EQ(root.getMax().getY(), 8);
+  EXPECT_DOUBLE_EQ(root.getMax().getZ(), 4);
+}
+
+TEST(BVHTest, VisitsEveryItemAlongTheRay) {
+  std::vector<AABB> boxes;
+  for (int i = 0; i < 100; ++i) {
+    boxes.emplace_back(Vector3D(i * 2.0, -0.5, -0.5),
+                       Vector3D(i * 2.0 + 1.0, 0.5, 0.5));
+  }
+  BVH bvh;
+  bvh.build(boxes);
+  EXPECT_GT(bvh.getNodeCount(), 1u);
+
+  std::vector<bool> seen(boxes.size(), false);
+  double tMax = std::numeric_limits<double>::infinity();
+  bvh.traverse(Ray(Vector3D(-1, 0, 0), Vector3D(1, 0, 0)), tMax,
+               [&](std::size_t item, double&) {
+                 seen[item] = true;
+                 return false;
+               });
+  for (std::size_t i = 0; i < seen.size(); ++i) {
+    EXPECT_TRUE(seen[i]) << "item " << i;
+  }
+
+  // A ray passing above every box visits nothing
+  tMax = std::numeric_limits<double>::infinity();
+  bool visited = false;
+  bvh.traverse(Ray(Vector3D(-1, 2, 0), Vector3D(1, 0, 0)), tMax,
+               [&](std::size_t, double&) {
+                 visited = true;
+                 return false;
+               });
+  EXPECT_FALSE(visited);
+}
+
+TEST(BVHTest, CoincidentCentroidsStayInOneLeaf) {
+  std::vector<AABB> boxes(10, AABB(Vector3D(-1, -1, -1), Vector3D(1, 1, 1)));
+  BVH bvh;
+  bvh.build(boxes);
+  EXPECT_EQ(bvh.getNodeCount(), 1u);
+}
+
+TEST(BVHTest, ParallelBuildMatchesSerialBuild) {
+  // Large enough for parallel binning of the top nodes and many tasks
+  std::vector<AABB> boxes = makeRandomBoxes(5, 40000);
+  BVH serial;
+  serial.build(boxes);
+  ThreadPool pool(4);
+  BVH parallel;
+  parallel.build(boxes, &pool);
+  EXPECT_GT(parallel.getBuildStats().taskCount, 1u);
+  EXPECT_EQ(serial.getBuildStats().taskCount, 0u);
+
+  const auto& expected = serial.getNodes();
+  const auto& actual = parallel.getNodes();
+  ASSERT_EQ(expected.size(), actual.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    for (int axis = 0; axis < 3; ++axis) {
+      ASSERT_EQ(expected[i].min[axis], actual[i].min[axis]) << "node " << i;
+      ASSERT_EQ(expected[i].max[axis], actual[i].max[axis]) << "node " << i;
+    }
+    ASSERT_EQ(expected[i].offset, actual[i].offset) << "node " << i;
+    ASSERT_EQ(expected[i].count, actual[i].count) << "node " << i;
+    ASSERT_EQ(expected[i].axis, actual[i].axis) << "node " << i;
+  }
+
+  for (const auto& ray : makeTraversalRays(11, 200)) {
+    std::vector<std::size_t> serialItems;
+    std::vector<std::size_t> parallelItems;
+    double tMax = std::numeric_limits<double>::infinity();
+    serial.traverse(ray, tMax, [&](std::size_t item, double&) {
+      serialItems.push_back(item);
+      return false;
+    });
+    tMax = std::numeric_limits<double>::infinity();
+    parallel.traverse(ray, tMax, [&](std::size_t item, double&) {
+      parallelItems.push_back(item);
+      return false;
+    });
+    EXPECT_EQ(serialItems, parallelItems);
+  }
+}
+
+TEST(BVHTest, BuildStatsDescribeTheTree) {
+  BVH bvh;
+  bvh.build(makeRandomBoxes(3, 1000));
+  const BVH::BuildStats& stats = bvh.getBuildStats();
+  EXPECT_EQ(stats.itemCount, 1000u);
+  EXPECT_EQ(stats.nodeCount, bvh.getNodeCount());
+  // Every interior node has two children
+  EXPECT_EQ(stats.nodeCount, 2 * stats.leafCount - 1);
+  EXPECT_GT(stats.maxDepth, 0u);
+  EXPECT_LE(stats.maxLeafSize, BVH::MAX_LEAF_SIZE);
+  EXPECT_GT(stats.sahCost, 0.0);
+  EXPECT_GE(stats.buildMilliseconds, 0.0);
+
+  bvh.clear();
+  EXPECT_EQ(bvh.getBuildStats().nodeCount, 0u);
+}
+
+TEST(BVHTest, RefitFollowsMovedItems) {
+  std::vector<AABB> boxes = makeRandomBoxes(8, 2000);
+  BVH bvh;
+  bvh.build(boxes);
+  std::size_t nodeCount = bvh.getNodeCount();
+  double builtCost = bvh.getBuildStats().sahCost;
+
+  std::mt19937 rng(21);
+  std::uniform_real_distribution<double> offset(-3.0, 3.0);
+  for (auto& box : boxes) {
+    Vector3D move(offset(rng), offset(rng), offset(rng));
+    box = AABB(box.getMin() + move, box.getMax() + move);
+  }
+  bvh.refit(boxes);
+  EXPECT_EQ(bvh.getNodeCount(), nodeCount);
+  EXPECT_EQ(bvh.getBuildStats().refitCount, 1u);
+  EXPECT_GT(bvh.getBuildStats().sahCost, builtCost * 0.9);
+
+  AABB all;
+  for (const auto& box : boxes) {
+    all.expand(box);
+  }
+  AABB root = bvh.getBounds();
+  EXPECT_DOUBLE_EQ(root.getMin().getX(), all.getMin().getX());
+  EXPECT_DOUBLE_EQ(root.getMax().getZ(), all.getMax().getZ());
+
+  // Every box hit at its new place is still reached
+  for (const auto& ray : makeTraversalRays(13, 300)) {
+    std::vector<bool> visited(boxes.size(), false);
+    double tMax = std::numeric_limits<double>::infinity();
+    bvh.traverse(ray, tMax, [&](std::size_t item, double&) {
+      visited[item] = true;
+      return false;
+    });
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+      if (boxes[i].intersects(ray)) {
+        ASSERT_TRUE(visited[i]) << "item " << i;
+      }
+    }
+  }
+
+  boxes.pop_back();
+  EXPECT_THROW(bvh.refit(boxes), std::invalid_argument);
+}
+
+TEST(BVHTest, SceneTraceMatchesLinearScan) {
+  Scene linear = makeRandomScene(42, 300);
+  Scene accelerated = linear;
+  accelerated.finalize();
+  ASSERT_FALSE(linear.isFinalized());
+  ASSERT_TRUE(accelerated.isFinalized());
+
+  for (const auto& ray : makeTraversalRays(7, 2000)) {
+    auto expected = linear.traceRay(ray);
+    auto actual = accelerated.traceRay(ray);
+    ASSERT_EQ(expected.has_value(), actual.has_value());
+    if (expected) {
+      EXPECT_DOUBLE_EQ(expected->distance, actual->distance);
+      EXPECT_EQ(expected->color, actual->color);
+    }
+  }
+}
+
+TEST(BVHTest, PacketVisitsWhatSingleRaysVisit) {
+  std::vector<AABB> boxes = makeRandomBoxes(4, 3000);
+  BVH bvh;
+  bvh.build(boxes);
+
+  // A coherent fan, then the incoherent random rays
+  std::vector<Ray> rays;
+  for (int y = 0; y < 8; ++y) {
+    for (int x = 0; x < 32; ++x) {
+      rays.emplace_back(Vector3D(0, 0, -150),
+                        Vector3D(x * 4.0 - 64, y * 4.0 - 16, 150));
+    }
+  }
+  for (const auto& ray : makeTraversalRays(5, 200)) {
+    rays.push_back(ray);
+  }
+
+  for (std::size_t packetSize : {1, 3, 4, 8, 16}) {
+    for (std::size_t begin = 0; begin < rays.size(); begin += packetSize) {
+      std::size_t count = std::min(packetSize, rays.size() - begin);
+      std::vector<std::vector<bool>> visited(
+          count, std::vector<bool>(boxes.size(), false));
+      std::vector<double> tMax(count,
+                               std::numeric_limits<double>::infinity());
+      bvh.traversePacket(rays.data() + begin, count, tMax.data(),
+                         [&](std::size_t item, std::size_t ray, double&) {
+                           visited[ray][item] = true;
+                           return false;
+                         });
+      for (std::size_t r = 0; r < count; ++r) {
+        for (std::size_t i = 0; i < boxes.size(); ++i) {
+          if (boxes[i].intersects(rays[begin + r])) {
+            ASSERT_TRUE(visited[r][i])
+                << "packet of " << packetSize << ", ray " << begin + r
+                << ", item " << i;
+          }
+        }
+      }
+    }
+  }
+
+  // Retired rays are no longer visited
+  std::vector<double> tMax(16, std::numeric_limits<double>::infinity());
+  std::vector<int> visits(16, 0);
+  bvh.traversePacket(rays.data(), 16, tMax.data(),
+                     [&](std::size_t, std::size_t ray, double&) {
+                       visits[ray]++;
+                       return true;
+                     });
+  for (int count : visits) {
+    EXPECT_LE(count, 1);
+  }
+
+  EXPECT_THROW(bvh.traversePacket(rays.data(), BVH::MAX_PACKET_SIZE + 1,
+                                  tMax.data(),
+                                  [](std::size_t, std::size_t, double&) {
+                                    return false;
+                                  }),
+               std::invalid_argument);
+}
+
+TEST(BVHTest, ScenePacketsMatchSingleRays) {
+  Scene linear = makeRandomScene(42, 300);
+  std::vector<Ray> rays;
+  for (int y = 0; y < 16; ++y) {
+    for (int x = 0; x < 64; ++x) {
+      rays.emplace_back(Vector3D(0, 0, -30),
+                        Vector3D(x * 0.5 - 16, y * 0.5 - 4, 30));
+    }
+  }
+  for (const auto& ray : makeTraversalRays(7, 500)) {
+    rays.push_back(ray);
+  }
+
+  for (AcceleratorType type : {AcceleratorType::BVH, AcceleratorType::BVH4,
+                                AcceleratorType::GRID}) {
+    Scene scene = linear;
+    scene.setAccelerator(type);
+    scene.finalize();
+    std::vector<std::optional<Intersection>> hits;
+    scene.traceRays(rays, hits);
+    ASSERT_EQ(hits.size(), rays.size());
+    for (std::size_t i = 0; i < rays.size(); ++i) {
+      auto expected = linear.traceRay(rays[i]);
+      ASSERT_EQ(expected.has_value(), hits[i].has_value()) << "ray " << i;
+      if (expected) {
+        EXPECT_DOUBLE_EQ(expected->distance, hits[i]->distance);
+        EXPECT_EQ(expected->color, hits[i]->color);
+      }
+    }
+  }
+}
+
+TEST(BVHTest, SceneShadowsMatchLinearScan) {
+  Scene linear = makeRandomScene(1234, 200);
+  Scene accelerated = linear;
+  accelerated.finalize();
+  auto light = std::make_shared<PointLight>(Vector3D(0, 30, 0));
+
+  for (const auto& ray : makeTraversalRays(99, 1000)) {
+    auto hit = linear.traceRay(ray);
+    if (!hit) {
+      continue;
+    }
+    EXPECT_EQ(linear.isInShadow(hit->point, light),
+              accelerated.isInShadow(hit->point, light));
+  }
+}
+
+TEST(BVHTest, SceneInvalidatesOnChange) {
+  Scene scene;
+  scene.addPrimitive(
+      std::make_shared<Sphere>(Vector3D(0, 0, 5), 1.0, Color::RED));
+  scene.finalize();
+  EXPECT_TRUE(scene.isFinalized());
+
+  scene.addPrimitive(
+      std::make_shared<Sphere>(Vector3D(0, 0, 2), 0.5, Color::BLUE));
+  EXPECT_FALSE(scene.isFinalized());
+
+  // The new sphere is still found through the linear fallback
+  auto hit = scene.traceRay(Ray(Vector3D(0, 0, 0), Vector3D(0, 0, 1)));
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_NEAR(hit->distance, 1.5, 1e-6);
+
+  scene.finalize();
+  Scene copy(scene);
+  EXPECT_TRUE(copy.isFinalized());
+  hit = copy.traceRay(Ray(Vector3D(0, 0, 0), Vector3D(0, 0, 1)));
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_NEAR(hit->distance, 1.5, 1e-6);
+}
+
+TEST(BVHTest, TorusInsideHierarchy) {
+  Scene scene;
+  scene.addPrimitive(std::make_shared<Torus>(2.0, 0.5, Color::RED));
+  scene.finalize();
+  auto hit = scene.traceRay(Ray(Vector3D(2, 10, 0), Vector3D(0, -1, 0)));
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_NEAR(hit->distance, 9.5, 1e-2);
+}
+
+TEST(BVH4Test, EmptyBuild) {
+  BVH4 bvh;
+  bvh.build(std::vector<AABB>{});
+  EXPECT_TRUE(bvh.isEmpty());
+  EXPECT_EQ(bvh.getBuildStats().nodeCount, 0u);
+  double tMax = 100.0;
+  EXPECT_FALSE(bvh.traverse(Ray(Vector3D(0, 0, 0), Vector3D(0, 0, 1)), tMax,
+                            [](std::size_t, double&) { return true; }));
+}
+
+TEST(BVH4Test, CollapsesTheBinaryTree) {
+  EXPECT_EQ(sizeof(BVH4::Node), 64u);
+  BVH binary;
+  binary.build(makeRandomBoxes(3, 1000));
+  BVH4 wide;
+  wide.build(binary);
+
+  const BVH::BuildStats& stats = wide.getBuildStats();
+  EXPECT_EQ(stats.itemCount, 1000u);
+  EXPECT_EQ(stats.nodeCount, wide.getNodeCount());
+  // Same leaves, less than half of the interior nodes
+  EXPECT_EQ(stats.leafCount, binary.getBuildStats().leafCount);
+  EXPECT_LT(2 * wide.getNodeCount(),
+            binary.getNodeCount() - binary.getBuildStats().leafCount);
+  EXPECT_LT(stats.maxDepth, binary.getBuildStats().maxDepth);
+  EXPECT_GT(stats.sahCost, 0.0);
+
+  // A single leaf becomes a root with one child
+  BVH4 single;
+  single.build({AABB(Vector3D(0, 0, 0), Vector3D(1, 1, 1))});
+  ASSERT_EQ(single.getNodeCount(), 1u);
+  EXPECT_EQ(single.getNodes()[0].childCount, 1);
+  double tMax = std::numeric_limits<double>::infinity();
+  bool visited = false;
+  single.traverse(Ray(Vector3D(0.5, 0.5, -5), Vector3D(0, 0, 1)), tMax,
+                  [&](std::size_t item, double&) {
+                    visited = item == 0;
+                    return false;
+                  });
+  EXPECT_TRUE(visited);
+}
+
+TEST(BVH4Test, VisitsEveryItemTheBinaryTreeVisits) {
+  std::vector<AABB> boxes = makeRandomBoxes(5, 5000);
+  // Tiny boxes far from the origin stress the quantization precision
+  for (int i = 0; i < 64; ++i) {
+    Vector3D corner(10000.0 + i * 0.01, -5000.0, 20000.0);
+    boxes.emplace_back(corner, corner + Vector3D(0.001, 0.001, 0.001));
+  }
+  BVH binary;
+  binary.build(boxes);
+  BVH4 wide;
+  wide.build(binary);
+
+  std::vector<Ray> rays = makeTraversalRays(11, 500);
+  for (int i = 0; i < 64; ++i) {
+    rays.emplace_back(Vector3D(10000.0005 + i * 0.01, -5000.0005, 0.0),
+                      Vector3D(0, 0, 1));
+  }
+  for (const auto& ray : rays) {
+    std::vector<bool> expected(boxes.size(), false);
+    std::vector<bool> actual(boxes.size(), false);
+    double tMax = std::numeric_limits<double>::infinity();
+    binary.traverse(ray, tMax, [&](std::size_t item, double&) {
+      expected[item] = true;
+      return false;
+    });
+    tMax = std::numeric_limits<double>::infinity();
+    wide.traverse(ray, tMax, [&](std::size_t item, double&) {
+      actual[item] = true;
+      return false;
+    });
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+      if (expected[i]) {
+        ASSERT_TRUE(actual[i]) << "item " << i;
+      }
+    }
+  }
+}
+
+TEST(BVH4Test, PacketVisitsWhatSingleRaysVisit) {
+  std::vector<AABB> boxes = makeRandomBoxes(4, 3000);
+  BVH binary;
+  binary.build(boxes);
+  BVH4 wide;
+  wide.build(binary);
+
+  std::vector<Ray> rays;
+  for (int y = 0; y < 8; ++y) {
+    for (int x = 0; x < 32; ++x) {
+      rays.emplace_back(Vector3D(0, 0, -150),
+                        Vector3D(x * 4.0 - 64, y * 4.0 - 16, 150));
+    }
+  }
+  for (const auto& ray : makeTraversalRays(5, 200)) {
+    rays.push_back(ray);
+  }
+
+  for (std::size_t packetSize : {1, 3, 16}) {
+    for (std::size_t begin = 0; begin < rays.size(); begin += packetSize) {
+      std::size_t count = std::min(packetSize, rays.size() - begin);
+      std::vector<std::vector<bool>> visited(
+          count, std::vector<bool>(boxes.size(), false));
+      std::vector<double> tMax(count,
+                               std::numeric_limits<double>::infinity());
+      wide.traversePacket(rays.data() + begin, count, tMax.data(),
+                          [&](std::size_t item, std::size_t ray, double&) {
+                            visited[ray][item] = true;
+                            return false;
+                          });
+      for (std::size_t r = 0; r < count; ++r) {
+        double rayTMax = std::numeric_limits<double>::infinity();
+        wide.traverse(rays[begin + r], rayTMax,
+                      [&](std::size_t item, double&) {
+                        EXPECT_TRUE(visited[r][item])
+                            << "packet of " << packetSize << ", ray "
+                            << begin + r << ", item " << item;
+                        return false;
+                      });
+      }
+    }
+  }
+
+  // Retired rays are no longer visited
+  std::vector<double> tMax(16, std::numeric_limits<double>::infinity());
+  std::vector<int> visits(16, 0);
+  wide.traversePacket(rays.data(), 16, tMax.data(),
+                      [&](std::size_t, std::size_t ray, double&) {
+                        visits[ray]++;
+                        return true;
+                      });
+  for (int count : visits) {
+    EXPECT_LE(count, 1);
+  }
+
+  EXPECT_THROW(wide.traversePacket(rays.data(), BVH::MAX_PACKET_SIZE + 1,
+                                   tMax.data(),
+                                   [](std::size_t, std::size_t, double&) {
+                                     return false;
+                                   }),
+               std::invalid_argument);
+}
+
+TEST(BVH4Test, SceneMatchesBinaryHierarchy) {
+  Scene binary = makeRandomScene(42, 300);
+  Scene wide = binary;
+  binary.finalize();
+  wide.setAccelerator(AcceleratorType::BVH4);
+  wide.finalize();
+  EXPECT_EQ(wide.getAccelerator(), AcceleratorType::BVH4);
+  EXPECT_EQ(wide.getAccelerationStats().itemCount, 300u);
+  auto light = std::make_shared<PointLight>(Vector3D(0, 30, 0));
+
+  for (const auto& ray : makeTraversalRays(7, 2000)) {
+    auto expected = binary.traceRay(ray);
+    auto actual = wide.traceRay(ray);
+    ASSERT_EQ(expected.has_value(), actual.has_value());
+    if (expected) {
+      EXPECT_DOUBLE_EQ(expected->distance, actual->distance);
+      EXPECT_EQ(expected->color, actual->color);
+      EXPECT_EQ(binary.isInShadow(expected->point, light),
+                wide.isInShadow(expected->point, light));
+    }
+  }
+
+  // Changing the accelerator drops the current one
+  wide.setAccelerator(AcceleratorType::BVH);
+  EXPECT_FALSE(wide.isFinalized());
+}
+
+TEST(BVH4Test, RefitFollowsMovedItems) {
+  std::vector<AABB> boxes = makeRandomBoxes(8, 2000);
+  BVH4 bvh;
+  bvh.build(boxes);
+  std::size_t nodeCount = bvh.getNodeCount();
+
+  std::mt19937 rng(21);
+  std::uniform_real_distribution<double> offset(-3.0, 3.0);
+  for (auto& box : boxes) {
+    Vector3D move(offset(rng), offset(rng), offset(rng));
+    box = AABB(box.getMin() + move, box.getMax() + move);
+  }
+  bvh.refit(boxes);
+  EXPECT_EQ(bvh.getNodeCount(), nodeCount);
+  EXPECT_EQ(bvh.getBuildStats().refitCount, 1u);
+
+  for (const auto& ray : makeTraversalRays(13, 300)) {
+    std::vector<bool> visited(boxes.size(), false);
+    double tMax = std::numeric_limits<double>::infinity();
+    bvh.traverse(ray, tMax, [&](std::size_t item, double&) {
+      visited[item] = true;
+      return false;
+    });
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+      if (boxes[i].intersects(ray)) {
+        ASSERT_TRUE(visited[i]) << "item " << i;
+      }
+    }
+  }
+}
+
+TEST(SceneRefitTest, FollowsTransformsAndRebuildsWhenDegraded) {
+  for (AcceleratorType type : {AcceleratorType::BVH, AcceleratorType::BVH4}) {
+    Scene scene;
+    scene.setAccelerator(type);
+    std::vector<std::shared_ptr<Sphere>> spheres;
+    for (int i = 0; i < 100; ++i) {
+      auto sphere =
+          std::make_shared<Sphere>(Vector3D(0, 0, 0), 0.4, Color::RED);
+      Transform transform;
+      transform.translate((i % 10) * 2.0, (i / 10) * 2.0, 0);
+      sphere->setTransform(transform);
+      spheres.push_back(sphere);
+      scene.addPrimitive(sphere);
+    }
+    // Not finalized yet: refit builds
+    EXPECT_FALSE(scene.refit());
+    EXPECT_TRUE(scene.isFinalized());
+
+    // A small motion keeps the tree
+    Transform moved;
+    moved.translate(0.5, 0, 0);
+    spheres[0]->setTransform(moved);
+    EXPECT_TRUE(scene.refit());
+    EXPECT_EQ(scene.getAccelerationStats().refitCount, 1u);
+    auto hit = scene.traceRay(Ray(Vector3D(0.5, 0, -10), Vector3D(0, 0, 1)));
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_NEAR(hit->distance, 9.6, 1e-9);
+    EXPECT_FALSE(
+        scene.traceRay(Ray(Vector3D(-0.3, 0, -10), Vector3D(0, 0, 1))));
+
+    // Shuffling every sphere across the grid ruins the tree: rebuild
+    std::mt19937 rng(3);
+    std::vector<int> order(spheres.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), rng);
+    for (std::size_t i = 0; i < spheres.size(); ++i) {
+      Transform transform;
+      transform.translate((order[i] % 10) * 2.0, (order[i] / 10) * 2.0, 0);
+      spheres[i]->setTransform(transform);
+    }
+    EXPECT_FALSE(scene.refit());
+    EXPECT_EQ(scene.getAccelerationStats().refitCount, 0u);
+    hit = scene.traceRay(Ray(Vector3D(18, 18, -10), Vector3D(0, 0, 1)));
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_NEAR(hit->distance, 9.6, 1e-9);
+  }
+}
+
+TEST(BVH4Test, AcceleratorNames) {
+  EXPECT_EQ(parseAcceleratorType("bvh"), AcceleratorType::BVH);
+  EXPECT_EQ(parseAcceleratorType("bvh4"), AcceleratorType::BVH4);
+  EXPECT_EQ(acceleratorTypeName(AcceleratorType::BVH4), "bvh4");
+  EXPECT_THROW(parseAcceleratorType("kdtree"), std::invalid_argument);
+}
+
+TEST(OcclusionTest, PrimitivesAgreeWithIntersect) {
+  // Non-uniform scales make local parameters differ from normalized ones,
+  // which occluded() must still compare against world distances
+  Transform scaled;
+  scaled.scale(2.0, 0.5, 1.5).rotateY(30).translate(0.5, -0.5, 1.0);
+
+  std::vector<std::shared_ptr<IPrimitive>> primitives = {
+      std::make_shared<Sphere>(Vector3D(0, 0, 0), 2.0, Color::RED),
+      std::make_shared<Plane>('Y', -1.0, Color::RED),
+      std::make_shared<Cylinder>(1.0, Color::RED),
+      std::make_shared<Cone>(Vector3D(0, 2, 0), Vector3D(0, -1, 0), 30.0,
+                             Color::RED),
+      std::make_shared<LimitedCylinder>(1.0, 3.0, Color::RED),
+      std::make_shared<LimitedCone>(Vector3D(0, 2, 0), Vector3D(0, -1, 0), 30.0,
+                                    Color::RED, 3.0),
+      std::make_shared<Triangle>(Vector3D(-2, -1, 0), Vector3D(2, -1, 0),
+                                 Vector3D(0, 2, 0), Color::RED),
+      std::make_shared<Torus>(2.0, 0.5, Color::RED),
+  };
+
+  std::mt19937 rng(5);
+  std::uniform_real_distribution<double> limit(0.5, 12.0);
+  for (bool transformed : {false, true}) {
+    for (const auto& primitive : primitives) {
+      if (transformed) {
+        primitive->setTransform(scaled);
+      }
+      for (const auto& ray : makeTraversalRays(11, 300)) {
+        double tMax = limit(rng);
+        auto hit = primitive->intersect(ray);
+        bool expected = hit && hit->distance > 0 && hit->distance < tMax;
+        // Skip grazing cases where rounding decides the comparison
+        if (hit && std::abs(hit->distance - tMax) < 1e-6) {
+          continue;
+        }
+        EXPECT_EQ(primitive->occluded(ray, tMax), expected);
+      }
+    }
+  }
+}
+
+TEST(RayIntervalTest, PrimitivesClipAndShrinkTheInterval) {
+  std::vector<std::shared_ptr<IPrimitive>> primitives = {
+      std::make_shared<Sphere>(Vector3D(0, 0, 0), 2.0, Color::RED),
+      std::make_shared<Plane>('Y', -1.0, Color::RED),
+      std::make_shared<Cylinder>(1.0, Color::RED),
+      std::make_shared<Cone>(Vector3D(0, 2, 0), Vector3D(0, -1, 0), 30.0,
+                             Color::RED),
+      std::make_shared<LimitedCylinder>(1.0, 3.0, Color::RED),
+      std::make_shared<LimitedCone>(Vector3D(0, 2, 0), Vector3D(0, -1, 0), 30.0,
+                                    Color::RED, 3.0),
+      std::make_shared<Triangle>(Vector3D(-2, -1, 0), Vector3D(2, -1, 0),
+                                 Vector3D(0, 2, 0), Color::RED),
+      std::make_shared<Torus>(2.0, 0.5, Color::RED),
+  };
+
+  for (const auto& primitive : primitives) {
+    for (const auto& ray : makeTraversalRays(21, 200)) {
+      Ray first(ray);
+      auto hit = primitive->intersect(first);
+      if (!hit) {
+        continue;
+      }
+      EXPECT_DOUBLE_EQ(first.getTMax(), hit->distance);
+      // The distance is the ray parameter of the hit point
+      Vector3D expectedPoint = ray.pointAt(hit->distance);
+      EXPECT_NEAR((hit->point - expectedPoint).getMagnitude(), 0.0, 1e-6);
+
+      // The bound is inclusive: the same hit is found again
+      auto again = primitive->intersect(first);
+      ASSERT_TRUE(again.has_value());
+      EXPECT_DOUBLE_EQ(again->distance, hit->distance);
+
+      Ray clipped(ray);
+      clipped.setInterval(0.0, hit->distance * 0.999);
+      EXPECT_FALSE(primitive->intersect(clipped).has_value());
+      EXPECT_TRUE(std::isinf(ray.getTMax()));
+
+      // Skipping the closest hit can only reveal a farther one
+      Ray skipped(ray);
+      skipped.setInterval(hit->distance * 1.001 + 1e-3, 1e9);
+      auto farther = primitive->intersect(skipped);
+      if (farther) {
+        EXPECT_GT(farther->distance, hit->distance);
+      }
+    }
+  }
+}
+
+TEST(RayIntervalTest, SceneTraceHonoursInterval) {
+  Scene scene;
+  scene.addPrimitive(
+      std::make_shared<Sphere>(Vector3D(0, 0, 5), 1.0, Color::RED));
+  scene.addPrimitive(
+      std::make_shared<Sphere>(Vector3D(0, 0, 10), 1.0, Color::BLUE));
+  scene.finalize();
+
+  Ray ray(Vector3D(0, 0, 0), Vector3D(0, 0, 1));
+  auto hit = scene.traceRay(ray);
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_NEAR(hit->distance, 4.0, 1e-9);
+  // The caller ray is not shrunk by the search
+  EXPECT_TRUE(std::isinf(ray.getTMax()));
+
+  ray.setInterval(7.0, 100.0);
+  hit = scene.traceRay(ray);
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_NEAR(hit->distance, 9.0, 1e-9);
+  EXPECT_EQ(hit->color, Color::BLUE);
+
+  ray.setInterval(0.0, 3.5);
+  EXPECT_FALSE(scene.traceRay(ray).has_value());
+}
+
+TEST(HitRecordTest, TwoPhasesMatchIntersect) {
+  Transform scaled;
+  scaled.scale(2.0, 0.5, 1.5).rotateY(30).translate(0.5, -0.5, 1.0);
+
+  std::vector<std::shared_ptr<IPrimitive>> primitives = {
+      std::make_shared<Sphere>(Vector3D(0, 0, 0), 2.0, Color::RED),
+      std::make_shared<Plane>('Y', -1.0, Color::RED),
+      std::make_shared<CheckerboardPlane>('Z', 1.0, Color::RED, Color::BLUE,
+                                          0.5),
+      std::make_shared<Cylinder>(1.0, Color::RED),
+      std::make_shared<Cone>(Vector3D(0, 2, 0), Vector3D(0, -1, 0), 30.0,
+                             Color::RED),
+      std::make_shared<LimitedCylinder>(1.0, 3.0, Color::RED),
+      std::make_shared<LimitedCone>(Vector3D(0, 2, 0), Vector3D(0, -1, 0), 30.0,
+                                    Color::RED, 3.0),
+      std::make_shared<Triangle>(Vector3D(-2, -1, 0), Vector3D(2, -1, 0),
+                                 Vector3D(0, 2, 0), Color::RED),
+      std::make_shared<Torus>(2.0, 0.5, Color::RED),
+  };
+
+  for (bool transformed : {false, true}) {
+    for (const auto& primitive : primitives) {
+      if (transformed) {
+        primitive->setTransform(scaled);
+      }
+      for (const auto& ray : makeTraversalRays(31, 200)) {
+        Ray hitRay(ray);
+        auto hit = primitive->intersectHit(hitRay);
+        auto expected = primitive->intersect(Ray(ray));
+        ASSERT_EQ(hit.has_value(), expected.has_value());
+        if (!hit) {
+          continue;
+        }
+        EXPECT_DOUBLE_EQ(hitRay.getTMax(), hit->t);
+        Intersection surface = primitive->computeSurface(ray, *hit);
+        EXPECT_DOUBLE_EQ(surface.distance, expected->distance);
+        EXPECT_NEAR((surface.point - ray.pointAt(hit->t)).getMagnitude(), 0.0,
+                    1e-6);
+        EXPECT_NEAR((surface.normal - expected->normal).getMagnitude(), 0.0,
+                    1e-9);
+        EXPECT_EQ(surface.color, expected->color);
+        EXPECT_EQ(surface.primitive, primitive.get());
+      }
+    }
+  }
+}
+
+TEST(HitRecordTest, TriangleReportsBarycentrics) {
+  Triangle triangle(Vector3D(0, 0, 0), Vector3D(4, 0, 0), Vector3D(0, 2, 0),
+                    Color::RED);
+  Ray ray(Vector3D(1, 0.5, -3), Vector3D(0, 0, 1));
+  auto hit = triangle.intersectHit(ray);
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_NEAR(hit->t, 3.0, 1e-9);
+  EXPECT_NEAR(hit->u, 0.25, 1e-9);
+  EXPECT_NEAR(hit->v, 0.25, 1e-9);
+}
+
+TEST(HitRecordTest, SceneComputesSurfaceOnceForTheWinner) {
+  int counter = 0;
+  Scene scene;
+  for (int i = 0; i < 20; ++i) {
+    scene.addPrimitive(std::make_shared<CountingSphere>(
+        Vector3D(0, 0, 5.0 + 3.0 * i), 1.0, counter));
+  }
+
+  auto hit = scene.traceRay(Ray(Vector3D(0, 0, 100), Vector3D(0, 0, -1)));
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_NEAR(hit->distance, 37.0, 1e-9);
+  EXPECT_EQ(counter, 1);
+
+  counter = 0;
+  scene.finalize();
+  hit = scene.traceRay(Ray(Vector3D(0, 0, 100), Vector3D(0, 0, -1)));
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_NEAR(hit->distance, 37.0, 1e-9);
+  EXPECT_EQ(counter, 1);
+
+  counter = 0;
+  EXPECT_FALSE(scene.traceRay(Ray(Vector3D(5, 0, 0), Vector3D(0, 0, 1))));
+  EXPECT_EQ(counter, 0);
+}
+
+TEST(OcclusionTest, SceneStopsAtDistance) {
+  Scene scene;
+  scene.addPrimitive(
+      std::make_shared<Sphere>(Vector3D(0, 0, 10), 1.0, Color::RED));
+  scene.finalize();
+  Ray ray(Vector3D(0, 0, 0), Vector3D(0, 0, 1));
+  EXPECT_TRUE(scene.occluded(ray, 20.0));
+  EXPECT_FALSE(scene.occluded(ray, 8.5));
+  EXPECT_FALSE(scene.occluded(Ray(Vector3D(0, 5, 0), Vector3D(0, 0, 1)), 20.0));
+}
@@ -0,0 +1,325 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Unit tests for BVHCache
+*/
+
+/**
+ * @file test_BVHCache.cpp
+ * @brief Unit tests for the disk cache of the acceleration structures
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "../src/core/AABB.hpp"
+#include "../src/core/Color.hpp"
+#include "../src/core/Ray.hpp"
+#include "../src/core/Transform.hpp"
+#include "../src/scene/Scene.hpp"
+#include "../src/scene/acceleration/BVH.hpp"
+#include "../src/scene/acceleration/BVH4.hpp"
+#include "../src/scene/acceleration/BVHCache.hpp"
+#include "../src/scene/primitives/Sphere.hpp"
+#include "TestHelpers.hpp"
+
+using namespace RayTracer;
+
+namespace {
+
+/**
+ * @brief Fresh directory under the system temporary directory, removed with
+ * its contents at the end of the test
+ */
+class CacheDirectory {
+ public:
+  CacheDirectory()
+      : _path(std::filesystem::temp_directory_path() /
+              ("raytracer_cache_test_" + std::to_string(::getpid()) + "_" +
+               testName())) {
+    std::filesystem::remove_all(_path);
+  }
+  ~CacheDirectory() { std::filesystem::remove_all(_path); }
+
+  std::string file(const std::string& name) const {
+    return (_path / name).string();
+  }
+
+ private:
+  std::filesystem::path _path;
+
+  static std::string testName() {
+    return ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  }
+};
+
+}  // namespace
+
+TEST(BVHCacheTest, HashIsFnv1a) {
+  EXPECT_EQ(BVHCache::hash("", 0), 0xcbf29ce484222325ULL);
+  EXPECT_EQ(BVHCache::hash("a", 1), 0xaf63dc4c8601ec8cULL);
+  EXPECT_EQ(BVHCache::hash("foobar", 6), 0x85944171f73967e8ULL);
+  // Chaining equals hashing the concatenation
+  EXPECT_EQ(BVHCache::hash("bar", 3, BVHCache::hash("foo", 3)),
+            BVHCache::hash("foobar", 6));
+
+  EXPECT_NE(BVHCache::pathFor(1, AcceleratorType::BVH),
+            BVHCache::pathFor(1, AcceleratorType::BVH4));
+  EXPECT_EQ(BVHCache::pathFor(0xabc, AcceleratorType::BVH, "dir"),
+            (std::filesystem::path("dir") / "0000000000000abc.bvh").string());
+}
+
+TEST(BVHCacheTest, SceneFileHashFollowsContentsAndIncludes) {
+  CacheDirectory directory;
+  std::filesystem::create_directories(
+      std::filesystem::path(directory.file("scene.cfg")).parent_path());
+  std::string included = directory.file("lights.cfg");
+  std::ofstream(included) << "lights: { ambient = 0.2; };\n";
+  std::string scene = directory.file("scene.cfg");
+  std::ofstream(scene) << "camera: {};\n  @include \"" << included << "\"\n";
+
+  uint64_t first = BVHCache::hashSceneFile(scene);
+  EXPECT_EQ(BVHCache::hashSceneFile(scene), first);
+  std::ofstream(included) << "lights: { ambient = 0.3; };\n";
+  uint64_t second = BVHCache::hashSceneFile(scene);
+  EXPECT_NE(second, first);
+  std::ofstream(scene, std::ios::app) << "# comment\n";
+  EXPECT_NE(BVHCache::hashSceneFile(scene), second);
+
+  EXPECT_THROW(BVHCache::hashSceneFile(directory.file("missing.cfg")),
+               std::runtime_error);
+}
+
+TEST(BVHCacheTest, RoundTripsBothHierarchies) {
+  CacheDirectory directory;
+  std::vector<AABB> boxes = makeRandomBoxes(4, 3000);
+
+  BVH built;
+  built.build(boxes);
+  std::string path = directory.file("tree.bvh");
+  ASSERT_TRUE(BVHCache::store(path, boxes, built));
+  BVH loaded;
+  ASSERT_TRUE(BVHCache::load(path, boxes, loaded));
+  EXPECT_TRUE(loaded.getBuildStats().fromCache);
+  EXPECT_FALSE(built.getBuildStats().fromCache);
+  EXPECT_EQ(loaded.getBuildStats().nodeCount, built.getBuildStats().nodeCount);
+  ASSERT_EQ(loaded.getNodeCount(), built.getNodeCount());
+  EXPECT_EQ(std::memcmp(loaded.getNodes().data(), built.getNodes().data(),
+                        built.getNodeCount() * sizeof(BVH::Node)),
+            0);
+  EXPECT_EQ(loaded.getItemIndices(), built.getItemIndices());
+
+  BVH4 wideBuilt;
+  wideBuilt.build(built);
+  std::string widePath = directory.file("tree.bvh4");
+  ASSERT_TRUE(BVHCache::store(widePath, boxes, wideBuilt));
+  BVH4 wideLoaded;
+  ASSERT_TRUE(BVHCache::load(widePath, boxes, wideLoaded));
+  ASSERT_EQ(wideLoaded.getNodeCount(), wideBuilt.getNodeCount());
+  EXPECT_EQ(std::memcmp(wideLoaded.getNodes().data(),
+                        wideBuilt.getNodes().data(),
+                        wideBuilt.getNodeCount() * sizeof(BVH4::Node)),
+            0);
+  EXPECT_EQ(wideLoaded.getItemIndices(), wideBuilt.getItemIndices());
+  EXPECT_DOUBLE_EQ(wideLoaded.getBounds().getMax().getY(),
+                   wideBuilt.getBounds().getMax().getY());
+
+  // A file only loads as the hierarchy it stores
+  EXPECT_FALSE(BVHCache::load(widePath, boxes, loaded));
+  EXPECT_FALSE(BVHCache::load(path, boxes, wideLoaded));
+}
+
+TEST(BVHCacheTest, RejectsStaleOrDamagedFiles) {
+  CacheDirectory directory;
+  std::vector<AABB> boxes = makeRandomBoxes(6, 500);
+  BVH built;
+  built.build(boxes);
+  std::string path = directory.file("tree.bvh");
+  ASSERT_TRUE(BVHCache::store(path, boxes, built));
+
+  BVH loaded;
+  EXPECT_FALSE(BVHCache::load(directory.file("missing.bvh"), boxes, loaded));
+
+  // Moved or removed items
+  std::vector<AABB> moved = boxes;
+  moved[42] = AABB(Vector3D(0, 0, 0), Vector3D(1, 1, 1));
+  EXPECT_FALSE(BVHCache::load(path, moved, loaded));
+  moved.pop_back();
+  EXPECT_FALSE(BVHCache::load(path, moved, loaded));
+  EXPECT_TRUE(loaded.isEmpty());
+
+  // Truncated file
+  auto size = std::filesystem::file_size(path);
+  std::filesystem::resize_file(path, size - 4);
+  EXPECT_FALSE(BVHCache::load(path, boxes, loaded));
+
+  // Not a cache file
+  std::ofstream(path, std::ios::trunc) << "not a cache";
+  EXPECT_FALSE(BVHCache::load(path, boxes, loaded));
+  EXPECT_TRUE(loaded.isEmpty());
+}
+
+TEST(BVHCacheTest, RejectsDamagedNodesAndItems) {
+  CacheDirectory directory;
+  std::vector<AABB> boxes = makeRandomBoxes(8, 500);
+  BVH built;
+  built.build(boxes);
+  BVH4 wideBuilt;
+  wideBuilt.build(built);
+
+  // The nodes end where the item indices, last in the file, start: node
+  // nodeCount is the first item index
+  auto patch = [&boxes](const std::string& path, std::size_t nodeCount,
+                        std::size_t nodeSize, std::size_t node,
+                        std::size_t field, uint32_t value) {
+    std::size_t items = std::filesystem::file_size(path) -
+                        boxes.size() * sizeof(uint32_t);
+    std::size_t position =
+        node == nodeCount ? items : items - (nodeCount - node) * nodeSize;
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(static_cast<std::streamoff>(position + field));
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+
+  std::string path = directory.file("tree.bvh");
+  ASSERT_TRUE(BVHCache::store(path, boxes, built));
+  patch(path, built.getNodeCount(), sizeof(BVH::Node), 0,
+        offsetof(BVH::Node, offset),
+        static_cast<uint32_t>(built.getNodeCount()));
+  BVH loaded;
+  EXPECT_FALSE(BVHCache::load(path, boxes, loaded));
+  EXPECT_TRUE(loaded.isEmpty());
+
+  // A root pointing back at itself would loop forever
+  ASSERT_TRUE(BVHCache::store(path, boxes, built));
+  patch(path, built.getNodeCount(), sizeof(BVH::Node), 0,
+        offsetof(BVH::Node, offset), 0);
+  EXPECT_FALSE(BVHCache::load(path, boxes, loaded));
+
+  // An item index out of the scene
+  ASSERT_TRUE(BVHCache::store(path, boxes, built));
+  patch(path, built.getNodeCount(), sizeof(BVH::Node), built.getNodeCount(),
+        0, static_cast<uint32_t>(boxes.size()));
+  EXPECT_FALSE(BVHCache::load(path, boxes, loaded));
+
+  std::string widePath = directory.file("tree.bvh4");
+  ASSERT_TRUE(BVHCache::store(widePath, boxes, wideBuilt));
+  patch(widePath, wideBuilt.getNodeCount(), sizeof(BVH4::Node), 0,
+        offsetof(BVH4::Node, child), 0xfffffff0u);
+  BVH4 wideLoaded;
+  EXPECT_FALSE(BVHCache::load(widePath, boxes, wideLoaded));
+  EXPECT_TRUE(wideLoaded.isEmpty());
+
+  // The untouched files still load
+  ASSERT_TRUE(BVHCache::store(path, boxes, built));
+  EXPECT_TRUE(BVHCache::load(path, boxes, loaded));
+  ASSERT_TRUE(BVHCache::store(widePath, boxes, wideBuilt));
+  EXPECT_TRUE(BVHCache::load(widePath, boxes, wideLoaded));
+}
+
+TEST(BVHCacheTest, SceneLoadsWhatItSaved) {
+  CacheDirectory directory;
+  std::string path = directory.file("scene.bvh4");
+  auto makeScene = [&path]() {
+    Scene scene;
+    scene.setAccelerator(AcceleratorType::BVH4);
+    scene.setAccelerationCache(path);
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<double> position(-50.0, 50.0);
+    for (std::size_t i = 0; i < BVHCache::MIN_CACHED_ITEMS; ++i) {
+      scene.addPrimitive(std::make_shared<Sphere>(
+          Vector3D(position(rng), position(rng), position(rng)), 0.3,
+          Color::RED));
+    }
+    return scene;
+  };
+
+  Scene first = makeScene();
+  first.finalize();
+  EXPECT_FALSE(first.getAccelerationStats().fromCache);
+  ASSERT_TRUE(std::filesystem::exists(path));
+
+  Scene second = makeScene();
+  second.finalize();
+  EXPECT_TRUE(second.getAccelerationStats().fromCache);
+  EXPECT_EQ(second.getAccelerationStats().nodeCount,
+            first.getAccelerationStats().nodeCount);
+
+  std::mt19937 rng(17);
+  std::uniform_real_distribution<double> direction(-1.0, 1.0);
+  for (int i = 0; i < 500; ++i) {
+    Ray ray(Vector3D(0, 0, -80),
+            Vector3D(direction(rng), direction(rng), 1.0));
+    auto expected = first.traceRay(ray);
+    auto actual = second.traceRay(ray);
+    ASSERT_EQ(expected.has_value(), actual.has_value());
+    if (expected) {
+      EXPECT_DOUBLE_EQ(expected->distance, actual->distance);
+    }
+  }
+
+  // Small scenes never touch the cache
+  Scene small;
+  small.setAccelerationCache(directory.file("small.bvh"));
+  small.addPrimitive(
+      std::make_shared<Sphere>(Vector3D(0, 0, 5), 1.0, Color::RED));
+  small.finalize();
+  EXPECT_FALSE(std::filesystem::exists(directory.file("small.bvh")));
+}
+
+TEST(BVHCacheTest, RefitRebuildsLeaveTheCacheFile) {
+  CacheDirectory directory;
+  std::string path = directory.file("scene.bvh");
+  Scene scene;
+  scene.setAccelerator(AcceleratorType::BVH);
+  scene.setAccelerationCache(path);
+  std::mt19937 rng(5);
+  std::uniform_real_distribution<double> position(-50.0, 50.0);
+  std::vector<std::shared_ptr<Sphere>> spheres;
+  for (std::size_t i = 0; i < BVHCache::MIN_CACHED_ITEMS; ++i) {
+    spheres.push_back(std::make_shared<Sphere>(
+        Vector3D(position(rng), position(rng), position(rng)), 0.3,
+        Color::RED));
+    scene.addPrimitive(spheres.back());
+  }
+  scene.finalize();
+  ASSERT_TRUE(std::filesystem::exists(path));
+  auto readFile = [&path]() {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), {});
+  };
+  std::string authored = readFile();
+
+  // Scattering every sphere ruins the hierarchy enough to rebuild it
+  for (const auto& sphere : spheres) {
+    sphere->setTransform(Transform().translate(
+        position(rng), position(rng), position(rng)));
+  }
+  EXPECT_FALSE(scene.refit());
+  EXPECT_FALSE(scene.getAccelerationStats().fromCache);
+  EXPECT_EQ(readFile(), authored);
+
+  // Refitting a scene never finalized builds it without the cache either
+  Scene moved;
+  moved.setAccelerator(AcceleratorType::BVH);
+  moved.setAccelerationCache(directory.file("moved.bvh"));
+  for (const auto& sphere : spheres) {
+    moved.addPrimitive(sphere);
+  }
+  EXPECT_FALSE(moved.refit());
+  EXPECT_EQ(moved.getAccelerationStats().itemCount, spheres.size());
+  EXPECT_FALSE(std::filesystem::exists(directory.file("moved.bvh")));
+}
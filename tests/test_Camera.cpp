@@ -16,6 +16,7 @@
 
 #include <gtest/gtest.h>
 #include <cmath>
+#include <vector>
 #include "../include/exceptions/InvalidTypeException.hpp"
 #include "../include/exceptions/ParserException.hpp"
 #include "../include/exceptions/RaytracerException.hpp"
@@ -206,6 +207,58 @@ TEST(CameraTest, OutOfBoundsRayGeneration) {
   EXPECT_THROW(camera.generateRay(400, 600), RaytracerException);
 }
 
+// Test that batches of rays match the rays of single pixels
+TEST(CameraTest, BatchRayGeneration) {
+  Camera camera(Vector3D(1, 2, 3), 800, 600, 75.0);
+  camera.setRotation(Vector3D(10, 20, 0));
+
+  std::vector<Ray> rays;
+  camera.generateRays(790, 599, 10, rays);
+  ASSERT_EQ(rays.size(), 10u);
+  for (int i = 0; i < 10; ++i) {
+    Ray single = camera.generateRay(790 + i, 599);
+    EXPECT_DOUBLE_EQ(rays[i].getOrigin().getX(), single.getOrigin().getX());
+    EXPECT_DOUBLE_EQ(rays[i].getOrigin().getY(), single.getOrigin().getY());
+    EXPECT_DOUBLE_EQ(rays[i].getOrigin().getZ(), single.getOrigin().getZ());
+    EXPECT_DOUBLE_EQ(rays[i].getDirection().getX(),
+                     single.getDirection().getX());
+    EXPECT_DOUBLE_EQ(rays[i].getDirection().getY(),
+                     single.getDirection().getY());
+    EXPECT_DOUBLE_EQ(rays[i].getDirection().getZ(),
+                     single.getDirection().getZ());
+  }
+
+  // The previous contents are replaced
+  camera.generateRays(0, 0, 4, rays);
+  EXPECT_EQ(rays.size(), 4u);
+
+  EXPECT_THROW(camera.generateRays(795, 0, 10, rays), RaytracerException);
+  EXPECT_THROW(camera.generateRays(-1, 0, 4, rays), RaytracerException);
+  EXPECT_THROW(camera.generateRays(0, 600, 1, rays), RaytracerException);
+}
+
+// Test that blocks of rays match the rays of single pixels, row by row
+TEST(CameraTest, BlockRayGeneration) {
+  Camera camera(Vector3D(1, 2, 3), 800, 600, 75.0);
+  camera.setRotation(Vector3D(10, 20, 0));
+
+  std::vector<Ray> rays;
+  camera.generateRays(796, 596, 4, 4, rays);
+  ASSERT_EQ(rays.size(), 16u);
+  for (int i = 0; i < 16; ++i) {
+    Ray single = camera.generateRay(796 + i % 4, 596 + i / 4);
+    EXPECT_DOUBLE_EQ(rays[i].getDirection().getX(),
+                     single.getDirection().getX());
+    EXPECT_DOUBLE_EQ(rays[i].getDirection().getY(),
+                     single.getDirection().getY());
+    EXPECT_DOUBLE_EQ(rays[i].getDirection().getZ(),
+                     single.getDirection().getZ());
+  }
+
+  EXPECT_THROW(camera.generateRays(0, 597, 4, 4, rays), RaytracerException);
+  EXPECT_THROW(camera.generateRays(0, 0, 4, -1, rays), RaytracerException);
+}
+
 // Test different field of view values
 TEST(CameraTest, FieldOfViewTest) {
   // Create cameras with different FOVs
@@ -0,0 +1,224 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Unit tests for CompiledPrimitives
+*/
+
+/**
+ * @file test_CompiledPrimitives.cpp
+ * @brief Unit tests for the typed render-time copy of the scene primitives,
+ * checked against the virtual calls of the authored primitives
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include "../src/core/Color.hpp"
+#include "../src/core/Ray.hpp"
+#include "../src/core/Transform.hpp"
+#include "../src/core/Vector3D.hpp"
+#include "../src/scene/CompiledPrimitives.hpp"
+#include "../src/scene/Scene.hpp"
+#include "../src/scene/primitives/Mesh.hpp"
+#include "TestHelpers.hpp"
+
+using namespace RayTracer;
+
+namespace {
+
+/**
+ * @brief Sphere subclass standing for a type the storage does not know
+ */
+class TaggedSphere : public Sphere {
+ public:
+  using Sphere::Sphere;
+};
+
+/**
+ * @brief Primitive written against the interface before intersectHit(),
+ * implementing intersect() only
+ */
+class LegacySphere : public IPrimitive {
+ public:
+  LegacySphere(const Vector3D& center, double radius)
+      : _sphere(center, radius, Color::GREEN) {}
+
+  std::optional<Intersection> intersect(const Ray& ray) const override {
+    // Ignores the search interval, as primitives used to
+    Ray unbounded(ray.getOrigin(), ray.getDirection());
+    std::optional<Intersection> hit = _sphere.intersect(unbounded);
+    if (hit) {
+      hit->primitive = this;
+    }
+    return hit;
+  }
+
+  void setTransform(const Transform& transform) override {
+    _sphere.setTransform(transform);
+  }
+  Transform getTransform() const override {
+    return _sphere.getTransform();
+  }
+  void setColor(const Color& color) override {
+    _sphere.setColor(color);
+  }
+  Color getColor() const override {
+    return _sphere.getColor();
+  }
+  Vector3D getNormalAt(const Vector3D& point) const override {
+    return _sphere.getNormalAt(point);
+  }
+  std::shared_ptr<IPrimitive> clone() const override {
+    return std::make_shared<LegacySphere>(*this);
+  }
+
+ private:
+  Sphere _sphere;  ///< Geometry the legacy calls are forwarded to
+};
+
+std::vector<std::shared_ptr<IPrimitive>> makePrimitives() {
+  std::vector<Vector3D> vertices = {Vector3D(-1, 0, 3), Vector3D(1, 0, 3),
+                                    Vector3D(0, 2, 3)};
+  return {
+      std::make_shared<Sphere>(Vector3D(0, 0, 0), 2.0, Color::RED),
+      std::make_shared<Plane>('Y', -1.0, Color::RED),
+      std::make_shared<CheckerboardPlane>('Z', 1.0, Color::RED, Color::BLUE,
+                                          0.5),
+      std::make_shared<Cone>(Vector3D(0, 2, 0), Vector3D(0, -1, 0), 30.0,
+                             Color::RED),
+      std::make_shared<LimitedCone>(Vector3D(0, 2, 0), Vector3D(0, -1, 0),
+                                    30.0, Color::RED, 3.0),
+      std::make_shared<Cylinder>(1.0, Color::RED),
+      std::make_shared<LimitedCylinder>(1.0, 3.0, Color::RED),
+      std::make_shared<Torus>(2.0, 0.5, Color::RED),
+      std::make_shared<Triangle>(Vector3D(-2, -1, 0), Vector3D(2, -1, 0),
+                                 Vector3D(0, 2, 0), Color::RED),
+      std::make_shared<Mesh>(vertices, std::vector<Mesh::Face>{{0, 1, 2}},
+                             Color::GREEN),
+      std::make_shared<TaggedSphere>(Vector3D(3, 0, 0), 1.0, Color::BLUE),
+  };
+}
+
+}  // namespace
+
+TEST(CompiledPrimitivesTest, SortsPrimitivesByExactType) {
+  auto primitives = makePrimitives();
+  CompiledPrimitives compiled;
+  compiled.compile(primitives);
+  ASSERT_EQ(compiled.size(), primitives.size());
+  const PrimitiveKind expected[] = {
+      PrimitiveKind::SPHERE,
+      PrimitiveKind::PLANE,
+      PrimitiveKind::CHECKERBOARD_PLANE,
+      PrimitiveKind::CONE,
+      PrimitiveKind::LIMITED_CONE,
+      PrimitiveKind::CYLINDER,
+      PrimitiveKind::LIMITED_CYLINDER,
+      PrimitiveKind::TORUS,
+      PrimitiveKind::TRIANGLE,
+      // Meshes and types derived from the built-in ones stay virtual
+      PrimitiveKind::OTHER,
+      PrimitiveKind::OTHER,
+  };
+  for (std::size_t i = 0; i < primitives.size(); ++i) {
+    EXPECT_EQ(compiled.getKind(i), expected[i]) << "primitive " << i;
+  }
+
+  compiled.clear();
+  EXPECT_EQ(compiled.size(), 0u);
+}
+
+TEST(CompiledPrimitivesTest, MatchesVirtualCalls) {
+  Transform transform;
+  transform.scale(1.5, 0.5, 1.0).rotateY(30).translate(0.5, -0.5, 1.0);
+  auto primitives = makePrimitives();
+  for (bool transformed : {false, true}) {
+    if (transformed) {
+      for (const auto& primitive : primitives) {
+        primitive->setTransform(transform);
+      }
+    }
+    CompiledPrimitives compiled;
+    compiled.compile(primitives);
+
+    for (const auto& ray : makeRandomRays(17, 300, 6.0)) {
+      for (std::size_t i = 0; i < primitives.size(); ++i) {
+        Ray expectedRay(ray);
+        Ray actualRay(ray);
+        auto expected = primitives[i]->intersectHit(expectedRay);
+        auto actual = compiled.intersectHit(i, actualRay);
+        ASSERT_EQ(expected.has_value(), actual.has_value());
+        EXPECT_EQ(expectedRay.getTMax(), actualRay.getTMax());
+        EXPECT_EQ(primitives[i]->occluded(ray, 4.0),
+                  compiled.occluded(i, ray, 4.0));
+        if (!expected) {
+          continue;
+        }
+        EXPECT_EQ(expected->t, actual->t);
+        EXPECT_EQ(expected->part, actual->part);
+        Intersection expectedSurface =
+            primitives[i]->computeSurface(ray, *expected);
+        Intersection actualSurface = compiled.computeSurface(i, ray, *actual);
+        EXPECT_EQ(expectedSurface.point, actualSurface.point);
+        EXPECT_EQ(expectedSurface.normal, actualSurface.normal);
+        EXPECT_EQ(expectedSurface.color, actualSurface.color);
+        // Intersections name the authored primitive, not the copy
+        EXPECT_EQ(actualSurface.primitive, primitives[i].get());
+      }
+    }
+  }
+}
+
+TEST(CompiledPrimitivesTest, SceneCompilesAgainAfterRefit) {
+  Scene scene;
+  auto sphere = std::make_shared<Sphere>(Vector3D(0, 0, 10), 1.0, Color::RED);
+  scene.addPrimitive(sphere);
+  scene.finalize();
+  Ray ray(Vector3D(0, 0, 0), Vector3D(0, 0, 1));
+  auto hit = scene.traceRay(ray);
+  ASSERT_TRUE(hit);
+  EXPECT_DOUBLE_EQ(hit->distance, 9.0);
+  EXPECT_EQ(hit->primitive, sphere.get());
+
+  // The copies follow the authored primitive once the scene is refit
+  sphere->setTransform(Transform().translate(0, 0, 5));
+  scene.refit();
+  hit = scene.traceRay(ray);
+  ASSERT_TRUE(hit);
+  EXPECT_DOUBLE_EQ(hit->distance, 14.0);
+  EXPECT_EQ(hit->primitive, sphere.get());
+  EXPECT_FALSE(scene.occluded(ray, 13.0));
+}
+
+TEST(CompiledPrimitivesTest, LegacyPrimitiveUsesDefaultHitQueries) {
+  LegacySphere legacy(Vector3D(0, 0, 10), 1.0);
+  Ray ray(Vector3D(0, 0, 0), Vector3D(0, 0, 1));
+  auto hit = legacy.intersectHit(ray);
+  ASSERT_TRUE(hit);
+  EXPECT_DOUBLE_EQ(hit->t, 9.0);
+  EXPECT_DOUBLE_EQ(ray.getTMax(), 9.0);
+  Intersection surface = legacy.computeSurface(ray, *hit);
+  EXPECT_DOUBLE_EQ(surface.distance, 9.0);
+  EXPECT_EQ(surface.primitive, &legacy);
+
+  // The default clips the hit to the search interval
+  Ray shortRay(Vector3D(0, 0, 0), Vector3D(0, 0, 1));
+  shortRay.setInterval(shortRay.getTMin(), 8.0);
+  EXPECT_FALSE(legacy.intersectHit(shortRay));
+  EXPECT_FALSE(legacy.occluded(ray, 8.0));
+
+  // A closer built-in primitive wins in a scene
+  Scene scene;
+  auto sphere = std::make_shared<Sphere>(Vector3D(0, 0, 5), 1.0, Color::RED);
+  scene.addPrimitive(std::make_shared<LegacySphere>(legacy));
+  scene.addPrimitive(sphere);
+  scene.finalize();
+  auto closest = scene.traceRay(Ray(Vector3D(0, 0, 0), Vector3D(0, 0, 1)));
+  ASSERT_TRUE(closest);
+  EXPECT_DOUBLE_EQ(closest->distance, 4.0);
+  EXPECT_EQ(closest->primitive, sphere.get());
+}
@@ -0,0 +1,213 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Unit tests for Grid
+*/
+
+/**
+ * @file test_Grid.cpp
+ * @brief Unit tests for the uniform grid accelerator and the automatic
+ * choice between it and the bounding volume hierarchy
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include <gtest/gtest.h>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "../src/core/AABB.hpp"
+#include "../src/core/Color.hpp"
+#include "../src/core/Ray.hpp"
+#include "../src/core/Vector3D.hpp"
+#include "../src/scene/Scene.hpp"
+#include "../src/scene/acceleration/Accelerator.hpp"
+#include "../src/scene/acceleration/Grid.hpp"
+#include "../src/scene/lights/PointLight.hpp"
+#include "../src/scene/primitives/Plane.hpp"
+#include "../src/scene/primitives/Sphere.hpp"
+#include "../src/scene/primitives/Triangle.hpp"
+#include "TestHelpers.hpp"
+
+using namespace RayTracer;
+
+namespace {
+
+Scene makeParticleField(unsigned seed, int count) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> position(-10.0, 10.0);
+  std::uniform_real_distribution<double> radius(0.05, 0.2);
+  Scene scene;
+  scene.addPrimitive(std::make_shared<Plane>('Y', -12.0, Color::GRAY));
+  for (int i = 0; i < count; ++i) {
+    Vector3D center(position(rng), position(rng), position(rng));
+    if (i % 2 == 0) {
+      scene.addPrimitive(
+          std::make_shared<Sphere>(center, radius(rng), Color::RED));
+    } else {
+      scene.addPrimitive(std::make_shared<Triangle>(
+          center, center + Vector3D(radius(rng), 0, 0),
+          center + Vector3D(0, radius(rng), radius(rng)), Color::GREEN));
+    }
+  }
+  return scene;
+}
+
+/**
+ * @brief Check that every item whose box the ray crosses is visited
+ */
+void expectVisitsCrossedItems(const Grid& grid,
+                              const std::vector<AABB>& boxes) {
+  for (const auto& ray : makeTraversalRays(11, 500, 25.0)) {
+    std::vector<bool> visited(boxes.size(), false);
+    double tMax = std::numeric_limits<double>::infinity();
+    EXPECT_FALSE(grid.traverse(ray, tMax, [&](std::size_t item, double&) {
+      visited[item] = true;
+      return false;
+    }));
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+      if (boxes[i].intersects(ray)) {
+        ASSERT_TRUE(visited[i]) << "item " << i;
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(GridTest, EmptyBuild) {
+  Grid grid;
+  grid.build({});
+  EXPECT_TRUE(grid.isEmpty());
+  EXPECT_EQ(grid.getBuildStats().nodeCount, 0u);
+  double tMax = std::numeric_limits<double>::infinity();
+  EXPECT_FALSE(grid.traverse(Ray(Vector3D(0, 0, 0), Vector3D(0, 0, 1)), tMax,
+                             [](std::size_t, double&) { return true; }));
+}
+
+TEST(GridTest, VisitsEveryItemTheRayCrosses) {
+  std::vector<AABB> boxes = makeRandomBoxes(3, 3000, 20.0, 1.5);
+  for (bool twoLevel : {false, true}) {
+    Grid grid;
+    grid.build(boxes, twoLevel);
+    EXPECT_FALSE(grid.isEmpty());
+    EXPECT_EQ(grid.getBuildStats().itemCount, boxes.size());
+    expectVisitsCrossedItems(grid, boxes);
+  }
+}
+
+TEST(GridTest, DividesCrowdedCells) {
+  // An even field with a dense cluster in one corner
+  std::vector<AABB> boxes = makeRandomBoxes(5, 2000, 20.0, 0.5);
+  std::vector<AABB> cluster = makeRandomBoxes(6, 500, 20.0, 0.5);
+  for (const auto& box : cluster) {
+    boxes.emplace_back(box.getMin() * 0.01 + Vector3D(15, 15, 15),
+                       box.getMax() * 0.01 + Vector3D(15, 15, 15));
+  }
+
+  Grid flat;
+  flat.build(boxes, false);
+  EXPECT_EQ(flat.getLevels().size(), 1u);
+  EXPECT_EQ(flat.getBuildStats().maxDepth, 0u);
+
+  Grid twoLevel;
+  twoLevel.build(boxes);
+  EXPECT_GT(twoLevel.getLevels().size(), 1u);
+  EXPECT_EQ(twoLevel.getBuildStats().maxDepth, 1u);
+  EXPECT_LT(twoLevel.getBuildStats().maxLeafSize,
+            flat.getBuildStats().maxLeafSize);
+  expectVisitsCrossedItems(twoLevel, boxes);
+}
+
+TEST(GridTest, StopsPastTheClosestHit) {
+  // A long row of unit boxes along z
+  std::vector<AABB> boxes;
+  for (int i = 0; i < 2000; ++i) {
+    double z = i * 4.0;
+    boxes.emplace_back(Vector3D(-0.5, -0.5, z), Vector3D(0.5, 0.5, z + 1));
+  }
+  Grid grid;
+  grid.build(boxes);
+
+  std::vector<std::size_t> visited;
+  double tMax = std::numeric_limits<double>::infinity();
+  grid.traverse(Ray(Vector3D(0, 0, -10), Vector3D(0, 0, 1)), tMax,
+                [&](std::size_t item, double& t) {
+                  visited.push_back(item);
+                  t = std::min(t, 10.0 + item * 4.0);
+                  return false;
+                });
+  ASSERT_FALSE(visited.empty());
+  EXPECT_EQ(visited.front(), 0u);
+  EXPECT_DOUBLE_EQ(tMax, 10.0);
+  // Only the first cells were walked, not the whole row
+  EXPECT_LT(visited.size(), 100u);
+}
+
+TEST(GridTest, SceneMatchesBinaryHierarchy) {
+  Scene binary = makeParticleField(42, 3000);
+  Scene grid = binary;
+  binary.setAccelerator(AcceleratorType::BVH);
+  binary.finalize();
+  grid.setAccelerator(AcceleratorType::GRID);
+  grid.finalize();
+  EXPECT_EQ(grid.getActiveAccelerator(), AcceleratorType::GRID);
+  EXPECT_EQ(grid.getAccelerationStats().itemCount, 3000u);
+  auto light = std::make_shared<PointLight>(Vector3D(0, 30, 0));
+
+  for (const auto& ray : makeTraversalRays(7, 2000, 25.0)) {
+    auto expected = binary.traceRay(ray);
+    auto actual = grid.traceRay(ray);
+    ASSERT_EQ(expected.has_value(), actual.has_value());
+    if (expected) {
+      EXPECT_DOUBLE_EQ(expected->distance, actual->distance);
+      EXPECT_EQ(expected->color, actual->color);
+      EXPECT_EQ(binary.isInShadow(expected->point, light),
+                grid.isInShadow(expected->point, light));
+    }
+  }
+
+  // A grid has no topology to refit
+  EXPECT_FALSE(grid.refit());
+  EXPECT_TRUE(grid.isFinalized());
+}
+
+TEST(GridTest, SuitsEvenFieldsOfSmallItems) {
+  EXPECT_TRUE(Grid::suits(makeRandomBoxes(1, 5000, 20.0, 0.5)));
+  // Too few items for the grid to pay off
+  EXPECT_FALSE(Grid::suits(makeRandomBoxes(1, 500, 20.0, 0.5)));
+  // Items spanning many cells
+  EXPECT_FALSE(Grid::suits(makeRandomBoxes(1, 5000, 20.0, 20.0)));
+
+  // Teapot in a stadium: everything but a few items in one spot
+  std::vector<AABB> boxes = makeRandomBoxes(2, 5000, 20.0, 0.5);
+  for (std::size_t i = 8; i < boxes.size(); ++i) {
+    boxes[i] = AABB(boxes[i].getMin() * 0.01, boxes[i].getMax() * 0.01);
+  }
+  EXPECT_FALSE(Grid::suits(boxes));
+}
+
+TEST(GridTest, AutoChoosesFromTheScene) {
+  Scene small = makeParticleField(1, 200);
+  EXPECT_EQ(small.getAccelerator(), AcceleratorType::AUTO);
+  small.finalize();
+  EXPECT_EQ(small.getActiveAccelerator(), AcceleratorType::BVH);
+
+  Scene field = makeParticleField(1, 3000);
+  field.finalize();
+  EXPECT_EQ(field.getActiveAccelerator(), AcceleratorType::GRID);
+  // Particles or the plane below them, which the grid does not hold
+  EXPECT_TRUE(field.traceRay(Ray(Vector3D(0, 30, 0), Vector3D(0, -1, 0))));
+}
+
+TEST(GridTest, AcceleratorNames) {
+  EXPECT_EQ(parseAcceleratorType("grid"), AcceleratorType::GRID);
+  EXPECT_EQ(parseAcceleratorType("auto"), AcceleratorType::AUTO);
+  EXPECT_EQ(acceleratorTypeName(AcceleratorType::GRID), "grid");
+  EXPECT_EQ(acceleratorTypeName(AcceleratorType::AUTO), "auto");
+  EXPECT_THROW(parseAcceleratorType("octree"), std::invalid_argument);
+}
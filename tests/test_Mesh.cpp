@@ -0,0 +1,222 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Unit tests for Mesh and Instance
+*/
+
+/**
+ * @file test_Mesh.cpp
+ * @brief Unit tests for the Mesh and Instance primitives and their creation
+ * from the scene configuration
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include "../src/core/Color.hpp"
+#include "../src/core/Ray.hpp"
+#include "../src/core/Transform.hpp"
+#include "../src/core/Vector3D.hpp"
+#include "../src/scene/Scene.hpp"
+#include "../src/scene/primitives/Instance.hpp"
+#include "../src/scene/primitives/Mesh.hpp"
+#include "../src/scene/primitives/PrimitiveFactory.hpp"
+#include "../src/scene/primitives/Triangle.hpp"
+
+using namespace RayTracer;
+
+namespace {
+
+/**
+ * @brief Axis-aligned unit cube centered on the origin, 12 triangles
+ */
+std::shared_ptr<Mesh> makeCube(const Color& color) {
+  std::vector<Vector3D> vertices;
+  for (int i = 0; i < 8; ++i) {
+    vertices.emplace_back((i & 1) ? 0.5 : -0.5, (i & 2) ? 0.5 : -0.5,
+                          (i & 4) ? 0.5 : -0.5);
+  }
+  std::vector<Mesh::Face> faces = {
+      {0, 1, 3}, {0, 3, 2}, {4, 6, 7}, {4, 7, 5}, {0, 4, 5}, {0, 5, 1},
+      {2, 3, 7}, {2, 7, 6}, {0, 2, 6}, {0, 6, 4}, {1, 5, 7}, {1, 7, 3},
+  };
+  return std::make_shared<Mesh>(vertices, faces, color);
+}
+
+void expectVectorNear(const Vector3D& actual, const Vector3D& expected,
+                      double epsilon = 1e-9) {
+  EXPECT_NEAR(actual.getX(), expected.getX(), epsilon);
+  EXPECT_NEAR(actual.getY(), expected.getY(), epsilon);
+  EXPECT_NEAR(actual.getZ(), expected.getZ(), epsilon);
+}
+
+}  // namespace
+
+TEST(MeshTest, ConstructionBuildsHierarchy) {
+  auto cube = makeCube(Color::RED);
+  EXPECT_EQ(cube->getVertexCount(), 8u);
+  EXPECT_EQ(cube->getTriangleCount(), 12u);
+  EXPECT_FALSE(cube->getBVH().isEmpty());
+  expectVectorNear(cube->worldBounds().getMin(), Vector3D(-0.5, -0.5, -0.5));
+  expectVectorNear(cube->worldBounds().getMax(), Vector3D(0.5, 0.5, 0.5));
+}
+
+TEST(MeshTest, InvalidMeshesThrow) {
+  std::vector<Vector3D> vertices = {Vector3D(0, 0, 0), Vector3D(1, 0, 0),
+                                    Vector3D(0, 1, 0)};
+  EXPECT_THROW(Mesh(vertices, {}, Color::RED), std::invalid_argument);
+  EXPECT_THROW(Mesh(vertices, {{0, 1, 3}}, Color::RED),
+               std::invalid_argument);
+}
+
+TEST(MeshTest, MatchesStandaloneTriangles) {
+  std::vector<Vector3D> vertices = {Vector3D(0, 0, 0), Vector3D(2, 0, 0),
+                                    Vector3D(0, 2, 0), Vector3D(0, 0, 2)};
+  Mesh mesh(vertices, {{0, 1, 2}, {0, 1, 3}, {0, 2, 3}, {1, 2, 3}},
+            Color::GREEN);
+  Triangle slanted(vertices[1], vertices[2], vertices[3], Color::GREEN);
+
+  Ray ray(Vector3D(2, 2, 2), Vector3D(-1, -1, -1));
+  auto expected = slanted.intersect(ray);
+  auto actual = mesh.intersect(ray);
+  ASSERT_TRUE(expected.has_value());
+  ASSERT_TRUE(actual.has_value());
+  EXPECT_NEAR(actual->distance, expected->distance, 1e-9);
+  expectVectorNear(actual->point, expected->point);
+  expectVectorNear(actual->normal, expected->normal);
+  EXPECT_EQ(actual->color, Color::GREEN);
+  EXPECT_EQ(actual->primitive, &mesh);
+
+  EXPECT_TRUE(mesh.occluded(ray, 10.0));
+  EXPECT_FALSE(mesh.occluded(ray, 1.0));
+  EXPECT_FALSE(mesh.intersect(Ray(Vector3D(5, 5, 5), Vector3D(1, 0, 0))));
+}
+
+TEST(MeshTest, ClosestTriangleWins) {
+  auto cube = makeCube(Color::RED);
+  auto hit = cube->intersect(Ray(Vector3D(0, 0, -5), Vector3D(0, 0, 1)));
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_NEAR(hit->distance, 4.5, 1e-9);
+  expectVectorNear(hit->normal, Vector3D(0, 0, -1));
+
+  // From inside, the far side is hit
+  hit = cube->intersect(Ray(Vector3D(0.1, 0.1, 0), Vector3D(0, 1, 0)));
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_NEAR(hit->distance, 0.4, 1e-9);
+}
+
+TEST(InstanceTest, SharesGeometryAndMovesIt) {
+  auto cube = makeCube(Color::RED);
+  Transform transform;
+  transform.scale(2.0).translate(10, 0, 0);
+  Instance instance(cube, transform);
+  EXPECT_EQ(instance.getGeometry(), cube);
+  expectVectorNear(instance.worldBounds().getMin(), Vector3D(9, -1, -1),
+                   1e-6);
+  expectVectorNear(instance.worldBounds().getMax(), Vector3D(11, 1, 1),
+                   1e-6);
+
+  Ray ray(Vector3D(10, 0, -5), Vector3D(0, 0, 1));
+  auto hit = instance.intersect(ray);
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_NEAR(hit->distance, 4.0, 1e-9);
+  expectVectorNear(hit->point, Vector3D(10, 0, -1), 1e-9);
+  expectVectorNear(hit->normal, Vector3D(0, 0, -1), 1e-9);
+  EXPECT_EQ(hit->color, Color::RED);
+  EXPECT_EQ(hit->primitive, &instance);
+
+  // The original, untransformed cube is not where the instance is
+  EXPECT_FALSE(instance.intersect(Ray(Vector3D(0, 0, -5), Vector3D(0, 0, 1))));
+  EXPECT_TRUE(instance.occluded(ray, 5.0));
+  EXPECT_FALSE(instance.occluded(ray, 3.0));
+
+  auto clone = std::static_pointer_cast<Instance>(instance.clone());
+  EXPECT_EQ(clone->getGeometry(), cube);
+}
+
+TEST(InstanceTest, ColorOverride) {
+  auto cube = makeCube(Color::RED);
+  Instance instance(cube);
+  EXPECT_EQ(instance.getColor(), Color::RED);
+  instance.setColor(Color::BLUE);
+  EXPECT_EQ(instance.getColor(), Color::BLUE);
+  EXPECT_EQ(cube->getColor(), Color::RED);
+  auto hit = instance.intersect(Ray(Vector3D(0, 0, -5), Vector3D(0, 0, 1)));
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_EQ(hit->color, Color::BLUE);
+}
+
+TEST(InstanceTest, SceneOfManyCopies) {
+  auto cube = makeCube(Color::RED);
+  Scene scene;
+  for (int x = 0; x < 30; ++x) {
+    for (int z = 0; z < 30; ++z) {
+      Transform transform;
+      transform.translate(x * 3.0, 0, z * 3.0);
+      scene.addPrimitive(std::make_shared<Instance>(cube, transform));
+    }
+  }
+  scene.finalize();
+  // One mesh shared by every instance
+  EXPECT_EQ(cube.use_count(), 901);
+  EXPECT_EQ(scene.getAccelerationStats().itemCount, 900u);
+
+  auto hit = scene.traceRay(Ray(Vector3D(30, 10, 30), Vector3D(0, -1, 0)));
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_NEAR(hit->distance, 9.5, 1e-9);
+  hit = scene.traceRay(Ray(Vector3D(31.5, 10, 30), Vector3D(0, -1, 0)));
+  EXPECT_FALSE(hit.has_value());
+}
+
+TEST(InstanceTest, CreatedFromConfig) {
+  libconfig::Config cfg;
+  cfg.readString(R"(
+    primitives: {
+      instances = (
+        { mesh = "pyramid"; transform = { translate = { x = 5; }; }; },
+        { mesh = "pyramid"; color = { r = 0; g = 0; b = 255; }; },
+        { mesh = "missing"; }
+      );
+      meshes = (
+        {
+          name = "pyramid";
+          vertices = (
+            { x = -1; y = 0; z = -1; }, { x = 1; y = 0; z = -1; },
+            { x = 1; y = 0; z = 1; }, { x = -1; y = 0; z = 1; },
+            { x = 0; y = 2; z = 0; }
+          );
+          triangles = ( [0, 1, 4], [1, 2, 4], [2, 3, 4], [3, 0, 4],
+                        [0, 2, 1], [0, 3, 2] );
+          color = { r = 255; g = 0; b = 0; };
+        }
+      );
+      spheres = ( { x = 0; y = 10; z = 0; r = 1; } );
+    };
+  )");
+
+  auto result =
+      PrimitiveFactory::createPrimitives(cfg.lookup("primitives"));
+  ASSERT_EQ(result.meshes.size(), 1u);
+  auto pyramid = result.meshes.at("pyramid");
+  EXPECT_EQ(pyramid->getTriangleCount(), 6u);
+  // Two valid instances and the sphere; the mesh itself is not rendered
+  ASSERT_EQ(result.primitives.size(), 3u);
+
+  auto moved = std::dynamic_pointer_cast<Instance>(result.primitives[0]);
+  auto tinted = std::dynamic_pointer_cast<Instance>(result.primitives[1]);
+  ASSERT_TRUE(moved);
+  ASSERT_TRUE(tinted);
+  EXPECT_EQ(moved->getGeometry(), pyramid);
+  EXPECT_EQ(tinted->getGeometry(), pyramid);
+  EXPECT_EQ(moved->getColor(), Color::RED);
+  EXPECT_EQ(tinted->getColor(), Color::BLUE);
+
+  auto hit = moved->intersect(Ray(Vector3D(5, 10, 0), Vector3D(0, -1, 0)));
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_NEAR(hit->distance, 8.0, 1e-6);
+}
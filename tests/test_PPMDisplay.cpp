@@ -0,0 +1,157 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Unit tests for PPMDisplay
+*/
+
+/**
+ * @file test_PPMDisplay.cpp
+ * @brief Unit tests for the tiled rendering of the display, and for the
+ * order and publication of its tiles
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include "../src/core/RenderTile.hpp"
+#include "../src/display/PPMDisplay.hpp"
+#include "../src/scene/Camera.hpp"
+#include "../src/scene/Scene.hpp"
+#include "TestHelpers.hpp"
+
+using namespace RayTracer;
+
+TEST(PPMDisplayTest, SameImageOnAnyThreadCount) {
+  // Not a multiple of the tile size: the last row and column are clipped
+  Scene scene = makeSphereRowScene(150, 100);
+  PPMDisplay reference;
+  reference.setThreadCount(1);
+  ASSERT_TRUE(reference.render(scene));
+
+  for (int threads : {2, 4, 0}) {
+    PPMDisplay display;
+    display.setThreadCount(threads);
+    EXPECT_EQ(display.getThreadCount(), threads);
+    ASSERT_TRUE(display.render(scene));
+    for (int y = 0; y < display.getHeight(); ++y) {
+      for (int x = 0; x < display.getWidth(); ++x) {
+        ASSERT_EQ(display.getRadiance(x, y), reference.getRadiance(x, y))
+            << threads << " threads, pixel " << x << ", " << y;
+      }
+    }
+  }
+}
+
+TEST(PPMDisplayTest, RenderTileSizesTheImageToTheCamera) {
+  Scene scene = makeSphereRowScene(150, 100);
+  PPMDisplay reference;
+  reference.setThreadCount(1);
+  ASSERT_TRUE(reference.render(scene));
+
+  // No frame rendered yet, and the tile reaches out of the image
+  PPMDisplay display;
+  display.renderTile(scene, RenderTile(100, 60, 64, 64));
+  ASSERT_EQ(display.getWidth(), 150);
+  ASSERT_EQ(display.getHeight(), 100);
+  for (int y = 60; y < 100; ++y) {
+    for (int x = 100; x < 150; ++x) {
+      ASSERT_EQ(display.getRadiance(x, y), reference.getRadiance(x, y))
+          << "pixel " << x << ", " << y;
+    }
+  }
+
+  // A smaller camera shrinks it again
+  Scene small(Camera(Vector3D(0, 0, 0), 20, 10, 60.0));
+  display.renderTile(small, RenderTile(-8, -8, 64, 64));
+  EXPECT_EQ(display.getWidth(), 20);
+  EXPECT_EQ(display.getHeight(), 10);
+}
+
+TEST(PPMDisplayTest, RejectsNegativeThreadCount) {
+  PPMDisplay display;
+  EXPECT_THROW(display.setThreadCount(-1), std::invalid_argument);
+  EXPECT_EQ(display.getThreadCount(), 0);
+}
+
+TEST(TileManagerTest, CountsCompletedTiles) {
+  TileManager tiles(150, 100, 64);
+  ASSERT_EQ(tiles.getTotalTiles(), 6);
+  EXPECT_EQ(tiles.getTile(5).getWidth(), 150 - 128);
+  EXPECT_EQ(tiles.getTile(5).getHeight(), 100 - 64);
+
+  tiles.tileCompleted();
+  tiles.tileCompleted();
+  tiles.tileCompleted();
+  EXPECT_EQ(tiles.getCompletedTiles(), 3);
+  EXPECT_DOUBLE_EQ(tiles.getProgress(), 50.0);
+
+  tiles.reset();
+  EXPECT_EQ(tiles.getCompletedTiles(), 0);
+}
+
+TEST(TileManagerTest, EveryOrderCoversEveryTileOnce) {
+  for (TileOrder order :
+       {TileOrder::RASTER, TileOrder::HILBERT, TileOrder::SPIRAL}) {
+    TileManager tiles(300, 170, 32, order);
+    EXPECT_EQ(tiles.getOrder(), order);
+    ASSERT_EQ(tiles.getTotalTiles(), 10 * 6);
+    std::set<std::pair<int, int>> seen;
+    int area = 0;
+    const RenderTile* tile = nullptr;
+    while ((tile = tiles.getNextTile()) != nullptr) {
+      seen.insert({tile->getStartX(), tile->getStartY()});
+      area += tile->getWidth() * tile->getHeight();
+    }
+    EXPECT_EQ(seen.size(), 60u) << tileOrderName(order);
+    EXPECT_EQ(area, 300 * 170) << tileOrderName(order);
+  }
+}
+
+TEST(TileManagerTest, HilbertTilesAreNeighbours) {
+  TileManager tiles(256, 256, 32, TileOrder::HILBERT);
+  for (int i = 1; i < tiles.getTotalTiles(); ++i) {
+    const RenderTile& previous = tiles.getTile(i - 1);
+    const RenderTile& tile = tiles.getTile(i);
+    int distance = std::abs(tile.getStartX() - previous.getStartX()) +
+                   std::abs(tile.getStartY() - previous.getStartY());
+    EXPECT_EQ(distance, 32) << "tile " << i;
+  }
+}
+
+TEST(TileManagerTest, SpiralStartsAtTheCenter) {
+  TileManager tiles(320, 192, 64, TileOrder::SPIRAL);
+  const RenderTile& first = tiles.getTile(0);
+  EXPECT_EQ(first.getStartX(), 128);
+  EXPECT_EQ(first.getStartY(), 64);
+
+  // The corners come last
+  const RenderTile& last = tiles.getTile(tiles.getTotalTiles() - 1);
+  EXPECT_TRUE(last.getStartX() == 0 || last.getEndX() == 320);
+}
+
+TEST(TileManagerTest, ParsesTileOrders) {
+  EXPECT_EQ(parseTileOrder("raster"), TileOrder::RASTER);
+  EXPECT_EQ(parseTileOrder("hilbert"), TileOrder::HILBERT);
+  EXPECT_EQ(parseTileOrder(tileOrderName(TileOrder::SPIRAL)),
+            TileOrder::SPIRAL);
+  EXPECT_THROW(parseTileOrder("zigzag"), std::invalid_argument);
+}
+
+TEST(TileManagerTest, MortonCodesInterleaveCoordinates) {
+  EXPECT_EQ(mortonEncode(0, 0), 0u);
+  EXPECT_EQ(mortonEncode(1, 0), 1u);
+  EXPECT_EQ(mortonEncode(0, 1), 2u);
+  EXPECT_EQ(mortonEncode(3, 3), 15u);
+  for (uint32_t code = 0; code < 4096; ++code) {
+    uint32_t x = 0;
+    uint32_t y = 0;
+    mortonDecode(code, x, y);
+    ASSERT_EQ(mortonEncode(x, y), code);
+  }
+}
@@ -0,0 +1,86 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Unit tests for the polynomial root finders
+*/
+
+/**
+ * @file test_Polynomial.cpp
+ * @brief Unit tests for the quadratic, cubic and quartic root finders
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include <gtest/gtest.h>
+#include <array>
+#include "../src/core/Polynomial.hpp"
+
+using namespace RayTracer;
+
+TEST(PolynomialTest, QuadraticRoots) {
+  std::array<double, 2> roots{};
+  ASSERT_EQ(solveQuadratic(1.0, -3.0, 2.0, roots), 2);
+  EXPECT_DOUBLE_EQ(roots[0], 1.0);
+  EXPECT_DOUBLE_EQ(roots[1], 2.0);
+
+  EXPECT_EQ(solveQuadratic(1.0, 0.0, 1.0, roots), 0);
+
+  ASSERT_EQ(solveQuadratic(0.0, 2.0, -4.0, roots), 1);
+  EXPECT_DOUBLE_EQ(roots[0], 2.0);
+}
+
+TEST(PolynomialTest, QuadraticAvoidsCancellation) {
+  // Roots 1e-8 and 1e8: the naive formula loses the small one entirely
+  std::array<double, 2> roots{};
+  ASSERT_EQ(solveQuadratic(1.0, -(1e8 + 1e-8), 1.0, roots), 2);
+  EXPECT_NEAR(roots[0], 1e-8, 1e-20);
+  EXPECT_NEAR(roots[1], 1e8, 1e-6);
+}
+
+TEST(PolynomialTest, CubicRoots) {
+  std::array<double, 3> roots{};
+  // (x - 1)(x - 2)(x - 3)
+  ASSERT_EQ(solveCubic(1.0, -6.0, 11.0, -6.0, roots), 3);
+  EXPECT_NEAR(roots[0], 1.0, 1e-9);
+  EXPECT_NEAR(roots[1], 2.0, 1e-9);
+  EXPECT_NEAR(roots[2], 3.0, 1e-9);
+
+  // (x - 2)(x^2 + 1)
+  ASSERT_EQ(solveCubic(2.0, -4.0, 2.0, -4.0, roots), 1);
+  EXPECT_NEAR(roots[0], 2.0, 1e-9);
+}
+
+TEST(PolynomialTest, SmallestQuarticRootInInterval) {
+  // (x - 1)(x - 2)(x - 3)(x - 4)
+  std::array<double, 5> quartic = {1.0, -10.0, 35.0, -50.0, 24.0};
+  auto root = findSmallestQuarticRoot(quartic, 0.0, 10.0);
+  ASSERT_TRUE(root.has_value());
+  EXPECT_NEAR(*root, 1.0, 1e-10);
+
+  root = findSmallestQuarticRoot(quartic, 1.5, 10.0);
+  ASSERT_TRUE(root.has_value());
+  EXPECT_NEAR(*root, 2.0, 1e-10);
+
+  root = findSmallestQuarticRoot(quartic, 3.2, 3.9);
+  EXPECT_FALSE(root.has_value());
+
+  // x^4 + 1 has no real root
+  EXPECT_FALSE(
+      findSmallestQuarticRoot({1.0, 0.0, 0.0, 0.0, 1.0}, -10.0, 10.0)
+          .has_value());
+}
+
+TEST(PolynomialTest, CloseQuarticRootsAreSeparated) {
+  // (x - 5)(x - 5.000001)(x^2 + 1): two roots a fixed step march would merge
+  double a = 5.0;
+  double b = 5.000001;
+  std::array<double, 5> quartic = {1.0, -(a + b), a * b + 1.0, -(a + b),
+                                   a * b};
+  auto root = findSmallestQuarticRoot(quartic, 0.0, 100.0);
+  ASSERT_TRUE(root.has_value());
+  // The quartic is flat between the two roots, which bounds the accuracy
+  EXPECT_NEAR(*root, a, 1e-7);
+  EXPECT_LT(*root, b);
+}
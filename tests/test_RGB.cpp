@@ -0,0 +1,95 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Unit tests for RGB
+*/
+
+/**
+ * @file test_RGB.cpp
+ * @brief Unit tests for the linear radiance type and its tone mapping pass
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "../src/core/Color.hpp"
+#include "../src/core/RGB.hpp"
+
+using namespace RayTracer;
+
+TEST(RGBTest, AccumulatesWithoutClamping) {
+  RGB light(0.8f, 0.6f, 0.4f);
+  RGB sum = light + light + light;
+  EXPECT_FLOAT_EQ(sum.getR(), 2.4f);
+  EXPECT_FLOAT_EQ(sum.getB(), 1.2f);
+
+  // Small contributions are kept instead of rounding to a byte
+  RGB dim;
+  for (int i = 0; i < 100; ++i) {
+    dim += RGB(0.001f, 0.0f, 0.0f);
+  }
+  EXPECT_NEAR(dim.getR(), 0.1f, 1e-5f);
+
+  RGB filtered = RGB(Color::RED) * RGB(0.5f, 0.5f, 0.5f) * 4.0f;
+  EXPECT_EQ(filtered, RGB(2.0f, 0.0f, 0.0f));
+  EXPECT_EQ(filtered.clamped(), RGB(1.0f, 0.0f, 0.0f));
+  EXPECT_EQ(RGB(-1.0f, NAN, 0.5f).clamped(), RGB(0.0f, 0.0f, 0.5f));
+}
+
+TEST(RGBTest, BytesSurviveTheRoundTrip) {
+  for (int value = 0; value < 256; ++value) {
+    uint8_t byte = static_cast<uint8_t>(value);
+    Color color(byte, byte, static_cast<uint8_t>(255 - value));
+    EXPECT_EQ(quantize(RGB(color)), color) << value;
+  }
+}
+
+TEST(RGBTest, QuantizeMatchesTheScalarReference) {
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<float> channel(-0.5f, 3.0f);
+  // Odd counts leave channels for the scalar tail of the SIMD loop
+  std::vector<RGB> pixels;
+  for (int i = 0; i < 37; ++i) {
+    pixels.emplace_back(channel(rng), channel(rng), channel(rng));
+  }
+  pixels.emplace_back(std::numeric_limits<float>::infinity(), NAN, -0.0f);
+
+  for (auto toneMap : {ToneMap::CLAMP, ToneMap::REINHARD}) {
+    std::vector<uint8_t> bytes(pixels.size() * 3);
+    quantize(pixels.data(), pixels.size(), toneMap, bytes.data());
+    for (std::size_t i = 0; i < pixels.size(); ++i) {
+      float channels[3] = {pixels[i].getR(), pixels[i].getG(),
+                           pixels[i].getB()};
+      for (int c = 0; c < 3; ++c) {
+        float value = std::isnan(channels[c]) ? 0.0f
+                                              : std::max(channels[c], 0.0f);
+        if (toneMap == ToneMap::REINHARD) {
+          value = std::isinf(value) ? 1.0f : value / (1.0f + value);
+        }
+        int expected =
+            static_cast<int>(std::round(std::min(value, 1.0f) * 255.0f));
+        EXPECT_EQ(bytes[i * 3 + c], expected)
+            << toneMapName(toneMap) << " pixel " << i << " channel " << c;
+      }
+    }
+  }
+
+  // Reinhard keeps the highlights apart instead of clipping them
+  Color bright = quantize(RGB(2.0f, 4.0f, 1.0f), ToneMap::REINHARD);
+  EXPECT_LT(bright.getR(), bright.getG());
+  EXPECT_EQ(bright.getB(), 128);
+}
+
+TEST(RGBTest, ParsesToneMapNames) {
+  for (auto toneMap : {ToneMap::CLAMP, ToneMap::REINHARD}) {
+    EXPECT_EQ(parseToneMap(toneMapName(toneMap)), toneMap);
+  }
+  EXPECT_THROW(parseToneMap("filmic"), std::invalid_argument);
+}
@@ -0,0 +1,96 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Unit tests for Ray
+*/
+
+/**
+ * @file test_Ray.cpp
+ * @brief Unit tests for the Ray class
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include "../src/core/Ray.hpp"
+#include "../src/core/Transform.hpp"
+#include "../src/core/Vector3D.hpp"
+
+using namespace RayTracer;
+
+TEST(RayTest, InverseDirectionIsCached) {
+  Ray ray(Vector3D(0, 0, 0), Vector3D(0, 3, 4));
+  const Vector3D& inv = ray.getInverseDirection();
+  EXPECT_TRUE(std::isinf(inv.getX()));
+  EXPECT_NEAR(inv.getY(), 1.0 / 0.6, 1e-9);
+  EXPECT_NEAR(inv.getZ(), 1.0 / 0.8, 1e-9);
+}
+
+TEST(RayTest, InverseDirectionFollowsSetDirection) {
+  Ray ray;
+  ray.setDirection(Vector3D(-2, 0, 0));
+  EXPECT_NEAR(ray.getInverseDirection().getX(), -1.0, 1e-9);
+
+  Ray copy(ray);
+  EXPECT_NEAR(copy.getInverseDirection().getX(), -1.0, 1e-9);
+
+  Transform transform;
+  transform.rotateZ(90);
+  Ray turned = ray.transform(transform);
+  EXPECT_NEAR(turned.getInverseDirection().getY(), -1.0, 1e-9);
+}
+
+TEST(RayTest, SignFollowsDirection) {
+  Ray ray(Vector3D(0, 0, 0), Vector3D(-1, 2, 0));
+  EXPECT_EQ(ray.getSign(0), 1);
+  EXPECT_EQ(ray.getSign(1), 0);
+  EXPECT_EQ(ray.getSign(2), 0);
+
+  ray.setDirection(Vector3D(1, -1, -1));
+  EXPECT_EQ(ray.getSign(0), 0);
+  EXPECT_EQ(ray.getSign(1), 1);
+  EXPECT_EQ(ray.getSign(2), 1);
+}
+
+TEST(RayTest, DefaultIntervalIsUnbounded) {
+  Ray ray(Vector3D(0, 0, 0), Vector3D(0, 0, 1));
+  EXPECT_DOUBLE_EQ(ray.getTMin(), 0.0);
+  EXPECT_TRUE(std::isinf(ray.getTMax()));
+  EXPECT_TRUE(ray.isInInterval(0.0));
+  EXPECT_TRUE(ray.isInInterval(1e300));
+  EXPECT_FALSE(ray.isInInterval(-1e-9));
+}
+
+TEST(RayTest, ShrinkTMaxOnlyLowersTheBound) {
+  const Ray ray(Vector3D(0, 0, 0), Vector3D(0, 0, 1));
+  ray.shrinkTMax(5.0);
+  EXPECT_DOUBLE_EQ(ray.getTMax(), 5.0);
+  ray.shrinkTMax(8.0);
+  EXPECT_DOUBLE_EQ(ray.getTMax(), 5.0);
+  EXPECT_TRUE(ray.isInInterval(5.0));
+  EXPECT_FALSE(ray.isInInterval(5.1));
+}
+
+TEST(RayTest, IntervalIsCopiedAndTransformed) {
+  Ray ray(Vector3D(0, 0, 0), Vector3D(0, 0, 1));
+  ray.setInterval(0.5, 10.0);
+
+  Ray copy(ray);
+  EXPECT_DOUBLE_EQ(copy.getTMin(), 0.5);
+  EXPECT_DOUBLE_EQ(copy.getTMax(), 10.0);
+
+  Ray assigned;
+  assigned = ray;
+  EXPECT_DOUBLE_EQ(assigned.getTMax(), 10.0);
+
+  Transform transform;
+  transform.scale(2, 2, 2);
+  Ray scaled = ray.transform(transform);
+  EXPECT_DOUBLE_EQ(scaled.getTMin(), 0.5);
+  EXPECT_DOUBLE_EQ(scaled.getTMax(), 10.0);
+  // The same parameter still designates the same point
+  EXPECT_NEAR(scaled.pointAt(3.0).getZ(), 2.0 * ray.pointAt(3.0).getZ(), 1e-9);
+}
@@ -0,0 +1,221 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Unit tests for Renderer
+*/
+
+/**
+ * @file test_Renderer.cpp
+ * @brief Unit tests for the persistent render engine
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+#include "../include/IPrimitive.hpp"
+#include "../src/display/Renderer.hpp"
+#include "../src/scene/Camera.hpp"
+#include "../src/scene/Scene.hpp"
+#include "TestHelpers.hpp"
+
+using namespace RayTracer;
+
+namespace {
+
+/**
+ * @brief Unbounded primitive that is never hit and records, in order, the
+ * direction of every ray tested against it
+ */
+class RayRecorder : public IPrimitive {
+ public:
+  std::optional<Intersection> intersect(const Ray& ray) const override {
+    std::lock_guard<std::mutex> lock(*_mutex);
+    _directions->push_back(ray.getDirection());
+    return std::nullopt;
+  }
+
+  void setTransform(const Transform&) override {}
+  Transform getTransform() const override { return Transform(); }
+  void setColor(const Color&) override {}
+  Color getColor() const override { return Color::RED; }
+  Vector3D getNormalAt(const Vector3D&) const override {
+    return Vector3D(0, 0, 1);
+  }
+  std::shared_ptr<IPrimitive> clone() const override {
+    return std::make_shared<RayRecorder>(*this);
+  }
+
+  std::vector<Vector3D> directions() const {
+    std::lock_guard<std::mutex> lock(*_mutex);
+    return *_directions;
+  }
+
+ private:
+  std::shared_ptr<std::mutex> _mutex = std::make_shared<std::mutex>();
+  std::shared_ptr<std::vector<Vector3D>> _directions =
+      std::make_shared<std::vector<Vector3D>>();
+};
+
+}  // namespace
+
+TEST(RendererTest, ReusesTheFramebufferAcrossFrames) {
+  Scene scene = makeSphereRowScene(150, 100);
+  Renderer renderer(2);
+  ASSERT_TRUE(renderer.renderFrame(scene));
+  EXPECT_EQ(renderer.getWidth(), 150);
+  EXPECT_EQ(renderer.getHeight(), 100);
+  std::vector<RGB> first = renderer.getFramebuffer();
+  const RGB* pixels = renderer.getFramebuffer().data();
+
+  // Same resolution: same buffer, same image
+  renderer.clear();
+  ASSERT_TRUE(renderer.renderFrame(scene));
+  EXPECT_EQ(renderer.getFramebuffer().data(), pixels);
+  EXPECT_EQ(renderer.getFramebuffer(), first);
+
+  // A new resolution resizes it
+  Scene small = makeSphereRowScene(40, 30);
+  ASSERT_TRUE(renderer.renderFrame(small));
+  EXPECT_EQ(renderer.getWidth(), 40);
+  EXPECT_EQ(renderer.getFramebuffer().size(), 40u * 30u);
+}
+
+TEST(RendererTest, SettingsDoNotChangeTheImage) {
+  Scene scene = makeSphereRowScene(150, 100);
+  Renderer reference(1);
+  ASSERT_TRUE(reference.renderFrame(scene));
+
+  Renderer renderer;
+  RenderSettings settings;
+  for (int threads : {1, 3, 0}) {
+    renderer.setThreadCount(threads);
+    EXPECT_EQ(renderer.getThreadCount(), threads);
+    for (int tileSize : {16, 37}) {
+      settings.tileSize = tileSize;
+      settings.packetSize = tileSize == 16 ? 4 : 8;
+      settings.tileOrder =
+          tileSize == 16 ? TileOrder::SPIRAL : TileOrder::RASTER;
+      renderer.clear(RGB(1.0f, 1.0f, 1.0f));
+      ASSERT_TRUE(renderer.renderFrame(scene, settings));
+      EXPECT_EQ(renderer.getFramebuffer(), reference.getFramebuffer())
+          << threads << " threads, " << tileSize << " pixel tiles";
+    }
+  }
+}
+
+TEST(RendererTest, ReportsTheEndOfTheFrame) {
+  Scene scene = makeSphereRowScene(64, 64);
+  Renderer renderer;
+  RenderSettings settings;
+  double last = -1.0;
+  settings.progress = [&last](double progress, double) { last = progress; };
+  ASSERT_TRUE(renderer.renderFrame(scene, settings));
+  EXPECT_DOUBLE_EQ(last, 100.0);
+}
+
+TEST(RendererTest, RejectsInvalidSettings) {
+  Scene scene = makeSphereRowScene(8, 8);
+  Renderer renderer(1);
+  RenderSettings settings;
+  settings.packetSize = 3;
+  EXPECT_THROW(renderer.renderFrame(scene, settings), std::invalid_argument);
+  settings.packetSize = 8;
+  settings.tileSize = -1;
+  EXPECT_THROW(renderer.renderFrame(scene, settings), std::invalid_argument);
+  EXPECT_THROW(renderer.setThreadCount(-2), std::invalid_argument);
+  EXPECT_THROW(Renderer(-1), std::invalid_argument);
+}
+
+TEST(RendererTest, SplitsTheLastTilesWithoutChangingTheImage) {
+  Scene scene = makeSphereRowScene(150, 100);
+  Renderer reference(1);
+  ASSERT_TRUE(reference.renderFrame(scene));
+
+  // Six tiles for three threads: the last ones are split
+  Renderer renderer(3);
+  RenderSettings settings;
+  settings.tileSize = 64;
+  ASSERT_TRUE(renderer.renderFrame(scene, settings));
+  EXPECT_EQ(renderer.getFrameStats().tileSize, 64);
+  EXPECT_EQ(renderer.getFrameStats().tiles, 6);
+  EXPECT_GT(renderer.getFrameStats().splitTiles, 0);
+  EXPECT_EQ(renderer.getFramebuffer(), reference.getFramebuffer());
+
+  settings.splitTiles = false;
+  renderer.clear();
+  ASSERT_TRUE(renderer.renderFrame(scene, settings));
+  EXPECT_EQ(renderer.getFrameStats().splitTiles, 0);
+  EXPECT_EQ(renderer.getFramebuffer(), reference.getFramebuffer());
+}
+
+TEST(RendererTest, TunesTheTileSizeFromTheLastFrame) {
+  Scene scene = makeSphereRowScene(320, 240);
+  Renderer renderer(2);
+  ASSERT_TRUE(renderer.renderFrame(scene));
+  const FrameStats& stats = renderer.getFrameStats();
+  EXPECT_EQ(stats.tileSize, RenderSettings::DEFAULT_TILE_SIZE);
+  EXPECT_GT(stats.busySeconds, 0.0);
+  EXPECT_GT(stats.utilization, 0.0);
+  EXPECT_LE(stats.utilization, 1.01);
+
+  int tuned = renderer.getTunedTileSize();
+  EXPECT_GE(tuned, 16);
+  EXPECT_LE(tuned, 128);
+  EXPECT_EQ(tuned & (tuned - 1), 0) << tuned;
+
+  // At least 8 tiles per thread
+  EXPECT_GE(((320 + tuned - 1) / tuned) * ((240 + tuned - 1) / tuned), 16);
+
+  ASSERT_TRUE(renderer.renderFrame(scene));
+  EXPECT_EQ(renderer.getFrameStats().tileSize, tuned);
+}
+
+TEST(RendererTest, TilesStartInTheOrderOfTheList) {
+  Scene scene(Camera(Vector3D(0, 0, 0), 256, 256, 60.0));
+  auto recorder = std::make_shared<RayRecorder>();
+  scene.addPrimitive(recorder);
+  scene.finalize();
+
+  const int threads = 4;
+  Renderer renderer(threads);
+  RenderSettings settings;
+  settings.tileSize = 16;
+  settings.tileOrder = TileOrder::SPIRAL;
+  settings.splitTiles = false;
+  ASSERT_TRUE(renderer.renderFrame(scene, settings));
+
+  // The first ray of a tile is the one of its top left pixel
+  TileManager tiles(256, 256, 16, TileOrder::SPIRAL);
+  std::vector<Vector3D> starts;
+  for (int i = 0; i < tiles.getTotalTiles(); ++i) {
+    const RenderTile& tile = tiles.getTile(i);
+    starts.push_back(
+        scene.getCamera()
+            .generateRay(tile.getStartX(), tile.getStartY())
+            .getDirection());
+  }
+  std::vector<int> started;
+  for (const Vector3D& direction : recorder->directions()) {
+    for (int i = 0; i < static_cast<int>(starts.size()); ++i) {
+      if ((direction - starts[i]).getMagnitude() < 1e-9 &&
+          std::find(started.begin(), started.end(), i) == started.end()) {
+        started.push_back(i);
+      }
+    }
+  }
+  ASSERT_EQ(started.size(), starts.size());
+
+  // When a tile starts, every earlier tile was handed out, and only the
+  // other threads can hold one that has not started yet
+  for (int k = 0; k < static_cast<int>(started.size()); ++k) {
+    EXPECT_LE(started[k], k + threads - 1) << "tile started " << k << "th";
+  }
+}
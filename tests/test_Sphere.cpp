@@ -295,3 +295,23 @@ TEST(SphereTest, NormalOnTransformedSphere) {
   EXPECT_TRUE(
       vectorsNearlyEqual_Sphere(normal.normalized(), Vector3D(0, 0, 1)));
 }
+
+TEST(SphereTest, IntersectionHonoursRayInterval) {
+  Sphere sphere(Vector3D(0, 0, 5), 1.0, Color::RED);
+  Ray ray(Vector3D(0, 0, 0), Vector3D(0, 0, 1));
+
+  auto hit = sphere.intersect(ray);
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_NEAR(hit->distance, 4.0, 1e-9);
+  // The closest hit shrinks the interval of the ray
+  EXPECT_NEAR(ray.getTMax(), 4.0, 1e-9);
+  ray.shrinkTMax(3.5);
+  EXPECT_FALSE(sphere.intersect(ray).has_value());
+
+  // Starting the interval past the front face reports the back face
+  Ray inside(Vector3D(0, 0, 0), Vector3D(0, 0, 1));
+  inside.setInterval(4.5, 100.0);
+  hit = sphere.intersect(inside);
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_NEAR(hit->distance, 6.0, 1e-9);
+}
@@ -0,0 +1,234 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Unit tests for SphereBlock
+*/
+
+/**
+ * @file test_SphereBlock.cpp
+ * @brief Unit tests for the packed sphere block, checking every kernel the
+ * processor runs against the Sphere primitive
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+#include "../src/core/Color.hpp"
+#include "../src/core/Ray.hpp"
+#include "../src/core/Transform.hpp"
+#include "../src/core/Vector3D.hpp"
+#include "../src/scene/Scene.hpp"
+#include "../src/scene/acceleration/SphereBlock.hpp"
+#include "../src/scene/lights/PointLight.hpp"
+#include "../src/scene/primitives/Plane.hpp"
+#include "../src/scene/primitives/Sphere.hpp"
+#include "../src/scene/primitives/Triangle.hpp"
+#include "TestHelpers.hpp"
+
+using namespace RayTracer;
+
+namespace {
+
+std::vector<Sphere> makeSpheres(unsigned seed, int count, bool transformed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> position(-10.0, 10.0);
+  std::uniform_real_distribution<double> radius(0.2, 2.0);
+  std::uniform_real_distribution<double> angle(0.0, 360.0);
+  std::vector<Sphere> spheres;
+  for (int i = 0; i < count; ++i) {
+    Sphere sphere(Vector3D(position(rng), position(rng), position(rng)),
+                  radius(rng), Color::RED);
+    if (transformed) {
+      Transform transform;
+      transform.translate(position(rng), position(rng), position(rng));
+      transform.rotateY(angle(rng));
+      transform.scale(radius(rng));
+      sphere.setTransform(transform);
+    }
+    spheres.push_back(sphere);
+  }
+  return spheres;
+}
+
+/**
+ * @brief Bake every sphere into a block, tagged with its index
+ */
+SphereBlock makeBlock(const std::vector<Sphere>& spheres) {
+  SphereBlock block;
+  for (std::size_t i = 0; i < spheres.size(); ++i) {
+    Vector3D center;
+    double radius = 0.0;
+    EXPECT_TRUE(SphereBlock::bake(spheres[i], center, radius));
+    block.add(center, radius, i);
+  }
+  return block;
+}
+
+}  // namespace
+
+TEST(SphereBlockTest, KernelDetection) {
+  EXPECT_TRUE(supportsSimdKernel(SimdKernel::SCALAR));
+  EXPECT_TRUE(supportsSimdKernel(bestSimdKernel()));
+  SphereBlock block;
+  EXPECT_EQ(block.getKernel(), bestSimdKernel());
+  EXPECT_EQ(block.size(), 0u);
+  block.setKernel(SimdKernel::SCALAR);
+  EXPECT_EQ(block.getKernel(), SimdKernel::SCALAR);
+  EXPECT_EQ(simdKernelName(SimdKernel::AVX), "avx");
+}
+
+TEST(SphereBlockTest, BakesOnlyRoundSpheres) {
+  Sphere sphere(Vector3D(1, 2, 3), 2.0, Color::RED);
+  Vector3D center;
+  double radius = 0.0;
+  ASSERT_TRUE(SphereBlock::bake(sphere, center, radius));
+  EXPECT_EQ(center, Vector3D(1, 2, 3));
+  EXPECT_DOUBLE_EQ(radius, 2.0);
+
+  Transform transform;
+  transform.translate(10, 0, 0).scale(3.0);
+  sphere.setTransform(transform);
+  ASSERT_TRUE(SphereBlock::bake(sphere, center, radius));
+  // The scale applies after the translation
+  EXPECT_NEAR(center.getX(), 33.0, 1e-12);
+  EXPECT_NEAR(center.getY(), 6.0, 1e-12);
+  EXPECT_NEAR(center.getZ(), 9.0, 1e-12);
+  EXPECT_DOUBLE_EQ(radius, 6.0);
+
+  // An ellipsoid cannot be baked
+  sphere.setTransform(Transform().scale(1.0, 2.0, 1.0));
+  EXPECT_FALSE(SphereBlock::bake(sphere, center, radius));
+}
+
+TEST(SphereBlockTest, MatchesSphereIntersect) {
+  std::vector<Sphere> spheres = makeSpheres(3, 13, false);
+  SphereBlock block = makeBlock(spheres);
+  ASSERT_EQ(block.size(), spheres.size());
+
+  for (auto kernel : supportedKernels()) {
+    block.setKernel(kernel);
+    for (const auto& ray : makeRandomRays(5, 2000)) {
+      // Untransformed spheres give the same parameter to the bit
+      for (std::size_t i = 0; i < spheres.size(); ++i) {
+        Ray expectedRay(ray);
+        Ray actualRay(ray);
+        auto expected = spheres[i].intersectHit(expectedRay);
+        auto actual = block.intersect(actualRay, i, i + 1);
+        ASSERT_EQ(expected.has_value(), actual.has_value())
+            << simdKernelName(kernel) << " sphere " << i;
+        if (expected) {
+          EXPECT_EQ(expected->t, actual->t);
+          EXPECT_EQ(actual->primitiveIndex, i);
+          EXPECT_EQ(expectedRay.getTMax(), actualRay.getTMax());
+        }
+        EXPECT_EQ(spheres[i].occluded(ray, 8.0),
+                  block.occluded(ray, i, i + 1, 8.0));
+      }
+
+      // The whole block reports the closest sphere
+      std::optional<double> closest;
+      for (const auto& sphere : spheres) {
+        auto hit = sphere.intersectHit(Ray(ray));
+        if (hit && (!closest || hit->t < *closest)) {
+          closest = hit->t;
+        }
+      }
+      auto actual = block.intersect(Ray(ray), 0, block.size());
+      ASSERT_EQ(closest.has_value(), actual.has_value());
+      if (closest) {
+        EXPECT_EQ(*closest, actual->t);
+      }
+    }
+  }
+}
+
+TEST(SphereBlockTest, MatchesTransformedSpheres) {
+  std::vector<Sphere> spheres = makeSpheres(4, 9, true);
+  SphereBlock block = makeBlock(spheres);
+  for (auto kernel : supportedKernels()) {
+    block.setKernel(kernel);
+    for (const auto& ray : makeRandomRays(6, 2000)) {
+      for (std::size_t i = 0; i < spheres.size(); ++i) {
+        // Both shrink the ray interval, so each gets its own copy
+        auto expected = spheres[i].intersectHit(Ray(ray));
+        auto actual = block.intersect(Ray(ray), i, i + 1);
+        ASSERT_EQ(expected.has_value(), actual.has_value());
+        if (expected) {
+          EXPECT_NEAR(expected->t, actual->t, 1e-9 * (1.0 + expected->t));
+        }
+      }
+    }
+  }
+}
+
+TEST(SphereBlockTest, TiesGoToTheLowestTag) {
+  SphereBlock block;
+  block.add(Vector3D(0, 0, 10), 1.0, 7);
+  block.add(Vector3D(0, 0, 10), 1.0, 3);
+  block.add(Vector3D(0, 0, 20), 1.0, 1);
+  for (auto kernel : supportedKernels()) {
+    block.setKernel(kernel);
+    Ray ray(Vector3D(0, 0, 0), Vector3D(0, 0, 1));
+    auto hit = block.intersect(ray, 0, block.size());
+    ASSERT_TRUE(hit);
+    EXPECT_DOUBLE_EQ(hit->t, 9.0);
+    EXPECT_EQ(hit->primitiveIndex, 3u);
+    EXPECT_DOUBLE_EQ(ray.getTMax(), 9.0);
+    // Ranges stop where asked, the padding is never hit
+    EXPECT_FALSE(block.intersect(Ray(Vector3D(0, 0, 15), Vector3D(0, 0, -1)),
+                                 2, 3));
+    EXPECT_FALSE(block.occluded(ray, 0, 2, 8.5));
+    EXPECT_TRUE(block.occluded(ray, 0, 2, 9.0));
+  }
+}
+
+TEST(SphereBlockTest, SceneMatchesVirtualPrimitives) {
+  std::mt19937 rng(9);
+  std::uniform_real_distribution<double> position(-10.0, 10.0);
+  std::uniform_real_distribution<double> radius(0.2, 1.0);
+  Scene linear;
+  linear.addPrimitive(std::make_shared<Plane>('Y', -12.0, Color::GRAY));
+  for (int i = 0; i < 600; ++i) {
+    Vector3D center(position(rng), position(rng), position(rng));
+    if (i % 3 == 2) {
+      linear.addPrimitive(std::make_shared<Triangle>(
+          center, center + Vector3D(radius(rng), 0, 0),
+          center + Vector3D(0, radius(rng), 0), Color::GREEN));
+      continue;
+    }
+    auto sphere = std::make_shared<Sphere>(center, radius(rng), Color::RED);
+    if (i % 3 == 1) {
+      // Not baked: stays a virtual call inside the leaves
+      sphere->setTransform(Transform().scale(1.0, 1.5, 1.0));
+    }
+    linear.addPrimitive(sphere);
+  }
+
+  Scene baked = linear;
+  baked.finalize();
+  EXPECT_EQ(baked.getSphereBlock().size(), 200u);
+  auto light = std::make_shared<PointLight>(Vector3D(0, 30, 0));
+
+  std::vector<Ray> rays = makeRandomRays(10, 2000);
+  std::vector<std::optional<Intersection>> packetHits;
+  baked.traceRays(rays, packetHits);
+  for (std::size_t i = 0; i < rays.size(); ++i) {
+    auto expected = linear.traceRay(rays[i]);
+    auto actual = baked.traceRay(rays[i]);
+    ASSERT_EQ(expected.has_value(), actual.has_value());
+    ASSERT_EQ(expected.has_value(), packetHits[i].has_value());
+    if (expected) {
+      EXPECT_EQ(expected->distance, actual->distance);
+      EXPECT_EQ(expected->color, actual->color);
+      EXPECT_EQ(actual->distance, packetHits[i]->distance);
+      EXPECT_EQ(linear.isInShadow(expected->point, light),
+                baked.isInShadow(expected->point, light));
+    }
+  }
+}
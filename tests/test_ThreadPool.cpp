@@ -0,0 +1,152 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Unit tests for ThreadPool
+*/
+
+/**
+ * @file test_ThreadPool.cpp
+ * @brief Unit tests for the work-stealing thread pool, its futures and its
+ * parallel loops
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "../src/core/ThreadPool.hpp"
+
+using namespace RayTracer;
+
+TEST(ThreadPoolTest, EnqueueReturnsResults) {
+  ThreadPool pool(3);
+  EXPECT_EQ(pool.size(), 3u);
+  std::vector<std::future<int>> results;
+  for (int i = 0; i < 1000; ++i) {
+    results.push_back(pool.enqueue([](int value) { return value * 2; }, i));
+  }
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(results[i].get(), i * 2);
+  }
+
+  auto failing = pool.enqueue([]() -> int { throw std::runtime_error("x"); });
+  EXPECT_THROW(failing.get(), std::runtime_error);
+}
+
+TEST(ThreadPoolTest, DestructorRunsQueuedTasks) {
+  std::atomic<int> ran(0);
+  {
+    ThreadPool pool(2);
+    pool.setActive(false);
+    // More tasks than a deque holds at first: the rings grow
+    for (int i = 0; i < 1000; ++i) {
+      pool.enqueue([&ran]() { ran++; });
+    }
+    EXPECT_EQ(ran.load(), 0);
+    EXPECT_EQ(pool.queueSize(), 1000u);
+  }
+  EXPECT_EQ(ran.load(), 1000);
+}
+
+TEST(ThreadPoolTest, ParallelForVisitsEveryIndexOnce) {
+  ThreadPool pool(4);
+  for (std::size_t grain : {0u, 1u, 3u, 64u, 5000u}) {
+    std::vector<std::atomic<int>> visits(1000);
+    pool.parallelFor(17, 1000, grain, [&](std::size_t first, std::size_t last) {
+      EXPECT_LT(first, last);
+      EXPECT_LE(last - first, grain == 0 ? 1 : grain);
+      for (std::size_t i = first; i < last; ++i) {
+        visits[i]++;
+      }
+    });
+    for (std::size_t i = 0; i < visits.size(); ++i) {
+      EXPECT_EQ(visits[i].load(), i < 17 ? 0 : 1) << "grain " << grain;
+    }
+  }
+
+  // Empty ranges call nothing
+  pool.parallelFor(5, 5, 1, [](std::size_t, std::size_t) { FAIL(); });
+}
+
+TEST(ThreadPoolTest, ParallelForNestsInsideTasks) {
+  ThreadPool pool(2);
+  std::atomic<long> sum(0);
+  // The callers work on their own loops, so nesting never waits on a
+  // worker that is itself waiting
+  pool.parallelFor(0, 8, 1, [&](std::size_t first, std::size_t last) {
+    for (std::size_t outer = first; outer < last; ++outer) {
+      pool.parallelFor(0, 100, 7, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          sum += static_cast<long>(i);
+        }
+      });
+    }
+  });
+  EXPECT_EQ(sum.load(), 8 * 4950);
+
+  auto nested = pool.enqueue([&pool]() {
+    std::atomic<int> count(0);
+    pool.parallelFor(0, 50, 1, [&](std::size_t first, std::size_t last) {
+      count += static_cast<int>(last - first);
+    });
+    return count.load();
+  });
+  EXPECT_EQ(nested.get(), 50);
+}
+
+TEST(ThreadPoolTest, ParallelForCallerHelpsWithLateNestedLoops) {
+  ThreadPool pool(1);
+  std::thread::id caller = std::this_thread::get_id();
+  std::atomic<int> nestedOnCaller(0);
+  std::atomic<bool> workerStarted(false);
+  pool.parallelFor(0, 2, 1, [&](std::size_t first, std::size_t) {
+    if (first == 0) {
+      // Keeps the caller busy until the worker owns the other chunk
+      while (!workerStarted) {
+        std::this_thread::yield();
+      }
+      return;
+    }
+    workerStarted = true;
+    // Posted once the caller ran out of chunks and waits for this one
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    pool.parallelFor(0, 20, 1, [&](std::size_t, std::size_t) {
+      if (std::this_thread::get_id() == caller) {
+        nestedOnCaller++;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    });
+  });
+  EXPECT_GT(nestedOnCaller.load(), 0);
+}
+
+TEST(ThreadPoolTest, ParallelForRethrowsTheFirstError) {
+  ThreadPool pool(3);
+  std::atomic<int> ran(0);
+  EXPECT_THROW(
+      pool.parallelFor(0, 200, 1,
+                       [&](std::size_t first, std::size_t) {
+                         ran++;
+                         if (first == 10) {
+                           throw std::invalid_argument("chunk 10");
+                         }
+                         std::this_thread::sleep_for(
+                             std::chrono::microseconds(50));
+                       }),
+      std::invalid_argument);
+  EXPECT_LT(ran.load(), 200);
+
+  // The pool is still usable afterwards
+  std::atomic<int> count(0);
+  pool.parallelFor(0, 64, 4, [&](std::size_t first, std::size_t last) {
+    count += static_cast<int>(last - first);
+  });
+  EXPECT_EQ(count.load(), 64);
+}
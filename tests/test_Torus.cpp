@@ -103,3 +103,47 @@ TEST(TorusTest, Clone) {
   EXPECT_EQ(clone->getTubeRadius(), 2.0);
   EXPECT_EQ(clone->getColor(), Color::MAGENTA);
 }
+
+TEST(TorusTest, ExactHitDistances) {
+  Torus torus(10.0, 2.0, Color::GREEN);
+  // From the center the first hit is the inner side of the tube
+  auto intersection =
+      torus.intersect(Ray(Vector3D(0, 0, 0), Vector3D(1, 0, 0)));
+  ASSERT_TRUE(intersection.has_value());
+  EXPECT_NEAR(intersection->distance, 8.0, 1e-9);
+
+  // Straight down through the tube
+  intersection = torus.intersect(Ray(Vector3D(10, 5, 0), Vector3D(0, -1, 0)));
+  ASSERT_TRUE(intersection.has_value());
+  EXPECT_NEAR(intersection->distance, 3.0, 1e-9);
+  EXPECT_VECTORS_NEARLY_EQUAL_TORUS(intersection->point, Vector3D(10, 2, 0),
+                                    1e-9);
+}
+
+TEST(TorusTest, HitsBeyondOneHundredUnits) {
+  Torus torus(10.0, 2.0, Color::GREEN);
+  auto intersection =
+      torus.intersect(Ray(Vector3D(-500, 0, 0), Vector3D(1, 0, 0)));
+  ASSERT_TRUE(intersection.has_value());
+  EXPECT_NEAR(intersection->distance, 488.0, 1e-6);
+}
+
+TEST(TorusTest, RayThroughTheHoleMisses) {
+  Torus torus(10.0, 2.0, Color::GREEN);
+  // Along the axis of revolution, through the hole
+  EXPECT_FALSE(
+      torus.intersect(Ray(Vector3D(0, 50, 0), Vector3D(0, -1, 0))).has_value());
+  // Grazing above the tube
+  EXPECT_FALSE(
+      torus.intersect(Ray(Vector3D(-50, 2.01, 0), Vector3D(1, 0, 0)))
+          .has_value());
+}
+
+TEST(TorusTest, ThinTubeIsNotSkipped) {
+  // A fixed-step march would step over a tube this thin
+  Torus torus(5.0, 0.001, Color::GREEN);
+  auto intersection =
+      torus.intersect(Ray(Vector3D(5, 3, 0), Vector3D(0, -1, 0)));
+  ASSERT_TRUE(intersection.has_value());
+  EXPECT_NEAR(intersection->distance, 2.999, 1e-9);
+}
@@ -275,3 +275,100 @@ TEST(TransformTest, DegenerateTransform) {
   // Zero scaling makes matrix non-invertible
   EXPECT_THROW(transform.scale(0.0, 1.0, 1.0), RaytracerException);
 }
+
+// Test the class chosen for the fast paths
+TEST(TransformTest, ClassifiesTransforms) {
+  EXPECT_EQ(Transform().getKind(), TransformKind::IDENTITY);
+  EXPECT_EQ(Transform().translate(1, 2, 3).getKind(),
+            TransformKind::TRANSLATION);
+  EXPECT_EQ(Transform().scale(2.0).translate(1, 0, 0).getKind(),
+            TransformKind::UNIFORM_SCALE);
+  EXPECT_EQ(Transform().scale(1.0, 2.0, 1.0).getKind(),
+            TransformKind::AFFINE);
+  EXPECT_EQ(Transform().rotateY(30).getKind(), TransformKind::AFFINE);
+  // A round trip that lands back on the identity matrix is the identity
+  EXPECT_EQ(Transform().translate(1, 2, 3).translate(-1, -2, -3).getKind(),
+            TransformKind::IDENTITY);
+  Transform scaled = Transform().scale(4.0).translate(1, 2, 3);
+  EXPECT_EQ(scaled.inverse().getKind(), TransformKind::UNIFORM_SCALE);
+  EXPECT_TRUE(scaled.isAffine());
+}
+
+// Test that every fast path gives the result of the full matrix
+TEST(TransformTest, FastPathsMatchTheMatrix) {
+  Transform transforms[] = {
+      Transform(),
+      Transform().translate(1.5, -2.0, 0.25),
+      Transform().scale(3.0).translate(1.5, -2.0, 0.25),
+      Transform().scale(1.0, 2.0, 0.5).rotateX(20).rotateZ(45).translate(
+          1.0, 2.0, 3.0),
+  };
+  Vector3D samples[] = {Vector3D(1.0, 2.0, 3.0), Vector3D(-0.3, 7.5, -2.25),
+                        Vector3D(0.1, 0.2, -0.7)};
+  for (const auto& transform : transforms) {
+    Matrix m = transform.getMatrix();
+    Matrix inv = transform.getInverseMatrix();
+    for (const auto& p : samples) {
+      double x = p.getX();
+      double y = p.getY();
+      double z = p.getZ();
+      Vector3D point(m.at(0, 0) * x + m.at(0, 1) * y + m.at(0, 2) * z +
+                         m.at(0, 3),
+                     m.at(1, 0) * x + m.at(1, 1) * y + m.at(1, 2) * z +
+                         m.at(1, 3),
+                     m.at(2, 0) * x + m.at(2, 1) * y + m.at(2, 2) * z +
+                         m.at(2, 3));
+      Vector3D vector(m.at(0, 0) * x + m.at(0, 1) * y + m.at(0, 2) * z,
+                      m.at(1, 0) * x + m.at(1, 1) * y + m.at(1, 2) * z,
+                      m.at(2, 0) * x + m.at(2, 1) * y + m.at(2, 2) * z);
+      Vector3D normal(
+          inv.at(0, 0) * x + inv.at(1, 0) * y + inv.at(2, 0) * z,
+          inv.at(0, 1) * x + inv.at(1, 1) * y + inv.at(2, 1) * z,
+          inv.at(0, 2) * x + inv.at(1, 2) * y + inv.at(2, 2) * z);
+      EXPECT_EQ(transform.applyToPoint(p), point);
+      EXPECT_EQ(transform.applyToVector(p), vector);
+      EXPECT_EQ(transform.applyToNormal(p), normal);
+    }
+  }
+}
+
+// Test the inverse composed operation by operation
+TEST(TransformTest, ComposedInverseUndoesTheMatrix) {
+  Transform transform;
+  transform.translate(3.0, -4.0, 5.0)
+      .rotateX(25.0)
+      .rotateY(-40.0)
+      .rotateZ(70.0)
+      .scale(2.0, 0.5, 3.0)
+      .combine(Transform().translate(1.0, 1.0, 1.0).scale(1.5));
+  Matrix product = transform.getMatrix() * transform.getInverseMatrix();
+  for (int row = 0; row < 4; ++row) {
+    for (int col = 0; col < 4; ++col) {
+      EXPECT_NEAR(product.at(row, col), row == col ? 1.0 : 0.0, 1e-12);
+    }
+  }
+  // Same inverse as a full inversion of the matrix
+  EXPECT_EQ(transform.getInverseMatrix(), transform.getMatrix().inverse());
+}
+
+// Test the closed-form affine inverse against the general one
+TEST(TransformTest, MatrixInverseHandlesBothForms) {
+  Matrix affine({2.0, 0.5, 0.0, 1.0,  //
+                 0.0, 1.0, -1.0, 2.0,  //
+                 1.0, 0.0, 3.0, -3.0,  //
+                 0.0, 0.0, 0.0, 1.0});
+  Matrix projective({1.0, 0.0, 0.0, 0.0,  //
+                     0.0, 1.0, 0.0, 0.0,  //
+                     0.0, 0.0, 1.0, 0.0,  //
+                     0.0, 0.0, 0.5, 1.0});
+  EXPECT_TRUE(affine.isAffine());
+  EXPECT_FALSE(projective.isAffine());
+  for (const Matrix& matrix : {affine, projective}) {
+    EXPECT_EQ(matrix * matrix.inverse(), Matrix());
+  }
+  Matrix singular({1.0, 2.0, 3.0, 0.0,  //
+                   2.0, 4.0, 6.0, 0.0,  //
+                   0.0, 0.0, 1.0, 0.0,  //
+                   0.0, 0.0, 0.0, 1.0});
+  EXPECT_THROW(singular.inverse(), std::runtime_error);
+}
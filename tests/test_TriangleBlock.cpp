@@ -0,0 +1,223 @@
+/*
+** EPITECH PROJECT, 2025
+** Raytracer
+** File description:
+** Unit tests for TriangleBlock
+*/
+
+/**
+ * @file test_TriangleBlock.cpp
+ * @brief Unit tests for the packed triangle block, checking every kernel the
+ * processor runs against the Triangle primitive, and the meshes and scenes
+ * built on it
+ * @author @paul-antoine
+ * @date 2026-10-17
+ * @version 1.0
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+#include "../src/core/Color.hpp"
+#include "../src/core/Ray.hpp"
+#include "../src/core/Transform.hpp"
+#include "../src/core/Vector3D.hpp"
+#include "../src/scene/Scene.hpp"
+#include "../src/scene/acceleration/TriangleBlock.hpp"
+#include "../src/scene/lights/PointLight.hpp"
+#include "../src/scene/primitives/Mesh.hpp"
+#include "../src/scene/primitives/Plane.hpp"
+#include "../src/scene/primitives/Triangle.hpp"
+#include "TestHelpers.hpp"
+
+using namespace RayTracer;
+
+namespace {
+
+std::vector<Triangle> makeTriangles(unsigned seed, int count) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> position(-10.0, 10.0);
+  std::uniform_real_distribution<double> offset(-3.0, 3.0);
+  std::vector<Triangle> triangles;
+  for (int i = 0; i < count; ++i) {
+    Vector3D a(position(rng), position(rng), position(rng));
+    triangles.emplace_back(a, a + Vector3D(offset(rng), offset(rng), 0.0),
+                           a + Vector3D(0.0, offset(rng), offset(rng)),
+                           Color::GREEN);
+  }
+  return triangles;
+}
+
+}  // namespace
+
+TEST(TriangleBlockTest, BakesWorldVertices) {
+  Triangle triangle(Vector3D(0, 0, 0), Vector3D(1, 0, 0), Vector3D(0, 1, 0),
+                    Color::RED);
+  triangle.setTransform(Transform().translate(0, 0, 5));
+  Vector3D a;
+  Vector3D b;
+  Vector3D c;
+  ASSERT_TRUE(TriangleBlock::bake(triangle, a, b, c));
+  EXPECT_EQ(a, Vector3D(0, 0, 5));
+  EXPECT_EQ(b, Vector3D(1, 0, 5));
+  EXPECT_EQ(c, Vector3D(0, 1, 5));
+
+  TriangleBlock block;
+  EXPECT_EQ(block.getKernel(), bestSimdKernel());
+  block.add(a, b, c, 4);
+  EXPECT_EQ(block.size(), 1u);
+  EXPECT_EQ(block.getTag(0), 4u);
+  block.setKernel(SimdKernel::SCALAR);
+  EXPECT_EQ(block.getKernel(), SimdKernel::SCALAR);
+  block.clear();
+  EXPECT_EQ(block.size(), 0u);
+}
+
+TEST(TriangleBlockTest, MatchesTriangleIntersect) {
+  std::vector<Triangle> triangles = makeTriangles(3, 15);
+  TriangleBlock block;
+  for (std::size_t i = 0; i < triangles.size(); ++i) {
+    block.add(triangles[i].getA(), triangles[i].getB(), triangles[i].getC(),
+              i);
+  }
+
+  for (auto kernel : supportedKernels()) {
+    block.setKernel(kernel);
+    for (const auto& ray : makeRandomRays(5, 4000)) {
+      // Untransformed triangles give the same hit to the bit
+      for (std::size_t i = 0; i < triangles.size(); ++i) {
+        Ray expectedRay(ray);
+        Ray actualRay(ray);
+        auto expected = triangles[i].intersectHit(expectedRay);
+        auto actual = block.intersect(actualRay, i, i + 1);
+        ASSERT_EQ(expected.has_value(), actual.has_value())
+            << simdKernelName(kernel) << " triangle " << i;
+        if (expected) {
+          EXPECT_EQ(expected->t, actual->t);
+          EXPECT_EQ(expected->u, actual->u);
+          EXPECT_EQ(expected->v, actual->v);
+          EXPECT_EQ(actual->primitiveIndex, i);
+          EXPECT_EQ(expectedRay.getTMax(), actualRay.getTMax());
+        }
+        EXPECT_EQ(triangles[i].occluded(ray, 8.0),
+                  block.occluded(ray, i, i + 1, 8.0));
+      }
+
+      // The whole block reports the closest triangle
+      std::optional<double> closest;
+      for (const auto& triangle : triangles) {
+        auto hit = triangle.intersectHit(Ray(ray));
+        if (hit && (!closest || hit->t < *closest)) {
+          closest = hit->t;
+        }
+      }
+      auto actual = block.intersect(Ray(ray), 0, block.size());
+      ASSERT_EQ(closest.has_value(), actual.has_value());
+      if (closest) {
+        EXPECT_EQ(*closest, actual->t);
+      }
+    }
+  }
+}
+
+TEST(TriangleBlockTest, TiesGoToTheLowestTag) {
+  TriangleBlock block;
+  Vector3D a(-1, -1, 10);
+  Vector3D b(1, -1, 10);
+  Vector3D c(0, 1, 10);
+  block.add(a, b, c, 7);
+  block.add(a, b, c, 3);
+  block.add(a + Vector3D(0, 0, 10), b + Vector3D(0, 0, 10),
+            c + Vector3D(0, 0, 10), 1);
+  for (auto kernel : supportedKernels()) {
+    block.setKernel(kernel);
+    Ray ray(Vector3D(0, 0, 0), Vector3D(0, 0, 1));
+    auto hit = block.intersect(ray, 0, block.size());
+    ASSERT_TRUE(hit);
+    EXPECT_DOUBLE_EQ(hit->t, 10.0);
+    EXPECT_EQ(hit->primitiveIndex, 3u);
+    EXPECT_DOUBLE_EQ(ray.getTMax(), 10.0);
+    // Ranges stop where asked, the padding is never hit
+    EXPECT_FALSE(block.intersect(Ray(Vector3D(0, 0, 15), Vector3D(0, 0, -1)),
+                                 2, 3));
+    EXPECT_FALSE(block.occluded(ray, 0, 2, 9.5));
+    EXPECT_TRUE(block.occluded(ray, 0, 2, 10.0));
+    // Rays in the plane of a triangle miss it
+    EXPECT_FALSE(
+        block.intersect(Ray(Vector3D(-5, 0, 10), Vector3D(1, 0, 0)), 0, 3));
+  }
+}
+
+TEST(TriangleBlockTest, MeshMatchesItsTriangles) {
+  std::vector<Triangle> triangles = makeTriangles(8, 300);
+  std::vector<Vector3D> vertices;
+  std::vector<Mesh::Face> faces;
+  for (const auto& triangle : triangles) {
+    uint32_t first = static_cast<uint32_t>(vertices.size());
+    vertices.push_back(triangle.getA());
+    vertices.push_back(triangle.getB());
+    vertices.push_back(triangle.getC());
+    faces.push_back({first, first + 1, first + 2});
+  }
+  Mesh mesh(vertices, faces, Color::GREEN);
+
+  for (const auto& ray : makeRandomRays(11, 2000)) {
+    std::optional<HitRecord> closest;
+    int closestFace = 0;
+    for (std::size_t i = 0; i < triangles.size(); ++i) {
+      auto hit = triangles[i].intersectHit(Ray(ray));
+      if (hit && (!closest || hit->t < closest->t)) {
+        closest = hit;
+        closestFace = static_cast<int>(i);
+      }
+    }
+    auto actual = mesh.intersectHit(Ray(ray));
+    ASSERT_EQ(closest.has_value(), actual.has_value());
+    if (closest) {
+      EXPECT_EQ(closest->t, actual->t);
+      EXPECT_EQ(closest->u, actual->u);
+      EXPECT_EQ(closest->v, actual->v);
+      EXPECT_EQ(closestFace, actual->part);
+    }
+    EXPECT_EQ(closest && closest->t <= 6.0, mesh.occluded(ray, 6.0));
+  }
+}
+
+TEST(TriangleBlockTest, SceneMatchesVirtualPrimitives) {
+  std::mt19937 rng(12);
+  std::uniform_real_distribution<double> angle(0.0, 360.0);
+  Scene linear;
+  linear.addPrimitive(std::make_shared<Plane>('Y', -12.0, Color::GRAY));
+  std::vector<Triangle> triangles = makeTriangles(13, 900);
+  for (std::size_t i = 0; i < triangles.size(); ++i) {
+    auto triangle = std::make_shared<Triangle>(triangles[i]);
+    if (i % 4 == 3) {
+      // Baked in world space, the hit moves by a rounding error
+      triangle->setTransform(Transform().rotateY(angle(rng)));
+    }
+    linear.addPrimitive(triangle);
+  }
+
+  for (auto type : {AcceleratorType::BVH, AcceleratorType::GRID}) {
+    Scene baked = linear;
+    baked.setAccelerator(type);
+    baked.finalize();
+    EXPECT_EQ(baked.getTriangleBlock().size(), 900u);
+    auto light = std::make_shared<PointLight>(Vector3D(0, 30, 0));
+
+    for (const auto& ray : makeRandomRays(14, 2000)) {
+      auto expected = linear.traceRay(ray);
+      auto actual = baked.traceRay(ray);
+      ASSERT_EQ(expected.has_value(), actual.has_value());
+      if (expected) {
+        EXPECT_NEAR(expected->distance, actual->distance,
+                    1e-9 * (1.0 + expected->distance));
+        EXPECT_EQ(expected->color, actual->color);
+        EXPECT_EQ(linear.isInShadow(expected->point, light),
+                  baked.isInShadow(expected->point, light));
+      }
+    }
+  }
+}
@@ -15,6 +15,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <type_traits>
 #include "../src/core/Vector3D.hpp"
 
 using namespace RayTracer;
@@ -278,3 +279,35 @@ TEST(Vector3DTest, InequalityOperator) {
   EXPECT_EQ(vec1 != vec2, !(vec1 == vec2));
   EXPECT_EQ(vec1 != vec3, !(vec1 == vec3));
 }
+
+// Test that the vectors are plain values, usable in constant expressions
+TEST(Vector3DTest, TriviallyCopyableAndConstexpr) {
+  EXPECT_TRUE(std::is_trivially_copyable_v<Vector3D>);
+  EXPECT_EQ(sizeof(Vector3D), 3 * sizeof(Real));
+
+  constexpr Vec3<double> a(1.0, 2.0, 3.0);
+  constexpr Vec3<double> b(4.0, 5.0, 6.0);
+  static_assert(a.dot(b) == 32.0);
+  static_assert((a + b).getZ() == 9.0);
+  static_assert(a.cross(b) == Vec3<double>(-3.0, 6.0, -3.0));
+  static_assert((-a * 2.0).getX() == -2.0);
+  static_assert((b / 2.0).getY() == 2.5);
+}
+
+// Test the single precision vectors and the conversions between precisions
+TEST(Vector3DTest, SinglePrecision) {
+  Vec3<float> a(1.0f, 2.0f, 2.0f);
+  EXPECT_EQ(sizeof(a), 3 * sizeof(float));
+  EXPECT_FLOAT_EQ(a.getMagnitude(), 3.0f);
+  Vec3<float> unit = a.normalized();
+  EXPECT_FLOAT_EQ(unit.getX(), 1.0f / 3.0f);
+  EXPECT_FLOAT_EQ(unit.dot(a), 3.0f);
+  EXPECT_THROW(Vec3<float>().normalized(), std::runtime_error);
+  EXPECT_THROW(a / 0.0f, std::runtime_error);
+
+  Vec3<double> wide(a);
+  EXPECT_DOUBLE_EQ(wide.getY(), 2.0);
+  Vec3<float> narrow(Vec3<double>(0.1, 0.2, 0.3));
+  EXPECT_EQ(narrow.getX(), 0.1f);
+  EXPECT_TRUE(narrow.isEqual(Vec3<float>(0.1f, 0.2f, 0.3f), 1e-7f));
+}